@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#include "perf_counters.h"
+
+namespace bench
+{
+	template <typename T>
+	inline void do_not_optimize(T const& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static_cast<void>(*static_cast<volatile char const*>(static_cast<void const*>(&value)));
+#endif
+	}
+
+	inline void clobber_memory()
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	struct result
+	{
+		std::string    name;
+		std::size_t    elements;
+		double         seconds;
+		counter_values counters;
+	};
+
+	inline perf_counters& counters()
+	{
+		static perf_counters instance;
+		return instance;
+	}
+
+	// Runs the kernel a few times and keeps the fastest run
+	template <typename Kernel>
+	result run(std::string name, std::size_t elements, Kernel&& kernel, int repetitions = 5)
+	{
+		using clock = std::chrono::steady_clock;
+
+		auto best        = std::chrono::duration<double>::max();
+		auto best_counts = counter_values{};
+		for (int i = 0; i < repetitions; ++i)
+		{
+			counters().start();
+			auto const start = clock::now();
+			kernel();
+			clobber_memory();
+			auto const elapsed = std::chrono::duration<double>{clock::now() - start};
+			auto const counts  = counters().stop();
+
+			if (elapsed < best)
+			{
+				best        = elapsed;
+				best_counts = counts;
+			}
+		}
+
+		return result{std::move(name), elements, best.count(), best_counts};
+	}
+
+	inline void print_header()
+	{
+		std::printf("%-48s %12s %12s", "benchmark", "ns/element", "Melem/s");
+		if (counters().available())
+		{
+			std::printf(" %10s %10s %6s %10s %10s", "cyc/elem", "ins/elem", "IPC", "brm/elem", "llcm/elem");
+		}
+		else
+		{
+			std::printf("  (hardware counters unavailable, timing only)");
+		}
+		std::printf("\n");
+	}
+
+	inline void print_per_element(counter_values const& counts, event e, std::size_t elements)
+	{
+		if (counts.has(e))
+		{
+			std::printf(" %10.3f", counts.get(e) / static_cast<double>(elements));
+		}
+		else
+		{
+			std::printf(" %10s", "-");
+		}
+	}
+
+	inline void print(result const& r)
+	{
+		auto const per_element = r.seconds * 1e9 / static_cast<double>(r.elements);
+		std::printf("%-48s %12.3f %12.1f", r.name.c_str(), per_element, r.elements / r.seconds / 1e6);
+
+		if (counters().available())
+		{
+			auto const& c = r.counters;
+			print_per_element(c, event::cycles, r.elements);
+			print_per_element(c, event::instructions, r.elements);
+			if (c.has(event::cycles) && c.has(event::instructions) && c.get(event::cycles) > 0)
+			{
+				std::printf(" %6.2f", c.get(event::instructions) / c.get(event::cycles));
+			}
+			else
+			{
+				std::printf(" %6s", "-");
+			}
+			print_per_element(c, event::branch_misses, r.elements);
+			print_per_element(c, event::cache_misses, r.elements);
+		}
+		std::printf("\n");
+	}
+}
@@ -0,0 +1,79 @@
+#include "bench.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/any_unit.h"
+#include "units/catalogue.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 20;
+
+	// The usual fallback: a double and the suffix it was read with
+	struct tagged
+	{
+		double      value;
+		std::string suffix;
+	};
+
+	double to_metres(tagged const& t)
+	{
+		auto const entry = units::catalogue::find(t.suffix);
+		return t.value * static_cast<double>(entry->scale);
+	}
+}
+
+int main()
+{
+	auto engine  = std::mt19937_64{42};
+	auto value   = std::uniform_real_distribution<double>{0, 1000};
+	auto alias   = std::uniform_int_distribution<int>{0, 3};
+	auto any     = std::vector<units::any_unit>{};
+	auto strings = std::vector<tagged>{};
+	auto plain   = std::vector<double>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const v = value(engine);
+		switch (alias(engine))
+		{
+		case 0: any.emplace_back(units::metres{v}); break;
+		case 1: any.emplace_back(units::feet{v}); break;
+		case 2: any.emplace_back(units::miles{v}); break;
+		default: any.emplace_back(units::kilometres{v}); break;
+		}
+		strings.push_back(tagged{v, any.back().suffix()});
+		plain.push_back(v);
+	}
+
+	auto out = std::vector<units::metres>(count, units::metres{0});
+
+	bench::print_header();
+	bench::print(bench::run("double and suffix lookup", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = units::metres{to_metres(strings[i])};
+		}
+		bench::do_not_optimize(out.data());
+	}));
+
+	bench::print(bench::run("any_unit::as per element", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = any[i].as<units::metres>();
+		}
+		bench::do_not_optimize(out.data());
+	}));
+
+	bench::print(bench::run("convert, mixed aliases", count, [&] {
+		units::convert(any.data(), any.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+
+	bench::print(bench::run("convert, one alias per batch", count, [&] {
+		units::convert(plain.data(), count, units::catalogue::unit_id<units::feet>::value, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+}
@@ -0,0 +1,92 @@
+#include "bench.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "units.h"
+#include "units/atomic.h"
+#include "units/sharded_counter.h"
+
+namespace
+{
+	constexpr std::size_t operations_per_thread = 1 << 20;
+
+	template <typename Work>
+	void run_threads(unsigned thread_count, Work const& work)
+	{
+		auto threads = std::vector<std::thread>{};
+		for (unsigned i = 0; i < thread_count; ++i)
+		{
+			threads.emplace_back(work);
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	template <typename Counter, typename Delta>
+	bench::result contended_add(std::string name, unsigned thread_count, Delta delta)
+	{
+		Counter counter;
+		return bench::run(name + " x" + std::to_string(thread_count), thread_count * operations_per_thread, [&] {
+			run_threads(thread_count, [&] {
+				for (std::size_t i = 0; i < operations_per_thread; ++i)
+				{
+					counter.add(delta);
+				}
+			});
+			bench::do_not_optimize(counter.load());
+		}, 3);
+	}
+
+	template <typename Counter, typename Delta>
+	bench::result contended_fetch_add(std::string name, unsigned thread_count, Delta delta)
+	{
+		Counter counter;
+		return bench::run(name + " x" + std::to_string(thread_count), thread_count * operations_per_thread, [&] {
+			run_threads(thread_count, [&] {
+				for (std::size_t i = 0; i < operations_per_thread; ++i)
+				{
+					counter.fetch_add(delta, std::memory_order_relaxed);
+				}
+			});
+		}, 3);
+	}
+
+	bench::result contended_mutex(unsigned thread_count)
+	{
+		auto       total = units::metres{0};
+		std::mutex mutex;
+		return bench::run("mutex<metres> += km x" + std::to_string(thread_count),
+		                  thread_count * operations_per_thread,
+		                  [&] {
+			                  run_threads(thread_count, [&] {
+				                  for (std::size_t i = 0; i < operations_per_thread; ++i)
+				                  {
+					                  std::lock_guard<std::mutex> lock{mutex};
+					                  total += units::kilometres{0.001};
+				                  }
+			                  });
+		                  },
+		                  3);
+	}
+}
+
+int main()
+{
+	auto const hardware = std::max(1u, std::thread::hardware_concurrency());
+
+	bench::print_header();
+	for (unsigned threads = 1; threads <= hardware * 2 && threads <= 64; threads *= 2)
+	{
+		bench::print(contended_fetch_add<units::atomic<units::metres>>(
+		    "atomic<metres>::fetch_add(km)", threads, units::kilometres{0.001}));
+		bench::print(contended_fetch_add<units::atomic<units::distance<std::int64_t, std::milli>>>(
+		    "atomic<int64 mm>::fetch_add(m)", threads, units::distance<std::int64_t>{1}));
+		bench::print(contended_add<units::sharded_counter<units::metres>>(
+		    "sharded_counter<metres>::add(km)", threads, units::kilometres{0.001}));
+		bench::print(contended_mutex(threads));
+	}
+}
@@ -0,0 +1,47 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/calibrated.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 20;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0, 4096};
+	auto readings     = std::vector<double>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		readings.push_back(distribution(engine));
+	}
+
+	auto const column  = units::calibrated_column<units::millimetres>{0.0625, readings};
+	auto const static_ = std::vector<units::millimetres>(readings.begin(), readings.end());
+	auto       out     = std::vector<units::metres>(count, units::metres{0});
+
+	bench::print_header();
+	bench::print(bench::run("bulk::cast, static ratio", count, [&] {
+		units::bulk::cast(static_.data(), static_.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+
+	bench::print(bench::run("calibrated_column::cast", count, [&] {
+		column.cast(out.data());
+		bench::do_not_optimize(out.data());
+	}));
+
+	bench::print(bench::run("unit_cast per calibrated element", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = units::unit_cast<units::metres>(column[i]);
+		}
+		bench::do_not_optimize(out.data());
+	}));
+}
@@ -0,0 +1,109 @@
+#include "bench.h"
+
+#include <cstddef>
+#include <random>
+#include <ratio>
+#include <vector>
+
+#include "units.h"
+
+namespace
+{
+	// clang-format off
+	struct gcd_distance {};
+	struct base_distance {};
+	// clang-format on
+}
+
+namespace units
+{
+	template <>
+	struct common_ratio_policy<gcd_distance>
+	{
+		using type = common_ratio::gcd;
+	};
+
+	template <>
+	struct common_ratio_policy<base_distance>
+	{
+		using type = common_ratio::base;
+	};
+}
+
+namespace
+{
+	constexpr std::size_t count = 1 << 22;
+
+	template <typename UnitType>
+	struct columns
+	{
+		using metres = units::unit<double, std::ratio<1>, UnitType>;
+		using feet   = units::unit<double, units::feet::ratio, UnitType>;
+		using miles  = units::unit<double, units::miles::ratio, UnitType>;
+
+		std::vector<metres> readings;
+		std::vector<feet>   offsets;
+		std::vector<miles>  limits;
+		std::vector<metres> out;
+	};
+
+	template <typename UnitType>
+	columns<UnitType> make_columns()
+	{
+		using column = columns<UnitType>;
+
+		auto engine       = std::mt19937_64{42};
+		auto distribution = std::uniform_real_distribution<double>{0.0, 2000.0};
+
+		auto result = column{};
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			result.readings.emplace_back(distribution(engine));
+			result.offsets.emplace_back(distribution(engine));
+			result.limits.emplace_back(distribution(engine) / 1000.0);
+		}
+		result.out = result.readings;
+		return result;
+	}
+
+	// metres + feet, stored back as metres as most callers do
+	template <typename UnitType>
+	void bench_arithmetic(char const* name)
+	{
+		using metres = typename columns<UnitType>::metres;
+
+		auto data = make_columns<UnitType>();
+		bench::print(bench::run(name, count, [&] {
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				data.out[i] = units::unit_cast<metres>(data.readings[i] + data.offsets[i]
+				                                       - data.offsets[count - 1 - i]);
+			}
+			bench::do_not_optimize(data.out.data());
+		}));
+	}
+
+	// metres < miles
+	template <typename UnitType>
+	void bench_compare(char const* name)
+	{
+		auto data = make_columns<UnitType>();
+		bench::print(bench::run(name, count, [&] {
+			std::size_t below = 0;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				below += data.readings[i] < data.limits[i] ? 1 : 0;
+			}
+			bench::do_not_optimize(below);
+		}));
+	}
+}
+
+int main()
+{
+	bench::print_header();
+	bench_arithmetic<gcd_distance>("metres + feet - feet to metres, gcd");
+	bench_arithmetic<base_distance>("metres + feet - feet to metres, base");
+	bench_compare<gcd_distance>("metres < miles, gcd");
+	bench_compare<base_distance>("metres < miles, base");
+}
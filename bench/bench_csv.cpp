@@ -0,0 +1,63 @@
+#include "bench.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "units.h"
+#include "units/csv.h"
+
+namespace
+{
+	constexpr std::size_t rows = 1 << 20;
+
+	std::string make_csv()
+	{
+		auto engine       = std::mt19937_64{42};
+		auto distribution = std::uniform_real_distribution<double>{0, 100000};
+		auto text         = std::string{"id,distance_ft,mass[kg],note\n"};
+		for (std::size_t i = 0; i < rows; ++i)
+		{
+			text += std::to_string(i) + "," + std::to_string(distribution(engine)) + ","
+			        + std::to_string(distribution(engine) / 100) + ",x\n";
+		}
+		return text;
+	}
+}
+
+int main()
+{
+	auto const text = make_csv();
+	std::printf("%zu rows, %.1f MiB\n", rows, text.size() / 1048576.0);
+
+	bench::print_header();
+	for (std::size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2)
+	{
+		auto opts    = units::csv::options{};
+		opts.threads = threads;
+		bench::print(bench::run("csv::read 2 columns x" + std::to_string(threads), rows, [&] {
+			std::istringstream in{text};
+			auto columns = units::csv::read(in,
+			                                opts,
+			                                units::csv::column<units::metres>("distance"),
+			                                units::csv::column<units::kilograms>("mass"));
+			bench::do_not_optimize(std::get<0>(columns).data());
+		}, 3));
+	}
+
+	bench::print(bench::run("istream >> double, 2 columns", rows, [&] {
+		std::istringstream in{text};
+		auto               line = std::string{};
+		std::getline(in, line);
+		auto distance = std::vector<units::metres>{};
+		auto mass     = std::vector<units::kilograms>{};
+		double id = 0, d = 0, m = 0;
+		char   comma = 0;
+		while (in >> id >> comma >> d >> comma >> m && std::getline(in, line))
+		{
+			distance.push_back(units::unit_cast<units::metres>(units::feet{d}));
+			mass.push_back(units::kilograms{m});
+		}
+		bench::do_not_optimize(distance.data());
+	}, 3));
+}
@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+
+namespace
+{
+	constexpr std::size_t elements = 1 << 20;
+
+	std::vector<double> make_values()
+	{
+		auto engine       = std::mt19937_64{42};
+		auto distribution = std::uniform_real_distribution<double>{0, 1000};
+		auto values       = std::vector<double>(elements);
+		for (auto& value : values)
+		{
+			value = distribution(engine);
+		}
+		return values;
+	}
+
+	std::string make_text(std::vector<double> const& values)
+	{
+		auto text = std::string{};
+		for (auto value : values)
+		{
+			text += std::to_string(value);
+			text += '\n';
+		}
+		return text;
+	}
+
+	void run_tier(units::cpu::tier tier, std::vector<double> const& values, std::string const& text)
+	{
+		auto const& kernels = units::bulk::kernels(tier);
+		auto const  prefix  = std::string{units::cpu::name(tier)} + " ";
+		auto        out     = std::vector<double>(elements);
+		auto        floats  = std::vector<float>(values.begin(), values.end());
+
+		bench::print(bench::run(prefix + "cast f64 (ft -> m)", elements, [&] {
+			kernels.f64.scale(values.data(), elements, 0.3048, out.data());
+			bench::do_not_optimize(out.data());
+		}));
+		bench::print(bench::run(prefix + "cast f32 (ft -> m)", elements, [&] {
+			kernels.f32.scale(floats.data(), elements, 0.3048f, floats.data());
+			bench::do_not_optimize(floats.data());
+		}));
+		bench::print(bench::run(prefix + "sum f64", elements, [&] {
+			bench::do_not_optimize(kernels.f64.sum(values.data(), elements));
+		}));
+		bench::print(bench::run(prefix + "min f64", elements, [&] {
+			bench::do_not_optimize(kernels.f64.min(values.data(), elements));
+		}));
+		bench::print(bench::run(prefix + "count_between f64", elements, [&] {
+			bench::do_not_optimize(kernels.f64.count_between(values.data(), elements, 250.0, 750.0));
+		}));
+		bench::print(bench::run(prefix + "parse f64", elements, [&] {
+			bench::do_not_optimize(kernels.parse(text.data(), text.data() + text.size(), out.data(), elements));
+		}));
+	}
+}
+
+int main()
+{
+	auto const values = make_values();
+	auto const text   = make_text(values);
+
+	std::printf("active tier: %s\n", units::cpu::name(units::cpu::active_tier()));
+	bench::print_header();
+	for (auto tier : {units::cpu::tier::scalar, units::cpu::tier::sse42, units::cpu::tier::avx2, units::cpu::tier::avx512})
+	{
+		if (units::cpu::supported(tier))
+		{
+			run_tier(tier, values, text);
+		}
+		else
+		{
+			std::printf("%s not supported on this machine\n", units::cpu::name(tier));
+		}
+	}
+}
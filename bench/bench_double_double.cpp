@@ -0,0 +1,121 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/double_double.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 20;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0, 1000};
+
+	auto long_doubles   = std::vector<units::light_years>{};
+	auto double_doubles = std::vector<units::dd::light_years>{};
+	auto metres         = std::vector<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const value = distribution(engine);
+		long_doubles.emplace_back(value);
+		double_doubles.emplace_back(value);
+		metres.push_back(units::unit_cast<units::metres>(units::light_years{value}));
+	}
+
+	auto out_metres         = std::vector<units::metres>(count, units::metres{0});
+	auto out_long_doubles   = std::vector<units::light_years>(count, units::light_years{0});
+	auto out_double_doubles = std::vector<units::dd::light_years>(count, units::dd::light_years{0});
+
+	bench::print_header();
+	bench::print(bench::run("light years to metres, long double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_metres[i] = units::unit_cast<units::metres>(long_doubles[i]);
+		}
+		bench::do_not_optimize(out_metres.data());
+	}));
+	bench::print(bench::run("light years to metres, double_double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_metres[i] = units::unit_cast<units::metres>(double_doubles[i]);
+		}
+		bench::do_not_optimize(out_metres.data());
+	}));
+
+	bench::print(bench::run("light years to metres, dd::cast", count, [&] {
+		units::dd::cast(double_doubles.data(), double_doubles.data() + count, out_metres.data());
+		bench::do_not_optimize(out_metres.data());
+	}));
+
+	bench::print(bench::run("metres to light years, long double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_long_doubles[i] = units::unit_cast<units::light_years>(metres[i]);
+		}
+		bench::do_not_optimize(out_long_doubles.data());
+	}));
+	bench::print(bench::run("metres to light years, double_double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_double_doubles[i] = units::unit_cast<units::dd::light_years>(metres[i]);
+		}
+		bench::do_not_optimize(out_double_doubles.data());
+	}));
+
+	bench::print(bench::run("metres to light years, dd::cast", count, [&] {
+		units::dd::cast(metres.data(), metres.data() + count, out_double_doubles.data());
+		bench::do_not_optimize(out_double_doubles.data());
+	}));
+	bench::print(bench::run("light years to parsecs, long double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_long_doubles[i] = units::unit_cast<units::parsecs>(long_doubles[i]);
+		}
+		bench::do_not_optimize(out_long_doubles.data());
+	}));
+	bench::print(bench::run("light years to parsecs, dd::cast", count, [&] {
+		auto const out = reinterpret_cast<units::dd::parsecs*>(out_double_doubles.data());
+		units::dd::cast(double_doubles.data(), double_doubles.data() + count, out);
+		bench::do_not_optimize(out);
+	}));
+
+	bench::print(bench::run("parsecs + light years, long double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_long_doubles[i] = units::parsecs{long_doubles[i].count()} + long_doubles[i];
+		}
+		bench::do_not_optimize(out_long_doubles.data());
+	}));
+	bench::print(bench::run("parsecs + light years, double_double", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out_double_doubles[i] = units::dd::parsecs{double_doubles[i].count()} + double_doubles[i];
+		}
+		bench::do_not_optimize(out_double_doubles.data());
+	}));
+
+	bench::print(bench::run("sum, long double", count, [&] {
+		auto total = units::light_years{0};
+		for (auto const& value : long_doubles)
+		{
+			total += value;
+		}
+		bench::do_not_optimize(total);
+	}));
+	bench::print(bench::run("sum, double_double", count, [&] {
+		auto total = units::dd::light_years{0};
+		for (auto const& value : double_doubles)
+		{
+			total += value;
+		}
+		bench::do_not_optimize(total);
+	}));
+	bench::print(bench::run("sum, dd::sum", count, [&] {
+		bench::do_not_optimize(units::dd::sum(double_doubles.data(), double_doubles.data() + count));
+	}));
+}
@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/families.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 24;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0, 1000};
+
+	auto f64 = std::vector<units::f64::metres>{};
+	auto f32 = std::vector<units::f32::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const value = distribution(engine);
+		f64.emplace_back(value);
+		f32.emplace_back(static_cast<float>(value));
+	}
+	auto out64 = std::vector<units::f64::kilometres>(count, units::f64::kilometres{0});
+	auto out32 = std::vector<units::f32::kilometres>(count, units::f32::kilometres{0});
+
+	bench::print_header();
+	bench::print(bench::run("bulk::sum, f64::metres", count, [&] {
+		bench::do_not_optimize(units::bulk::sum(f64.data(), f64.data() + count));
+	}));
+	bench::print(bench::run("bulk::sum, f32::metres", count, [&] {
+		bench::do_not_optimize(units::bulk::sum(f32.data(), f32.data() + count));
+	}));
+	bench::print(bench::run("bulk::cast to kilometres, f64", count, [&] {
+		units::bulk::cast(f64.data(), f64.data() + count, out64.data());
+		bench::do_not_optimize(out64.data());
+	}));
+	bench::print(bench::run("bulk::cast to kilometres, f32", count, [&] {
+		units::bulk::cast(f32.data(), f32.data() + count, out32.data());
+		bench::do_not_optimize(out32.data());
+	}));
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "units.h"
+#include "units/format.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 20;
+
+	// Picks the alias with a chain of casts and comparisons
+	void format_with_casts(std::ostream& os, units::metres value)
+	{
+		if (value >= units::kilometres{1})
+		{
+			os << units::unit_cast<units::kilometres>(value);
+		}
+		else if (value >= units::metres{1})
+		{
+			os << value;
+		}
+		else if (value >= units::centimetres{1})
+		{
+			os << units::unit_cast<units::centimetres>(value);
+		}
+		else if (value >= units::millimetres{1})
+		{
+			os << units::unit_cast<units::millimetres>(value);
+		}
+		else if (value >= units::micrometres{1})
+		{
+			os << units::unit_cast<units::micrometres>(value);
+		}
+		else
+		{
+			os << units::unit_cast<units::nanometres>(value);
+		}
+	}
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{-10, 7};
+	auto values       = std::vector<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		values.emplace_back(std::pow(10.0, distribution(engine)));
+	}
+
+	bench::print_header();
+	bench::print(bench::run("format::scale", count, [&] {
+		auto total = 0.0;
+		for (auto const& value : values)
+		{
+			total += units::format::scale(value).value;
+		}
+		bench::do_not_optimize(total);
+	}));
+
+	bench::print(bench::run("format::format_to", count, [&] {
+		char buffer[units::format::buffer_size];
+		for (auto const& value : values)
+		{
+			bench::do_not_optimize(units::format::format_to(buffer, value));
+		}
+	}));
+
+	bench::print(bench::run("unit_cast chain and operator<<", count, [&] {
+		std::ostringstream os;
+		os.precision(4);
+		for (auto const& value : values)
+		{
+			format_with_casts(os, value);
+		}
+		bench::do_not_optimize(os.str().data());
+	}));
+}
@@ -0,0 +1,126 @@
+#include "bench.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/geodesic.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 20;
+	constexpr double      pi    = 3.14159265358979323846;
+
+	double libm_haversine(double lat1, double lon1, double lat2, double lon2)
+	{
+		auto const phi1    = lat1 * pi / 180;
+		auto const phi2    = lat2 * pi / 180;
+		auto const dphi    = std::sin((phi2 - phi1) / 2);
+		auto const dlambda = std::sin((lon2 - lon1) * pi / 180 / 2);
+		auto const a       = dphi * dphi + std::cos(phi1) * std::cos(phi2) * dlambda * dlambda;
+		return 2 * 6371000.0 * std::asin(std::sqrt(std::fmin(a, 1.0)));
+	}
+
+	struct pairs
+	{
+		std::vector<double> lat1, lon1, lat2, lon2;
+	};
+
+	// Half of the pairs are within about 50 km of each other, the rest anywhere on the globe
+	pairs make_pairs()
+	{
+		auto engine    = std::mt19937_64{42};
+		auto latitude  = std::uniform_real_distribution<double>{-70, 70};
+		auto longitude = std::uniform_real_distribution<double>{-180, 180};
+		auto nearby    = std::uniform_real_distribution<double>{-0.3, 0.3};
+
+		auto p = pairs{};
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			p.lat1.push_back(latitude(engine));
+			p.lon1.push_back(longitude(engine));
+			p.lat2.push_back(i % 2 ? p.lat1.back() + nearby(engine) : latitude(engine));
+			p.lon2.push_back(i % 2 ? std::fmod(p.lon1.back() + nearby(engine) + 540, 360) - 180 : longitude(engine));
+		}
+		return p;
+	}
+}
+
+int main()
+{
+	auto const p   = make_pairs();
+	auto       out = std::vector<units::metres>(count, units::metres{0});
+	auto       ref = std::vector<double>(count);
+
+	bench::print_header();
+	bench::print(bench::run("libm haversine", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ref[i] = libm_haversine(p.lat1[i], p.lon1[i], p.lat2[i], p.lon2[i]);
+		}
+		bench::do_not_optimize(ref.data());
+	}));
+
+	using units::cpu::tier;
+	auto const raw = reinterpret_cast<double*>(out.data());
+	for (auto t : {tier::scalar, tier::sse42, tier::avx2, tier::avx512})
+	{
+		if (!units::cpu::supported(t))
+		{
+			continue;
+		}
+
+		auto const& kernels = units::geodesic::kernels(t);
+		bench::print(bench::run(std::string{"haversine "} + units::cpu::name(t), count, [&] {
+			kernels.haversine(p.lat1.data(), p.lon1.data(), p.lat2.data(), p.lon2.data(), count, 6371000, raw);
+			bench::do_not_optimize(raw);
+		}));
+		bench::print(bench::run(std::string{"equirectangular "} + units::cpu::name(t), count, [&] {
+			kernels.equirectangular(p.lat1.data(), p.lon1.data(), p.lat2.data(), p.lon2.data(), count, 6371000, raw);
+			bench::do_not_optimize(raw);
+		}));
+		bench::print(bench::run(std::string{"vincenty "} + units::cpu::name(t), count, [&] {
+			kernels.vincenty(p.lat1.data(), p.lon1.data(), p.lat2.data(), p.lon2.data(), count, 1, raw);
+			bench::do_not_optimize(raw);
+		}, 1));
+	}
+
+	auto ellipsoid = std::vector<units::metres>(count, units::metres{0});
+	bench::print(bench::run("vincenty, one pair at a time", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ellipsoid[i] = units::geodesic::vincenty({p.lat1[i], p.lon1[i]}, {p.lat2[i], p.lon2[i]});
+		}
+		bench::do_not_optimize(ellipsoid.data());
+	}, 1));
+	units::geodesic::vincenty(p.lat1.data(), p.lon1.data(), p.lat2.data(), p.lon2.data(), count, ellipsoid.data());
+
+	// Accuracy of each method against a more exact one
+	units::geodesic::haversine(p.lat1.data(), p.lon1.data(), p.lat2.data(), p.lon2.data(), count, out.data());
+	auto worst_haversine = 0.0;
+	auto worst_sphere    = 0.0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		worst_haversine = std::fmax(worst_haversine, std::fabs(out[i].count() - ref[i]));
+		if (ellipsoid[i].count() > 0)
+		{
+			worst_sphere = std::fmax(worst_sphere, std::fabs(out[i].count() / ellipsoid[i].count() - 1));
+		}
+	}
+
+	auto flat = std::vector<units::metres>(count, units::metres{0});
+	units::geodesic::equirectangular(p.lat1.data(), p.lon1.data(), p.lat2.data(), p.lon2.data(), count, flat.data());
+	auto worst_flat = 0.0;
+	for (std::size_t i = 1; i < count; i += 2)
+	{
+		worst_flat = std::fmax(worst_flat, std::fabs(flat[i].count() / out[i].count() - 1));
+	}
+
+	std::printf("\nhaversine against libm          max abs error %.3g m\n", worst_haversine);
+	std::printf("haversine against vincenty      max rel error %.3g\n", worst_sphere);
+	std::printf("equirectangular within 50 km    max rel error %.3g\n", worst_flat);
+}
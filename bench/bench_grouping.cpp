@@ -0,0 +1,101 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "units.h"
+#include "units/grouping.h"
+
+using namespace distance_literals;
+
+namespace
+{
+	constexpr std::size_t count = 1 << 20;
+
+	// Labels each element with its group by sorting indices and splitting at every gap wider than the tolerance
+	std::vector<std::size_t> sort_groups(std::vector<units::metres> const& values, double tolerance)
+	{
+		std::vector<std::size_t> order(values.size());
+		for (std::size_t i = 0; i < order.size(); ++i)
+		{
+			order[i] = i;
+		}
+		std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+			return values[lhs].count() < values[rhs].count();
+		});
+
+		std::vector<std::size_t> labels(values.size());
+		std::size_t              group = 0;
+		for (std::size_t i = 0; i < order.size(); ++i)
+		{
+			if (i > 0 && values[order[i]].count() - values[order[i - 1]].count() > tolerance)
+			{
+				++group;
+			}
+			labels[order[i]] = group;
+		}
+		return labels;
+	}
+
+	std::size_t sort_dedup(std::vector<units::metres> values, double tolerance)
+	{
+		std::sort(values.begin(), values.end());
+		auto const last = std::unique(values.begin(), values.end(), [&](units::metres lhs, units::metres rhs) {
+			return rhs.count() - lhs.count() <= tolerance;
+		});
+		return static_cast<std::size_t>(last - values.begin());
+	}
+}
+
+int main()
+{
+	auto engine = std::mt19937_64{42};
+
+	// Readings scattered around a tenth of as many true positions, so most values have close neighbours
+	auto positions = std::uniform_real_distribution<double>{0.0, 100000.0};
+	auto noise     = std::normal_distribution<double>{0.0, 0.001};
+	auto centres   = std::vector<double>{};
+	for (std::size_t i = 0; i < count / 10; ++i)
+	{
+		centres.push_back(positions(engine));
+	}
+
+	auto pick   = std::uniform_int_distribution<std::size_t>{0, centres.size() - 1};
+	auto values = std::vector<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		values.emplace_back(centres[pick(engine)] + noise(engine));
+	}
+
+	auto unique = std::vector<units::metres>{};
+	unique.reserve(count);
+
+	bench::print_header();
+	bench::print(bench::run("sort indices and split (group by)", count, [&] {
+		bench::do_not_optimize(sort_groups(values, 0.01));
+	}));
+	bench::print(bench::run("units::group_by", count, [&] {
+		bench::do_not_optimize(units::group_by(values.begin(), values.end(), 1_cm).size());
+	}));
+	bench::print(bench::run("sort and unique within tolerance (dedup)", count, [&] {
+		bench::do_not_optimize(sort_dedup(values, 0.01));
+	}));
+	bench::print(bench::run("units::dedup", count, [&] {
+		unique.clear();
+		units::dedup(values.begin(), values.end(), std::back_inserter(unique), 1_cm);
+		bench::do_not_optimize(unique.size());
+	}));
+	bench::print(bench::run("std::unordered_set with grid_hash", count, [&] {
+		using hash  = units::grid_hash<units::metres>;
+		using equal = units::grid_equal<units::metres>;
+
+		auto const cells = units::grid<units::metres>{1_cm};
+		auto       set   = std::unordered_set<units::metres, hash, equal>{16, hash{cells}, equal{cells}};
+		set.insert(values.begin(), values.end());
+		bench::do_not_optimize(set.size());
+	}));
+}
@@ -0,0 +1,100 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/cpu_dispatch.h"
+#include "units/families.h"
+#include "units/half.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 22;
+}
+
+int main()
+{
+	using half_millimetres = units::family<units::half>::millimetres;
+	using bf16_millimetres = units::family<units::bfloat16>::millimetres;
+
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0, 60};
+
+	auto metres = std::vector<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		metres.emplace_back(distribution(engine));
+	}
+	auto doubles = std::vector<units::millimetres>(count, units::millimetres{0});
+	auto halves  = std::vector<half_millimetres>(count, half_millimetres{0});
+	auto bf16s   = std::vector<bf16_millimetres>(count, bf16_millimetres{0});
+	auto out     = std::vector<units::metres>(count, units::metres{0});
+
+	units::bulk::cast(metres.data(), metres.data() + count, doubles.data());
+	units::bulk::narrow(metres.data(), metres.data() + count, halves.data());
+	units::bulk::narrow(metres.data(), metres.data() + count, bf16s.data());
+
+	bench::print_header();
+	bench::print(bench::run("bulk::cast, double millimetres to metres", count, [&] {
+		units::bulk::cast(doubles.data(), doubles.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("unit_cast loop, half millimetres to metres", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = units::unit_cast<units::metres>(halves[i]);
+		}
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("bulk::widen, half millimetres to metres", count, [&] {
+		units::bulk::widen(halves.data(), halves.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("bulk::widen, bfloat16 millimetres to metres", count, [&] {
+		units::bulk::widen(bf16s.data(), bf16s.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("bulk::narrow, metres to half millimetres", count, [&] {
+		units::bulk::narrow(metres.data(), metres.data() + count, halves.data());
+		bench::do_not_optimize(halves.data());
+	}));
+	bench::print(bench::run("bulk::narrow, metres to bfloat16 millimetres", count, [&] {
+		units::bulk::narrow(metres.data(), metres.data() + count, bf16s.data(), units::rounding::toward_zero);
+		bench::do_not_optimize(bf16s.data());
+	}));
+
+	auto const tiers = {units::cpu::tier::scalar,
+	                    units::cpu::tier::sse42,
+	                    units::cpu::tier::avx2,
+	                    units::cpu::tier::avx512};
+	auto const in    = units::detail::raw(metres.data());
+	auto const bits  = reinterpret_cast<std::uint16_t*>(halves.data());
+	for (auto tier : tiers)
+	{
+		auto const& software = units::bulk::float16_software_kernels_for(tier);
+		auto const& hardware = units::bulk::float16_kernels_for(tier);
+		auto const  name     = std::string{units::cpu::name(software.tier)};
+
+		bench::print(bench::run("narrow binary16, software " + name, count, [&] {
+			software.binary16.narrow(in, count, 1000.0, units::rounding::to_nearest, bits);
+			bench::do_not_optimize(bits);
+		}));
+		bench::print(bench::run("widen binary16, software " + name, count, [&] {
+			software.binary16.widen(bits, count, 0.001, units::detail::raw(out.data()));
+			bench::do_not_optimize(out.data());
+		}));
+		if (hardware.hardware)
+		{
+			bench::print(bench::run("narrow binary16, hardware " + name, count, [&] {
+				hardware.binary16.narrow(in, count, 1000.0, units::rounding::to_nearest, bits);
+				bench::do_not_optimize(bits);
+			}));
+			bench::print(bench::run("widen binary16, hardware " + name, count, [&] {
+				hardware.binary16.widen(bits, count, 0.001, units::detail::raw(out.data()));
+				bench::do_not_optimize(out.data());
+			}));
+		}
+	}
+}
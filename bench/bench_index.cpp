@@ -0,0 +1,92 @@
+#include "bench.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/index.h"
+
+using namespace distance_literals;
+
+namespace
+{
+	constexpr std::size_t count   = 1 << 24;
+	constexpr std::size_t queries = 1 << 16;
+}
+
+int main()
+{
+	auto engine  = std::mt19937_64{42};
+	auto lengths = std::uniform_real_distribution<double>{0.0, 20000.0};
+
+	auto segments = std::vector<units::metres>{};
+	auto ends     = std::vector<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		segments.emplace_back(lengths(engine));
+		ends.push_back(segments.back() + units::metres{lengths(engine) / 10000.0});
+	}
+
+	// Bounds arrive in whatever unit the query was written in
+	auto miles = std::uniform_real_distribution<double>{0.0, 6.0};
+	auto lo    = std::vector<units::miles>{};
+	auto hi    = std::vector<units::kilometres>{};
+	for (std::size_t i = 0; i < queries; ++i)
+	{
+		lo.emplace_back(miles(engine));
+		hi.push_back(units::unit_cast<units::kilometres>(lo.back()) + units::kilometres{0.5});
+	}
+
+	auto serial    = units::index_options{};
+	serial.threads = 1;
+
+	bench::print_header();
+	bench::print(bench::run("linear scan with mixed unit compares", count, [&] {
+		std::size_t found = 0;
+		for (auto s : segments)
+		{
+			found += static_cast<std::size_t>(s >= 2_mi && s < 5_km);
+		}
+		bench::do_not_optimize(found);
+	}));
+	bench::print(bench::run("bulk::count_between", count, [&] {
+		bench::do_not_optimize(units::bulk::count_between(segments.data(), segments.data() + count, 2_mi, 5_km));
+	}));
+	bench::print(bench::run("range_index build, one thread", count, [&] {
+		bench::do_not_optimize(units::range_index<units::metres>{segments.begin(), segments.end(), serial}.size());
+	}));
+	bench::print(bench::run("range_index build, all threads", count, [&] {
+		bench::do_not_optimize(units::range_index<units::metres>{segments.begin(), segments.end()}.size());
+	}));
+
+	auto const index = units::range_index<units::metres>{segments.begin(), segments.end()};
+	bench::print(bench::run("range_index::count_between per query", queries, [&] {
+		std::size_t found = 0;
+		for (std::size_t i = 0; i < queries; ++i)
+		{
+			found += index.count_between(lo[i], hi[i]);
+		}
+		bench::do_not_optimize(found);
+	}));
+
+	bench::print(bench::run("linear stabbing scan", count, [&] {
+		std::size_t found = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			found += static_cast<std::size_t>(segments[i] <= 1_mi && 1_mi <= ends[i]);
+		}
+		bench::do_not_optimize(found);
+	}));
+
+	auto const intervals = units::interval_index<units::metres>{segments.begin(), segments.end(), ends.begin()};
+	bench::print(bench::run("interval_index::count_containing per query", queries, [&] {
+		std::size_t found = 0;
+		for (std::size_t i = 0; i < queries; ++i)
+		{
+			found += intervals.count_containing(lo[i]);
+		}
+		bench::do_not_optimize(found);
+	}));
+}
@@ -0,0 +1,115 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "units.h"
+
+namespace
+{
+	constexpr std::size_t elements = 1 << 20;
+
+	template <typename Unit>
+	std::vector<Unit> make_values()
+	{
+		auto engine       = std::mt19937_64{42};
+		auto distribution = std::uniform_real_distribution<double>{0, 1000};
+		auto values       = std::vector<Unit>{};
+		values.reserve(elements);
+		for (std::size_t i = 0; i < elements; ++i)
+		{
+			values.push_back(Unit{static_cast<typename Unit::rep>(distribution(engine))});
+		}
+		return values;
+	}
+
+	template <typename To, typename From>
+	bench::result cast_kernel(std::string name)
+	{
+		auto const in  = make_values<From>();
+		auto       out = std::vector<To>(elements, To{0});
+		return bench::run(name, elements, [&] {
+			for (std::size_t i = 0; i < elements; ++i)
+			{
+				out[i] = units::unit_cast<To>(in[i]);
+			}
+			bench::do_not_optimize(out.data());
+		});
+	}
+
+	template <typename Lhs, typename Rhs>
+	bench::result add_kernel(std::string name)
+	{
+		auto const lhs = make_values<Lhs>();
+		auto const rhs = make_values<Rhs>();
+		auto       out = std::vector<Lhs>(elements, Lhs{0});
+		return bench::run(name, elements, [&] {
+			for (std::size_t i = 0; i < elements; ++i)
+			{
+				out[i] = lhs[i] + rhs[i];
+			}
+			bench::do_not_optimize(out.data());
+		});
+	}
+
+	template <typename Lhs, typename Rhs>
+	bench::result compare_kernel(std::string name)
+	{
+		auto const lhs = make_values<Lhs>();
+		auto const rhs = make_values<Rhs>();
+		return bench::run(name, elements, [&] {
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < elements; ++i)
+			{
+				count += lhs[i] < rhs[i];
+			}
+			bench::do_not_optimize(count);
+		});
+	}
+
+	template <typename Unit>
+	bench::result scale_kernel(std::string name)
+	{
+		auto values = make_values<Unit>();
+		return bench::run(name, elements, [&] {
+			for (auto& value : values)
+			{
+				value *= 1.0001;
+			}
+			bench::do_not_optimize(values.data());
+		});
+	}
+
+	template <typename Unit>
+	bench::result sum_kernel(std::string name)
+	{
+		auto const values = make_values<Unit>();
+		return bench::run(name, elements, [&] {
+			auto total = Unit{0};
+			for (auto value : values)
+			{
+				total += value;
+			}
+			bench::do_not_optimize(total);
+		});
+	}
+}
+
+int main()
+{
+	bench::print_header();
+
+	bench::print(cast_kernel<units::metres, units::kilometres>("unit_cast km -> m"));
+	bench::print(cast_kernel<units::metres, units::feet>("unit_cast ft -> m"));
+	bench::print(cast_kernel<units::kilometres, units::miles>("unit_cast mi -> km"));
+	bench::print(cast_kernel<units::metres, units::distance<std::int32_t, std::milli>>("unit_cast int32 mm -> m"));
+	bench::print(cast_kernel<units::light_years, units::parsecs>("unit_cast pc -> ly (long double)"));
+	bench::print(cast_kernel<units::kilograms, units::pounds>("unit_cast lb -> kg"));
+
+	bench::print(add_kernel<units::metres, units::metres>("operator+ m + m"));
+	bench::print(add_kernel<units::metres, units::feet>("operator+ m + ft"));
+	bench::print(compare_kernel<units::metres, units::metres>("operator< m < m"));
+	bench::print(compare_kernel<units::feet, units::metres>("operator< ft < m"));
+	bench::print(scale_kernel<units::metres>("operator*= m"));
+	bench::print(sum_kernel<units::metres>("operator+= m"));
+}
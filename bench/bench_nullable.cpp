@@ -0,0 +1,93 @@
+#include "bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/nullable.h"
+
+using namespace distance_literals;
+
+namespace
+{
+	constexpr std::size_t count = 1 << 22;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0.0, 2000.0};
+	auto missing      = std::bernoulli_distribution{0.1};
+
+	auto optional = std::vector<std::optional<units::metres>>{};
+	auto sentinel = std::vector<units::nullable<units::metres>>{};
+	auto bitmap   = units::bitmap_column<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const value = units::metres{distribution(engine)};
+		if (missing(engine))
+		{
+			optional.emplace_back();
+			sentinel.emplace_back();
+			bitmap.push_back(units::null);
+		}
+		else
+		{
+			optional.emplace_back(value);
+			sentinel.emplace_back(value);
+			bitmap.push_back(value);
+		}
+	}
+	auto const first = sentinel.data();
+	auto const last  = sentinel.data() + count;
+
+	bench::print_header();
+	bench::print(bench::run("bulk::sum without nulls", count, [&] {
+		bench::do_not_optimize(units::bulk::sum(bitmap.data(), bitmap.data() + count));
+	}));
+	bench::print(bench::run("std::optional sum loop", count, [&] {
+		auto total = 0_m;
+		for (auto const& value : optional)
+		{
+			if (value)
+			{
+				total += *value;
+			}
+		}
+		bench::do_not_optimize(total);
+	}));
+	bench::print(bench::run("bulk::sum, sentinel", count, [&] {
+		bench::do_not_optimize(units::bulk::sum(first, last));
+	}));
+	bench::print(bench::run("bulk::sum, bitmap", count, [&] {
+		bench::do_not_optimize(units::bulk::sum(bitmap.data(), bitmap.data() + count, bitmap.validity()));
+	}));
+	bench::print(bench::run("bulk::min without nulls", count, [&] {
+		bench::do_not_optimize(units::bulk::min(bitmap.data(), bitmap.data() + count));
+	}));
+	bench::print(bench::run("bulk::min, sentinel", count, [&] {
+		bench::do_not_optimize(units::bulk::min(first, last));
+	}));
+	bench::print(bench::run("bulk::min, bitmap", count, [&] {
+		bench::do_not_optimize(units::bulk::min(bitmap.data(), bitmap.data() + count, bitmap.validity()));
+	}));
+	bench::print(bench::run("std::optional count_between loop", count, [&] {
+		std::size_t kept = 0;
+		for (auto const& value : optional)
+		{
+			kept += value && *value >= 500_m && *value < 1_km ? 1 : 0;
+		}
+		bench::do_not_optimize(kept);
+	}));
+	bench::print(bench::run("bulk::count_between, sentinel", count, [&] {
+		bench::do_not_optimize(units::bulk::count_between(first, last, 500_m, 1_km));
+	}));
+	bench::print(bench::run("bulk::count_between, bitmap", count, [&] {
+		bench::do_not_optimize(
+		    units::bulk::count_between(bitmap.data(), bitmap.data() + count, bitmap.validity(), 500_m, 1_km));
+	}));
+}
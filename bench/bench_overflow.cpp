@@ -0,0 +1,122 @@
+#include "bench.h"
+
+#include <cstdint>
+#include <random>
+#include <ratio>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/overflow.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 22;
+
+	using plain_mm     = units::unit<std::int32_t, std::milli, units::unit_type::distance>;
+	using saturated_mm = units::unit<units::saturating<std::int32_t>, std::milli, units::unit_type::distance>;
+	using checked_mm   = units::unit<units::checked<std::int32_t>, std::milli, units::unit_type::distance>;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_int_distribution<std::int32_t>{-1000000000, 1000000000};
+
+	auto plain     = std::vector<plain_mm>{};
+	auto saturated = std::vector<saturated_mm>{};
+	auto checked   = std::vector<checked_mm>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const value = distribution(engine);
+		plain.emplace_back(value);
+		saturated.emplace_back(units::saturating<std::int32_t>{value});
+		checked.emplace_back(units::checked<std::int32_t>{value / 2});
+	}
+	auto plain_out     = plain;
+	auto saturated_out = saturated;
+	auto checked_out   = checked;
+
+	bench::print_header();
+	bench::print(bench::run("wrapping int32 add loop", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			plain_out[i] = plain[i] + plain[count - 1 - i];
+		}
+		bench::do_not_optimize(plain_out.data());
+	}));
+	bench::print(bench::run("saturating operator+ loop", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			saturated_out[i] = saturated[i] + saturated[count - 1 - i];
+		}
+		bench::do_not_optimize(saturated_out.data());
+	}));
+	bench::print(bench::run("bulk::add, saturating", count, [&] {
+		bench::do_not_optimize(
+		    units::bulk::add(saturated.data(), saturated.data() + count, saturated_out.data(), saturated_out.data()));
+	}));
+	bench::print(bench::run("bulk::add, checked", count, [&] {
+		bench::do_not_optimize(
+		    units::bulk::add(checked.data(), checked.data() + count, checked.data(), checked_out.data()));
+	}));
+	bench::print(bench::run("wrapping int32 scale loop", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			plain_out[i] = plain[i] * 3;
+		}
+		bench::do_not_optimize(plain_out.data());
+	}));
+	bench::print(bench::run("bulk::scale, saturating", count, [&] {
+		bench::do_not_optimize(units::bulk::scale(saturated.data(), saturated.data() + count, 3, saturated_out.data()));
+	}));
+	bench::print(bench::run("int64 sum loop", count, [&] {
+		std::int64_t total = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			total += plain[i].count();
+		}
+		bench::do_not_optimize(total);
+	}));
+	bench::print(bench::run("saturating operator+= loop", count, [&] {
+		auto total = saturated_mm{units::saturating<std::int32_t>{0}};
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			total += saturated[i];
+		}
+		bench::do_not_optimize(total);
+	}));
+	bench::print(bench::run("bulk::sum, saturating", count, [&] {
+		bench::do_not_optimize(units::bulk::sum(saturated.data(), saturated.data() + count));
+	}));
+
+	auto const tiers = {units::cpu::tier::scalar,
+	                    units::cpu::tier::sse42,
+	                    units::cpu::tier::avx2,
+	                    units::cpu::tier::avx512};
+	auto const in    = units::detail::overflow::values(saturated.data());
+	auto const out   = units::detail::overflow::values(saturated_out.data());
+	auto const half  = std::vector<std::int16_t>(count, 12345);
+	auto       halves = std::vector<std::int16_t>(count);
+	for (auto tier : tiers)
+	{
+		auto const& kernels = units::bulk::overflow_kernels_for(tier);
+		auto const  name    = std::string{units::cpu::name(kernels.tier)};
+
+		bench::print(bench::run("add int16, " + name, count, [&] {
+			bench::do_not_optimize(kernels.i16.add(half.data(), half.data(), count, halves.data()));
+		}));
+		bench::print(bench::run("add int32, " + name, count, [&] {
+			bench::do_not_optimize(kernels.i32.add(in, in, count, out));
+		}));
+		bench::print(bench::run("scale int32, " + name, count, [&] {
+			bench::do_not_optimize(kernels.i32.scale(in, count, 3, out));
+		}));
+		bench::print(bench::run("sum int32, " + name, count, [&] {
+			std::int32_t total = 0;
+			bench::do_not_optimize(kernels.i32.sum(in, count, &total));
+			bench::do_not_optimize(total);
+		}));
+	}
+}
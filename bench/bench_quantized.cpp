@@ -0,0 +1,143 @@
+#include "bench.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <ratio>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/cpu_dispatch.h"
+#include "units/quantized.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 22;
+
+	using centimetres16 = units::unit<std::int16_t, std::centi, units::unit_type::distance>;
+	using millimetres32 = units::unit<std::int32_t, std::milli, units::unit_type::distance>;
+
+	// Largest and root mean square difference after a round trip, in metres
+	template <typename Encoded>
+	void print_error(char const* name, std::vector<units::metres> const& in)
+	{
+		auto encoded = std::vector<Encoded>(in.size(), Encoded{0});
+		auto decoded = std::vector<units::metres>(in.size(), units::metres{0});
+		auto report  = units::bulk::encode(in.data(), in.data() + in.size(), encoded.data());
+		units::bulk::decode(encoded.data(), encoded.data() + encoded.size(), decoded.data());
+
+		auto worst   = 0.0;
+		auto squares = 0.0;
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			auto const error = std::abs(in[i].count() - decoded[i].count());
+			worst            = std::max(worst, error);
+			squares += error * error;
+		}
+		std::printf("%-32s max abs error %.3g m, rms %.3g m, %zu clamped\n",
+		            name,
+		            worst,
+		            std::sqrt(squares / static_cast<double>(in.size())),
+		            report.clamped());
+	}
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{-300, 300};
+
+	auto metres = std::vector<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		metres.emplace_back(distribution(engine));
+	}
+	auto encoded16 = std::vector<centimetres16>(count, centimetres16{0});
+	auto encoded32 = std::vector<millimetres32>(count, millimetres32{0});
+	auto out       = std::vector<units::kilometres>(count, units::kilometres{0});
+
+	units::bulk::encode(metres.data(), metres.data() + count, encoded16.data());
+	units::bulk::encode(metres.data(), metres.data() + count, encoded32.data());
+
+	bench::print_header();
+	bench::print(bench::run("bulk::cast, double metres to kilometres", count, [&] {
+		units::bulk::cast(metres.data(), metres.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("unit_cast loop, int16 cm to kilometres", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = units::unit_cast<units::kilometres>(encoded16[i]);
+		}
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("bulk::decode, int16 cm to kilometres", count, [&] {
+		units::bulk::decode(encoded16.data(), encoded16.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("bulk::decode, int32 mm to kilometres", count, [&] {
+		units::bulk::decode(encoded32.data(), encoded32.data() + count, out.data());
+		bench::do_not_optimize(out.data());
+	}));
+	bench::print(bench::run("unit_cast loop, metres to int16 cm", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			encoded16[i] = centimetres16{static_cast<std::int16_t>(std::lround(metres[i].count() * 100))};
+		}
+		bench::do_not_optimize(encoded16.data());
+	}));
+	bench::print(bench::run("bulk::encode, metres to int16 cm", count, [&] {
+		bench::do_not_optimize(units::bulk::encode(metres.data(), metres.data() + count, encoded16.data()));
+	}));
+	bench::print(bench::run("bulk::encode, metres to int32 mm", count, [&] {
+		bench::do_not_optimize(units::bulk::encode(metres.data(), metres.data() + count, encoded32.data()));
+	}));
+	bench::print(bench::run("bulk::pick_quantum, int16", count, [&] {
+		bench::do_not_optimize(
+		    units::bulk::pick_quantum<std::int16_t, std::milli, std::centi, std::deci>(metres.data(),
+		                                                                               metres.data() + count));
+	}));
+
+	auto const tiers = {units::cpu::tier::scalar,
+	                    units::cpu::tier::sse42,
+	                    units::cpu::tier::avx2,
+	                    units::cpu::tier::avx512};
+	auto const in    = units::detail::raw(metres.data());
+	auto const i16   = units::detail::raw(encoded16.data());
+	auto const i32   = units::detail::raw(encoded32.data());
+	auto const wide  = units::detail::raw(out.data());
+	for (auto tier : tiers)
+	{
+		auto const& kernels = units::bulk::quantized_kernels_for(tier);
+		auto const  name    = std::string{units::cpu::name(kernels.tier)};
+
+		bench::print(bench::run("encode int16, " + name, count, [&] {
+			bench::do_not_optimize(kernels.i16.encode(in, count, 100.0, i16));
+		}));
+		bench::print(bench::run("decode int16, " + name, count, [&] {
+			kernels.i16.decode(i16, count, 1e-5, wide);
+			bench::do_not_optimize(wide);
+		}));
+		bench::print(bench::run("encode int32, " + name, count, [&] {
+			bench::do_not_optimize(kernels.i32.encode(in, count, 1000.0, i32));
+		}));
+		bench::print(bench::run("decode int32, " + name, count, [&] {
+			kernels.i32.decode(i32, count, 1e-6, wide);
+			bench::do_not_optimize(wide);
+		}));
+	}
+
+	std::printf("\n");
+	print_error<centimetres16>("int16 centimetres, +-300 m", metres);
+	print_error<millimetres32>("int32 millimetres, +-300 m", metres);
+
+	auto far = metres;
+	for (auto& value : far)
+	{
+		value *= 2;
+	}
+	print_error<centimetres16>("int16 centimetres, +-600 m", far);
+}
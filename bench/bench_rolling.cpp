@@ -0,0 +1,82 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "units.h"
+#include "units/rolling.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	using clock = std::chrono::steady_clock;
+
+	constexpr std::size_t count = 1 << 22;
+	constexpr std::size_t naive = 1 << 16;
+}
+
+int main()
+{
+	auto engine = std::mt19937_64{42};
+	auto values = std::uniform_real_distribution<double>{0.0, 20000.0};
+	auto gaps   = std::uniform_int_distribution<int>{0, 2000};
+
+	// About a thousand samples in the window, in a finer ratio than the window keeps
+	auto times   = std::vector<clock::time_point>{};
+	auto samples = std::vector<units::centimetres>{};
+	auto now     = clock::time_point{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		now += std::chrono::microseconds{gaps(engine)};
+		times.push_back(now);
+		samples.emplace_back(values(engine));
+	}
+
+	bench::print_header();
+	bench::print(bench::run("deque and rescan, sum and max per sample", naive, [&] {
+		auto   window = std::deque<std::pair<clock::time_point, units::metres>>{};
+		double found  = 0;
+		for (std::size_t i = 0; i < naive; ++i)
+		{
+			window.emplace_back(times[i], units::unit_cast<units::metres>(samples[i]));
+			while (window.front().first <= times[i] - 1s)
+			{
+				window.pop_front();
+			}
+
+			auto sum = units::metres{0};
+			auto hi  = window.front().second;
+			for (auto const& sample : window)
+			{
+				sum += sample.second;
+				hi = std::max(hi, sample.second);
+			}
+			found += sum.count() + hi.count();
+		}
+		bench::do_not_optimize(found);
+	}));
+	bench::print(bench::run("rolling_window push only", count, [&] {
+		auto window = units::rolling_window<units::metres>{1s, 2048};
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			window.push(times[i], samples[i]);
+		}
+		bench::do_not_optimize(window.size());
+	}));
+	bench::print(bench::run("rolling_window push, sum, mean, min, max", count, [&] {
+		auto   window = units::rolling_window<units::metres>{1s, 2048};
+		double found  = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			window.push(times[i], samples[i]);
+			found += window.sum().count() + window.mean().count() + window.min().count() + window.max().count();
+		}
+		bench::do_not_optimize(found);
+	}));
+}
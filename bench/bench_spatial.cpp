@@ -0,0 +1,83 @@
+#include "bench.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/index.h"
+#include "units/spatial.h"
+#include "units/vec3.h"
+
+using namespace distance_literals;
+
+namespace
+{
+	using point = units::vec3<units::metres>;
+
+	constexpr std::size_t count   = 1 << 20;
+	constexpr std::size_t queries = 1 << 12;
+}
+
+int main()
+{
+	auto engine = std::mt19937_64{42};
+	auto across = std::uniform_real_distribution<double>{-200000.0, 200000.0};
+	auto height = std::uniform_real_distribution<double>{0.0, 12000.0};
+
+	auto points = std::vector<point>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const x = units::metres{across(engine)};
+		auto const y = units::metres{across(engine)};
+		points.emplace_back(x, y, units::metres{height(engine)});
+	}
+
+	auto centres = std::vector<point>(points.begin(), points.begin() + queries);
+
+	auto serial    = units::index_options{};
+	serial.threads = 1;
+
+	bench::print_header();
+	bench::print(bench::run("linear radius scan, nautical miles", count, [&] {
+		auto const  r     = units::unit_cast<units::metres>(2_NM).count();
+		std::size_t found = 0;
+		for (auto const& p : points)
+		{
+			auto const d = p - centres[0];
+			found += static_cast<std::size_t>(
+			    d.x().count() * d.x().count() + d.y().count() * d.y().count() + d.z().count() * d.z().count() <= r * r);
+		}
+		bench::do_not_optimize(found);
+	}));
+	bench::print(bench::run("kd_tree build, one thread", count, [&] {
+		bench::do_not_optimize(units::kd_tree<units::metres>{points.begin(), points.end(), serial}.size());
+	}));
+	bench::print(bench::run("kd_tree build, all threads", count, [&] {
+		bench::do_not_optimize(units::kd_tree<units::metres>{points.begin(), points.end()}.size());
+	}));
+
+	auto const tree = units::kd_tree<units::metres>{points.begin(), points.end()};
+	bench::print(bench::run("kd_tree::count_within per query", queries, [&] {
+		std::size_t found = 0;
+		for (auto const& c : centres)
+		{
+			found += tree.count_within(c, 2_NM);
+		}
+		bench::do_not_optimize(found);
+	}));
+	bench::print(bench::run("kd_tree::nearest per query", queries, [&] {
+		std::size_t found = 0;
+		for (auto const& c : centres)
+		{
+			found += tree.nearest(c).row;
+		}
+		bench::do_not_optimize(found);
+	}));
+
+	auto nearest = std::vector<units::neighbour<units::metres>>(queries, {0, 0_m});
+	bench::print(bench::run("kd_tree::nearest batch, all threads", queries, [&] {
+		tree.nearest(centres.data(), centres.data() + queries, nearest.data());
+		bench::do_not_optimize(nearest.front().row);
+	}));
+}
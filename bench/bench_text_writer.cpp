@@ -0,0 +1,60 @@
+#include "bench.h"
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "units.h"
+#include "units/text_writer.h"
+
+namespace
+{
+	constexpr std::size_t rows = 1 << 20;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0, 100000};
+	auto distance     = std::vector<units::feet>{};
+	auto mass         = std::vector<units::kilograms>{};
+	for (std::size_t i = 0; i < rows; ++i)
+	{
+		distance.emplace_back(distribution(engine));
+		mass.emplace_back(distribution(engine) / 100);
+	}
+
+	bench::print_header();
+	bench::print(bench::run("operator<<, 2 columns", rows, [&] {
+		std::ostringstream out;
+		out.precision(17);
+		for (std::size_t i = 0; i < rows; ++i)
+		{
+			out << distance[i] << ',' << mass[i] << '\n';
+		}
+		bench::do_not_optimize(out.str().data());
+	}, 3));
+
+	bench::print(bench::run("text::write_csv, 2 columns", rows, [&] {
+		std::ostringstream out;
+		{
+			units::text::writer w{out};
+			units::text::write_csv(w, units::text::column("distance", distance), units::text::column("mass", mass));
+		}
+		bench::do_not_optimize(out.str().data());
+	}, 3));
+
+	bench::print(bench::run("text::write_lines", rows, [&] {
+		std::ostringstream out;
+		{
+			units::text::writer w{out};
+			units::text::write_lines(w, distance.begin(), distance.end());
+		}
+		bench::do_not_optimize(out.str().data());
+	}, 3));
+
+	bench::print(bench::run("text::write_csv to /dev/null", rows, [&] {
+		units::text::writer w{std::string{"/dev/null"}};
+		units::text::write_csv(w, units::text::column("distance", distance), units::text::column("mass", mass));
+	}, 3));
+}
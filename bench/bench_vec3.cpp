@@ -0,0 +1,98 @@
+#include "bench.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/vec3.h"
+
+namespace
+{
+	constexpr std::size_t count = 1 << 18;
+
+	// The layout a caller would write without vec3
+	struct point
+	{
+		units::metres x;
+		units::metres y;
+		units::metres z;
+	};
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{-1000, 1000};
+	auto random       = [&] { return units::metres{distribution(engine)}; };
+
+	auto points  = std::vector<point>{};
+	auto vectors = std::vector<units::vec3<units::metres>>{};
+	auto array   = units::vec3_array<units::metres>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const p = point{random(), random(), random()};
+		points.push_back(p);
+		vectors.push_back({p.x, p.y, p.z});
+		array.push_back({p.x, p.y, p.z});
+	}
+	auto const offset_point  = point{units::metres{1}, units::metres{2}, units::metres{3}};
+	auto const offset_vector = units::vec3<units::metres>{offset_point.x, offset_point.y, offset_point.z};
+
+	auto lengths = std::vector<units::metres>(count, units::metres{0});
+
+	bench::print_header();
+	bench::print(bench::run("translate, struct of three metres", count, [&] {
+		for (auto& p : points)
+		{
+			p.x = p.x + offset_point.x;
+			p.y = p.y + offset_point.y;
+			p.z = p.z + offset_point.z;
+		}
+		bench::do_not_optimize(points.data());
+	}));
+	bench::print(bench::run("translate, vec3", count, [&] {
+		for (auto& v : vectors)
+		{
+			v += offset_vector;
+		}
+		bench::do_not_optimize(vectors.data());
+	}));
+	bench::print(bench::run("translate, vec3_array", count, [&] {
+		array += offset_vector;
+		bench::do_not_optimize(array.x());
+	}));
+
+	bench::print(bench::run("norm, struct of three metres", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto const& p = points[i];
+			lengths[i]    = units::metres{std::sqrt((p.x * p.x + p.y * p.y + p.z * p.z).count())};
+		}
+		bench::do_not_optimize(lengths.data());
+	}));
+	bench::print(bench::run("norm, vec3", count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			lengths[i] = units::norm(vectors[i]);
+		}
+		bench::do_not_optimize(lengths.data());
+	}));
+	bench::print(bench::run("norm, vec3_array", count, [&] {
+		units::norm(array, lengths.data());
+		bench::do_not_optimize(lengths.data());
+	}));
+
+	bench::print(bench::run("unit_cast to kilometres, vec3", count, [&] {
+		auto sum = units::vec3<units::kilometres>{};
+		for (auto const& v : vectors)
+		{
+			sum += units::unit_cast<units::kilometres>(v);
+		}
+		bench::do_not_optimize(sum);
+	}));
+	bench::print(bench::run("unit_cast to kilometres, vec3_array", count, [&] {
+		auto const converted = units::unit_cast<units::kilometres>(array);
+		bench::do_not_optimize(converted.x());
+	}));
+}
@@ -0,0 +1,64 @@
+#include "bench.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/views.h"
+
+using namespace distance_literals;
+
+namespace
+{
+	constexpr std::size_t count = 1 << 22;
+}
+
+int main()
+{
+	auto engine       = std::mt19937_64{42};
+	auto distribution = std::uniform_real_distribution<double>{0.0, 20000.0};
+
+	auto feet = std::vector<units::feet>{};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		feet.emplace_back(distribution(engine));
+	}
+	auto metres = std::vector<units::metres>(count, units::metres{0.0});
+
+	bench::print_header();
+	bench::print(bench::run("bulk::cast to copy, then bulk::sum", count, [&] {
+		units::bulk::cast(feet.data(), feet.data() + count, metres.data());
+		bench::do_not_optimize(units::bulk::sum(metres.data(), metres.data() + count));
+	}));
+	bench::print(bench::run("views::sum of cast", count, [&] {
+		bench::do_not_optimize(units::views::sum(feet | units::views::cast<units::metres>()));
+	}));
+	bench::print(bench::run("loop with if, unit_cast and +=", count, [&] {
+		auto total = units::metres{0.0};
+		for (auto f : feet)
+		{
+			if (f >= 1_km && f < 5_km)
+			{
+				total += units::unit_cast<units::metres>(f);
+			}
+		}
+		bench::do_not_optimize(total);
+	}));
+	bench::print(bench::run("views::sum of filter_between and cast", count, [&] {
+		bench::do_not_optimize(units::views::sum(feet | units::views::filter_between(1_km, 5_km)
+		                                         | units::views::cast<units::metres>()));
+	}));
+	bench::print(bench::run("views::size of filter_between", count, [&] {
+		bench::do_not_optimize(units::views::size(feet | units::views::filter_between(1_km, 5_km)));
+	}));
+	bench::print(bench::run("range for over filter_between and cast", count, [&] {
+		auto total = units::metres{0.0};
+		for (auto m : feet | units::views::filter_between(1_km, 5_km) | units::views::cast<units::metres>())
+		{
+			total += m;
+		}
+		bench::do_not_optimize(total);
+	}));
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+// A thin wrapper over Linux perf_event_open that counts cycles, instructions, branch misses and last level cache
+// misses for the calling thread and any threads it starts while counting. When the kernel refuses to open the
+// counters, as it usually does inside containers or when perf_event_paranoid is high, or on other platforms, every
+// counter reports as unavailable and the harness falls back to timing only. Set UNITS_BENCH_DISABLE_PERF to skip the
+// counters altogether.
+
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace bench
+{
+	enum class event
+	{
+		cycles,
+		instructions,
+		branch_misses,
+		cache_misses,
+		count
+	};
+
+	struct counter_values
+	{
+		bool          available[static_cast<int>(event::count)] = {};
+		std::uint64_t value[static_cast<int>(event::count)]     = {};
+
+		bool has(event e) const { return available[static_cast<int>(e)]; }
+		double get(event e) const { return static_cast<double>(value[static_cast<int>(e)]); }
+	};
+
+	class perf_counters
+	{
+	public:
+		perf_counters()
+		{
+			for (auto& fd : fds)
+			{
+				fd = -1;
+			}
+
+#if defined(__linux__)
+			if (std::getenv("UNITS_BENCH_DISABLE_PERF") != nullptr)
+			{
+				return;
+			}
+
+			std::uint64_t const configs[] = {PERF_COUNT_HW_CPU_CYCLES,
+			                                 PERF_COUNT_HW_INSTRUCTIONS,
+			                                 PERF_COUNT_HW_BRANCH_MISSES,
+			                                 PERF_COUNT_HW_CACHE_MISSES};
+
+			for (int i = 0; i < static_cast<int>(event::count); ++i)
+			{
+				perf_event_attr attr;
+				std::memset(&attr, 0, sizeof(attr));
+				attr.type           = PERF_TYPE_HARDWARE;
+				attr.size           = sizeof(attr);
+				attr.config         = configs[i];
+				attr.disabled       = 1;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv     = 1;
+				attr.inherit        = 1;
+				attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+				fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+			}
+#endif
+		}
+
+		~perf_counters()
+		{
+#if defined(__linux__)
+			for (auto fd : fds)
+			{
+				if (fd != -1)
+				{
+					close(fd);
+				}
+			}
+#endif
+		}
+
+		perf_counters(perf_counters const&) = delete;
+		perf_counters& operator=(perf_counters const&) = delete;
+
+		bool available() const
+		{
+			for (auto fd : fds)
+			{
+				if (fd != -1)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void start()
+		{
+#if defined(__linux__)
+			for (auto fd : fds)
+			{
+				if (fd != -1)
+				{
+					ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+					ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+				}
+			}
+#endif
+		}
+
+		counter_values stop()
+		{
+			auto result = counter_values{};
+#if defined(__linux__)
+			for (int i = 0; i < static_cast<int>(event::count); ++i)
+			{
+				if (fds[i] != -1)
+				{
+					ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+				}
+			}
+
+			for (int i = 0; i < static_cast<int>(event::count); ++i)
+			{
+				// value, time enabled, time running; scale up if the kernel had to multiplex the counter
+				std::uint64_t data[3] = {};
+				if (fds[i] != -1 && read(fds[i], data, sizeof(data)) == sizeof(data) && data[2] != 0)
+				{
+					result.available[i] = true;
+					result.value[i] = static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+				}
+			}
+#endif
+			return result;
+		}
+
+	private:
+		int fds[static_cast<int>(event::count)];
+	};
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/any_unit.h"
+
+using testing::Test;
+
+namespace TestAnyUnit
+{
+	class AnyUnitTest : public Test
+	{
+	};
+
+	TEST_F(AnyUnitTest, AnyUnit_WhenDeclared_WillBeSmallAndTriviallyCopyable)
+	{
+		EXPECT_TRUE(std::is_trivially_copyable<units::any_unit>::value);
+		EXPECT_LE(sizeof(units::any_unit), 2 * sizeof(double));
+	}
+
+	TEST_F(AnyUnitTest, AnyUnit_WhenDefaultConstructed_WillBeZeroInFirstAlias)
+	{
+		auto const zero = units::any_unit{};
+
+		EXPECT_EQ(0.0, zero.count());
+		EXPECT_EQ(0u, zero.unit_id());
+		EXPECT_EQ(units::catalogue::entries()[0].suffix, zero.suffix());
+		EXPECT_EQ(units::catalogue::entries()[0].unit_type, zero.unit_type());
+		EXPECT_EQ(0.0, zero.to_id(zero.unit_id()).count());
+	}
+
+	TEST_F(AnyUnitTest, As_WhenUnitTypesMatch_WillConvert)
+	{
+		units::any_unit const distance = units::feet{1000};
+
+		EXPECT_DOUBLE_EQ(304.8, distance.as<units::metres>().count());
+		EXPECT_DOUBLE_EQ(1000, distance.as<units::feet>().count());
+		EXPECT_EQ(units::catalogue::unit_id<units::feet>::value, distance.unit_id());
+	}
+
+	TEST_F(AnyUnitTest, As_WhenUnitTypesDiffer_WillThrow)
+	{
+		units::any_unit const mass = units::kilograms{2};
+
+		EXPECT_THROW(mass.as<units::metres>(), std::domain_error);
+		EXPECT_DOUBLE_EQ(2000, mass.as<units::grams>().count());
+	}
+
+	TEST_F(AnyUnitTest, As_WhenTargetHasIntegralRep_WillConvertToAliasWithSameRatio)
+	{
+		using integral_millimetres = units::distance<int, std::milli>;
+		units::any_unit const distance = units::centimetres{12};
+
+		EXPECT_EQ(120, distance.as<integral_millimetres>().count());
+	}
+
+	TEST_F(AnyUnitTest, FromSuffix_WhenSuffixIsKnown_WillUseThatAlias)
+	{
+		auto const area = units::any_unit::from_suffix(3, "sqm");
+
+		EXPECT_EQ("sqm", area.suffix());
+		EXPECT_DOUBLE_EQ(30000, area.as<units::square_centimetres>().count());
+		EXPECT_THROW(units::any_unit::from_suffix(1, "furlongs"), std::invalid_argument);
+	}
+
+	TEST_F(AnyUnitTest, ToId_WhenConvertingBetweenRuntimeUnits_WillKeepUnitType)
+	{
+		auto const distance = units::any_unit{units::miles{1}}.to_id(units::catalogue::unit_id<units::yards>::value);
+
+		EXPECT_DOUBLE_EQ(1760, distance.count());
+		EXPECT_EQ("yd", distance.suffix());
+		EXPECT_THROW(distance.to_id(units::catalogue::unit_id<units::grams>::value), std::domain_error);
+		EXPECT_THROW(units::any_unit::from_id(1, 1000), std::out_of_range);
+	}
+
+	TEST_F(AnyUnitTest, Convert_WhenRangeHasMixedAliases_WillConvertEachValue)
+	{
+		auto const values = std::vector<units::any_unit>{units::metres{1}, units::kilometres{2}, units::inches{10}};
+		auto       out    = std::vector<units::centimetres>(values.size(), units::centimetres{0});
+
+		units::convert(values.data(), values.data() + values.size(), out.data());
+
+		EXPECT_DOUBLE_EQ(100, out[0].count());
+		EXPECT_DOUBLE_EQ(200000, out[1].count());
+		EXPECT_DOUBLE_EQ(25.4, out[2].count());
+	}
+
+	TEST_F(AnyUnitTest, Convert_WhenRangeHoldsAnotherUnitType_WillThrow)
+	{
+		auto const values = std::vector<units::any_unit>{units::metres{1}, units::grams{2}};
+		auto       out    = std::vector<units::metres>(values.size(), units::metres{0});
+
+		EXPECT_THROW(units::convert(values.data(), values.data() + values.size(), out.data()), std::domain_error);
+	}
+
+	TEST_F(AnyUnitTest, Convert_WhenValuesShareAnAlias_WillScaleTheBatch)
+	{
+		auto const values = std::vector<double>(37, 2.0);
+		auto       out    = std::vector<units::metres>(values.size(), units::metres{0});
+
+		units::convert(values.data(), values.size(), units::catalogue::unit_id<units::feet>::value, out.data());
+
+		for (auto const& value : out)
+		{
+			EXPECT_DOUBLE_EQ(0.6096, value.count());
+		}
+		EXPECT_THROW(units::convert(values.data(), values.size(), units::catalogue::unit_id<units::grams>::value, out.data()),
+		             std::domain_error);
+	}
+}
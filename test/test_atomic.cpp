@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "units.h"
+#include "units/atomic.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+using namespace mass_literals;
+
+namespace TestAtomic
+{
+	using millimetres_int = units::distance<long long, std::milli>;
+
+	class AtomicTest : public Test
+	{
+	};
+
+	TEST_F(AtomicTest, Constructor_WhenDefaulted_WillBeZero)
+	{
+		units::atomic<units::metres> counter;
+		EXPECT_EQ(0_m, counter.load());
+	}
+
+	TEST_F(AtomicTest, FetchAdd_WhenGivenDifferentRatio_WillConvertAndReturnPreviousValue)
+	{
+		units::atomic<units::metres> counter{1_m};
+
+		auto previous = counter.fetch_add(1_km);
+
+		EXPECT_EQ(1_m, previous);
+		EXPECT_EQ(1001_m, counter.load());
+	}
+
+	TEST_F(AtomicTest, FetchSub_WhenIntegral_WillSubtractConvertedValue)
+	{
+		units::atomic<millimetres_int> counter{millimetres_int{5000}};
+
+		auto previous = counter.fetch_sub(units::distance<long long>{2});
+
+		EXPECT_EQ(5000, previous.count());
+		EXPECT_EQ(3000, counter.load().count());
+	}
+
+	TEST_F(AtomicTest, CompoundAssignment_WillReturnNewValue)
+	{
+		units::atomic<units::kilograms> counter{1_kg};
+
+		EXPECT_EQ(units::kilograms{1.5}, counter += 500_g);
+		EXPECT_EQ(units::kilograms{1.25}, counter -= 250_g);
+	}
+
+	TEST_F(AtomicTest, CompareExchange_WhenExpectedIsStale_WillUpdateExpected)
+	{
+		units::atomic<units::metres> counter{2_m};
+		auto                         expected = 1_m;
+
+		EXPECT_FALSE(counter.compare_exchange_strong(expected, 3_m));
+		EXPECT_EQ(2_m, expected);
+		EXPECT_TRUE(counter.compare_exchange_strong(expected, 3_m));
+		EXPECT_EQ(3_m, counter.load());
+	}
+
+	TEST_F(AtomicTest, Exchange_WillReturnPreviousValue)
+	{
+		units::atomic<units::metres> counter{2_m};
+
+		EXPECT_EQ(2_m, counter.exchange(5_m));
+		EXPECT_EQ(5_m, static_cast<units::metres>(counter));
+	}
+
+	template <typename Counter, typename Delta>
+	void add_from_threads(Counter& counter, Delta delta, int thread_count, int additions)
+	{
+		auto threads = std::vector<std::thread>{};
+		for (int t = 0; t < thread_count; ++t)
+		{
+			threads.emplace_back([&] {
+				for (int i = 0; i < additions; ++i)
+				{
+					counter.fetch_add(delta);
+				}
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	TEST_F(AtomicTest, FetchAdd_WhenContendedAndFloating_WillNotLoseUpdates)
+	{
+		units::atomic<units::metres> counter;
+		add_from_threads(counter, 1_km, 4, 10000);
+		EXPECT_EQ(units::metres{40000000}, counter.load());
+	}
+
+	TEST_F(AtomicTest, FetchAdd_WhenContendedAndIntegral_WillNotLoseUpdates)
+	{
+		units::atomic<millimetres_int> counter;
+		add_from_threads(counter, units::distance<long long>{1}, 4, 10000);
+		EXPECT_EQ(40000000, counter.load().count());
+	}
+}
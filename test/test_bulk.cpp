@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestBulk
+{
+	class BulkTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			for (int i = 0; i < 1001; ++i)
+			{
+				values.push_back(units::kilometres{i * 0.5 - 100});
+			}
+		}
+
+		std::vector<units::kilometres> values;
+	};
+
+	TEST_F(BulkTest, Cast_WhenRepsMatch_WillMatchUnitCast)
+	{
+		auto result = std::vector<units::feet>(values.size(), units::feet{0});
+
+		auto end = units::bulk::cast(values.data(), values.data() + values.size(), result.data());
+
+		EXPECT_EQ(result.data() + result.size(), end);
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			EXPECT_EQ(units::unit_cast<units::feet>(values[i]), result[i]);
+		}
+	}
+
+	TEST_F(BulkTest, Cast_WhenRepsDiffer_WillFallBackToUnitCast)
+	{
+		auto integers = std::vector<units::distance<int, std::milli>>{};
+		for (int i = 0; i < 10; ++i)
+		{
+			integers.push_back(units::distance<int, std::milli>{i * 250});
+		}
+		auto result = std::vector<units::metres>(integers.size(), 0_m);
+
+		units::bulk::cast(integers.data(), integers.data() + integers.size(), result.data());
+
+		EXPECT_EQ(units::metres{2.25}, result.back());
+	}
+
+	TEST_F(BulkTest, Reductions_WillMatchSequentialLoop)
+	{
+		auto expected = 0_km;
+		for (auto value : values)
+		{
+			expected += value;
+		}
+
+		auto const first = values.data();
+		auto const last  = values.data() + values.size();
+		EXPECT_EQ(expected, units::bulk::sum(first, last));
+		EXPECT_EQ(units::kilometres{-100}, units::bulk::min(first, last));
+		EXPECT_EQ(units::kilometres{400}, units::bulk::max(first, last));
+	}
+
+	TEST_F(BulkTest, MinMax_WhenRangeIsEmpty_WillThrow)
+	{
+		EXPECT_THROW(units::bulk::min(values.data(), values.data()), std::domain_error);
+		EXPECT_THROW(units::bulk::max(values.data(), values.data()), std::domain_error);
+	}
+
+	TEST_F(BulkTest, MinMax_WhenRangeHasNaN_WillSkipIt)
+	{
+		auto const nan   = std::numeric_limits<double>::quiet_NaN();
+		auto       mixed = std::vector<units::metres>(37, units::metres{nan});
+		mixed[5]         = units::metres{-2.0};
+		mixed[30]        = units::metres{7.0};
+
+		EXPECT_EQ(units::metres{-2.0}, units::bulk::min(mixed.data(), mixed.data() + mixed.size()));
+		EXPECT_EQ(units::metres{7.0}, units::bulk::max(mixed.data(), mixed.data() + mixed.size()));
+
+		auto const only_nan = std::vector<units::metres>(19, units::metres{nan});
+		auto const first    = only_nan.data();
+		auto const last     = only_nan.data() + only_nan.size();
+		EXPECT_TRUE(std::isnan(units::bulk::min(first, last).count()));
+		EXPECT_TRUE(std::isnan(units::bulk::max(first, last).count()));
+	}
+
+	TEST_F(BulkTest, CountBetween_WhenBoundsHaveDifferentRatio_WillNormaliseBounds)
+	{
+		auto const first = values.data();
+		auto const last  = values.data() + values.size();
+
+		EXPECT_EQ(20u, units::bulk::count_between(first, last, 0_m, 10000_m));
+		EXPECT_EQ(200u, units::bulk::count_less(first, last, 0_mi));
+	}
+
+	TEST_F(BulkTest, CountBetween_WhenRepIsIntegral_WillUseFallback)
+	{
+		auto integers = std::vector<units::distance<int>>{};
+		for (int i = 0; i < 100; ++i)
+		{
+			integers.push_back(units::distance<int>{i});
+		}
+
+		EXPECT_EQ(15u, units::bulk::count_between(integers.data(), integers.data() + integers.size(), 150_cm, 165_dm));
+	}
+
+	TEST_F(BulkTest, Parse_WhenGivenSeparatedNumbers_WillParseEveryValue)
+	{
+		auto const text   = std::string{"1.5, -2e3\n0.000125\t42 12345678901234567890 nan"};
+		auto       result = std::vector<units::metres>(8, 0_m);
+
+		auto count = units::bulk::parse(text.data(), text.data() + text.size(), result.data(), result.size());
+
+		ASSERT_EQ(6u, count);
+		EXPECT_EQ(1.5, result[0].count());
+		EXPECT_EQ(-2000, result[1].count());
+		EXPECT_EQ(0.000125, result[2].count());
+		EXPECT_EQ(42, result[3].count());
+		EXPECT_EQ(12345678901234567890.0, result[4].count());
+		EXPECT_TRUE(std::isnan(result[5].count()));
+	}
+
+	TEST_F(BulkTest, ParseNumber_WhenDigitsExceedFastPath_WillRoundTrip)
+	{
+		for (double expected : {0.1, 1.0 / 3.0, 6.02214076e23, 1e-300, 123456789.12345678})
+		{
+			char text[32];
+			auto length = std::snprintf(text, sizeof text, "%.17g", expected);
+			auto actual = 0.0;
+			ASSERT_TRUE(units::detail::parse_number(text, text + length, actual)) << text;
+			EXPECT_EQ(expected, actual) << text;
+		}
+
+		auto const huge = std::string{"1e400"};
+		auto const tiny = std::string{"-1e-400"};
+		auto       out  = 0.0;
+		ASSERT_TRUE(units::detail::parse_number(huge.data(), huge.data() + huge.size(), out));
+		EXPECT_EQ(std::numeric_limits<double>::infinity(), out);
+		ASSERT_TRUE(units::detail::parse_number(tiny.data(), tiny.data() + tiny.size(), out));
+		EXPECT_EQ(0.0, out);
+	}
+
+	TEST_F(BulkTest, ParseNumber_WhenPadded_WillIgnorePaddingOnEitherSide)
+	{
+		for (std::string text : {" 0.1", "0.1 ", "\t0.1 \t", " 0.10000000000000000555 "})
+		{
+			auto out = 0.0;
+			ASSERT_TRUE(units::detail::parse_number(text.data(), text.data() + text.size(), out)) << text;
+			EXPECT_EQ(0.1, out) << text;
+		}
+
+		for (std::string text : {"", " ", "0. 1", "+-1", "+-1.0000000000000000001"})
+		{
+			auto out = 0.0;
+			EXPECT_FALSE(units::detail::parse_number(text.data(), text.data() + text.size(), out)) << text;
+		}
+	}
+
+	TEST_F(BulkTest, Parse_WhenNumberIsMalformed_WillThrow)
+	{
+		auto const text   = std::string{"1.5 1.2.3"};
+		auto       result = std::vector<units::metres>(2, 0_m);
+
+		EXPECT_THROW(units::bulk::parse(text.data(), text.data() + text.size(), result.data(), result.size()),
+		             std::invalid_argument);
+	}
+
+	TEST_F(BulkTest, Kernels_ForEverySupportedTier_WillGiveIdenticalResults)
+	{
+		auto const raw      = reinterpret_cast<double const*>(values.data());
+		auto const n        = values.size();
+		auto const& scalar  = units::bulk::kernels(units::cpu::tier::scalar).f64;
+
+		for (auto tier : {units::cpu::tier::sse42, units::cpu::tier::avx2, units::cpu::tier::avx512})
+		{
+			if (!units::cpu::supported(tier))
+			{
+				continue;
+			}
+
+			auto const& kernels = units::bulk::kernels(tier);
+			EXPECT_EQ(tier, kernels.tier);
+			EXPECT_EQ(scalar.sum(raw, n), kernels.f64.sum(raw, n)) << units::cpu::name(tier);
+			EXPECT_EQ(scalar.min(raw, n), kernels.f64.min(raw, n)) << units::cpu::name(tier);
+			EXPECT_EQ(scalar.count_between(raw, n, 1.0, 7.0), kernels.f64.count_between(raw, n, 1.0, 7.0));
+		}
+	}
+
+	TEST(CpuDispatchTest, Select_WhenTierIsForced_WillNotExceedSupportedTier)
+	{
+		auto features = units::cpu::features{};
+		features.sse42 = true;
+
+		EXPECT_EQ(units::cpu::tier::sse42, units::cpu::detail::select(features, nullptr));
+		EXPECT_EQ(units::cpu::tier::scalar, units::cpu::detail::select(features, "scalar"));
+		EXPECT_EQ(units::cpu::tier::sse42, units::cpu::detail::select(features, "avx512"));
+		EXPECT_EQ(units::cpu::tier::sse42, units::cpu::detail::select(features, "bogus"));
+	}
+}
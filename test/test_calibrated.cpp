@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/calibrated.h"
+
+using testing::Test;
+
+namespace TestCalibrated
+{
+	class CalibratedTest : public Test
+	{
+	};
+
+	TEST_F(CalibratedTest, Element_WhenRead_WillApplyColumnScale)
+	{
+		auto column = units::calibrated_column<units::millimetres, std::int16_t>{0.25};
+		column.push_back(100);
+		column.push_back(-8);
+
+		EXPECT_EQ(100, column[0].raw());
+		EXPECT_DOUBLE_EQ(25, column[0].value().count());
+		EXPECT_DOUBLE_EQ(-2, units::millimetres{column[1]}.count());
+	}
+
+	TEST_F(CalibratedTest, UnitCast_WhenGivenCalibratedValue_WillConvertToStaticUnit)
+	{
+		auto const column = units::calibrated_column<units::millimetres>{2.0, {500}};
+
+		EXPECT_DOUBLE_EQ(1, units::unit_cast<units::metres>(column[0]).count());
+	}
+
+	TEST_F(CalibratedTest, CommonType_WhenMixedWithStaticUnit_WillUseCommonTypeOfColumnUnit)
+	{
+		using calibrated = units::calibrated<units::kilometres, float>;
+
+		EXPECT_TRUE((std::is_same<std::common_type<calibrated, units::metres>::type,
+		                          std::common_type<units::kilometres, units::metres>::type>::value));
+		EXPECT_TRUE((std::is_same<std::common_type<units::metres, calibrated>::type,
+		                          std::common_type<units::metres, units::kilometres>::type>::value));
+	}
+
+	TEST_F(CalibratedTest, Cast_WhenRawMatchesTargetRep_WillScaleWholeColumn)
+	{
+		auto readings = std::vector<double>{};
+		for (int i = 0; i < 103; ++i)
+		{
+			readings.push_back(i);
+		}
+		auto const column = units::calibrated_column<units::centimetres>{0.5, readings};
+
+		auto const metres = column.to_vector<units::metres>();
+
+		ASSERT_EQ(readings.size(), metres.size());
+		for (std::size_t i = 0; i < metres.size(); ++i)
+		{
+			EXPECT_DOUBLE_EQ(readings[i] * 0.005, metres[i].count());
+		}
+	}
+
+	TEST_F(CalibratedTest, Cast_WhenRawIsIntegral_WillConvertEachReading)
+	{
+		auto const column = units::calibrated_column<units::grams, std::uint16_t>{0.1, {10, 20, 65535}};
+
+		auto const kilograms = column.to_vector<units::kilograms>();
+
+		EXPECT_DOUBLE_EQ(0.001, kilograms[0].count());
+		EXPECT_DOUBLE_EQ(0.002, kilograms[1].count());
+		EXPECT_DOUBLE_EQ(6.5535, kilograms[2].count());
+	}
+
+	TEST_F(CalibratedTest, Recalibrate_WhenScaleChanges_WillRescaleSumWithoutTouchingReadings)
+	{
+		auto column = units::calibrated_column<units::metres, float>{1.0, {1, 2, 3}};
+		EXPECT_DOUBLE_EQ(6, column.sum().count());
+
+		column.recalibrate(2.0);
+
+		EXPECT_DOUBLE_EQ(12, column.sum().count());
+		EXPECT_EQ(2, column.raw()[1]);
+	}
+
+	TEST_F(CalibratedTest, Constructor_WhenScaleIsZeroOrNotFinite_WillThrow)
+	{
+		EXPECT_THROW(units::calibrated_column<units::metres>{0.0}, std::invalid_argument);
+		EXPECT_THROW(units::calibrated_column<units::metres>{std::numeric_limits<double>::infinity()},
+		             std::invalid_argument);
+	}
+}
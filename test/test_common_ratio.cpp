@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#define UNITS_DEFAULT_COMMON_RATIO ::units::common_ratio::base
+
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+#include "units.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+using namespace mass_literals;
+
+namespace TestCommonRatio
+{
+	namespace unit_type
+	{
+		// clang-format off
+		struct millis {};
+		// clang-format on
+	}
+}
+
+namespace units
+{
+	template <>
+	struct common_ratio_policy<unit_type::mass>
+	{
+		using type = common_ratio::gcd;
+	};
+
+	template <>
+	struct common_ratio_policy<TestCommonRatio::unit_type::millis>
+	{
+		using type = common_ratio::fixed<std::milli>;
+	};
+}
+
+namespace TestCommonRatio
+{
+	template <typename Ratio>
+	using millis = units::unit<double, Ratio, unit_type::millis>;
+
+	class CommonRatioTest : public Test
+	{
+	};
+
+	TEST_F(CommonRatioTest, CommonType_WhenDefaultIsBase_WillUseBaseRatio)
+	{
+		using common = std::common_type_t<units::feet, units::kilometres>;
+		EXPECT_TRUE((std::is_same<common::ratio, std::ratio<1>>::value));
+	}
+
+	TEST_F(CommonRatioTest, CommonType_WhenRatiosAreEqual_WillKeepRatio)
+	{
+		using common = std::common_type_t<units::feet, units::feet>;
+		EXPECT_TRUE((std::is_same<common::ratio, units::feet::ratio>::value));
+		EXPECT_TRUE((std::is_same<decltype(+1_km)::ratio, std::kilo>::value));
+	}
+
+	TEST_F(CommonRatioTest, CommonType_WhenUnitTypeIsSpecialised_WillUseItsPolicy)
+	{
+		using common = std::common_type_t<units::pounds, units::kilograms>;
+		EXPECT_TRUE((std::is_same<common::ratio, std::ratio<1, 100000>>::value));
+	}
+
+	TEST_F(CommonRatioTest, CommonType_WhenOperandsAreSwapped_WillBeTheSame)
+	{
+		EXPECT_TRUE((std::is_same<std::common_type_t<units::feet, units::kilometres>,
+		                          std::common_type_t<units::kilometres, units::feet>>::value));
+		EXPECT_TRUE((std::is_same<std::common_type_t<units::pounds, units::kilograms>,
+		                          std::common_type_t<units::kilograms, units::pounds>>::value));
+		EXPECT_TRUE((std::is_same<std::common_type_t<millis<std::kilo>, millis<std::centi>>,
+		                          std::common_type_t<millis<std::centi>, millis<std::kilo>>>::value));
+	}
+
+	TEST_F(CommonRatioTest, CommonType_WhenIntegerOperandsWouldBeTruncated_WillUseGcd)
+	{
+		using millimetres_i = units::distance<long, std::milli>;
+		using metres_i      = units::distance<long>;
+		using kilometres_i  = units::distance<long, std::kilo>;
+
+		EXPECT_TRUE((std::is_same<std::common_type_t<millimetres_i, metres_i>, millimetres_i>::value));
+		EXPECT_TRUE((std::is_same<std::common_type_t<kilometres_i, metres_i>, metres_i>::value));
+
+		EXPECT_FALSE(millimetres_i{1500} == metres_i{1});
+		EXPECT_TRUE(millimetres_i{1500} > metres_i{1});
+		EXPECT_EQ(2500, (millimetres_i{1500} + metres_i{1}).count());
+		EXPECT_EQ(1001, (kilometres_i{1} + metres_i{1}).count());
+	}
+
+	TEST_F(CommonRatioTest, CommonType_WhenPolicyIsFixed_WillUseThatRatio)
+	{
+		using common = std::common_type_t<millis<std::kilo>, millis<std::centi>>;
+		EXPECT_TRUE((std::is_same<common::ratio, std::milli>::value));
+	}
+
+	TEST_F(CommonRatioTest, Addition_WhenMixed_WillReturnBaseRatio)
+	{
+		auto const sum = units::feet{1000.0} + 1_km;
+
+		EXPECT_TRUE((std::is_same<decltype(sum), units::metres const>::value));
+		EXPECT_DOUBLE_EQ(1304.8, sum.count());
+	}
+
+	TEST_F(CommonRatioTest, Subtraction_WhenMixed_WillReturnBaseRatio)
+	{
+		auto const difference = 1_km - units::feet{1000.0};
+
+		EXPECT_TRUE((std::is_same<decltype(difference), units::metres const>::value));
+		EXPECT_DOUBLE_EQ(695.2, difference.count());
+	}
+
+	TEST_F(CommonRatioTest, Modulo_WhenMixed_WillReturnBaseRatio)
+	{
+		using metres_i     = units::distance<std::int64_t>;
+		using kilometres_i = units::distance<std::int64_t, std::kilo>;
+
+		auto const remainder = metres_i{2531} % kilometres_i{1};
+
+		EXPECT_TRUE((std::is_same<decltype(remainder), metres_i const>::value));
+		EXPECT_EQ(531, remainder.count());
+	}
+
+	TEST_F(CommonRatioTest, Comparison_WhenMixed_WillCompareInBaseRatio)
+	{
+		EXPECT_TRUE(units::feet{1000.0} == units::kilometres{0.3048});
+		EXPECT_TRUE(units::feet{1000.0} < 1_km);
+		EXPECT_TRUE(1_mi > 1_km);
+		EXPECT_FALSE(1_mi <= 1_km);
+	}
+
+	TEST_F(CommonRatioTest, UnitCast_WhenFloatingPoint_WillMatchExactRatio)
+	{
+		EXPECT_DOUBLE_EQ(304.8, units::unit_cast<units::metres>(units::feet{1000.0}).count());
+		EXPECT_DOUBLE_EQ(1000.0, units::unit_cast<units::feet>(units::metres{304.8}).count());
+		EXPECT_DOUBLE_EQ(1609.344, units::unit_cast<units::metres>(1_mi).count());
+	}
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#define UNITS_ENABLE_CONVERSION_STATS
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+
+#include "units.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestConversionStats
+{
+	std::uint64_t count_of(std::string const& operation, std::intmax_t from_num, std::intmax_t to_num)
+	{
+		auto const entries = units::conversion_stats::snapshot();
+		auto const found = std::find_if(entries.begin(), entries.end(), [&](units::conversion_stats::entry const& e) {
+			return e.operation == operation && e.from_num == from_num && e.from_den == 1 && e.to_num == to_num
+			       && e.to_den == 1;
+		});
+		return found == entries.end() ? 0 : found->count;
+	}
+
+	class ConversionStatsTest : public Test
+	{
+	};
+
+	TEST_F(ConversionStatsTest, UnitCast_WhenRatiosDiffer_WillBeCounted)
+	{
+		auto const before = count_of("unit_cast", 1000, 1);
+
+		for (int i = 0; i < 3; ++i)
+		{
+			units::unit_cast<units::metres>(1_km);
+		}
+
+		EXPECT_EQ(before + 3, count_of("unit_cast", 1000, 1));
+	}
+
+	TEST_F(ConversionStatsTest, UnitCast_WhenRatiosAreEqual_WillNotBeCounted)
+	{
+		units::unit_cast<units::metres>(1_m);
+		EXPECT_EQ(0u, count_of("unit_cast", 1, 1));
+	}
+
+	TEST_F(ConversionStatsTest, Operators_WhenMixed_WillBeCountedPerOperation)
+	{
+		auto const before_add     = count_of("operator+", 1, 1000);
+		auto const before_compare = count_of("comparison", 1, 1000);
+
+		auto sum = 1_m + 1_km;
+		EXPECT_TRUE(1_m < 1_km);
+
+		EXPECT_EQ(units::metres{1001}, sum);
+		EXPECT_EQ(before_add + 1, count_of("operator+", 1, 1000));
+		EXPECT_EQ(before_compare + 1, count_of("comparison", 1, 1000));
+	}
+
+	TEST_F(ConversionStatsTest, Operators_WhenMixed_WillNotCountTheirCasts)
+	{
+		auto const total = [] {
+			std::uint64_t sum = 0;
+			for (auto const& e : units::conversion_stats::snapshot())
+			{
+				sum += e.count;
+			}
+			return sum;
+		};
+
+		auto const before_add = count_of("operator+", 1, 1000);
+		auto const before     = total();
+		auto const sum        = 1_m + 1_km;
+		EXPECT_EQ(before + 1, total());
+		EXPECT_EQ(before_add + 1, count_of("operator+", 1, 1000));
+
+		EXPECT_FALSE(1_m == 1_km);
+		EXPECT_EQ(before + 2, total());
+		EXPECT_EQ(units::metres{1001}, sum);
+	}
+
+	TEST_F(ConversionStatsTest, Snapshot_WhenThreadHasExited_WillKeepItsCounts)
+	{
+		auto const before = count_of("unit_cast", 1, 1000);
+
+		std::thread{[] { units::unit_cast<units::kilometres>(1_m); }}.join();
+
+		EXPECT_EQ(before + 1, count_of("unit_cast", 1, 1000));
+	}
+
+	TEST_F(ConversionStatsTest, ConstantExpressions_WhenEnabled_WillStillCompile)
+	{
+		constexpr auto result = units::unit_cast<units::metres>(1_km);
+		EXPECT_EQ(1000, result.count());
+	}
+
+	TEST_F(ConversionStatsTest, Report_WillListConversions)
+	{
+		units::unit_cast<units::millimetres>(1_m);
+
+		std::stringstream ss;
+		units::conversion_stats::report(ss);
+
+		EXPECT_NE(std::string::npos, ss.str().find("unit_cast\t1/1 -> 1/1000"));
+	}
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "units.h"
+#include "units/csv.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+using namespace mass_literals;
+
+namespace TestCsv
+{
+	class CsvHeaderTest : public Test
+	{
+	};
+
+	TEST_F(CsvHeaderTest, SplitHeader_WhenUnitIsSuffixedOrBracketed_WillSeparateNameAndUnit)
+	{
+		auto const fields = units::csv::detail::parse_header("distance_ft, mass[kg],area (sqm),trip_id", ',');
+
+		ASSERT_EQ(4u, fields.size());
+		EXPECT_EQ("distance", fields[0].name);
+		EXPECT_EQ("ft", fields[0].unit);
+		EXPECT_EQ("mass", fields[1].name);
+		EXPECT_EQ("kg", fields[1].unit);
+		EXPECT_EQ("area", fields[2].name);
+		EXPECT_EQ("sqm", fields[2].unit);
+		EXPECT_EQ("trip_id", fields[3].name);
+		EXPECT_EQ("", fields[3].unit);
+	}
+
+	class CsvReadTest : public Test
+	{
+	protected:
+		units::csv::options small_blocks() const
+		{
+			auto opts       = units::csv::options{};
+			opts.threads    = 3;
+			opts.block_size = 16;
+			return opts;
+		}
+	};
+
+	TEST_F(CsvReadTest, Read_WhenColumnsHaveUnits_WillConvertToRequestedUnits)
+	{
+		std::stringstream in{"id,distance_ft,mass[kg]\n1,1000,1.5\n2,,2\r\n\n3,-3.28084,0.25\n"};
+
+		auto columns = units::csv::read(in,
+		                                units::csv::column<units::metres>("distance"),
+		                                units::csv::column<units::grams>("mass[kg]"));
+
+		auto const& distance = std::get<0>(columns);
+		auto const& mass     = std::get<1>(columns);
+		ASSERT_EQ(3u, distance.size());
+		ASSERT_EQ(3u, mass.size());
+		EXPECT_EQ(units::metres{304.8}, distance[0]);
+		EXPECT_TRUE(std::isnan(distance[1].count()));
+		EXPECT_NEAR(-1.0, distance[2].count(), 1e-6);
+		EXPECT_EQ(1500_g, mass[0]);
+		EXPECT_EQ(2000_g, mass[1]);
+		EXPECT_EQ(250_g, mass[2]);
+	}
+
+	TEST_F(CsvReadTest, Read_WhenBlocksAndThreadsSplitRows_WillKeepRowOrder)
+	{
+		auto text = std::string{"n,distance_km\n"};
+		for (int i = 0; i < 500; ++i)
+		{
+			text += std::to_string(i) + "," + std::to_string(i) + "\n";
+		}
+		text += "500,500";
+		std::stringstream in{text};
+
+		auto columns = units::csv::read(in,
+		                                small_blocks(),
+		                                units::csv::column<units::metres>("distance_km"),
+		                                units::csv::column<units::distance<int>>("n"));
+
+		auto const& distance = std::get<0>(columns);
+		auto const& n        = std::get<1>(columns);
+		ASSERT_EQ(501u, distance.size());
+		for (int i = 0; i <= 500; ++i)
+		{
+			EXPECT_EQ(units::metres{i * 1000.0}, distance[i]);
+			EXPECT_EQ(i, n[i].count());
+		}
+	}
+
+	TEST_F(CsvReadTest, Read_WhenColumnIsMissing_WillThrow)
+	{
+		std::stringstream in{"distance_ft\n1\n"};
+		EXPECT_THROW(units::csv::read(in, units::csv::column<units::metres>("length")), std::invalid_argument);
+	}
+
+	TEST_F(CsvReadTest, Read_WhenUnitTypeIsIncompatible_WillThrow)
+	{
+		std::stringstream in{"mass[kg]\n1\n"};
+		EXPECT_THROW(units::csv::read(in, units::csv::column<units::metres>("mass")), std::invalid_argument);
+	}
+
+	TEST_F(CsvReadTest, Read_WhenNumberIsMalformed_WillThrow)
+	{
+		std::stringstream in{"distance_m\n1\nabc\n"};
+		EXPECT_THROW(units::csv::read(in, units::csv::column<units::metres>("distance")), std::invalid_argument);
+	}
+
+	TEST_F(CsvReadTest, Read_WhenColumnIsIntegral_WillRoundToNearest)
+	{
+		using centimetres = units::distance<int, std::centi>;
+
+		std::stringstream in{"d[m]\n0.29\n-0.29\n1.006\n21474836.47\n"};
+		auto const        d = std::get<0>(units::csv::read(in, units::csv::column<centimetres>("d")));
+
+		ASSERT_EQ(4u, d.size());
+		EXPECT_EQ(29, d[0].count());
+		EXPECT_EQ(-29, d[1].count());
+		EXPECT_EQ(101, d[2].count());
+		EXPECT_EQ(2147483647, d[3].count());
+	}
+
+	TEST_F(CsvReadTest, Read_WhenValueDoesNotFitColumn_WillThrow)
+	{
+		using centimetres = units::distance<int, std::centi>;
+
+		std::stringstream big{"d[m]\n1\n21474836.48\n"};
+		EXPECT_THROW(units::csv::read(big, units::csv::column<centimetres>("d")), std::invalid_argument);
+
+		std::stringstream nan{"d[m]\nnan\n"};
+		EXPECT_THROW(units::csv::read(nan, units::csv::column<centimetres>("d")), std::invalid_argument);
+
+		std::stringstream wide{"d[km]\n1e36\n"};
+		EXPECT_THROW(units::csv::read(wide, units::csv::column<units::distance<float>>("d")), std::invalid_argument);
+	}
+
+	TEST_F(CsvReadTest, Read_WhenFieldsArePadded_WillTrimBothSides)
+	{
+		std::stringstream in{"a_m,b_m\n 0.1,0.1 \n0.30000000000000004 , 1e400\n"};
+
+		auto columns =
+		    units::csv::read(in, units::csv::column<units::metres>("a"), units::csv::column<units::metres>("b"));
+
+		auto const& a = std::get<0>(columns);
+		auto const& b = std::get<1>(columns);
+		ASSERT_EQ(2u, a.size());
+		EXPECT_EQ(0.1, a[0].count());
+		EXPECT_EQ(0.1, b[0].count());
+		EXPECT_EQ(0.1 + 0.2, a[1].count());
+		EXPECT_TRUE(std::isinf(b[1].count()));
+	}
+
+	TEST_F(CsvReadTest, Read_WhenRowIsShort_WillThrow)
+	{
+		std::stringstream in{"a_m,b_m\n1,2\n3\n"};
+		EXPECT_THROW(units::csv::read(in, units::csv::column<units::metres>("b")), std::invalid_argument);
+	}
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/double_double.h"
+
+using testing::Test;
+
+namespace TestDoubleDouble
+{
+	class DoubleDoubleTest : public Test
+	{
+	};
+
+	TEST_F(DoubleDoubleTest, Construction_WhenGivenLongDouble_WillKeepEveryBit)
+	{
+		auto const value = 1.0L + std::ldexp(1.0L, -60);
+
+		auto const dd = units::double_double{value};
+
+		EXPECT_EQ(1.0, dd.hi);
+		EXPECT_EQ(std::ldexp(1.0, -60), dd.lo);
+		EXPECT_EQ(value, static_cast<long double>(dd));
+	}
+
+	TEST_F(DoubleDoubleTest, Construction_WhenGivenLargeIntegers_WillBeExact)
+	{
+		auto const light_year = std::intmax_t{9460730472580800};
+		auto const largest    = std::numeric_limits<std::intmax_t>::max();
+
+		EXPECT_EQ(light_year, static_cast<std::intmax_t>(units::double_double{light_year}));
+		EXPECT_EQ(largest, static_cast<std::intmax_t>(units::double_double{largest}));
+		EXPECT_EQ(-largest, static_cast<std::intmax_t>(units::double_double{-largest}));
+		EXPECT_EQ(-1.0, units::double_double{largest}.lo);
+	}
+
+	TEST_F(DoubleDoubleTest, Conversion_WhenTruncatingToInteger_WillRoundTowardsZero)
+	{
+		auto const below = units::double_double{std::int64_t{1} << 60} - 0.5;
+		auto const above = units::double_double{-(std::int64_t{1} << 60)} + 0.5;
+
+		EXPECT_EQ((std::int64_t{1} << 60) - 1, static_cast<std::int64_t>(below));
+		EXPECT_EQ(-(std::int64_t{1} << 60) + 1, static_cast<std::int64_t>(above));
+		EXPECT_EQ(2, static_cast<int>(units::double_double{2.75}));
+	}
+
+	TEST_F(DoubleDoubleTest, Arithmetic_WhenBelowDoublePrecision_WillKeepLowPart)
+	{
+		auto const tiny = std::ldexp(1.0, -80);
+
+		EXPECT_EQ(tiny, static_cast<double>((units::double_double{1.0} + tiny) - 1.0));
+		EXPECT_EQ(tiny * 3, static_cast<double>((units::double_double{1.0} + tiny) * 3 - 3));
+	}
+
+	TEST_F(DoubleDoubleTest, Division_WhenMultipliedBack_WillBeWithinDoubleDoublePrecision)
+	{
+		auto const third = units::double_double{1.0} / 3;
+		auto const error = third * 3 - 1;
+
+		EXPECT_LT(std::abs(static_cast<double>(error)), 1e-30);
+		EXPECT_LT(std::abs(static_cast<double>(units::sqrt(units::double_double{2.0}) * units::sqrt(2.0) - 2)), 1e-30);
+	}
+
+	TEST_F(DoubleDoubleTest, Comparison_WhenHighPartsEqual_WillOrderByLowPart)
+	{
+		auto const one  = units::double_double{1.0};
+		auto const more = one + std::ldexp(1.0, -70);
+
+		EXPECT_LT(one, more);
+		EXPECT_GT(more, 1.0);
+		EXPECT_NE(one, more);
+		EXPECT_EQ(one, 1);
+	}
+
+	TEST_F(DoubleDoubleTest, CommonType_WhenMixedWithArithmetic_WillBeDoubleDouble)
+	{
+		EXPECT_TRUE((std::is_same<units::double_double, std::common_type_t<units::double_double, double>>::value));
+		EXPECT_TRUE(
+		    (std::is_same<units::double_double, std::common_type_t<std::intmax_t, units::double_double>>::value));
+		EXPECT_TRUE((std::is_same<units::dd::light_years::rep,
+		                          std::common_type_t<units::dd::light_years, units::metres>::rep>::value));
+	}
+
+	TEST_F(DoubleDoubleTest, UnitCast_WhenConvertingToMetres_WillMatchLongDouble)
+	{
+		auto const distance = 4.2465;
+
+		auto const from_dd          = units::unit_cast<units::metres>(units::dd::light_years{distance});
+		auto const from_long_double = units::unit_cast<units::metres>(units::light_years{distance});
+
+		EXPECT_EQ(9460730472580800.0, units::unit_cast<units::metres>(units::dd::light_years{1}).count());
+		EXPECT_EQ(from_long_double.count(), from_dd.count());
+	}
+
+	TEST_F(DoubleDoubleTest, UnitCast_WhenRoundTripped_WillKeepLongDoublePrecision)
+	{
+		auto const distance = units::light_years{1.0L / 3};
+
+		auto const metres = units::unit_cast<units::distance<units::double_double>>(units::dd::light_years{distance});
+		auto const back   = units::unit_cast<units::dd::light_years>(metres);
+
+		EXPECT_EQ(distance.count(), static_cast<long double>(back.count()));
+		EXPECT_EQ(units::parsecs{1}, units::dd::parsecs{1});
+	}
+
+	TEST_F(DoubleDoubleTest, Arithmetic_WhenMixingAliases_WillUseCommonType)
+	{
+		auto const sum = units::dd::parsecs{1} + units::dd::light_years{1};
+
+		EXPECT_TRUE((std::is_same<units::double_double, decltype(sum)::rep>::value));
+		auto const parsec   = units::unit_cast<units::kilometres>(units::parsecs{1});
+		auto const expected = parsec + units::kilometres{9460730472580.8};
+		EXPECT_TRUE(expected == sum);
+		EXPECT_EQ(units::dd::light_years{3}, units::dd::light_years{1.5} * 2);
+		EXPECT_LT(units::dd::astronimical_units{1}, units::dd::light_years{1});
+	}
+
+	TEST_F(DoubleDoubleTest, Stream_WhenWritten_WillUseAliasSuffix)
+	{
+		auto stream = std::ostringstream{};
+
+		stream << units::dd::light_years{1.5};
+
+		EXPECT_EQ("1.5ly", stream.str());
+	}
+
+	TEST_F(DoubleDoubleTest, BatchCast_OnEveryTier_WillMatchUnitCast)
+	{
+		auto light_years = std::vector<units::dd::light_years>{};
+		auto metres      = std::vector<units::metres>{};
+		for (int i = 0; i < 53; ++i)
+		{
+			light_years.emplace_back(units::double_double{1.0 / (i + 1)} + i * 1000);
+			metres.emplace_back(9460730472580800.0 * i / 7);
+		}
+
+		auto const tiers = {units::cpu::tier::scalar,
+		                    units::cpu::tier::sse42,
+		                    units::cpu::tier::avx2,
+		                    units::cpu::tier::avx512};
+		for (auto tier : tiers)
+		{
+			auto const& kernels = units::dd::kernels(tier);
+			auto const  factor  = units::double_double{1} / 3;
+
+			auto scaled = std::vector<units::double_double>(light_years.size());
+			auto narrow = std::vector<double>(light_years.size());
+			auto widen  = std::vector<units::double_double>(metres.size());
+			auto const  pairs   = reinterpret_cast<double const*>(light_years.data());
+			kernels.scale(pairs, light_years.size(), factor, reinterpret_cast<double*>(scaled.data()));
+			kernels.narrow(pairs, light_years.size(), factor, narrow.data());
+			kernels.widen(
+			    units::detail::raw(metres.data()), metres.size(), factor, reinterpret_cast<double*>(widen.data()));
+
+			auto total = units::double_double{};
+			for (std::size_t i = 0; i < light_years.size(); ++i)
+			{
+				auto const expected = light_years[i].count() * factor;
+				EXPECT_EQ(expected, scaled[i]) << units::cpu::name(kernels.tier);
+				EXPECT_EQ(expected.hi, narrow[i]) << units::cpu::name(kernels.tier);
+				EXPECT_EQ(metres[i].count() * factor, widen[i]) << units::cpu::name(kernels.tier);
+				total += light_years[i].count();
+			}
+
+			auto const sum = kernels.sum(pairs, light_years.size());
+			EXPECT_LT(std::abs(static_cast<double>(sum - total)), 1e-25) << units::cpu::name(kernels.tier);
+		}
+	}
+
+	TEST_F(DoubleDoubleTest, BatchCast_WhenConverting_WillAgreeWithUnitCast)
+	{
+		auto const light_years = std::vector<units::dd::light_years>{
+		    units::dd::light_years{0.5}, units::dd::light_years{4.2465}, units::dd::light_years{-1e6}};
+		auto       metres      = std::vector<units::metres>(light_years.size(), units::metres{0});
+		auto       back        = std::vector<units::dd::light_years>(light_years.size(), units::dd::light_years{0});
+		auto       parsecs     = std::vector<units::dd::parsecs>(light_years.size(), units::dd::parsecs{0});
+
+		units::dd::cast(light_years.data(), light_years.data() + light_years.size(), metres.data());
+		units::dd::cast(metres.data(), metres.data() + metres.size(), back.data());
+		units::dd::cast(light_years.data(), light_years.data() + light_years.size(), parsecs.data());
+
+		for (std::size_t i = 0; i < light_years.size(); ++i)
+		{
+			EXPECT_EQ(units::unit_cast<units::metres>(light_years[i]).count(), metres[i].count());
+			EXPECT_TRUE(units::unit_cast<units::dd::light_years>(metres[i]) == back[i]);
+			EXPECT_TRUE(light_years[i] == parsecs[i]);
+		}
+		EXPECT_TRUE(units::dd::light_years{4.2465 - 1e6 + 0.5}
+		            == units::dd::sum(light_years.data(), light_years.data() + light_years.size()));
+	}
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <ratio>
+#include <sstream>
+#include <type_traits>
+
+#include "units.h"
+#include "units/families.h"
+
+using testing::Test;
+
+namespace TestFamilies
+{
+	class FamiliesTest : public Test
+	{
+	};
+
+	TEST_F(FamiliesTest, Alias_WhenTakenFromFamily_WillKeepRatioAndChangeRep)
+	{
+		EXPECT_TRUE((std::is_same<units::distance<float>, units::f32::metres>::value));
+		EXPECT_TRUE((std::is_same<units::distance<std::int64_t, std::milli>, units::i64::millimetres>::value));
+		EXPECT_TRUE((std::is_same<units::family<float>::miles, units::f32::miles>::value));
+		EXPECT_TRUE((std::is_same<units::family<double>::feet, units::feet>::value));
+		EXPECT_TRUE((std::is_same<units::parsecs::ratio, units::i32::parsecs::ratio>::value));
+		EXPECT_TRUE((std::is_same<units::pounds::ratio, units::f32::pounds::ratio>::value));
+		EXPECT_TRUE((std::is_same<units::square_feet::ratio, units::i32::square_feet::ratio>::value));
+	}
+
+	TEST_F(FamiliesTest, Alias_WhenFloat_WillHalveStorage)
+	{
+		EXPECT_EQ(sizeof(float), sizeof(units::f32::kilometres));
+		EXPECT_EQ(sizeof(std::int32_t), sizeof(units::i32::grams));
+	}
+
+	TEST_F(FamiliesTest, Literal_WhenFromFamily_WillUseFamilyRep)
+	{
+		using namespace units::f32::distance_literals;
+		using namespace units::i64::mass_literals;
+
+		auto const distance = 5_m;
+		auto const mass     = 3_kg;
+
+		EXPECT_TRUE((std::is_same<units::f32::metres, std::decay_t<decltype(distance)>>::value));
+		EXPECT_TRUE((std::is_same<units::i64::kilograms, std::decay_t<decltype(mass)>>::value));
+		EXPECT_FLOAT_EQ(5, distance.count());
+		EXPECT_EQ(3, mass.count());
+		EXPECT_TRUE((std::is_same<units::i64::us_hundredweight, std::decay_t<decltype(2_cwt)>>::value));
+	}
+
+	TEST_F(FamiliesTest, Stream_WhenWritten_WillUseSuffixOfMirroredAlias)
+	{
+		auto stream = std::ostringstream{};
+
+		stream << units::f32::kilometres{2} << ' ' << units::i32::feet{3} << ' ' << units::i64::milligrams{7};
+
+		EXPECT_EQ("2km 3ft 7mg", stream.str());
+	}
+
+	TEST_F(FamiliesTest, Conversion_WhenMixingFamilies_WillUseCommonRep)
+	{
+		auto const sum = units::f32::metres{1.5f} + units::f64::kilometres{1};
+
+		EXPECT_TRUE((std::is_same<double, decltype(sum)::rep>::value));
+		EXPECT_DOUBLE_EQ(1001.5, units::unit_cast<units::metres>(sum).count());
+		EXPECT_EQ(2500, units::unit_cast<units::i64::millimetres>(units::f64::metres{2.5}).count());
+		EXPECT_FLOAT_EQ(0.25f, units::unit_cast<units::f32::metres>(units::i32::millimetres{250}).count());
+	}
+
+	TEST_F(FamiliesTest, Area_WhenMultiplyingFamilyDistances_WillBeFamilyArea)
+	{
+		auto const area = units::f32::metres{2} * units::f32::metres{3};
+
+		EXPECT_TRUE((std::is_same<units::f32::square_metres, std::decay_t<decltype(area)>>::value));
+		EXPECT_FLOAT_EQ(6, area.count());
+	}
+}
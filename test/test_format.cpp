@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#include "units.h"
+#include "units/format.h"
+
+using testing::Test;
+
+namespace TestFormat
+{
+	class FormatTest : public Test
+	{
+	};
+
+	TEST_F(FormatTest, ToString_WhenValueIsLarge_WillPickLargerPrefix)
+	{
+		EXPECT_EQ("1.532 km", units::format::to_string(units::metres{1532}));
+	}
+
+	TEST_F(FormatTest, ToString_WhenValueIsSmall_WillPickSmallerPrefix)
+	{
+		EXPECT_EQ("420 mg", units::format::to_string(units::kilograms{0.00042}));
+		EXPECT_EQ("-420 mg", units::format::to_string(units::kilograms{-0.00042}));
+	}
+
+	TEST_F(FormatTest, ToString_WhenValueIsExactlyAnAlias_WillPickThatAlias)
+	{
+		EXPECT_EQ("1 cm", units::format::to_string(units::millimetres{10}));
+		EXPECT_EQ("1 m", units::format::to_string(units::centimetres{100}));
+		EXPECT_EQ("1 mi", units::format::to_string<units::catalogue::imperial_distances>(units::yards{1760}));
+	}
+
+	TEST_F(FormatTest, ToString_WhenValueIsOutsideFamily_WillClampToEnds)
+	{
+		EXPECT_EQ("1e+06 km", units::format::to_string(units::kilometres{1000000}));
+		EXPECT_EQ("0.001 nm", units::format::to_string(units::nanometres{0.001}));
+	}
+
+	TEST_F(FormatTest, ToString_WhenValueIsZeroOrNotFinite_WillUseTheAliasNearestOne)
+	{
+		EXPECT_EQ("0 m", units::format::to_string(units::kilometres{0}));
+		EXPECT_EQ("inf g", units::format::to_string(units::kilograms{std::numeric_limits<double>::infinity()}));
+	}
+
+	TEST_F(FormatTest, Scale_WhenFamilyIsImperial_WillConvertFromMetric)
+	{
+		auto const s = units::format::scale<units::catalogue::imperial_distances>(units::metres{0.3048 * 2});
+
+		EXPECT_DOUBLE_EQ(2, s.value);
+		EXPECT_STREQ("ft", s.suffix);
+	}
+
+	TEST_F(FormatTest, FormatTo_WhenAreaIsGiven_WillUseMetricAreas)
+	{
+		char       buffer[units::format::buffer_size];
+		auto const end = units::format::format_to(buffer, units::square_feet{100}, 3);
+
+		EXPECT_EQ("9.29 sqm", std::string(buffer, end));
+	}
+
+	TEST_F(FormatTest, ToString_WhenPrecisionIsTooLarge_WillClampToMaxDigits10)
+	{
+		auto const huge = units::metres{-std::numeric_limits<double>::max()};
+		EXPECT_EQ(units::format::to_string(huge, 17), units::format::to_string(huge, 40));
+		EXPECT_EQ("1.1000000000000001 m", units::format::to_string(units::metres{1.1}, 1000));
+		EXPECT_EQ("1 m", units::format::to_string(units::metres{1}, 0));
+	}
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/geodesic.h"
+
+using testing::Test;
+
+namespace TestGeodesic
+{
+	class GeodesicTest : public Test
+	{
+	protected:
+		static constexpr double pi = 3.14159265358979323846;
+
+		static double reference_haversine(units::geodesic::point from, units::geodesic::point to)
+		{
+			auto const phi1   = from.latitude * pi / 180;
+			auto const phi2   = to.latitude * pi / 180;
+			auto const dphi   = std::sin((phi2 - phi1) / 2);
+			auto const dlamda = std::sin((to.longitude - from.longitude) * pi / 180 / 2);
+			auto const a      = dphi * dphi + std::cos(phi1) * std::cos(phi2) * dlamda * dlamda;
+			return 2 * 6371000.0 * std::asin(std::sqrt(std::fmin(a, 1.0)));
+		}
+	};
+
+	constexpr double GeodesicTest::pi;
+
+	TEST_F(GeodesicTest, Haversine_WhenPointsAreQuarterCircleApart_WillReturnQuarterCircumference)
+	{
+		auto const distance = units::geodesic::haversine(units::geodesic::point{0, 0}, units::geodesic::point{0, 90});
+
+		EXPECT_NEAR(pi / 2 * 6371000, distance.count(), 1e-6);
+	}
+
+	TEST_F(GeodesicTest, Haversine_WhenPointsArePoles_WillReturnHalfCircumferenceInRequestedRatio)
+	{
+		auto const distance = units::geodesic::haversine<units::kilometres>({90, 0}, {-90, 0});
+
+		EXPECT_NEAR(pi * 6371, distance.count(), 1e-9);
+		EXPECT_NEAR(1, units::geodesic::haversine<units::earth_radii>({0, 0}, {0, 180 / pi}).count(), 1e-15);
+	}
+
+	TEST_F(GeodesicTest, Haversine_WhenBatchedOnEveryTier_WillMatchLibm)
+	{
+		auto engine    = std::mt19937_64{7};
+		auto latitude  = std::uniform_real_distribution<double>{-90, 90};
+		auto longitude = std::uniform_real_distribution<double>{-180, 180};
+
+		auto const n = std::size_t{1000};
+		std::vector<double> lat1(n), lon1(n), lat2(n), lon2(n), out(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			lat1[i] = latitude(engine);
+			lon1[i] = longitude(engine);
+			lat2[i] = i % 2 ? lat1[i] + 0.001 : latitude(engine);
+			lon2[i] = i % 2 ? lon1[i] - 0.001 : longitude(engine);
+		}
+
+		using units::cpu::tier;
+		for (auto t : {tier::scalar, tier::sse42, tier::avx2, tier::avx512})
+		{
+			auto const& kernels = units::geodesic::kernels(t);
+			kernels.haversine(lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, 6371000, out.data());
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				EXPECT_NEAR(reference_haversine({lat1[i], lon1[i]}, {lat2[i], lon2[i]}), out[i], 1e-5);
+			}
+		}
+	}
+
+	TEST_F(GeodesicTest, Haversine_WhenBatchedIntoOtherRep_WillConvertEachDistance)
+	{
+		auto const lat1 = std::vector<double>(300, 0.0);
+		auto const lon1 = std::vector<double>(300, 0.0);
+		auto const lat2 = std::vector<double>(300, 1.0);
+		auto const lon2 = std::vector<double>(300, 0.0);
+		auto       out  = std::vector<units::distance<float, std::kilo>>(300, units::distance<float, std::kilo>{0});
+
+		units::geodesic::haversine(lat1.data(), lon1.data(), lat2.data(), lon2.data(), out.size(), out.data());
+
+		for (auto const& distance : out)
+		{
+			EXPECT_FLOAT_EQ(static_cast<float>(6371 * pi / 180), distance.count());
+		}
+	}
+
+	TEST_F(GeodesicTest, Vincenty_WhenGivenFlindersPeakAndBuninyong_WillMatchPublishedDistance)
+	{
+		auto const degrees = [](double d, double m, double s) { return d + m / 60 + s / 3600; };
+
+		auto const flinders_peak = units::geodesic::point{-degrees(37, 57, 3.72030), degrees(144, 25, 29.52440)};
+		auto const buninyong     = units::geodesic::point{-degrees(37, 39, 10.15610), degrees(143, 55, 35.38390)};
+
+		EXPECT_NEAR(54972.271, units::geodesic::vincenty(flinders_peak, buninyong).count(), 1e-3);
+		EXPECT_EQ(0, units::geodesic::vincenty(flinders_peak, flinders_peak).count());
+	}
+
+	TEST_F(GeodesicTest, Vincenty_WhenBatchedOnEveryTier_WillMatchScalar)
+	{
+		auto engine    = std::mt19937_64{13};
+		auto latitude  = std::uniform_real_distribution<double>{-90, 90};
+		auto longitude = std::uniform_real_distribution<double>{-180, 180};
+
+		auto const n = std::size_t{1000};
+		std::vector<double> lat1(n), lon1(n), lat2(n), lon2(n), out(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			lat1[i] = latitude(engine);
+			lon1[i] = longitude(engine);
+			lat2[i] = i % 2 ? lat1[i] + 0.001 : latitude(engine);
+			lon2[i] = i % 2 ? lon1[i] - 0.001 : longitude(engine);
+		}
+
+		// Coincident points, points on the equator and a nearly antipodal pair that does not converge
+		lat2[3] = lat1[3];
+		lon2[3] = lon1[3];
+		lat1[5] = lat2[5] = 0;
+		lat1[7] = lon1[7] = 0;
+		lat2[7]           = 0.5;
+		lon2[7]           = 179.7;
+
+		using units::cpu::tier;
+		for (auto t : {tier::scalar, tier::sse42, tier::avx2, tier::avx512})
+		{
+			auto const& kernels = units::geodesic::kernels(t);
+			kernels.vincenty(lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, 1, out.data());
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				auto const expected = units::geodesic::vincenty({lat1[i], lon1[i]}, {lat2[i], lon2[i]}).count();
+				if (std::isnan(expected))
+				{
+					EXPECT_TRUE(std::isnan(out[i]));
+				}
+				else
+				{
+					EXPECT_NEAR(expected, out[i], 1e-6);
+				}
+			}
+			EXPECT_EQ(0, out[3]);
+			EXPECT_TRUE(std::isnan(out[7]));
+		}
+
+		auto kilometres = std::vector<units::kilometres>(n, units::kilometres{0});
+		units::geodesic::vincenty(lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, kilometres.data());
+		EXPECT_NEAR(out[0] / 1000, kilometres[0].count(), 1e-9);
+	}
+
+	TEST_F(GeodesicTest, Vincenty_WhenComparedWithHaversine_WillDifferByLessThanFlattening)
+	{
+		auto const from = units::geodesic::point{51.4778, -0.0015};
+		auto const to   = units::geodesic::point{40.6892, -74.0445};
+
+		auto const ellipsoid = units::geodesic::vincenty<units::kilometres>(from, to);
+		auto const sphere    = units::geodesic::haversine<units::kilometres>(from, to);
+
+		EXPECT_NEAR(1, ellipsoid.count() / sphere.count(), 0.005);
+	}
+
+	TEST_F(GeodesicTest, Equirectangular_WhenPointsAreClose_WillStayWithinDocumentedBound)
+	{
+		auto engine = std::mt19937_64{11};
+		auto offset = std::uniform_real_distribution<double>{-0.6, 0.6};
+		auto centre = std::uniform_real_distribution<double>{-69, 69};
+
+		for (int i = 0; i < 10000; ++i)
+		{
+			auto const from = units::geodesic::point{centre(engine), 2.5 * centre(engine)};
+			auto const to   = units::geodesic::point{from.latitude + offset(engine), from.longitude + offset(engine)};
+
+			auto const exact = units::geodesic::haversine(from, to).count();
+			if (exact > 0 && exact < 100000)
+			{
+				EXPECT_NEAR(1, units::geodesic::equirectangular(from, to).count() / exact, 1e-4);
+			}
+		}
+	}
+
+	TEST_F(GeodesicTest, Equirectangular_WhenCrossingAntimeridian_WillTakeShortWay)
+	{
+		auto const lat1 = std::vector<double>{10};
+		auto const lon1 = std::vector<double>{179.5};
+		auto const lat2 = std::vector<double>{10};
+		auto const lon2 = std::vector<double>{-179.5};
+		auto       out  = std::vector<units::metres>(1, units::metres{0});
+
+		units::geodesic::equirectangular(lat1.data(), lon1.data(), lat2.data(), lon2.data(), 1, out.data());
+
+		EXPECT_NEAR(units::geodesic::haversine({10, 179.5}, {10, -179.5}).count(), out[0].count(), 1);
+	}
+}
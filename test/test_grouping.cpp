@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "units.h"
+#include "units/grouping.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestGrouping
+{
+	class GroupingTest : public Test
+	{
+	protected:
+		// The partition found by sorting and splitting at every gap wider than the tolerance, labelled the way
+		// group_by labels its groups
+		static std::vector<std::size_t> sorted_groups(std::vector<units::metres> const& values, double tolerance)
+		{
+			std::vector<std::size_t> order(values.size());
+			for (std::size_t i = 0; i < order.size(); ++i)
+			{
+				order[i] = i;
+			}
+			std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+				return values[lhs].count() < values[rhs].count();
+			});
+
+			std::vector<std::size_t> run(values.size());
+			std::size_t              runs = 0;
+			for (std::size_t i = 0; i < order.size(); ++i)
+			{
+				if (i > 0 && values[order[i]].count() - values[order[i - 1]].count() > tolerance)
+				{
+					++runs;
+				}
+				run[order[i]] = runs;
+			}
+
+			std::vector<std::size_t> number(runs + 1, values.size());
+			std::vector<std::size_t> labels(values.size());
+			std::size_t              groups = 0;
+			for (std::size_t i = 0; i < values.size(); ++i)
+			{
+				if (number[run[i]] == values.size())
+				{
+					number[run[i]] = groups++;
+				}
+				labels[i] = number[run[i]];
+			}
+			return labels;
+		}
+	};
+
+	using integer_millimetres = units::unit<int, std::milli, units::unit_type::distance>;
+
+	TEST_F(GroupingTest, Hash_WhenRepIsIntegral_WillKeyUnorderedContainers)
+	{
+		std::unordered_set<integer_millimetres> millimetres{
+		    integer_millimetres{1}, integer_millimetres{2}, integer_millimetres{1}};
+
+		EXPECT_EQ(2u, millimetres.size());
+		EXPECT_EQ(1u, millimetres.count(integer_millimetres{2}));
+	}
+
+	TEST_F(GroupingTest, Hash_WhenRepIsFloatingPoint_WillBeDisabled)
+	{
+		EXPECT_FALSE(std::is_default_constructible<std::hash<units::metres>>::value);
+		EXPECT_FALSE(std::is_copy_constructible<std::hash<units::metres>>::value);
+		EXPECT_TRUE(std::is_default_constructible<std::hash<integer_millimetres>>::value);
+	}
+
+	TEST_F(GroupingTest, Grid_WhenConstructedWithoutWidth_WillThrow)
+	{
+		EXPECT_THROW(units::grid<units::metres>{units::metres{0.0}}, std::invalid_argument);
+		EXPECT_THROW(units::grid<units::metres>{units::metres{-1.0}}, std::invalid_argument);
+	}
+
+	TEST_F(GroupingTest, Grid_WhenGivenOtherRatio_WillConvertToCells)
+	{
+		auto const cells = units::grid<units::metres>{10_cm};
+
+		EXPECT_EQ(12, cells.cell(units::metres{1.25}));
+		EXPECT_EQ(-13, cells.cell(-units::metres{1.25}));
+		EXPECT_EQ(10000, cells.cell(1_km));
+		EXPECT_THROW(cells.cell(units::metres{std::numeric_limits<double>::quiet_NaN()}), std::domain_error);
+	}
+
+	TEST_F(GroupingTest, GridHash_WhenValuesShareCell_WillBeOneKey)
+	{
+		using hash  = units::grid_hash<units::metres>;
+		using equal = units::grid_equal<units::metres>;
+
+		auto const cells = units::grid<units::metres>{1_m};
+		std::unordered_map<units::metres, int, hash, equal> counts{16, hash{cells}, equal{cells}};
+
+		for (auto m : {units::metres{0.1}, units::metres{0.9}, units::metres{1.5}, units::metres{0.5}})
+		{
+			++counts[m];
+		}
+
+		EXPECT_EQ(2u, counts.size());
+		EXPECT_EQ(3, counts[units::metres{0.2}]);
+	}
+
+	TEST_F(GroupingTest, GroupBy_WhenValuesAreClose_WillLinkThem)
+	{
+		auto const values = std::vector<units::metres>{
+		    units::metres{5.0}, units::metres{1.0}, units::metres{1.05}, units::metres{5.02}, units::metres{1.1}, 9_m};
+		auto const groups = units::group_by(values.begin(), values.end(), 6_cm);
+
+		ASSERT_EQ(3u, groups.size());
+		EXPECT_EQ((std::vector<std::size_t>{0, 1, 1, 0, 1, 2}), groups.labels());
+		EXPECT_EQ(units::metres{1.0}, groups.representative(1));
+		EXPECT_EQ(units::metres{1.0}, groups.lower(1));
+		EXPECT_EQ(units::metres{1.1}, groups.upper(1));
+		EXPECT_EQ(3u, groups.count(1));
+		EXPECT_EQ(units::metres{9.0}, groups.representative(2));
+	}
+
+	TEST_F(GroupingTest, GroupBy_WhenChainCrossesCells_WillLinkNeighbours)
+	{
+		// Each step is within the tolerance, so the chain is one group although its ends are far apart
+		std::vector<units::metres> values;
+		for (int i = 0; i < 100; ++i)
+		{
+			values.push_back(units::metres{i * 0.9});
+		}
+		values.push_back(units::metres{200.0});
+
+		auto const groups = units::group_by(values.begin(), values.end(), 1_m);
+
+		ASSERT_EQ(2u, groups.size());
+		EXPECT_DOUBLE_EQ(99 * 0.9, groups.upper(0).count());
+		EXPECT_EQ(100u, groups.count(0));
+	}
+
+	TEST_F(GroupingTest, GroupBy_WhenRandom_WillMatchSortedGrouping)
+	{
+		std::mt19937                           engine{7};
+		std::uniform_real_distribution<double> distribution{-1000.0, 1000.0};
+
+		std::vector<units::metres> values;
+		for (int i = 0; i < 5000; ++i)
+		{
+			values.push_back(units::metres{distribution(engine)});
+		}
+
+		for (double tolerance : {0.01, 0.2, 1.0, 5.0})
+		{
+			auto const groups = units::group_by(values.begin(), values.end(), units::metres{tolerance});
+
+			EXPECT_EQ(sorted_groups(values, tolerance), groups.labels());
+		}
+	}
+
+	TEST_F(GroupingTest, GroupBy_WhenGivenList_WillGroup)
+	{
+		auto const values = std::list<units::metres>{
+		    units::metres{1.0}, units::metres{1.5}, units::metres{3.0}, units::metres{10.0}, units::metres{1.2}};
+		auto const groups = units::group_by(values.begin(), values.end(), 1_m);
+
+		EXPECT_EQ((std::vector<std::size_t>{0, 0, 1, 2, 0}), groups.labels());
+	}
+
+	TEST_F(GroupingTest, GroupBy_WhenGivenNaN_WillThrow)
+	{
+		auto const values = std::vector<units::metres>{1_m, units::metres{std::numeric_limits<double>::quiet_NaN()}};
+
+		EXPECT_THROW(units::group_by(values.begin(), values.end(), 1_m), std::domain_error);
+	}
+
+	TEST_F(GroupingTest, Dedup_WhenValuesRepeat_WillKeepFirstOfEach)
+	{
+		auto const values = std::vector<units::metres>{2_m, units::metres{1.0 + 1e-12}, 1_m, 2_m, 3_m};
+		std::vector<units::metres> unique;
+
+		units::dedup(values.begin(), values.end(), std::back_inserter(unique), 1_mm);
+
+		ASSERT_EQ(3u, unique.size());
+		EXPECT_EQ(2.0, unique[0].count());
+		EXPECT_EQ(1.0 + 1e-12, unique[1].count());
+		EXPECT_EQ(3.0, unique[2].count());
+	}
+}
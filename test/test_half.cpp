@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/families.h"
+#include "units/half.h"
+
+using testing::Test;
+
+namespace TestHalf
+{
+	class HalfTest : public Test
+	{
+	protected:
+		std::vector<units::cpu::tier> const tiers{units::cpu::tier::scalar,
+		                                          units::cpu::tier::sse42,
+		                                          units::cpu::tier::avx2,
+		                                          units::cpu::tier::avx512};
+
+		std::vector<units::rounding> const modes{units::rounding::to_nearest,
+		                                         units::rounding::toward_zero,
+		                                         units::rounding::upward,
+		                                         units::rounding::downward};
+	};
+
+	TEST_F(HalfTest, Construction_WhenGivenKnownValues_WillMatchBinary16)
+	{
+		EXPECT_EQ(0x3c00, units::half{1.0f}.bits);
+		EXPECT_EQ(0xc000, units::half{-2}.bits);
+		EXPECT_EQ(0x7bff, units::half{65504.0}.bits);
+		EXPECT_EQ(0x7c00, units::half{65520.0}.bits);
+		EXPECT_EQ(0x0001, units::half{std::ldexp(1.0, -24)}.bits);
+		EXPECT_EQ(0x0000, units::half{1e-8}.bits);
+		EXPECT_EQ(0x3555, units::half{1.0 / 3}.bits);
+		EXPECT_TRUE(std::isnan(static_cast<float>(units::half{std::numeric_limits<float>::quiet_NaN()})));
+		EXPECT_EQ(std::numeric_limits<float>::infinity(), units::half{1e300});
+	}
+
+	TEST_F(HalfTest, Construction_WhenGivenKnownValues_WillMatchBfloat16)
+	{
+		EXPECT_EQ(0x3f80, units::bfloat16{1.0f}.bits);
+		EXPECT_EQ(0xc000, units::bfloat16{-2.0}.bits);
+		EXPECT_EQ(0x7f80, units::bfloat16{std::numeric_limits<float>::infinity()}.bits);
+		EXPECT_FLOAT_EQ(3.140625f, units::bfloat16{3.14159});
+	}
+
+	TEST_F(HalfTest, Round_WhenModeGiven_WillRoundInThatDirection)
+	{
+		auto const tie      = 1.0 + std::ldexp(1.0, -11);
+		auto const negative = -tie;
+
+		EXPECT_EQ(0x3c00, units::half::round(tie, units::rounding::to_nearest).bits);
+		EXPECT_EQ(0x3c00, units::half::round(tie, units::rounding::toward_zero).bits);
+		EXPECT_EQ(0x3c01, units::half::round(tie, units::rounding::upward).bits);
+		EXPECT_EQ(0x3c00, units::half::round(tie, units::rounding::downward).bits);
+		EXPECT_EQ(0xbc01, units::half::round(negative, units::rounding::downward).bits);
+		EXPECT_EQ(0xbc00, units::half::round(negative, units::rounding::upward).bits);
+		EXPECT_EQ(0x7bff, units::half::round(1e6, units::rounding::toward_zero).bits);
+		EXPECT_EQ(0x0001, units::half::round(1e-30, units::rounding::upward).bits);
+		EXPECT_EQ(0x3f81, units::bfloat16::round(1.001f, units::rounding::upward).bits);
+	}
+
+	TEST_F(HalfTest, Round_WhenDoubleIsJustAboveTie_WillNotRoundTwice)
+	{
+		// Rounding to float first would land exactly on the tie and round down to even
+		auto const above_tie = 1.0 + std::ldexp(1.0, -11) + std::ldexp(1.0, -40);
+
+		EXPECT_EQ(0x3c01, units::half{above_tie}.bits);
+		EXPECT_EQ(0x3f81, units::bfloat16{1.0 + std::ldexp(1.0, -8) + std::ldexp(1.0, -40)}.bits);
+	}
+
+	TEST_F(HalfTest, RoundTrip_WhenEveryPatternWidened_WillNarrowBackUnchanged)
+	{
+		for (std::uint32_t bits = 0; bits <= 0xffff; ++bits)
+		{
+			auto const half     = units::half::from_bits(static_cast<std::uint16_t>(bits));
+			auto const bfloat16 = units::bfloat16::from_bits(static_cast<std::uint16_t>(bits));
+			if (std::isnan(static_cast<float>(half)) || std::isnan(static_cast<float>(bfloat16)))
+			{
+				continue;
+			}
+
+			for (auto mode : modes)
+			{
+				ASSERT_EQ(bits, units::half::round(static_cast<float>(half), mode).bits);
+				ASSERT_EQ(bits, units::bfloat16::round(static_cast<float>(bfloat16), mode).bits);
+			}
+		}
+	}
+
+	TEST_F(HalfTest, Kernels_OnEveryTier_WillMatchScalarConversion)
+	{
+		auto engine   = std::mt19937_64{7};
+		auto exponent = std::uniform_int_distribution<int>{-30, 20};
+		auto fraction = std::uniform_real_distribution<double>{-2, 2};
+		auto values   = std::vector<double>{0.0, -0.0, 65504.0, 65520.0, -1e9, std::ldexp(1.0, -25)};
+		for (int i = 0; i < 1000; ++i)
+		{
+			values.push_back(std::ldexp(fraction(engine), exponent(engine)));
+		}
+
+		for (auto tier : tiers)
+		{
+			auto const& hardware = units::bulk::float16_kernels_for(tier);
+			auto const& software = units::bulk::float16_software_kernels_for(tier);
+			for (auto mode : modes)
+			{
+				auto narrowed = std::vector<std::uint16_t>(values.size());
+				auto expected = std::vector<std::uint16_t>(values.size());
+				hardware.binary16.narrow(values.data(), values.size(), 0.5, mode, narrowed.data());
+				software.binary16.narrow(values.data(), values.size(), 0.5, mode, expected.data());
+				for (std::size_t i = 0; i < values.size(); ++i)
+				{
+					ASSERT_EQ(units::half::round(values[i] * 0.5, mode).bits, narrowed[i]) << values[i];
+					ASSERT_EQ(expected[i], narrowed[i]) << values[i];
+				}
+
+				hardware.bfloat16.narrow(values.data(), values.size(), 0.5, mode, narrowed.data());
+				for (std::size_t i = 0; i < values.size(); ++i)
+				{
+					ASSERT_EQ(units::bfloat16::round(values[i] * 0.5, mode).bits, narrowed[i]) << values[i];
+				}
+			}
+
+			auto patterns = std::vector<std::uint16_t>{};
+			for (std::uint32_t bits = 0; bits <= 0xffff; ++bits)
+			{
+				patterns.push_back(static_cast<std::uint16_t>(bits));
+			}
+			auto widened = std::vector<double>(patterns.size());
+			hardware.binary16.widen(patterns.data(), patterns.size(), 4.0, widened.data());
+			for (std::size_t i = 0; i < patterns.size(); ++i)
+			{
+				auto const expected = 4.0 * units::half::from_bits(patterns[i]);
+				ASSERT_TRUE(expected == widened[i] || (std::isnan(expected) && std::isnan(widened[i])))
+				    << units::cpu::name(tier) << ' ' << patterns[i];
+			}
+		}
+	}
+
+	TEST_F(HalfTest, Unit_WhenHalfRep_WillConvertAndPrint)
+	{
+		using millimetres = units::family<units::half>::millimetres;
+
+		auto const distance = millimetres{1500} + millimetres{2.5f};
+		auto       stream   = std::ostringstream{};
+		stream << distance;
+
+		EXPECT_TRUE((std::is_same<millimetres, std::decay_t<decltype(distance)>>::value));
+		EXPECT_EQ(2, sizeof(distance));
+		EXPECT_DOUBLE_EQ(1.502, units::unit_cast<units::metres>(distance).count());
+		EXPECT_EQ("1502mm", stream.str());
+		EXPECT_TRUE((std::is_same<double, std::common_type_t<millimetres, units::metres>::rep>::value));
+		EXPECT_TRUE(units::metres{1.502} == distance);
+	}
+
+	TEST_F(HalfTest, Bulk_WhenWideningAndNarrowing_WillFuseUnitCast)
+	{
+		using half_millimetres    = units::family<units::half>::millimetres;
+		using bfloat16_kilometres = units::family<units::bfloat16>::kilometres;
+
+		auto const metres  = std::vector<units::metres>{units::metres{0.25}, units::metres{-1.5}, units::metres{40.96}};
+		auto       compact = std::vector<half_millimetres>(metres.size(), half_millimetres{0});
+		auto       coarse  = std::vector<bfloat16_kilometres>(metres.size(), bfloat16_kilometres{0});
+		auto       wide    = std::vector<units::metres>(metres.size(), units::metres{0});
+
+		units::bulk::narrow(metres.data(), metres.data() + metres.size(), compact.data());
+		units::bulk::widen(compact.data(), compact.data() + compact.size(), wide.data());
+		units::bulk::narrow(metres.data(), metres.data() + metres.size(), coarse.data(), units::rounding::upward);
+
+		for (std::size_t i = 0; i < metres.size(); ++i)
+		{
+			EXPECT_DOUBLE_EQ(metres[i].count(), wide[i].count());
+			EXPECT_GE(static_cast<double>(coarse[i].count()), metres[i].count() / 1000);
+		}
+		EXPECT_EQ(units::half{40960}.bits, compact[2].count().bits);
+	}
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "units.h"
+#include "units/histogram.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestHistogram
+{
+	class UniformHistogramTest : public Test
+	{
+	protected:
+		units::histogram<units::metres> histogram{0_m, 10_m, 10};
+	};
+
+	TEST_F(UniformHistogramTest, Fill_WhenValueIsInRange_WillCountInCorrectBin)
+	{
+		histogram.fill(units::metres{3.5});
+		EXPECT_EQ(1u, histogram.count(3));
+		EXPECT_EQ(1u, histogram.total());
+	}
+
+	TEST_F(UniformHistogramTest, Fill_WhenValueIsOnLowerEdge_WillCountInThatBin)
+	{
+		histogram.fill(units::metres{0});
+		histogram.fill(units::metres{9});
+		EXPECT_EQ(1u, histogram.count(0));
+		EXPECT_EQ(1u, histogram.count(9));
+	}
+
+	TEST_F(UniformHistogramTest, Fill_WhenValueIsOutOfRange_WillCountInUnderflowOrOverflow)
+	{
+		histogram.fill(units::metres{-0.5});
+		histogram.fill(units::metres{10});
+		histogram.fill(units::metres{std::numeric_limits<double>::quiet_NaN()});
+		EXPECT_EQ(1u, histogram.underflow());
+		EXPECT_EQ(2u, histogram.overflow());
+	}
+
+	TEST_F(UniformHistogramTest, Fill_WhenValueHasDifferentRatio_WillConvertValue)
+	{
+		histogram.fill(450_cm);
+		EXPECT_EQ(1u, histogram.count(4));
+	}
+
+	TEST_F(UniformHistogramTest, FillRange_WhenGivenContiguousValues_WillMatchSingleFills)
+	{
+		auto values = std::vector<units::metres>{};
+		for (int i = -20; i < 1020; ++i)
+		{
+			values.push_back(units::metres{i / 100.0});
+		}
+
+		auto expected = units::histogram<units::metres>{0_m, 10_m, 10};
+		for (auto value : values)
+		{
+			expected.fill(value);
+		}
+
+		histogram.fill(values.begin(), values.end());
+
+		EXPECT_EQ(expected.underflow(), histogram.underflow());
+		EXPECT_EQ(expected.overflow(), histogram.overflow());
+		for (std::size_t i = 0; i < histogram.bins(); ++i)
+		{
+			EXPECT_EQ(expected.count(i), histogram.count(i));
+		}
+	}
+
+	TEST(HistogramEdgesTest, Constructor_WhenEdgesHaveDifferentRatio_WillNormaliseEdges)
+	{
+		auto histogram = units::histogram<units::kilometres>{0_mi, 10_mi, 10};
+
+		EXPECT_EQ(units::kilometres{1.609344}, histogram.upper_edge(0));
+		EXPECT_EQ(units::kilometres{16.09344}, histogram.upper_edge(9));
+
+		histogram.fill(units::kilometres{1.6});
+		histogram.fill(units::kilometres{1.7});
+		EXPECT_EQ(1u, histogram.count(0));
+		EXPECT_EQ(1u, histogram.count(1));
+	}
+
+	TEST(HistogramEdgesTest, Constructor_WhenRangeIsEmpty_WillThrow)
+	{
+		EXPECT_THROW((units::histogram<units::metres>{1_m, 1_m, 10}), std::invalid_argument);
+		EXPECT_THROW((units::histogram<units::metres>{0_m, 1_m, 0}), std::invalid_argument);
+	}
+
+	TEST(VariableHistogramTest, Fill_WhenEdgesAreVariable_WillCountInCorrectBin)
+	{
+		auto histogram = units::histogram<units::metres>{{0_m, 1_m, 5_m, 100_m}};
+
+		histogram.fill(50_cm);
+		histogram.fill(4_m);
+		histogram.fill(99_m);
+		histogram.fill(100_m);
+
+		EXPECT_EQ(3u, histogram.bins());
+		EXPECT_EQ(1u, histogram.count(0));
+		EXPECT_EQ(1u, histogram.count(1));
+		EXPECT_EQ(1u, histogram.count(2));
+		EXPECT_EQ(1u, histogram.overflow());
+	}
+
+	TEST(VariableHistogramTest, Constructor_WhenEdgesAreNotIncreasing_WillThrow)
+	{
+		EXPECT_THROW((units::histogram<units::metres>{{0_m, 5_m, 5_m}}), std::invalid_argument);
+		EXPECT_THROW((units::histogram<units::metres>{{0_m}}), std::invalid_argument);
+	}
+
+	TEST(HistogramMergeTest, Merge_WhenEdgesDiffer_WillThrow)
+	{
+		auto lhs = units::histogram<units::metres>{0_m, 10_m, 10};
+		auto rhs = units::histogram<units::metres>{0_m, 10_m, 5};
+		EXPECT_THROW(lhs += rhs, std::invalid_argument);
+	}
+
+	TEST(ConcurrentHistogramTest, Fill_WhenFilledFromManyThreads_WillCountEveryValue)
+	{
+		auto histogram = units::concurrent_histogram<units::metres>{0_m, 1_km, 100};
+		auto values    = std::vector<units::metres>{};
+		for (int i = 0; i < 1000; ++i)
+		{
+			values.push_back(units::metres{static_cast<double>(i)});
+		}
+
+		auto threads = std::vector<std::thread>{};
+		for (int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&] {
+				histogram.fill(values.begin(), values.end());
+				histogram.fill(units::metres{-1});
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ(4u, histogram.underflow());
+		for (std::size_t i = 0; i < histogram.bins(); ++i)
+		{
+			EXPECT_EQ(40u, histogram.count(i));
+		}
+	}
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "units.h"
+#include "units/index.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestIndex
+{
+	class IndexTest : public Test
+	{
+	protected:
+		IndexTest()
+		{
+			std::mt19937                           engine{11};
+			std::uniform_real_distribution<double> distribution{0.0, 10000.0};
+			for (int i = 0; i < 200000; ++i)
+			{
+				lengths.push_back(units::metres{distribution(engine)});
+			}
+		}
+
+		std::vector<std::size_t> scan(units::metres lo, units::metres hi) const
+		{
+			auto rows = std::vector<std::size_t>{};
+			for (std::size_t i = 0; i < lengths.size(); ++i)
+			{
+				if (lengths[i].count() >= lo.count() && lengths[i].count() < hi.count())
+				{
+					rows.push_back(i);
+				}
+			}
+			return rows;
+		}
+
+		std::vector<units::metres> lengths;
+	};
+
+	TEST_F(IndexTest, RangeIndex_WhenQueried_WillMatchScan)
+	{
+		auto const index = units::range_index<units::metres>{lengths.begin(), lengths.end()};
+
+		std::mt19937                           engine{3};
+		std::uniform_real_distribution<double> distribution{-10.0, 10010.0};
+		for (int i = 0; i < 200; ++i)
+		{
+			auto       lo       = units::metres{distribution(engine)};
+			auto       hi       = units::metres{distribution(engine)};
+			auto const expected = lo < hi ? scan(lo, hi) : std::vector<std::size_t>{};
+
+			EXPECT_EQ(expected.size(), index.count_between(lo, hi));
+
+			auto const rows   = index.between(lo, hi);
+			auto       actual = std::vector<std::size_t>(rows.begin(), rows.end());
+			std::sort(actual.begin(), actual.end());
+			EXPECT_EQ(expected, actual);
+		}
+	}
+
+	TEST_F(IndexTest, RangeIndex_WhenBoundsInOtherRatios_WillConvertThem)
+	{
+		auto const index = units::range_index<units::metres>{lengths.begin(), lengths.end()};
+
+		EXPECT_EQ(scan(units::metres{3218.688}, 5_km).size(), index.count_between(2_mi, 5_km));
+		EXPECT_EQ(index.count_between(1_km, 2_km), index.count_between(1000_m, 2000_m));
+		EXPECT_EQ(lengths.size(), index.rank(10_km));
+		EXPECT_EQ(0u, index.rank(0_m));
+	}
+
+	TEST_F(IndexTest, RangeIndex_WhenBuiltWithOneThread_WillMatchParallelBuild)
+	{
+		auto       options = units::index_options{};
+		options.threads    = 1;
+		auto const serial  = units::range_index<units::metres>{lengths.begin(), lengths.end(), options};
+		options.threads    = 7;
+		auto const threads = units::range_index<units::metres>{lengths.begin(), lengths.end(), options};
+
+		auto const lhs = serial.between(100_m, 9_km);
+		auto const rhs = threads.between(100_m, 9_km);
+		EXPECT_TRUE(std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+		for (std::size_t i = 1; i < threads.size(); ++i)
+		{
+			ASSERT_LE(threads[i - 1], threads[i]);
+		}
+	}
+
+	TEST_F(IndexTest, RangeIndex_WhenValuesRepeat_WillCountEachRow)
+	{
+		auto const values = std::list<units::metres>{2_m, 1_m, 2_m, 3_m, 2_m};
+		auto const index  = units::range_index<units::metres>{values.begin(), values.end()};
+
+		EXPECT_EQ(3u, index.count_between(2_m, 3_m));
+		EXPECT_EQ(1u, index.rank(2_m));
+		EXPECT_EQ(0u, index.count_between(3_m, 2_m));
+
+		auto const rows = index.between(2_m, 3_m);
+		EXPECT_EQ((std::vector<std::size_t>{0, 2, 4}), std::vector<std::size_t>(rows.begin(), rows.end()));
+	}
+
+	TEST_F(IndexTest, RangeIndex_WhenEmpty_WillFindNothing)
+	{
+		auto const values = std::vector<units::metres>{};
+		auto const index  = units::range_index<units::metres>{values.begin(), values.end()};
+
+		EXPECT_EQ(0u, index.count_between(0_m, 1_km));
+		EXPECT_TRUE(index.between(0_m, 1_km).empty());
+	}
+
+	TEST_F(IndexTest, RangeIndex_WhenGivenNaN_WillThrow)
+	{
+		auto const values = std::vector<units::metres>{1_m, units::metres{std::numeric_limits<double>::quiet_NaN()}};
+
+		EXPECT_THROW((units::range_index<units::metres>{values.begin(), values.end()}), std::domain_error);
+	}
+
+	TEST_F(IndexTest, IntervalIndex_WhenStabbed_WillMatchScan)
+	{
+		auto starts = std::vector<units::metres>{};
+		auto ends   = std::vector<units::metres>{};
+		for (std::size_t i = 0; i + 1 < lengths.size(); i += 2)
+		{
+			auto const start = std::min(lengths[i], lengths[i + 1]);
+			starts.push_back(start);
+			ends.push_back(std::min(std::max(lengths[i], lengths[i + 1]), start + 50_m));
+		}
+		auto const index = units::interval_index<units::metres>{starts.begin(), starts.end(), ends.begin()};
+
+		for (double point : {0.0, 12.5, 5000.0, 9999.0, 10001.0})
+		{
+			auto expected = std::vector<std::size_t>{};
+			for (std::size_t i = 0; i < starts.size(); ++i)
+			{
+				if (starts[i].count() <= point && point <= ends[i].count())
+				{
+					expected.push_back(i);
+				}
+			}
+
+			auto actual = index.stabbing(units::metres{point});
+			std::sort(actual.begin(), actual.end());
+			EXPECT_EQ(expected, actual);
+			EXPECT_EQ(expected.size(), index.count_containing(units::metres{point}));
+		}
+	}
+
+	TEST_F(IndexTest, IntervalIndex_WhenOverlapped_WillReturnEveryTouchingInterval)
+	{
+		auto const starts = std::vector<units::metres>{0_m, 10_m, 20_m, 5_m, 100_m};
+		auto const ends   = std::vector<units::metres>{5_m, 15_m, 30_m, 50_m, 200_m};
+		auto const index  = units::interval_index<units::metres>{starts.begin(), starts.end(), ends.begin()};
+
+		EXPECT_EQ((std::vector<std::size_t>{0, 3, 1}), index.overlapping(5_m, 12_m));
+		EXPECT_EQ((std::vector<std::size_t>{3, 4}), index.overlapping(4000_cm, 1_km));
+		EXPECT_EQ(0u, index.count_overlapping(60_m, 90_m));
+		EXPECT_EQ(0u, index.count_overlapping(90_m, 60_m));
+	}
+
+	TEST_F(IndexTest, IntervalIndex_WhenIntervalIsReversed_WillThrow)
+	{
+		auto const starts = std::vector<units::metres>{0_m, 10_m};
+		auto const ends   = std::vector<units::metres>{5_m, 9_m};
+
+		EXPECT_THROW((units::interval_index<units::metres>{starts.begin(), starts.end(), ends.begin()}),
+		             std::invalid_argument);
+	}
+}
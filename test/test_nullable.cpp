@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/nullable.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestNullable
+{
+	using nullable_metres = units::nullable<units::metres>;
+	using millimetres_i   = units::distance<std::int32_t, std::milli>;
+	using nullable_mm     = units::nullable<millimetres_i>;
+
+	class NullableTest : public Test
+	{
+	protected:
+		// Long enough for whole lanes and a tail, with a null every third element
+		static std::vector<nullable_metres> column(std::size_t size)
+		{
+			auto values = std::vector<nullable_metres>{};
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				values.push_back(i % 3 == 0 ? nullable_metres{} : nullable_metres{units::metres{double(i)}});
+			}
+			return values;
+		}
+	};
+
+	TEST_F(NullableTest, Size_WillMatchRep)
+	{
+		EXPECT_EQ(sizeof(double), sizeof(nullable_metres));
+		EXPECT_EQ(sizeof(std::int32_t), sizeof(nullable_mm));
+	}
+
+	TEST_F(NullableTest, Default_WillBeNull)
+	{
+		EXPECT_FALSE(nullable_metres{}.has_value());
+		EXPECT_FALSE(nullable_metres{units::null}.has_value());
+		EXPECT_FALSE(nullable_mm{}.has_value());
+		EXPECT_FALSE(static_cast<bool>(nullable_mm{}));
+	}
+
+	TEST_F(NullableTest, Value_WhenNull_WillThrow)
+	{
+		EXPECT_THROW(nullable_metres{}.value(), std::domain_error);
+		EXPECT_DOUBLE_EQ(3.0, nullable_metres{}.value_or(3_m).count());
+		EXPECT_DOUBLE_EQ(2.0, nullable_metres{2_m}.value().count());
+	}
+
+	TEST_F(NullableTest, HasValue_WhenArithmeticNaN_WillBeTrue)
+	{
+		auto const nan = nullable_metres{units::metres{std::numeric_limits<double>::quiet_NaN()}};
+
+		EXPECT_TRUE(nan.has_value());
+		EXPECT_TRUE(std::isnan(units::null_traits<double>::null()));
+	}
+
+	TEST_F(NullableTest, HasValue_WhenIntegerSentinel_WillBeFalse)
+	{
+		EXPECT_FALSE(nullable_mm{millimetres_i{std::numeric_limits<std::int32_t>::lowest()}}.has_value());
+		EXPECT_EQ(std::numeric_limits<std::uint16_t>::max(), units::null_traits<std::uint16_t>::null());
+	}
+
+	TEST_F(NullableTest, Comparison_WillOrderNullFirst)
+	{
+		EXPECT_TRUE(nullable_metres{} == nullable_metres{});
+		EXPECT_TRUE(nullable_metres{} != nullable_metres{1_m});
+		EXPECT_TRUE(nullable_metres{} < nullable_metres{1_m});
+		EXPECT_FALSE(nullable_metres{1_m} < nullable_metres{});
+		EXPECT_TRUE(nullable_metres{1_km} == units::nullable<units::kilometres>{1_km});
+		EXPECT_TRUE(nullable_metres{1_m} < units::nullable<units::kilometres>{1_km});
+		EXPECT_TRUE(nullable_metres{1000_m} >= units::nullable<units::kilometres>{1_km});
+		EXPECT_TRUE(nullable_metres{1_km} == 1_km);
+		EXPECT_TRUE(nullable_metres{} != 1_km);
+	}
+
+	TEST_F(NullableTest, Sum_WillSkipNulls)
+	{
+		auto const values = column(101);
+
+		auto expected = 0.0;
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			expected += i % 3 == 0 ? 0.0 : double(i);
+		}
+
+		EXPECT_DOUBLE_EQ(expected, units::bulk::sum(values.data(), values.data() + values.size()).count());
+		EXPECT_EQ(67u, units::bulk::count_valid(values.data(), values.data() + values.size()));
+	}
+
+	TEST_F(NullableTest, Mean_WhenAllNull_WillBeNull)
+	{
+		auto const values = std::vector<nullable_metres>(10);
+
+		EXPECT_FALSE(units::bulk::mean(values.data(), values.data() + values.size()).has_value());
+		EXPECT_FALSE(units::bulk::min(values.data(), values.data() + values.size()).has_value());
+		EXPECT_FALSE(units::bulk::max(values.data(), values.data() + values.size()).has_value());
+	}
+
+	TEST_F(NullableTest, MinMax_WillSkipNulls)
+	{
+		auto values = column(50);
+		values[1]   = nullable_metres{-5_m};
+
+		EXPECT_DOUBLE_EQ(-5.0, units::bulk::min(values.data(), values.data() + values.size()).value().count());
+		EXPECT_DOUBLE_EQ(49.0, units::bulk::max(values.data(), values.data() + values.size()).value().count());
+	}
+
+	TEST_F(NullableTest, CountBetween_WillSkipNulls)
+	{
+		auto const values = column(100);
+		auto const hi     = units::kilometres{0.02};
+
+		EXPECT_EQ(7u, units::bulk::count_between(values.data(), values.data() + values.size(), 10_m, hi));
+		EXPECT_EQ(6u, units::bulk::count_less(values.data(), values.data() + values.size(), 10_m));
+	}
+
+	TEST_F(NullableTest, Reductions_WhenIntegerRep_WillSkipSentinel)
+	{
+		auto const values = std::vector<nullable_mm>{
+		    nullable_mm{millimetres_i{5}}, nullable_mm{}, nullable_mm{millimetres_i{-3}}, nullable_mm{millimetres_i{8}},
+		};
+		auto const first = values.data();
+		auto const last  = values.data() + values.size();
+
+		EXPECT_EQ(10, units::bulk::sum(first, last).count());
+		EXPECT_DOUBLE_EQ(10.0 / 3.0, units::bulk::mean(first, last).value().count());
+		EXPECT_EQ(-3, units::bulk::min(first, last).value().count());
+		EXPECT_EQ(8, units::bulk::max(first, last).value().count());
+		EXPECT_EQ(2u, units::bulk::count_less(first, last, units::metres{0.006}));
+	}
+
+	TEST_F(NullableTest, Cast_WillKeepNulls)
+	{
+		auto const values = column(10);
+		auto       out    = std::vector<units::nullable<units::kilometres>>(values.size());
+
+		units::bulk::cast(values.data(), values.data() + values.size(), out.data());
+
+		EXPECT_FALSE(out[0].has_value());
+		EXPECT_DOUBLE_EQ(0.002, out[2].value().count());
+	}
+
+	TEST_F(NullableTest, Cast_WhenRepsAreIntegral_WillMatchUnitCast)
+	{
+		using kilometres_i = units::distance<int, std::kilo>;
+		using metres_i     = units::distance<int>;
+
+		auto const values = std::vector<units::nullable<metres_i>>{metres_i{5000}, {}, metres_i{-2600}};
+		auto       out    = std::vector<units::nullable<kilometres_i>>(values.size());
+
+		units::bulk::cast(values.data(), values.data() + values.size(), out.data());
+
+		EXPECT_EQ(units::unit_cast<kilometres_i>(metres_i{5000}), out[0].value());
+		EXPECT_FALSE(out[1].has_value());
+		EXPECT_EQ(units::unit_cast<kilometres_i>(metres_i{-2600}), out[2].value());
+	}
+
+	TEST_F(NullableTest, Cast_WhenFloatingToIntegral_WillKeepNulls)
+	{
+		using millimetres_i = units::distance<int, std::milli>;
+
+		auto const values = std::vector<units::nullable<units::metres>>{units::metres{1.25}, {}, units::metres{-0.5}};
+		auto       out    = std::vector<units::nullable<millimetres_i>>(values.size());
+
+		units::bulk::cast(values.data(), values.data() + values.size(), out.data());
+
+		EXPECT_EQ(1250, out[0].value().count());
+		EXPECT_FALSE(out[1].has_value());
+		EXPECT_EQ(-500, out[2].value().count());
+	}
+
+	TEST_F(NullableTest, Cast_WhenValueConvertsToNull_WillThrow)
+	{
+		using metres_i = units::distance<int>;
+
+		auto const values = std::vector<units::nullable<units::metres>>{units::metres{-2147483648.0}};
+		auto       out    = std::vector<units::nullable<metres_i>>(values.size());
+
+		EXPECT_THROW(units::bulk::cast(values.data(), values.data() + values.size(), out.data()), std::domain_error);
+	}
+
+	TEST_F(NullableTest, BitmapColumn_WillMatchSentinel)
+	{
+		auto const values = column(203);
+
+		auto bitmap = units::bitmap_column<units::metres>{};
+		for (auto v : values)
+		{
+			bitmap.push_back(v);
+		}
+		auto const first = bitmap.data();
+		auto const last  = bitmap.data() + bitmap.size();
+
+		EXPECT_TRUE(bitmap.is_null(0));
+		EXPECT_FALSE(bitmap.is_null(1));
+		EXPECT_TRUE(bitmap[3] == values[3]);
+		EXPECT_EQ(units::bulk::count_valid(values.data(), values.data() + values.size()),
+		          units::bulk::count_valid(first, last, bitmap.validity()));
+		EXPECT_DOUBLE_EQ(units::bulk::sum(values.data(), values.data() + values.size()).count(),
+		                 units::bulk::sum(first, last, bitmap.validity()).count());
+		EXPECT_DOUBLE_EQ(1.0, units::bulk::min(first, last, bitmap.validity()).value().count());
+		EXPECT_DOUBLE_EQ(202.0, units::bulk::max(first, last, bitmap.validity()).value().count());
+		EXPECT_EQ(7u, units::bulk::count_between(first, last, bitmap.validity(), 10_m, 20_m));
+		EXPECT_EQ(6u, units::bulk::count_less(first, last, bitmap.validity(), 10_m));
+	}
+
+	TEST_F(NullableTest, Bitmap_WhenConverted_WillRoundTrip)
+	{
+		auto const values   = column(70);
+		auto       plain    = std::vector<units::metres>(values.size(), 0_m);
+		auto       validity = std::vector<std::uint64_t>(units::bitmap_column<units::metres>::words(values.size()));
+		auto       back     = std::vector<nullable_metres>(values.size());
+
+		units::bulk::to_bitmap(values.data(), values.data() + values.size(), plain.data(), validity.data());
+		units::bulk::from_bitmap(plain.data(), plain.data() + plain.size(), validity.data(), back.data());
+
+		EXPECT_EQ(values, back);
+	}
+
+	TEST_F(NullableTest, Kernels_WhenEveryTier_WillAgree)
+	{
+		auto const values = column(1001);
+		auto const in     = reinterpret_cast<double const*>(values.data());
+
+		auto const& scalar = units::bulk::nullable_kernels_for(units::cpu::tier::scalar).f64;
+		std::size_t count  = 0;
+		auto const  sum    = scalar.sum(in, values.size(), &count);
+
+		for (auto tier : {units::cpu::tier::sse42, units::cpu::tier::avx2, units::cpu::tier::avx512})
+		{
+			auto const& kernels = units::bulk::nullable_kernels_for(tier).f64;
+			std::size_t tier_count = 0;
+			EXPECT_DOUBLE_EQ(sum, kernels.sum(in, values.size(), &tier_count));
+			EXPECT_EQ(count, tier_count);
+			EXPECT_EQ(scalar.count_between(in, values.size(), 100.0, 200.0),
+			          kernels.count_between(in, values.size(), 100.0, 200.0));
+			EXPECT_EQ(scalar.min(in, values.size()), kernels.min(in, values.size()));
+		}
+	}
+}
@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ratio>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/overflow.h"
+
+using testing::Test;
+
+namespace TestOverflow
+{
+	using sat16 = units::saturating<std::int16_t>;
+	using sat32 = units::saturating<std::int32_t>;
+	using sat64 = units::saturating<std::int64_t>;
+	using chk32 = units::checked<std::int32_t>;
+
+	using millimetres = units::unit<sat32, std::milli, units::unit_type::distance>;
+	using metres      = units::unit<sat32, std::ratio<1>, units::unit_type::distance>;
+	using checked_mm  = units::unit<chk32, std::milli, units::unit_type::distance>;
+
+	constexpr auto max32 = std::numeric_limits<std::int32_t>::max();
+	constexpr auto min32 = std::numeric_limits<std::int32_t>::lowest();
+
+	class OverflowTest : public Test
+	{
+	protected:
+		std::vector<units::cpu::tier> const tiers{units::cpu::tier::scalar,
+		                                          units::cpu::tier::sse42,
+		                                          units::cpu::tier::avx2,
+		                                          units::cpu::tier::avx512};
+
+		// Edge values mixed with random ones
+		template <typename T>
+		std::vector<T> values(std::size_t count, std::uint64_t seed) const
+		{
+			auto engine       = std::mt19937_64{seed};
+			auto distribution = std::uniform_int_distribution<T>{std::numeric_limits<T>::lowest(),
+			                                                     std::numeric_limits<T>::max()};
+			auto result       = std::vector<T>{std::numeric_limits<T>::lowest(),
+                                         std::numeric_limits<T>::max(),
+                                         -1,
+                                         0,
+                                         1,
+                                         static_cast<T>(std::numeric_limits<T>::max() / 2 + 1)};
+			while (result.size() < count)
+			{
+				result.push_back(distribution(engine));
+			}
+			return result;
+		}
+	};
+
+	TEST_F(OverflowTest, Saturating_WhenArithmeticOverflows_WillClampToTheRange)
+	{
+		EXPECT_EQ(max32, sat32{max32} + 1);
+		EXPECT_EQ(min32, sat32{min32} - 1);
+		EXPECT_EQ(min32, sat32{-2} * (max32 / 2 + 2));
+		EXPECT_EQ(max32, sat32{min32} / -1);
+		EXPECT_EQ(max32, -sat32{min32});
+		EXPECT_EQ(0, sat32{min32} % -1);
+		EXPECT_EQ(32767, sat16{32000} + sat16{1000});
+		EXPECT_EQ(-32768, --sat16{-32768});
+		EXPECT_EQ(std::numeric_limits<std::int64_t>::max(), sat64{1ll << 40} * (1ll << 40));
+		EXPECT_EQ(std::numeric_limits<std::int64_t>::lowest(), sat64{-(1ll << 40)} * (1ll << 40));
+		EXPECT_EQ(-(1ll << 62), sat64{-(1ll << 31)} * (1ll << 31));
+	}
+
+	TEST_F(OverflowTest, Saturating_WhenArithmeticFits_WillMatchBuiltInIntegers)
+	{
+		auto const lhs = values<std::int32_t>(200, 1);
+		auto const rhs = values<std::int32_t>(200, 2);
+		for (std::size_t i = 0; i < lhs.size(); ++i)
+		{
+			auto const a = static_cast<std::int64_t>(lhs[i]);
+			auto const b = static_cast<std::int64_t>(rhs[i]);
+			auto const clamp = [](std::int64_t value) {
+				return value < min32 ? min32 : value > max32 ? max32 : static_cast<std::int32_t>(value);
+			};
+
+			EXPECT_EQ(clamp(a + b), (sat32{lhs[i]} + sat32{rhs[i]}).value);
+			EXPECT_EQ(clamp(a - b), (sat32{lhs[i]} - sat32{rhs[i]}).value);
+			EXPECT_EQ(clamp(a * b), (sat32{lhs[i]} * sat32{rhs[i]}).value);
+			if (b != 0)
+			{
+				EXPECT_EQ(clamp(a / b), (sat32{lhs[i]} / sat32{rhs[i]}).value);
+			}
+		}
+	}
+
+	TEST_F(OverflowTest, Checked_WhenArithmeticOverflows_WillThrow)
+	{
+		EXPECT_THROW(chk32{max32} + 1, std::overflow_error);
+		EXPECT_THROW(chk32{min32} - 1, std::overflow_error);
+		EXPECT_THROW(chk32{1 << 16} * (1 << 16), std::overflow_error);
+		EXPECT_THROW(chk32{min32} / -1, std::overflow_error);
+		EXPECT_THROW(chk32{std::int64_t{1} << 40}, std::overflow_error);
+		EXPECT_THROW(chk32{std::numeric_limits<double>::quiet_NaN()}, std::overflow_error);
+		EXPECT_THROW(chk32{1} / 0, std::domain_error);
+		EXPECT_THROW(sat32{1} / 0, std::domain_error);
+
+		EXPECT_EQ(max32, chk32{max32 - 1} + 1);
+		EXPECT_EQ(-6, chk32{-2} * 3);
+	}
+
+	TEST_F(OverflowTest, Conversion_WhenValueIsOutOfRange_WillSaturate)
+	{
+		EXPECT_EQ(max32, sat32{std::int64_t{1} << 40});
+		EXPECT_EQ(min32, sat32{-(std::int64_t{1} << 40)});
+		EXPECT_EQ(max32, sat32{std::numeric_limits<std::uint64_t>::max()});
+		EXPECT_EQ(max32, sat32{1e300});
+		EXPECT_EQ(min32, sat32{-std::numeric_limits<double>::infinity()});
+		EXPECT_EQ(0, sat32{std::numeric_limits<double>::quiet_NaN()});
+		EXPECT_EQ(-2, sat32{-2.9});
+		EXPECT_EQ(max32, sat32{2147483647.5});
+		EXPECT_EQ(min32, sat32{-2147483648.5});
+		EXPECT_EQ(32767, sat16{sat32{40000}});
+		EXPECT_EQ(2.5, sat32{5} / 2.0);
+		EXPECT_EQ(7, static_cast<int>(sat32{7}));
+	}
+
+	TEST_F(OverflowTest, Units_WhenOperationsOverflow_WillSaturate)
+	{
+		auto distance = millimetres{sat32{2000000000}};
+		distance += millimetres{sat32{2000000000}};
+		EXPECT_EQ(max32, distance.count());
+
+		distance -= millimetres{sat32{max32}};
+		EXPECT_EQ(0, distance.count());
+
+		EXPECT_EQ(max32, units::unit_cast<millimetres>(metres{sat32{3000000}}).count());
+		EXPECT_EQ(-3000000, units::unit_cast<millimetres>(metres{sat32{-3000}}).count());
+		EXPECT_EQ(3, units::unit_cast<metres>(millimetres{sat32{3999}}).count());
+		EXPECT_EQ(min32, (millimetres{sat32{-2000000000}} * 2).count());
+		EXPECT_EQ(max32, (-millimetres{sat32{min32}}).count());
+		EXPECT_EQ(max32, (metres{sat32{3000000}} + millimetres{sat32{1}}).count());
+		EXPECT_TRUE(metres{sat32{3}} == millimetres{sat32{3000}});
+		EXPECT_TRUE(metres{sat32{3}} < millimetres{sat32{3001}});
+		EXPECT_DOUBLE_EQ(2.5, units::unit_cast<units::metres>(millimetres{sat32{2500}}).count());
+		EXPECT_EQ(max32, units::unit_cast<millimetres>(units::kilometres{1e9}).count());
+
+		static_assert(std::is_same<decltype(millimetres{sat32{1}} + metres{sat32{1}}), millimetres>::value,
+		              "Saturating units keep their rep");
+
+		EXPECT_THROW(checked_mm{chk32{max32}} += checked_mm{chk32{1}}, std::overflow_error);
+		using checked_km = units::unit<chk32, std::kilo, units::unit_type::distance>;
+		EXPECT_THROW(units::unit_cast<checked_mm>(checked_km{chk32{5000}}), std::overflow_error);
+
+		auto stream = std::ostringstream{};
+		stream << millimetres{sat32{-12}} << ' ' << units::saturating<std::int8_t>{65};
+		EXPECT_EQ("-12mm 65", stream.str());
+	}
+
+	TEST_F(OverflowTest, Kernels_WhenRunOnEveryTier_WillMatchTheScalarOperations)
+	{
+		auto const lhs16 = values<std::int16_t>(1003, 3);
+		auto const rhs16 = values<std::int16_t>(1003, 4);
+		auto const lhs32 = values<std::int32_t>(1003, 5);
+		auto const rhs32 = values<std::int32_t>(1003, 6);
+
+		for (auto tier : tiers)
+		{
+			auto const& kernels = units::bulk::overflow_kernels_for(tier);
+			auto        out16   = std::vector<std::int16_t>(lhs16.size());
+			auto        out32   = std::vector<std::int32_t>(lhs32.size());
+
+			EXPECT_TRUE(kernels.i16.add(lhs16.data(), rhs16.data(), lhs16.size(), out16.data()));
+			for (std::size_t i = 0; i < lhs16.size(); ++i)
+			{
+				EXPECT_EQ((sat16{lhs16[i]} + sat16{rhs16[i]}).value, out16[i]) << units::cpu::name(kernels.tier);
+			}
+
+			EXPECT_TRUE(kernels.i32.subtract(lhs32.data(), rhs32.data(), lhs32.size(), out32.data()));
+			for (std::size_t i = 0; i < lhs32.size(); ++i)
+			{
+				EXPECT_EQ((sat32{lhs32[i]} - sat32{rhs32[i]}).value, out32[i]) << units::cpu::name(kernels.tier);
+			}
+
+			for (auto factor : {min32, -3, -1, 0, 1, 2, 7919, max32})
+			{
+				auto const overflowed = kernels.i32.scale(lhs32.data(), lhs32.size(), factor, out32.data());
+				EXPECT_EQ(factor != 0 && factor != 1, overflowed);
+				for (std::size_t i = 0; i < lhs32.size(); ++i)
+				{
+					EXPECT_EQ((sat32{lhs32[i]} * factor).value, out32[i]) << units::cpu::name(kernels.tier) << factor;
+				}
+
+				auto const factor16 = sat16{factor}.value;
+				kernels.i16.scale(lhs16.data(), lhs16.size(), factor16, out16.data());
+				for (std::size_t i = 0; i < lhs16.size(); ++i)
+				{
+					EXPECT_EQ((sat16{lhs16[i]} * factor16).value, out16[i]) << units::cpu::name(kernels.tier) << factor;
+				}
+			}
+
+			EXPECT_FALSE(kernels.i16.add(lhs16.data() + 2, lhs16.data() + 3, 3, out16.data()));
+			EXPECT_FALSE(kernels.i32.scale(lhs32.data() + 2, 3, 1000, out32.data()));
+
+			std::int64_t expected = 0;
+			for (auto value : lhs32)
+			{
+				expected += value;
+			}
+			std::int32_t total = 0;
+			EXPECT_EQ(expected > max32, kernels.i32.sum(lhs32.data(), lhs32.size(), &total));
+			EXPECT_EQ((sat32{expected}).value, total);
+
+			std::int16_t small_total = 0;
+			EXPECT_FALSE(kernels.i16.sum(lhs16.data() + 2, 4, &small_total));
+			EXPECT_EQ(lhs16[5], small_total);
+		}
+	}
+
+	TEST_F(OverflowTest, Bulk_WhenRangesOverflow_WillSaturateAndReportOnce)
+	{
+		std::vector<millimetres> lhs(100, millimetres{sat32{2000000000}});
+		std::vector<millimetres> rhs(100, millimetres{sat32{-1}});
+		std::vector<millimetres> out(100, millimetres{sat32{0}});
+
+		EXPECT_FALSE(units::bulk::add(lhs.data(), lhs.data() + lhs.size(), rhs.data(), out.data()));
+		EXPECT_EQ(1999999999, out[99].count());
+
+		rhs[50] = millimetres{sat32{max32}};
+		EXPECT_TRUE(units::bulk::add(lhs.data(), lhs.data() + lhs.size(), rhs.data(), out.data()));
+		EXPECT_EQ(max32, out[50].count());
+		EXPECT_EQ(1999999999, out[51].count());
+
+		rhs[60] = millimetres{sat32{min32}};
+		EXPECT_TRUE(units::bulk::subtract(lhs.data(), lhs.data() + lhs.size(), rhs.data(), out.data()));
+		EXPECT_EQ(2000000001, out[0].count());
+		EXPECT_EQ(max32, out[60].count());
+
+		EXPECT_TRUE(units::bulk::scale(lhs.data(), lhs.data() + lhs.size(), 2, out.data()));
+		EXPECT_EQ(max32, out[0].count());
+
+		auto overflowed = false;
+		EXPECT_EQ(max32, units::bulk::sum(lhs.data(), lhs.data() + lhs.size(), overflowed).count());
+		EXPECT_TRUE(overflowed);
+
+		EXPECT_EQ(-50, units::bulk::sum(rhs.data(), rhs.data() + 50, overflowed).count());
+		EXPECT_TRUE(overflowed);
+	}
+
+	TEST_F(OverflowTest, Sum_WhenPartialSumsOverflowButTheTotalFits_WillNotReport)
+	{
+		std::vector<millimetres> values(64, millimetres{sat32{max32}});
+		values.push_back(millimetres{sat32{-5}});
+		for (int i = 0; i < 64; ++i)
+		{
+			values.push_back(millimetres{sat32{-max32}});
+		}
+
+		auto overflowed = false;
+		EXPECT_EQ(-5, units::bulk::sum(values.data(), values.data() + values.size(), overflowed).count());
+		EXPECT_FALSE(overflowed);
+
+		using wide = units::unit<sat64, std::milli, units::unit_type::distance>;
+		std::vector<wide> wides{wide{sat64{std::numeric_limits<std::int64_t>::max()}},
+		                        wide{sat64{10}},
+		                        wide{sat64{-20}}};
+		EXPECT_EQ(std::numeric_limits<std::int64_t>::max() - 10,
+		          units::bulk::sum(wides.data(), wides.data() + wides.size(), overflowed).count());
+		EXPECT_FALSE(overflowed);
+
+		wides.push_back(wide{sat64{std::numeric_limits<std::int64_t>::max()}});
+		EXPECT_EQ(std::numeric_limits<std::int64_t>::max(),
+		          units::bulk::sum(wides.data(), wides.data() + wides.size(), overflowed).count());
+		EXPECT_TRUE(overflowed);
+	}
+
+	TEST_F(OverflowTest, Bulk_WhenCheckedRangesOverflow_WillThrowAfterTheRange)
+	{
+		std::vector<checked_mm> lhs(20, checked_mm{chk32{max32 - 1}});
+		std::vector<checked_mm> rhs(20, checked_mm{chk32{1}});
+		std::vector<checked_mm> out(20, checked_mm{chk32{0}});
+
+		EXPECT_FALSE(units::bulk::add(lhs.data(), lhs.data() + lhs.size(), rhs.data(), out.data()));
+		EXPECT_EQ(max32, out[19].count());
+
+		rhs[3] = checked_mm{chk32{2}};
+		EXPECT_THROW(units::bulk::add(lhs.data(), lhs.data() + lhs.size(), rhs.data(), out.data()),
+		             std::overflow_error);
+		EXPECT_EQ(max32, out[19].count());
+		EXPECT_THROW(units::bulk::sum(lhs.data(), lhs.data() + lhs.size()), std::overflow_error);
+
+		using small = units::unit<units::checked<std::int8_t>, std::milli, units::unit_type::distance>;
+		std::vector<small> smalls(3, small{units::checked<std::int8_t>{100}});
+		EXPECT_THROW(units::bulk::scale(smalls.data(), smalls.data() + smalls.size(), 2, smalls.data()),
+		             std::overflow_error);
+	}
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ratio>
+#include <vector>
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+#include "units/quantized.h"
+
+using testing::Test;
+
+namespace TestQuantized
+{
+	using centimetres16 = units::unit<std::int16_t, std::centi, units::unit_type::distance>;
+	using millimetres32 = units::unit<std::int32_t, std::milli, units::unit_type::distance>;
+
+	class QuantizedTest : public Test
+	{
+	protected:
+		std::vector<units::cpu::tier> const tiers{units::cpu::tier::scalar,
+		                                          units::cpu::tier::sse42,
+		                                          units::cpu::tier::avx2,
+		                                          units::cpu::tier::avx512};
+	};
+
+	TEST_F(QuantizedTest, Encode_WhenValuesAreInRange_WillRoundToNearestEven)
+	{
+		std::vector<units::metres> const in{units::metres{0.125},
+		                                    units::metres{0.375},
+		                                    units::metres{-1.5},
+		                                    units::metres{327.67},
+		                                    units::metres{-327.68}};
+		std::vector<centimetres16>       out(in.size(), centimetres16{0});
+
+		auto const report = units::bulk::encode(in.data(), in.data() + in.size(), out.data());
+
+		EXPECT_TRUE(report.exact_range());
+		EXPECT_EQ(12, out[0].count());
+		EXPECT_EQ(38, out[1].count());
+		EXPECT_EQ(-150, out[2].count());
+		EXPECT_EQ(32767, out[3].count());
+		EXPECT_EQ(-32768, out[4].count());
+	}
+
+	TEST_F(QuantizedTest, Encode_WhenValuesAreOutOfRange_WillClampAndCount)
+	{
+		auto const nan = std::numeric_limits<double>::quiet_NaN();
+		auto const inf = std::numeric_limits<double>::infinity();
+
+		std::vector<units::metres> const in{units::metres{400},
+		                                    units::metres{-400},
+		                                    units::metres{nan},
+		                                    units::metres{inf},
+		                                    units::metres{-inf},
+		                                    units::metres{327.674},
+		                                    units::metres{327.675},
+		                                    units::metres{1}};
+		std::vector<centimetres16>       out(in.size(), centimetres16{1});
+
+		auto const report = units::bulk::encode(in.data(), in.data() + in.size(), out.data());
+
+		EXPECT_EQ(2u, report.below);
+		EXPECT_EQ(3u, report.above);
+		EXPECT_EQ(1u, report.invalid);
+		EXPECT_EQ(5u, report.clamped());
+		EXPECT_FALSE(report.exact_range());
+
+		EXPECT_EQ(32767, out[0].count());
+		EXPECT_EQ(-32768, out[1].count());
+		EXPECT_EQ(0, out[2].count());
+		EXPECT_EQ(32767, out[3].count());
+		EXPECT_EQ(-32768, out[4].count());
+		EXPECT_EQ(32767, out[5].count());
+		EXPECT_EQ(32767, out[6].count());
+		EXPECT_EQ(100, out[7].count());
+	}
+
+	TEST_F(QuantizedTest, Encode_WhenRunOnEveryTier_WillGiveIdenticalResults)
+	{
+		auto engine       = std::mt19937_64{7};
+		auto distribution = std::uniform_real_distribution<double>{-3e6, 3e6};
+
+		std::vector<double> in;
+		for (int i = 0; i < 1003; ++i)
+		{
+			in.push_back(distribution(engine));
+		}
+		in[10] = std::numeric_limits<double>::quiet_NaN();
+		in[20] = 2147483647.5;
+		in[30] = -2147483648.5;
+
+		auto const& reference          = units::bulk::quantized_kernels_for(units::cpu::tier::scalar);
+		auto        expected16         = std::vector<std::int16_t>(in.size());
+		auto        expected32         = std::vector<std::int32_t>(in.size());
+		auto const  expected16_report  = reference.i16.encode(in.data(), in.size(), 0.01, expected16.data());
+		auto const  expected32_report  = reference.i32.encode(in.data(), in.size(), 1000.0, expected32.data());
+
+		for (auto tier : tiers)
+		{
+			auto const& kernels = units::bulk::quantized_kernels_for(tier);
+			auto        out16   = std::vector<std::int16_t>(in.size());
+			auto        out32   = std::vector<std::int32_t>(in.size());
+			auto const  report16 = kernels.i16.encode(in.data(), in.size(), 0.01, out16.data());
+			auto const  report32 = kernels.i32.encode(in.data(), in.size(), 1000.0, out32.data());
+
+			EXPECT_EQ(expected16, out16) << units::cpu::name(kernels.tier);
+			EXPECT_EQ(expected32, out32) << units::cpu::name(kernels.tier);
+			EXPECT_EQ(expected16_report.below, report16.below);
+			EXPECT_EQ(expected16_report.above, report16.above);
+			EXPECT_EQ(expected32_report.below, report32.below);
+			EXPECT_EQ(expected32_report.above, report32.above);
+			EXPECT_EQ(1u, report32.invalid);
+		}
+
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			if (!std::isnan(in[i]))
+			{
+				auto const clamped = std::min(std::max(std::nearbyint(in[i] * 0.01), -32768.0), 32767.0);
+				EXPECT_EQ(static_cast<std::int16_t>(clamped), expected16[i]) << in[i];
+			}
+		}
+	}
+
+	TEST_F(QuantizedTest, Decode_WhenGivenIntegerUnits_WillMatchUnitCast)
+	{
+		std::vector<millimetres32> const in{millimetres32{0},
+		                                    millimetres32{1},
+		                                    millimetres32{-2500},
+		                                    millimetres32{123456789},
+		                                    millimetres32{std::numeric_limits<std::int32_t>::lowest()}};
+		std::vector<units::kilometres>   out(in.size(), units::kilometres{0});
+
+		auto const end = units::bulk::decode(in.data(), in.data() + in.size(), out.data());
+
+		EXPECT_EQ(out.data() + out.size(), end);
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			EXPECT_DOUBLE_EQ(units::unit_cast<units::kilometres>(in[i]).count(), out[i].count());
+		}
+	}
+
+	TEST_F(QuantizedTest, Decode_WhenRunOnEveryTier_WillGiveIdenticalResults)
+	{
+		auto in16 = std::vector<std::int16_t>{};
+		auto in32 = std::vector<std::int32_t>{};
+		for (int i = -40000; i < 40000; i += 37)
+		{
+			in16.push_back(static_cast<std::int16_t>(i));
+			in32.push_back(i * 50000);
+		}
+
+		for (auto tier : tiers)
+		{
+			auto const& kernels = units::bulk::quantized_kernels_for(tier);
+			auto        out16   = std::vector<double>(in16.size());
+			auto        out32   = std::vector<double>(in32.size());
+			kernels.i16.decode(in16.data(), in16.size(), 0.01, out16.data());
+			kernels.i32.decode(in32.data(), in32.size(), 1e-6, out32.data());
+
+			for (std::size_t i = 0; i < in16.size(); ++i)
+			{
+				EXPECT_EQ(in16[i] * 0.01, out16[i]);
+				EXPECT_EQ(in32[i] * 1e-6, out32[i]);
+			}
+		}
+	}
+
+	TEST_F(QuantizedTest, RoundTrip_WhenValuesAreInRange_WillBeWithinHalfAQuantum)
+	{
+		auto engine       = std::mt19937_64{11};
+		auto distribution = std::uniform_real_distribution<double>{-0.3, 0.3};
+
+		std::vector<units::kilometres> in;
+		for (int i = 0; i < 1000; ++i)
+		{
+			in.emplace_back(distribution(engine));
+		}
+		std::vector<centimetres16>     encoded(in.size(), centimetres16{0});
+		std::vector<units::kilometres> decoded(in.size(), units::kilometres{0});
+
+		EXPECT_TRUE(units::bulk::encode(in.data(), in.data() + in.size(), encoded.data()).exact_range());
+		units::bulk::decode(encoded.data(), encoded.data() + encoded.size(), decoded.data());
+
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			EXPECT_LE(std::abs(in[i].count() - decoded[i].count()), 0.5e-5 + 1e-15);
+		}
+	}
+
+	TEST_F(QuantizedTest, Encode_WhenRepsAreNotDispatched_WillUseTheSameRules)
+	{
+		using metres_f     = units::unit<float, std::ratio<1>, units::unit_type::distance>;
+		using decimetres8  = units::unit<std::int8_t, std::deci, units::unit_type::distance>;
+		using centimetresu = units::unit<std::uint16_t, std::centi, units::unit_type::distance>;
+
+		std::vector<metres_f> const in{metres_f{1.25f}, metres_f{-20.0f}, metres_f{700.0f}};
+		std::vector<decimetres8>    small(in.size(), decimetres8{0});
+		std::vector<centimetresu>   unsigned_out(in.size(), centimetresu{0});
+
+		auto const report = units::bulk::encode(in.data(), in.data() + in.size(), small.data());
+		EXPECT_EQ(12, small[0].count());
+		EXPECT_EQ(-128, small[1].count());
+		EXPECT_EQ(127, small[2].count());
+		EXPECT_EQ(1u, report.below);
+		EXPECT_EQ(1u, report.above);
+
+		auto const unsigned_report = units::bulk::encode(in.data(), in.data() + in.size(), unsigned_out.data());
+		EXPECT_EQ(125, unsigned_out[0].count());
+		EXPECT_EQ(0, unsigned_out[1].count());
+		EXPECT_EQ(65535, unsigned_out[2].count());
+		EXPECT_EQ(1u, unsigned_report.below);
+		EXPECT_EQ(1u, unsigned_report.above);
+
+		std::vector<metres_f> back(in.size(), metres_f{0});
+		units::bulk::decode(small.data(), small.data() + small.size(), back.data());
+		EXPECT_FLOAT_EQ(1.2f, back[0].count());
+		EXPECT_FLOAT_EQ(-12.8f, back[1].count());
+	}
+
+	TEST_F(QuantizedTest, PickQuantum_WhenGivenARange_WillChooseTheFinestThatFits)
+	{
+		std::vector<units::metres> in{units::metres{-12}, units::metres{30}, units::metres{0.5}};
+
+		auto const pick = [&] {
+			return units::bulk::pick_quantum<std::int16_t, std::ratio<1>, std::deci, std::milli, std::centi>(
+			    in.data(), in.data() + in.size());
+		};
+
+		EXPECT_EQ(2u, pick());
+
+		in[1] = units::metres{40};
+		EXPECT_EQ(3u, pick());
+
+		in[1] = units::metres{3000};
+		EXPECT_EQ(1u, pick());
+
+		in[1] = units::metres{4000};
+		EXPECT_EQ(0u, pick());
+
+		in[1] = units::metres{40000};
+		EXPECT_EQ(4u, pick());
+
+		in[1] = units::metres{std::numeric_limits<double>::quiet_NaN()};
+		EXPECT_EQ(2u, pick());
+
+		EXPECT_EQ(2u,
+		          (units::bulk::pick_quantum<std::int16_t, std::ratio<1>, std::deci, std::milli, std::centi>(
+		              in.data(), in.data())));
+	}
+
+	TEST_F(QuantizedTest, Report_WhenAccumulated_WillAddEveryCounter)
+	{
+		units::bulk::quantize_report total;
+		units::bulk::quantize_report part;
+		part.below   = 1;
+		part.above   = 2;
+		part.invalid = 3;
+
+		total += part;
+		total += part;
+
+		EXPECT_EQ(2u, total.below);
+		EXPECT_EQ(4u, total.above);
+		EXPECT_EQ(6u, total.invalid);
+		EXPECT_EQ(6u, total.clamped());
+	}
+}
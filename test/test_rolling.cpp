@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "units.h"
+#include "units/rolling.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+using namespace mass_literals;
+using namespace std::chrono_literals;
+
+namespace TestRolling
+{
+	class RollingTest : public Test
+	{
+	protected:
+		using clock = std::chrono::steady_clock;
+
+		static clock::time_point at(std::chrono::milliseconds offset) { return clock::time_point{} + offset; }
+	};
+
+	TEST_F(RollingTest, Aggregates_WhenStreamed_WillMatchRecomputing)
+	{
+		auto window = units::rolling_window<units::metres>{2s};
+
+		std::mt19937                           engine{17};
+		std::uniform_real_distribution<double> values{-500.0, 500.0};
+		std::uniform_int_distribution<int>     gaps{0, 300};
+
+		auto times  = std::vector<std::chrono::milliseconds>{};
+		auto stream = std::vector<double>{};
+		auto now    = std::chrono::milliseconds{0};
+		for (int i = 0; i < 5000; ++i)
+		{
+			now += std::chrono::milliseconds{gaps(engine)};
+			times.push_back(now);
+			stream.push_back(values(engine));
+			window.push(at(now), units::metres{stream.back()});
+
+			double      sum   = 0;
+			double      lo    = std::numeric_limits<double>::infinity();
+			double      hi    = -lo;
+			std::size_t count = 0;
+			for (std::size_t j = 0; j < times.size(); ++j)
+			{
+				if (times[j] > now - 2s)
+				{
+					sum += stream[j];
+					lo = std::min(lo, stream[j]);
+					hi = std::max(hi, stream[j]);
+					++count;
+				}
+			}
+
+			ASSERT_EQ(count, window.size());
+			ASSERT_NEAR(sum, window.sum().count(), 1e-9);
+			ASSERT_NEAR(sum / count, window.mean().count(), 1e-9);
+			ASSERT_EQ(lo, window.min().count());
+			ASSERT_EQ(hi, window.max().count());
+		}
+	}
+
+	TEST_F(RollingTest, Push_WhenGivenOtherRatios_WillConvertThem)
+	{
+		auto window = units::rolling_window<units::kilograms>{1min};
+		window.push(at(0ms), 2_kg);
+		window.push(at(10ms), 500_g);
+		window.push(at(20ms), 1500_g);
+
+		EXPECT_DOUBLE_EQ(4.0, window.sum().count());
+		EXPECT_DOUBLE_EQ(0.5, window.min().count());
+		EXPECT_DOUBLE_EQ(2.0, window.max().count());
+		EXPECT_EQ(std::chrono::duration_cast<std::chrono::steady_clock::duration>(1min), window.width());
+	}
+
+	TEST_F(RollingTest, Expire_WhenTimeMovesOn_WillDropOldSamples)
+	{
+		auto window = units::rolling_window<units::metres>{1s};
+		window.push(at(0ms), 3_m);
+		window.push(at(400ms), 1_km);
+		window.push(at(800ms), 2_m);
+
+		window.expire(at(1000ms));
+		EXPECT_EQ(2u, window.size());
+		EXPECT_DOUBLE_EQ(1000.0, window.max().count());
+
+		window.expire(at(1400ms));
+		EXPECT_EQ(1u, window.size());
+		EXPECT_DOUBLE_EQ(2.0, window.max().count());
+		EXPECT_DOUBLE_EQ(2.0, window.min().count());
+
+		window.expire(at(5000ms));
+		EXPECT_TRUE(window.empty());
+		EXPECT_DOUBLE_EQ(0.0, window.sum().count());
+		EXPECT_THROW(window.mean(), std::domain_error);
+		EXPECT_THROW(window.max(), std::domain_error);
+	}
+
+	TEST_F(RollingTest, Sum_WhenRepIsIntegral_WillStayExact)
+	{
+		using millimetres32 = units::unit<std::int32_t, std::milli, units::unit_type::distance>;
+
+		auto window = units::rolling_window<millimetres32>{100ms};
+		for (int i = 0; i < 1000; ++i)
+		{
+			window.push(at(std::chrono::milliseconds{i}), 1_m);
+		}
+
+		EXPECT_EQ(100u, window.size());
+		EXPECT_EQ(100000, window.sum().count());
+		EXPECT_EQ(1000, window.mean().count());
+	}
+
+	TEST_F(RollingTest, Capacity_WhenSteady_WillStopGrowing)
+	{
+		auto window = units::rolling_window<units::metres>{1s, 4};
+		for (int i = 0; i < 100; ++i)
+		{
+			window.push(at(std::chrono::milliseconds{i * 10}), units::metres{static_cast<double>(i)});
+		}
+		auto const capacity = window.capacity();
+		EXPECT_GE(capacity, window.size());
+
+		for (int i = 100; i < 10000; ++i)
+		{
+			window.push(at(std::chrono::milliseconds{i * 10}), units::metres{static_cast<double>(i % 37)});
+		}
+		EXPECT_EQ(capacity, window.capacity());
+	}
+
+	TEST_F(RollingTest, Push_WhenInvalid_WillThrow)
+	{
+		auto window = units::rolling_window<units::metres>{1s};
+		window.push(at(500ms), 1_m);
+
+		EXPECT_THROW(window.push(at(499ms), 1_m), std::invalid_argument);
+		EXPECT_THROW(window.push(at(600ms), units::metres{std::numeric_limits<double>::quiet_NaN()}),
+		             std::domain_error);
+		EXPECT_EQ(1u, window.size());
+		EXPECT_THROW((units::rolling_window<units::metres>{0s}), std::invalid_argument);
+	}
+}
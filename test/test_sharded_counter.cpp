@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "units.h"
+#include "units/sharded_counter.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestShardedCounter
+{
+	class ShardedCounterTest : public Test
+	{
+	};
+
+	TEST_F(ShardedCounterTest, Load_WhenNothingAdded_WillBeZero)
+	{
+		units::sharded_counter<units::metres> counter;
+		EXPECT_EQ(0_m, counter.load());
+	}
+
+	TEST_F(ShardedCounterTest, Add_WhenGivenDifferentRatio_WillReadBackInDeclaredUnit)
+	{
+		units::sharded_counter<units::metres> counter;
+
+		counter += 1_km;
+		counter += 50_cm;
+		counter -= 1_m;
+
+		auto result = counter.load();
+		EXPECT_TRUE(typeid(result) == typeid(units::metres));
+		EXPECT_EQ(units::metres{999.5}, result);
+	}
+
+	TEST_F(ShardedCounterTest, Constructor_WhenShardCountIsNotPowerOfTwo_WillThrow)
+	{
+		EXPECT_THROW(units::sharded_counter<units::metres>{3}, std::invalid_argument);
+	}
+
+	TEST_F(ShardedCounterTest, Add_WhenCalledFromManyThreads_WillSumEveryShard)
+	{
+		units::sharded_counter<units::distance<long long, std::milli>> counter{4};
+
+		auto threads = std::vector<std::thread>{};
+		for (int t = 0; t < 8; ++t)
+		{
+			threads.emplace_back([&] {
+				for (int i = 0; i < 10000; ++i)
+				{
+					counter.add(units::distance<long long>{1});
+				}
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		EXPECT_EQ(80000000, counter.load().count());
+
+		counter.reset();
+		EXPECT_EQ(0, counter.load().count());
+	}
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "units.h"
+#include "units/spatial.h"
+#include "units/vec3.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestSpatial
+{
+	class SpatialTest : public Test
+	{
+	protected:
+		using point = units::vec3<units::metres>;
+
+		SpatialTest()
+		{
+			std::mt19937                           engine{5};
+			std::uniform_real_distribution<double> distribution{-20000.0, 20000.0};
+			for (int i = 0; i < 50000; ++i)
+			{
+				points.emplace_back(units::metres{distribution(engine)},
+				                    units::metres{distribution(engine)},
+				                    units::metres{distribution(engine) / 100.0});
+			}
+		}
+
+		double squared_distance(point const& lhs, point const& rhs) const
+		{
+			auto const d = lhs - rhs;
+			return d.x().count() * d.x().count() + d.y().count() * d.y().count() + d.z().count() * d.z().count();
+		}
+
+		std::vector<point> points;
+	};
+
+	TEST_F(SpatialTest, Within_WhenRadiusInNauticalMiles_WillMatchScan)
+	{
+		auto const tree   = units::kd_tree<units::metres>{points.begin(), points.end()};
+		auto const centre = point{1_km, -2_km, 0_m};
+		auto const radius = units::unit_cast<units::metres>(1_NM).count();
+
+		auto expected = std::vector<std::size_t>{};
+		for (std::size_t i = 0; i < points.size(); ++i)
+		{
+			if (squared_distance(points[i], centre) <= radius * radius)
+			{
+				expected.push_back(i);
+			}
+		}
+
+		auto actual = std::vector<std::size_t>{};
+		tree.within(centre, 1_NM, actual);
+		std::sort(actual.begin(), actual.end());
+
+		EXPECT_FALSE(expected.empty());
+		EXPECT_EQ(expected, actual);
+		EXPECT_EQ(expected.size(), tree.count_within(centre, 1_NM));
+		EXPECT_EQ(expected.size(), tree.count_within(units::unit_cast<units::kilometres>(centre), 6080_ft));
+	}
+
+	TEST_F(SpatialTest, Nearest_WhenQueried_WillMatchScan)
+	{
+		auto const tree = units::kd_tree<units::metres>{points.begin(), points.end()};
+
+		std::mt19937                           engine{9};
+		std::uniform_real_distribution<double> distribution{-25000.0, 25000.0};
+		for (int q = 0; q < 100; ++q)
+		{
+			auto const centre = point{units::metres{distribution(engine)}, units::metres{distribution(engine)}, 0_m};
+
+			std::size_t best = 0;
+			for (std::size_t i = 1; i < points.size(); ++i)
+			{
+				if (squared_distance(points[i], centre) < squared_distance(points[best], centre))
+				{
+					best = i;
+				}
+			}
+
+			auto const found = tree.nearest(centre);
+			EXPECT_EQ(best, found.row);
+			EXPECT_DOUBLE_EQ(std::sqrt(squared_distance(points[best], centre)), found.distance.count());
+		}
+	}
+
+	TEST_F(SpatialTest, Nearest_WhenAskedForSeveral_WillSortThem)
+	{
+		auto const tree   = units::kd_tree<units::metres>{points.begin(), points.end()};
+		auto const centre = point{3_km, 3_km, 0_m};
+
+		auto order = std::vector<std::size_t>(points.size());
+		for (std::size_t i = 0; i < order.size(); ++i)
+		{
+			order[i] = i;
+		}
+		std::partial_sort(order.begin(), order.begin() + 10, order.end(), [&](std::size_t lhs, std::size_t rhs) {
+			return squared_distance(points[lhs], centre) < squared_distance(points[rhs], centre);
+		});
+
+		auto found = std::vector<units::neighbour<units::metres>>(10, {0, 0_m});
+		ASSERT_EQ(10u, tree.nearest(centre, 10, found.data()));
+		for (std::size_t i = 0; i < 10; ++i)
+		{
+			EXPECT_EQ(order[i], found[i].row);
+		}
+	}
+
+	TEST_F(SpatialTest, Nearest_WhenRepIsIntegral_WillCompareExactDistances)
+	{
+		using metres_i = units::distance<int>;
+		using point_i  = units::vec3<metres_i>;
+
+		auto const points = std::vector<point_i>{point_i{metres_i{5}, metres_i{3}, metres_i{0}},
+		                                         point_i{metres_i{-5}, metres_i{-2}, metres_i{-1}}};
+		auto const tree   = units::kd_tree<metres_i>{points.begin(), points.end()};
+		auto const origin = point_i{metres_i{0}, metres_i{0}, metres_i{0}};
+
+		auto const found = tree.nearest(origin);
+		EXPECT_EQ(1u, found.row);
+		EXPECT_EQ(5, found.distance.count());
+
+		auto both = std::vector<units::neighbour<metres_i>>(2, {0, metres_i{0}});
+		ASSERT_EQ(2u, tree.nearest(origin, 2, both.data()));
+		EXPECT_EQ(1u, both[0].row);
+		EXPECT_EQ(0u, both[1].row);
+	}
+
+	TEST_F(SpatialTest, Nearest_WhenAskedForMoreThanSize_WillReturnAll)
+	{
+		auto const few  = std::vector<point>{point{0_m, 0_m, 0_m}, point{3_m, 4_m, 0_m}};
+		auto const tree = units::kd_tree<units::metres>{few.begin(), few.end()};
+
+		auto found = std::vector<units::neighbour<units::metres>>(4, {0, 0_m});
+		ASSERT_EQ(2u, tree.nearest(point{3_m, 3_m, 0_m}, 4, found.data()));
+		EXPECT_EQ(1u, found[0].row);
+		EXPECT_DOUBLE_EQ(1.0, found[0].distance.count());
+		EXPECT_EQ(0u, found[1].row);
+	}
+
+	TEST_F(SpatialTest, Nearest_WhenEmpty_WillThrow)
+	{
+		auto const none = std::vector<point>{};
+		auto const tree = units::kd_tree<units::metres>{none.begin(), none.end()};
+
+		EXPECT_THROW(tree.nearest(point{0_m, 0_m, 0_m}), std::domain_error);
+		EXPECT_EQ(0u, tree.count_within(point{0_m, 0_m, 0_m}, 1_km));
+	}
+
+	TEST_F(SpatialTest, Build_WhenThreaded_WillAnswerAsSerial)
+	{
+		auto options    = units::index_options{};
+		options.threads = 1;
+		auto const one  = units::kd_tree<units::metres>{points.begin(), points.end(), options};
+		options.threads = 6;
+		auto const six  = units::kd_tree<units::metres>{points.begin(), points.end(), options};
+
+		auto const centres = std::vector<point>(points.begin(), points.begin() + 500);
+		auto       lhs     = std::vector<units::neighbour<units::metres>>(centres.size(), {0, 0_m});
+		auto       rhs     = lhs;
+		one.nearest(centres.data(), centres.data() + centres.size(), lhs.data(), options);
+		six.nearest(centres.data(), centres.data() + centres.size(), rhs.data(), options);
+
+		for (std::size_t i = 0; i < centres.size(); ++i)
+		{
+			EXPECT_EQ(i, lhs[i].row);
+			EXPECT_EQ(i, rhs[i].row);
+		}
+
+		auto counts = std::vector<std::size_t>(centres.size());
+		six.count_within(centres.data(), centres.data() + centres.size(), 2_km, counts.data(), options);
+		for (std::size_t i = 0; i < centres.size(); i += 50)
+		{
+			EXPECT_EQ(one.count_within(centres[i], 2_km), counts[i]);
+		}
+	}
+
+	TEST_F(SpatialTest, Build_WhenGivenNaN_WillThrow)
+	{
+		auto const nan = units::metres{std::numeric_limits<double>::quiet_NaN()};
+		auto const bad = std::vector<point>{point{0_m, 0_m, 0_m}, point{nan, 0_m, 0_m}};
+
+		EXPECT_THROW((units::kd_tree<units::metres>{bad.begin(), bad.end()}), std::domain_error);
+	}
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "units.h"
+#include "units/csv.h"
+#include "units/text_writer.h"
+
+using testing::Test;
+
+namespace TestTextWriter
+{
+	class TextWriterTest : public Test
+	{
+	};
+
+	TEST_F(TextWriterTest, WriteCsv_WhenGivenColumns_WillWriteSuffixesInHeaderAndShortestValues)
+	{
+		auto const distance = std::vector<units::feet>{units::feet{0.1}, units::feet{-2.5}, units::feet{1e21}};
+		auto const mass     = std::vector<units::grams>{units::grams{3}, units::grams{-4}, units::grams{5}};
+
+		std::ostringstream out;
+		{
+			units::text::writer w{out};
+			units::text::write_csv(w, units::text::column("distance", distance), units::text::column("mass", mass));
+		}
+
+		EXPECT_EQ("distance[ft],mass[g]\n0.1,3\n-2.5,-4\n1e+21,5\n", out.str());
+	}
+
+	TEST_F(TextWriterTest, WriteCsv_WhenValueIsNaN_WillWriteEmptyField)
+	{
+		auto const distance = std::vector<units::metres>{units::metres{std::numeric_limits<double>::quiet_NaN()}};
+
+		std::ostringstream out;
+		{
+			units::text::writer w{out};
+			units::text::write_csv(w, ';', units::text::column("distance", distance), units::text::column("copy", distance));
+		}
+
+		EXPECT_EQ("distance[m];copy[m]\n;\n", out.str());
+	}
+
+	TEST_F(TextWriterTest, WriteCsv_WhenColumnsHaveDifferentLengths_WillThrow)
+	{
+		auto const distance = std::vector<units::metres>(2, units::metres{1});
+		auto const mass     = std::vector<units::grams>(3, units::grams{1});
+
+		std::ostringstream  out;
+		units::text::writer w{out};
+		EXPECT_THROW(units::text::write_csv(w, units::text::column("distance", distance), units::text::column("mass", mass)),
+		             std::invalid_argument);
+	}
+
+	TEST_F(TextWriterTest, WriteCsv_WhenReadBack_WillRoundTripExactly)
+	{
+		auto distance = std::vector<units::kilometres>{};
+		for (int i = 0; i < 5000; ++i)
+		{
+			distance.push_back(units::kilometres{std::sin(i) * std::pow(10.0, i % 40 - 20)});
+		}
+
+		std::stringstream buffer;
+		{
+			units::text::writer w{buffer, 256};
+			units::text::write_csv(w, units::text::column("distance", distance));
+		}
+
+		auto const columns = units::csv::read(buffer, units::csv::column<units::kilometres>("distance"));
+		auto const& read   = std::get<0>(columns);
+		ASSERT_EQ(distance.size(), read.size());
+		for (std::size_t i = 0; i < distance.size(); ++i)
+		{
+			EXPECT_EQ(distance[i].count(), read[i].count());
+		}
+	}
+
+	TEST_F(TextWriterTest, WriteLines_WhenGivenValues_WillMatchStreamOperatorFormat)
+	{
+		using integral_grams = units::mass<int, std::ratio<1>>;
+		auto const values    = std::vector<integral_grams>{
+		    integral_grams{1}, integral_grams{-20}, integral_grams{std::numeric_limits<int>::min()}};
+
+		std::ostringstream out;
+		{
+			units::text::writer w{out};
+			units::text::write_lines(w, values.begin(), values.end());
+		}
+
+		std::ostringstream expected;
+		for (auto const& value : values)
+		{
+			expected << value << '\n';
+		}
+		EXPECT_EQ(expected.str(), out.str());
+	}
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/vec3.h"
+
+using testing::Test;
+
+namespace TestVec3
+{
+	class Vec3Test : public Test
+	{
+	};
+
+	TEST_F(Vec3Test, Storage_WhenDeclared_WillBeFourAlignedLanes)
+	{
+		EXPECT_EQ(4 * sizeof(double), sizeof(units::vec3<units::metres>));
+		EXPECT_EQ(4 * sizeof(double), alignof(units::vec3<units::metres>));
+		EXPECT_EQ(4 * sizeof(float), alignof(units::vec3<units::distance<float>>));
+		EXPECT_TRUE(std::is_trivially_copyable<units::vec3<units::metres>>::value);
+	}
+
+	TEST_F(Vec3Test, Arithmetic_WhenApplied_WillWorkComponentWise)
+	{
+		auto const a = units::vec3<units::metres>{units::metres{1}, units::metres{2}, units::metres{3}};
+		auto const b = units::vec3<units::metres>{units::metres{4}, units::metres{-5}, units::metres{6}};
+
+		EXPECT_EQ((units::vec3<units::metres>{units::metres{5}, units::metres{-3}, units::metres{9}}), a + b);
+		EXPECT_EQ((units::vec3<units::metres>{units::metres{-3}, units::metres{7}, units::metres{-3}}), a - b);
+		EXPECT_EQ((units::vec3<units::metres>{units::metres{2}, units::metres{4}, units::metres{6}}), 2.0 * a);
+		EXPECT_EQ((units::vec3<units::metres>{units::metres{0.5}, units::metres{1}, units::metres{1.5}}), a / 2.0);
+		EXPECT_EQ((units::vec3<units::metres>{units::metres{-1}, units::metres{-2}, units::metres{-3}}), -a);
+		EXPECT_EQ(0, (a / 2.0).data()[3]);
+	}
+
+	TEST_F(Vec3Test, Add_WhenRatiosDiffer_WillUseCommonType)
+	{
+		auto const a   = units::vec3<units::metres>{units::metres{1}, units::metres{0}, units::metres{0}};
+		auto const b   = units::vec3<units::kilometres>{
+		    units::kilometres{1}, units::kilometres{0}, units::kilometres{2}};
+		auto const sum = a + b;
+
+		EXPECT_TRUE((std::is_same<units::vec3<units::metres>, decltype(a + b)>::value));
+		EXPECT_DOUBLE_EQ(1001, sum.x().count());
+		EXPECT_DOUBLE_EQ(2000, sum.z().count());
+	}
+
+	TEST_F(Vec3Test, Dot_WhenGivenDistances_WillReturnArea)
+	{
+		auto const a = units::vec3<units::metres>{units::metres{1}, units::metres{2}, units::metres{3}};
+		auto const b = units::vec3<units::metres>{units::metres{4}, units::metres{-5}, units::metres{6}};
+
+		auto const product = units::dot(a, b);
+
+		EXPECT_TRUE((std::is_same<units::square_metres, typename std::decay<decltype(product)>::type>::value));
+		EXPECT_DOUBLE_EQ(12, product.count());
+	}
+
+	TEST_F(Vec3Test, Scale_WhenScalarIsNotFinite_WillKeepPaddingLaneZero)
+	{
+		auto       v     = units::vec3<units::metres>{units::metres{1}, units::metres{-2}, units::metres{3}};
+		auto const other = v;
+
+		v *= std::numeric_limits<double>::infinity();
+
+		EXPECT_EQ(0, v.data()[3]);
+		EXPECT_EQ(std::numeric_limits<double>::infinity(), units::dot(v, other).count());
+		EXPECT_EQ(std::numeric_limits<double>::infinity(), units::norm(v).count());
+	}
+
+	TEST_F(Vec3Test, Norm_WhenGivenDistances_WillReturnDistance)
+	{
+		auto const v = units::vec3<units::kilometres>{units::kilometres{2}, units::kilometres{3}, units::kilometres{6}};
+
+		auto const length = units::norm(v);
+
+		EXPECT_TRUE((std::is_same<units::kilometres, typename std::decay<decltype(length)>::type>::value));
+		EXPECT_DOUBLE_EQ(7, length.count());
+	}
+
+	TEST_F(Vec3Test, UnitCast_WhenRatiosDiffer_WillConvertEachComponent)
+	{
+		auto const v = units::vec3<units::kilometres>{
+		    units::kilometres{1}, units::kilometres{0.5}, units::kilometres{-2}};
+
+		auto const metres = units::unit_cast<units::metres>(v);
+		auto const miles  = units::unit_cast<units::miles>(v);
+
+		EXPECT_DOUBLE_EQ(1000, metres.x().count());
+		EXPECT_DOUBLE_EQ(500, metres.y().count());
+		EXPECT_DOUBLE_EQ(-2000, metres.z().count());
+		EXPECT_DOUBLE_EQ(units::unit_cast<units::miles>(units::kilometres{0.5}).count(), miles.y().count());
+	}
+
+	TEST_F(Vec3Test, Array_WhenBuiltFromVectors_WillStoreComponentsSeparately)
+	{
+		auto const array = units::vec3_array<units::metres>{
+		    {units::metres{1}, units::metres{2}, units::metres{3}},
+		    {units::metres{4}, units::metres{5}, units::metres{6}},
+		};
+
+		ASSERT_EQ(2u, array.size());
+		EXPECT_DOUBLE_EQ(4, array.x()[1].count());
+		EXPECT_DOUBLE_EQ(2, array.y()[0].count());
+		EXPECT_EQ((units::vec3<units::metres>{units::metres{4}, units::metres{5}, units::metres{6}}), array[1]);
+	}
+
+	TEST_F(Vec3Test, Array_WhenCombined_WillMatchSingleVectors)
+	{
+		auto a = units::vec3_array<units::metres>{};
+		auto b = units::vec3_array<units::metres>{};
+		for (int i = 0; i < 37; ++i)
+		{
+			a.push_back({units::metres{i * 1.0}, units::metres{i * 2.0}, units::metres{-i * 0.5}});
+			b.push_back({units::metres{3.0 - i}, units::metres{i * 0.25}, units::metres{1.0}});
+		}
+
+		auto dots  = std::vector<units::square_metres>(a.size(), units::square_metres{0});
+		auto norms = std::vector<units::metres>(a.size(), units::metres{0});
+		units::dot(a, b, dots.data());
+		units::norm(a, norms.data());
+
+		auto const offset = units::vec3<units::metres>{units::metres{1}, units::metres{0}, units::metres{0}};
+
+		auto sum = a;
+		sum += b;
+		sum *= 2.0;
+		sum += offset;
+
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			EXPECT_DOUBLE_EQ(units::dot(a[i], b[i]).count(), dots[i].count());
+			EXPECT_DOUBLE_EQ(units::norm(a[i]).count(), norms[i].count());
+			EXPECT_EQ(2.0 * (a[i] + b[i]) + offset, sum[i]);
+		}
+	}
+
+	TEST_F(Vec3Test, Array_WhenSizesDiffer_WillThrow)
+	{
+		auto a = units::vec3_array<units::metres>(3);
+		auto b = units::vec3_array<units::metres>(2);
+
+		EXPECT_THROW(a += b, std::invalid_argument);
+	}
+
+	TEST_F(Vec3Test, ArrayUnitCast_WhenRatiosDiffer_WillConvertEachComponent)
+	{
+		auto const array = units::vec3_array<units::metres>{
+		    {units::metres{1500}, units::metres{-250}, units::metres{0}},
+		};
+
+		auto const converted = units::unit_cast<units::kilometres>(array);
+
+		EXPECT_DOUBLE_EQ(1.5, converted.x()[0].count());
+		EXPECT_DOUBLE_EQ(-0.25, converted.y()[0].count());
+		EXPECT_DOUBLE_EQ(0, converted.z()[0].count());
+	}
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <vector>
+
+#include "units.h"
+#include "units/views.h"
+
+using testing::Test;
+
+using namespace distance_literals;
+
+namespace TestViews
+{
+	class ViewsTest : public Test
+	{
+	protected:
+		std::vector<units::feet> feet{
+		    units::feet{1000.0}, units::feet{2000.0}, units::feet{5000.0}, units::feet{-100.0}};
+	};
+
+	TEST_F(ViewsTest, Cast_WhenIterated_WillConvertEachElement)
+	{
+		auto converted    = std::vector<units::metres>{};
+		for (auto m : feet | units::views::cast<units::metres>())
+		{
+			converted.push_back(m);
+		}
+
+		ASSERT_EQ(4u, converted.size());
+		EXPECT_DOUBLE_EQ(304.8, converted[0].count());
+		EXPECT_DOUBLE_EQ(609.6, converted[1].count());
+		EXPECT_DOUBLE_EQ(1524.0, converted[2].count());
+		EXPECT_DOUBLE_EQ(-30.48, converted[3].count());
+	}
+
+	TEST_F(ViewsTest, Cast_WhenChained_WillConvertFromSource)
+	{
+		auto const view = feet | units::views::cast<units::kilometres>() | units::views::cast<units::metres>();
+
+		EXPECT_DOUBLE_EQ(304.8, (*view.begin()).count());
+	}
+
+	TEST_F(ViewsTest, Sum_WhenCast_WillReturnTargetUnit)
+	{
+		auto const total = units::views::sum(feet | units::views::cast<units::metres>());
+
+		EXPECT_TRUE((std::is_same<decltype(total), units::metres const>::value));
+		EXPECT_DOUBLE_EQ(2407.92, total.count());
+	}
+
+	TEST_F(ViewsTest, Scale_WhenSummed_WillMultiplyEachElement)
+	{
+		auto const total = units::views::sum(feet | units::views::scale(2.0));
+
+		EXPECT_DOUBLE_EQ(15800.0, total.count());
+	}
+
+	TEST_F(ViewsTest, Count_WhenSummed_WillReturnRep)
+	{
+		auto const total = units::views::sum(feet | units::views::cast<units::metres>() | units::views::count);
+
+		EXPECT_TRUE((std::is_same<decltype(total), double const>::value));
+		EXPECT_DOUBLE_EQ(2407.92, total);
+	}
+
+	TEST_F(ViewsTest, FilterBetween_WhenBoundsAreMixed_WillKeepHalfOpenRange)
+	{
+		auto const view = feet | units::views::filter_between(0_m, units::feet{5000.0});
+
+		EXPECT_EQ(2u, units::views::size(view));
+		EXPECT_DOUBLE_EQ(3000.0, units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, FilterBetween_WhenAfterCast_WillCompareSource)
+	{
+		auto const view = feet | units::views::cast<units::metres>() | units::views::filter_between(300_m, 1_km);
+
+		ASSERT_EQ(2u, units::views::size(view));
+		auto it = view.begin();
+		EXPECT_DOUBLE_EQ(304.8, (*it).count());
+		++it;
+		EXPECT_DOUBLE_EQ(609.6, (*it).count());
+		++it;
+		EXPECT_TRUE(it == view.end());
+	}
+
+	TEST_F(ViewsTest, FilterBetween_WhenAfterNarrowingCast_WillCompareCastValues)
+	{
+		using metres_i    = units::distance<int>;
+		auto const metres = std::vector<units::metres>{units::metres{1.7}, units::metres{2.2}, units::metres{3.4}};
+
+		auto const view =
+		    metres | units::views::cast<metres_i>() | units::views::filter_between(units::metres{1.5}, 3_m);
+
+		ASSERT_EQ(1u, units::views::size(view));
+		EXPECT_EQ(2, (*view.begin()).count());
+		EXPECT_EQ(2, units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, Sum_WhenRejectedValuesCannotBeCast_WillSkipThem)
+	{
+		using metres_i = units::distance<int>;
+
+		auto values = std::vector<units::metres>(20, units::metres{1e300});
+		values[3]   = units::metres{std::numeric_limits<double>::quiet_NaN()};
+		values[7]   = units::metres{2.5};
+		values[18]  = units::metres{4.0};
+
+		auto const view = values | units::views::filter_between(0_m, 10_m) | units::views::cast<metres_i>();
+
+		EXPECT_EQ(2u, units::views::size(view));
+		EXPECT_EQ(6, units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, FilterBetween_WhenAfterScale_WillCompareScaledValues)
+	{
+		auto const view = feet | units::views::scale(-1.0) | units::views::filter_between(0_m, 1_km);
+
+		EXPECT_EQ(1u, units::views::size(view));
+		EXPECT_DOUBLE_EQ(100.0, units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, FilterBetween_WhenChained_WillKeepIntersection)
+	{
+		auto const view = feet | units::views::filter_between(0_m, 1_km) | units::views::filter_between(400_m, 2_km);
+
+		EXPECT_EQ(1u, units::views::size(view));
+		EXPECT_DOUBLE_EQ(2000.0, units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, FilterBetween_WhenRepIsIntegral_WillKeepFractionalBounds)
+	{
+		using millimetres_i = units::distance<std::int32_t, std::milli>;
+		auto const values   = std::vector<millimetres_i>{millimetres_i{1}, millimetres_i{2}, millimetres_i{3}};
+
+		auto const view = values | units::views::filter_between(units::micrometres{1500.0}, units::micrometres{2500.0});
+
+		EXPECT_EQ(1u, units::views::size(view));
+		EXPECT_EQ(2, units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, Sum_WhenRangeIsLarge_WillMatchLoop)
+	{
+		auto values = std::vector<units::feet>{};
+		for (int i = 0; i < 1003; ++i)
+		{
+			values.emplace_back(static_cast<double>(i));
+		}
+
+		auto const view = values | units::views::filter_between(10_m, 200_m) | units::views::cast<units::metres>();
+
+		auto expected = units::metres{0.0};
+		for (auto f : values)
+		{
+			if (f >= 10_m && f < 200_m)
+			{
+				expected += units::unit_cast<units::metres>(f);
+			}
+		}
+		EXPECT_DOUBLE_EQ(expected.count(), units::views::sum(view).count());
+	}
+
+	TEST_F(ViewsTest, Sum_WhenRangeIsNotRandomAccess_WillSumKeptElements)
+	{
+		auto const values = std::list<units::metres>{1_m, 2_m, 3_m};
+
+		EXPECT_DOUBLE_EQ(5.0, units::views::sum(values | units::views::filter_between(2_m, 4_m)).count());
+		EXPECT_EQ(2u, units::views::size(values | units::views::filter_between(2_m, 4_m)));
+	}
+
+	TEST_F(ViewsTest, Iterator_WhenUsedWithAlgorithms_WillVisitKeptElements)
+	{
+		auto const view   = feet | units::views::filter_between(0_m, 1_km) | units::views::count;
+		auto const copied = std::vector<double>(view.begin(), view.end());
+
+		EXPECT_EQ((std::vector<double>{1000.0, 2000.0}), copied);
+	}
+}
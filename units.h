@@ -36,6 +36,16 @@
 #include <iostream>
 #endif
 
+// Define UNITS_ENABLE_CONVERSION_STATS to count the conversions made by unit_cast and the mixed ratio arithmetic and
+// relational operators, see units/conversion_stats.h. When it is not defined the hooks compile to nothing.
+#ifdef UNITS_ENABLE_CONVERSION_STATS
+#include "units/conversion_stats.h"
+#define UNITS_TRACE_CONVERSION(Operation, FromRatio, ToRatio, UnitType)                                           \
+	::units::conversion_stats::detail::trace<::units::conversion_stats::Operation, FromRatio, ToRatio, UnitType>()
+#else
+#define UNITS_TRACE_CONVERSION(Operation, FromRatio, ToRatio, UnitType) static_cast<void>(0)
+#endif
+
 namespace units
 {
 	template <typename Rep, typename Ratio, typename UnitType>
@@ -114,6 +124,90 @@ namespace units
 		{ // return type for unit / rep and unit % rep
 		};
 	}
+
+	// Policies for the ratio that mixed ratio arithmetic and comparisons convert both operands to
+	namespace common_ratio
+	{
+		// The greatest common divisor of both ratios, exact for integer reps but usually a ratio nobody asked for
+		struct gcd
+		{
+		};
+
+		// The given ratio, or gcd when integer operands are not whole multiples of it
+		template <typename Ratio>
+		struct fixed
+		{
+		};
+
+		// Always the base ratio of the unit type (metres, grams, square metres)
+		using base = fixed<std::ratio<1>>;
+	}
+
+// Define UNITS_DEFAULT_COMMON_RATIO to one of the units::common_ratio policies to change it for every unit type
+#ifndef UNITS_DEFAULT_COMMON_RATIO
+#define UNITS_DEFAULT_COMMON_RATIO ::units::common_ratio::gcd
+#endif
+
+	// Specialise for a unit type to choose its policy, e.g. common_ratio::base for unit_type::distance. Operands of
+	// the same ratio keep it whatever the policy, and every policy is symmetric so std::common_type does not depend on
+	// the order of its operands.
+	template <typename UnitType>
+	struct common_ratio_policy
+	{
+		using type = UNITS_DEFAULT_COMMON_RATIO;
+	};
+
+	namespace detail
+	{
+		template <typename Policy, typename Rep, typename Ratio1, typename Ratio2>
+		struct select_common_ratio;
+
+		template <typename Rep, typename Ratio1, typename Ratio2>
+		struct select_common_ratio<common_ratio::gcd, Rep, Ratio1, Ratio2>
+		{
+		private:
+			using gcd_num = greatest_common_divisor<Ratio1::num, Ratio2::num>;
+			using gcd_den = greatest_common_divisor<Ratio1::den, Ratio2::den>;
+
+		public:
+			using type = std::ratio<gcd_num::value, (Ratio1::den / gcd_den::value) * Ratio2::den>;
+		};
+
+		// Integer operands are only converted to a fixed ratio that both of their ratios are whole multiples of,
+		// otherwise they would be truncated, so they fall back to the greatest common divisor
+		template <typename Ratio, typename Rep, typename Ratio1, typename Ratio2>
+		struct select_common_ratio<common_ratio::fixed<Ratio>, Rep, Ratio1, Ratio2>
+		{
+		private:
+			using exact = std::integral_constant<bool,
+			                                     !std::is_integral<Rep>::value
+			                                         || (std::ratio_divide<Ratio1, Ratio>::den == 1
+			                                             && std::ratio_divide<Ratio2, Ratio>::den == 1)>;
+			using gcd   = typename select_common_ratio<common_ratio::gcd, Rep, Ratio1, Ratio2>::type;
+
+		public:
+			using type = typename std::conditional<exact::value, typename Ratio::type, gcd>::type;
+		};
+
+		// The policy is only looked up for different ratios, so it can still be specialised after units of its unit
+		// type have been declared
+		template <typename UnitType,
+		          typename Rep,
+		          typename Ratio1,
+		          typename Ratio2,
+		          bool = std::ratio_equal<Ratio1, Ratio2>::value>
+		struct common_ratio_of
+		{
+			using type =
+			    typename select_common_ratio<typename common_ratio_policy<UnitType>::type, Rep, Ratio1, Ratio2>::type;
+		};
+
+		template <typename UnitType, typename Rep, typename Ratio1, typename Ratio2>
+		struct common_ratio_of<UnitType, Rep, Ratio1, Ratio2, true>
+		{
+			using type = typename Ratio1::type;
+		};
+	}
 }
 
 namespace std
@@ -122,10 +216,8 @@ namespace std
 	struct unit_common_type
 	{
 	private:
-		using gcd_num    = units::detail::greatest_common_divisor<Ratio1::num, Ratio2::num>;
-		using gcd_den    = units::detail::greatest_common_divisor<Ratio1::den, Ratio2::den>;
 		using common_rep = typename CommonRep::type;
-		using ratio      = std::ratio<gcd_num::value, (Ratio1::den / gcd_den::value) * Ratio2::den>;
+		using ratio      = typename units::detail::common_ratio_of<UnitType, common_rep, Ratio1, Ratio2>::type;
 		using unit_type  = UnitType;
 
 	public:
@@ -168,6 +260,13 @@ namespace units
 	                                && (std::is_integral<Type>::value || std::is_floating_point<Type>::value),
 	                            Type>::type;
 
+	namespace detail
+	{
+		// unit_cast without the conversion trace, for the mixed ratio operators that record their own
+		template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+		constexpr ToUnit untraced_cast(unit<Rep, Ratio, UnitType> from);
+	}
+
 	template <typename Rep, typename Ratio, typename UnitType>
 	struct unit
 	{
@@ -410,7 +509,7 @@ inline namespace literals
 		constexpr units::drams operator"" _dr(unsigned long long int mass);
 		constexpr units::ounces operator"" _oz(unsigned long long int mass);
 		constexpr units::pounds operator"" _lb(unsigned long long int mass);
-		constexpr units::us_hundredweight operator"" _cwr(unsigned long long int mass);
+		constexpr units::us_hundredweight operator"" _cwt(unsigned long long int mass);
 	}
 }
 
@@ -516,7 +615,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return static_cast<common_type>(static_cast<common_type>(lhs).count() + static_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(add, Ratio1, Ratio2, UnitType1);
+
+		return static_cast<common_type>(detail::untraced_cast<common_type>(lhs).count()
+		                                + detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	template <typename Rep1, typename Ratio1, typename UnitType1, typename Rep2, typename Ratio2, typename UnitType2>
@@ -527,7 +629,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return static_cast<common_type>(static_cast<common_type>(lhs).count() - static_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(subtract, Ratio1, Ratio2, UnitType1);
+
+		return static_cast<common_type>(detail::untraced_cast<common_type>(lhs).count()
+		                                - detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	template <typename Rep1, typename Ratio, typename UnitType, typename Rep2>
@@ -592,9 +697,12 @@ namespace units
 			return (T{} > value) ? -value : value;
 		}
 
+		// The absolute difference below which == treats two values as equal
+		constexpr double default_max_diff = 0.000000001;
+
 		constexpr bool unit_compare(double lhs,
 		                            double rhs,
-		                            double max_diff          = 0.000000001,
+		                            double max_diff          = default_max_diff,
 		                            double max_relative_diff = std::numeric_limits<double>::epsilon())
 		{
 			return (abs(lhs - rhs) <= (((abs(rhs) > abs(lhs)) ? abs(rhs) : abs(lhs)) * max_relative_diff)) || (abs(lhs - rhs) <= max_diff);
@@ -609,7 +717,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return detail::unit_compare(unit_cast<common_type>(lhs).count(), unit_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(compare, Ratio1, Ratio2, UnitType1);
+
+		return detail::unit_compare(detail::untraced_cast<common_type>(lhs).count(),
+		                            detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	template <typename Rep1, typename Ratio1, typename UnitType1, typename Rep2, typename Ratio2, typename UnitType2>
@@ -625,7 +736,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return std::isless(unit_cast<common_type>(lhs).count(), unit_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(compare, Ratio1, Ratio2, UnitType1);
+
+		return std::isless(detail::untraced_cast<common_type>(lhs).count(),
+		                   detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	template <typename Rep1, typename Ratio1, typename UnitType1, typename Rep2, typename Ratio2, typename UnitType2>
@@ -635,7 +749,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return std::islessequal(unit_cast<common_type>(lhs).count(), unit_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(compare, Ratio1, Ratio2, UnitType1);
+
+		return std::islessequal(detail::untraced_cast<common_type>(lhs).count(),
+		                        detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	template <typename Rep1, typename Ratio1, typename UnitType1, typename Rep2, typename Ratio2, typename UnitType2>
@@ -645,7 +762,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return std::isgreater(unit_cast<common_type>(lhs).count(), unit_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(compare, Ratio1, Ratio2, UnitType1);
+
+		return std::isgreater(detail::untraced_cast<common_type>(lhs).count(),
+		                      detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	template <typename Rep1, typename Ratio1, typename UnitType1, typename Rep2, typename Ratio2, typename UnitType2>
@@ -655,7 +775,10 @@ namespace units
 		using unit2       = unit<Rep2, Ratio2, UnitType2>;
 		using common_type = typename std::common_type<unit1, unit2>::type;
 
-		return std::isgreaterequal(unit_cast<common_type>(lhs).count(), unit_cast<common_type>(rhs).count());
+		UNITS_TRACE_CONVERSION(compare, Ratio1, Ratio2, UnitType1);
+
+		return std::isgreaterequal(detail::untraced_cast<common_type>(lhs).count(),
+		                           detail::untraced_cast<common_type>(rhs).count());
 	}
 
 	namespace detail
@@ -669,11 +792,27 @@ namespace units
 		{
 			template <typename Rep, typename Length, typename UnitType>
 			static constexpr ToUnit cast(unit<Rep, Length, UnitType> from)
+			{
+				return scale(from.count(), std::is_floating_point<CommonType>{});
+			}
+
+		private:
+			// Floating point counts are scaled with a single multiply by a factor folded at compile time
+			template <typename Rep>
+			static constexpr ToUnit scale(Rep count, std::true_type)
+			{
+				using ToRep = typename ToUnit::rep;
+				return ToUnit{static_cast<ToRep>(static_cast<CommonType>(count)
+				                                 * static_cast<CommonType>(static_cast<long double>(Ratio::den)
+				                                                           / static_cast<long double>(Ratio::num)))};
+			}
+
+			template <typename Rep>
+			static constexpr ToUnit scale(Rep count, std::false_type)
 			{
 				using ToRep = typename ToUnit::rep;
-				return ToUnit{static_cast<ToRep>(static_cast<CommonType>(from.count())
-				                                     / static_cast<CommonType>(Ratio::num)
-				                                     * static_cast<CommonType>(Ratio::den))};
+				return ToUnit{static_cast<ToRep>(static_cast<CommonType>(count) / static_cast<CommonType>(Ratio::num)
+				                                 * static_cast<CommonType>(Ratio::den))};
 			}
 		};
 
@@ -711,6 +850,18 @@ namespace units
 				    static_cast<ToRep>(static_cast<CommonType>(from.count()) / static_cast<CommonType>(Ratio::num))};
 			}
 		};
+
+		template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+		constexpr ToUnit untraced_cast(unit<Rep, Ratio, UnitType> from)
+		{
+			using ToRatio     = typename ToUnit::ratio;
+			using ToRep       = typename ToUnit::rep;
+			using CommonType  = typename std::common_type<ToRep, Rep, intmax_t>::type;
+			using CommonRatio = std::ratio_divide<ToRatio, Ratio>;
+
+			return unit_cast<ToUnit, CommonRatio, CommonType, CommonRatio::num == 1, CommonRatio::den == 1>::cast(
+			    from);
+		}
 	}
 
 	template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
@@ -719,13 +870,9 @@ namespace units
 	{
 		static_assert(std::is_same<typename ToUnit::unit_type, UnitType>::value, "Incompatible types");
 
-		using ToRatio = typename ToUnit::ratio;
-		using ToRep = typename ToUnit::rep;
-		using CommonType = typename std::common_type<ToRep, Rep, intmax_t>::type;
-		using CommonRatio = std::ratio_divide<ToRatio, Ratio>;
+		UNITS_TRACE_CONVERSION(cast, Ratio, typename ToUnit::ratio, UnitType);
 
-		return detail::unit_cast<ToUnit, CommonRatio, CommonType, CommonRatio::num == 1, CommonRatio::den == 1>::cast(
-			from);
+		return detail::untraced_cast<ToUnit>(from);
 	}
 
 	template <typename Type, typename Unit>
@@ -0,0 +1,265 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// A quantity whose unit is only known at runtime. An any_unit holds a double, the id of its unit type and the id of
+// its alias in catalogue::all. Conversions look up a factor in a matrix that is built at compile time from every
+// alias, so converting to a static unit is a single load and multiply.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/catalogue.h"
+
+namespace units
+{
+	namespace detail
+	{
+		template <typename List>
+		struct alias_table;
+
+		template <typename... Units>
+		struct alias_table<type_list<Units...>>
+		{
+			static constexpr std::size_t size = sizeof...(Units);
+
+			// Position of the alias with the given ratio and unit type, or size
+			static constexpr std::size_t find(std::intmax_t num, std::intmax_t den, std::size_t unit_type)
+			{
+				constexpr std::intmax_t nums[]       = {Units::ratio::num...};
+				constexpr std::intmax_t dens[]       = {Units::ratio::den...};
+				constexpr std::size_t   unit_types[] = {catalogue::unit_type_id<typename Units::unit_type>::value...};
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					if (nums[i] == num && dens[i] == den && unit_types[i] == unit_type)
+					{
+						return i;
+					}
+				}
+				return size;
+			}
+
+			// The factor from alias from to alias to, or zero when their unit types differ
+			static constexpr double factor(std::size_t from, std::size_t to)
+			{
+				constexpr long double scales[]     = {catalogue::scale<typename Units::ratio>()...};
+				constexpr std::size_t unit_types[] = {catalogue::unit_type_id<typename Units::unit_type>::value...};
+				return unit_types[from] == unit_types[to] ? static_cast<double>(scales[from] / scales[to]) : 0.0;
+			}
+
+			template <std::size_t... Indices>
+			static constexpr std::array<double, sizeof...(Indices)> make_factors(std::index_sequence<Indices...>)
+			{
+				return std::array<double, sizeof...(Indices)>{{factor(Indices % size, Indices / size)...}};
+			}
+
+			static constexpr std::array<std::uint8_t, size> unit_types{
+			    {static_cast<std::uint8_t>(catalogue::unit_type_id<typename Units::unit_type>::value)...}};
+
+			// Row to holds the factors from every alias to alias to
+			static constexpr std::array<double, size * size> factors = make_factors(std::make_index_sequence<size * size>{});
+		};
+
+		template <typename... Units>
+		constexpr std::size_t alias_table<type_list<Units...>>::size;
+
+		template <typename... Units>
+		constexpr std::array<std::uint8_t, alias_table<type_list<Units...>>::size> alias_table<type_list<Units...>>::unit_types;
+
+		template <typename... Units>
+		constexpr std::array<double, alias_table<type_list<Units...>>::size * alias_table<type_list<Units...>>::size>
+		    alias_table<type_list<Units...>>::factors;
+
+		using aliases = alias_table<catalogue::all>;
+
+		// The id of the alias with the ratio and unit type of Unit
+		template <typename Unit>
+		struct alias_id
+		    : std::integral_constant<std::size_t,
+		                             aliases::find(Unit::ratio::num,
+		                                           Unit::ratio::den,
+		                                           catalogue::unit_type_id<typename Unit::unit_type>::value)>
+		{
+			static_assert(alias_id::value < aliases::size, "The unit must share its ratio with an alias in units.h");
+		};
+	}
+
+	class any_unit
+	{
+	public:
+		// Zero in the first alias of catalogue::all
+		any_unit() = default;
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		any_unit(unit<Rep, Ratio, UnitType> value)
+		    : amount{static_cast<double>(value.count())}
+		    , type_id{static_cast<std::uint8_t>(catalogue::unit_type_id<UnitType>::value)}
+		    , alias{static_cast<std::uint8_t>(detail::alias_id<unit<Rep, Ratio, UnitType>>::value)}
+		{
+		}
+
+		// A value in the alias with the given id in catalogue::all
+		static any_unit from_id(double value, std::size_t unit_id)
+		{
+			if (unit_id >= detail::aliases::size)
+			{
+				throw std::out_of_range{"No unit with id " + std::to_string(unit_id)};
+			}
+			return any_unit{value, detail::aliases::unit_types[unit_id], static_cast<std::uint8_t>(unit_id)};
+		}
+
+#ifndef UNITS_DISABLE_IOSTREAM
+		// A value in the alias with the given stream suffix, such as "ft" or "kg"
+		static any_unit from_suffix(double value, std::string const& suffix)
+		{
+			auto const found = catalogue::find(suffix);
+			if (found == nullptr)
+			{
+				throw std::invalid_argument{"Unknown unit " + suffix};
+			}
+			return from_id(value, static_cast<std::size_t>(found - catalogue::entries().data()));
+		}
+
+		std::string const& suffix() const { return catalogue::entries()[alias].suffix; }
+#endif
+
+		double      count() const { return amount; }
+		std::size_t unit_type() const { return type_id; }
+		std::size_t unit_id() const { return alias; }
+
+		template <typename Unit>
+		bool holds() const
+		{
+			return type_id == catalogue::unit_type_id<typename Unit::unit_type>::value;
+		}
+
+		// Converts to a static unit, throwing std::domain_error when the unit types differ
+		template <typename ToUnit>
+		ToUnit as() const
+		{
+			static_assert(is_unit<ToUnit>::value, "Can only convert to a unit");
+
+			if (!holds<ToUnit>())
+			{
+				throw std::domain_error{"Incompatible unit types"};
+			}
+			return ToUnit{static_cast<typename ToUnit::rep>(amount * factor_to(detail::alias_id<ToUnit>::value))};
+		}
+
+		// Converts to the alias with the given id
+		any_unit to_id(std::size_t unit_id) const
+		{
+			auto const result = from_id(0, unit_id);
+			if (result.type_id != type_id)
+			{
+				throw std::domain_error{"Incompatible unit types"};
+			}
+			return any_unit{amount * factor_to(unit_id), type_id, result.alias};
+		}
+
+	private:
+		any_unit(double value, std::uint8_t unit_type, std::uint8_t unit_id)
+		    : amount{value}
+		    , type_id{unit_type}
+		    , alias{unit_id}
+		{
+		}
+
+		double factor_to(std::size_t unit_id) const { return detail::aliases::factors[unit_id * detail::aliases::size + alias]; }
+
+		template <typename ToUnit>
+		friend ToUnit* convert(any_unit const* first, any_unit const* last, ToUnit* out);
+
+		double       amount  = 0;
+		std::uint8_t type_id = detail::aliases::unit_types[0];
+		std::uint8_t alias   = 0;
+	};
+
+	static_assert(std::is_trivially_copyable<any_unit>::value, "any_unit must be trivially copyable");
+
+	// Converts a range of values in any units to ToUnit. The row of factors into ToUnit is found once, then each value
+	// costs a load and a multiply. Throws std::domain_error, leaving out partly written, if any unit type differs.
+	template <typename ToUnit>
+	ToUnit* convert(any_unit const* first, any_unit const* last, ToUnit* out)
+	{
+		static_assert(is_unit<ToUnit>::value, "Can only convert to a unit");
+
+		using rep = typename ToUnit::rep;
+
+		auto const  row        = detail::aliases::factors.data() + detail::alias_id<ToUnit>::value * detail::aliases::size;
+		auto const  unit_type  = catalogue::unit_type_id<typename ToUnit::unit_type>::value;
+		auto        mismatched = false;
+		for (; first != last; ++first, ++out)
+		{
+			mismatched |= first->type_id != unit_type;
+			*out = ToUnit{static_cast<rep>(first->amount * row[first->alias])};
+		}
+
+		if (mismatched)
+		{
+			throw std::domain_error{"Incompatible unit types"};
+		}
+		return out;
+	}
+
+	namespace detail
+	{
+		template <typename ToUnit>
+		ToUnit* scale_values(double const* values, std::size_t count, double factor, ToUnit* out, std::true_type)
+		{
+			select<double>(bulk::kernels()).scale(values, count, factor, raw(out));
+			return out + count;
+		}
+
+		template <typename ToUnit>
+		ToUnit* scale_values(double const* values, std::size_t count, double factor, ToUnit* out, std::false_type)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out[i] = ToUnit{static_cast<typename ToUnit::rep>(values[i] * factor)};
+			}
+			return out + count;
+		}
+	}
+
+	// Converts count values that all share the alias unit_id to ToUnit, looking the factor up once and scaling with
+	// the bulk kernel when ToUnit holds doubles
+	template <typename ToUnit>
+	ToUnit* convert(double const* values, std::size_t count, std::size_t unit_id, ToUnit* out)
+	{
+		static_assert(is_unit<ToUnit>::value, "Can only convert to a unit");
+
+		using factor_unit = unit<double, typename ToUnit::ratio, typename ToUnit::unit_type>;
+		auto const factor = any_unit::from_id(1, unit_id).template as<factor_unit>().count();
+		return detail::scale_values(values, count, factor, out, std::is_same<typename ToUnit::rep, double>{});
+	}
+}
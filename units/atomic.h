@@ -0,0 +1,181 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <atomic>
+#include <type_traits>
+
+#include "units.h"
+
+namespace units
+{
+	namespace detail
+	{
+		template <typename Rep>
+		Rep atomic_fetch_add(std::atomic<Rep>& value, Rep delta, std::memory_order order, std::true_type)
+		{
+			return value.fetch_add(delta, order);
+		}
+
+		// std::atomic has no fetch_add for floating point types before C++20, so fall back to a CAS loop
+		template <typename Rep>
+		Rep atomic_fetch_add(std::atomic<Rep>& value, Rep delta, std::memory_order order, std::false_type)
+		{
+			auto expected = value.load(std::memory_order_relaxed);
+			while (!value.compare_exchange_weak(
+			           expected, static_cast<Rep>(expected + delta), order, std::memory_order_relaxed))
+			{
+			}
+			return expected;
+		}
+	}
+
+	template <typename Unit>
+	class atomic;
+
+	template <typename Rep, typename Ratio, typename UnitType>
+	class atomic<unit<Rep, Ratio, UnitType>>
+	{
+		static_assert(std::is_integral<Rep>::value || std::is_floating_point<Rep>::value,
+		              "Atomic units need an arithmetic representation");
+
+	public:
+		using value_type = unit<Rep, Ratio, UnitType>;
+		using rep        = Rep;
+
+		atomic() noexcept
+		    : value{Rep{}}
+		{
+		}
+
+		constexpr atomic(value_type desired) noexcept
+		    : value{desired.count()}
+		{
+		}
+
+		atomic(atomic const&) = delete;
+		atomic& operator=(atomic const&) = delete;
+
+		bool is_lock_free() const noexcept { return value.is_lock_free(); }
+
+		void store(value_type desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+		{
+			value.store(desired.count(), order);
+		}
+
+		value_type load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+		{
+			return value_type{value.load(order)};
+		}
+
+		operator value_type() const noexcept { return load(); }
+
+		value_type operator=(value_type desired) noexcept
+		{
+			store(desired);
+			return desired;
+		}
+
+		value_type exchange(value_type desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+		{
+			return value_type{value.exchange(desired.count(), order)};
+		}
+
+		bool compare_exchange_weak(value_type&       expected,
+		                           value_type        desired,
+		                           std::memory_order success,
+		                           std::memory_order failure) noexcept
+		{
+			auto raw    = expected.count();
+			auto result = value.compare_exchange_weak(raw, desired.count(), success, failure);
+			expected    = value_type{raw};
+			return result;
+		}
+
+		bool compare_exchange_weak(value_type&       expected,
+		                           value_type        desired,
+		                           std::memory_order order = std::memory_order_seq_cst) noexcept
+		{
+			auto raw    = expected.count();
+			auto result = value.compare_exchange_weak(raw, desired.count(), order);
+			expected    = value_type{raw};
+			return result;
+		}
+
+		bool compare_exchange_strong(value_type&       expected,
+		                             value_type        desired,
+		                             std::memory_order success,
+		                             std::memory_order failure) noexcept
+		{
+			auto raw    = expected.count();
+			auto result = value.compare_exchange_strong(raw, desired.count(), success, failure);
+			expected    = value_type{raw};
+			return result;
+		}
+
+		bool compare_exchange_strong(value_type&       expected,
+		                             value_type        desired,
+		                             std::memory_order order = std::memory_order_seq_cst) noexcept
+		{
+			auto raw    = expected.count();
+			auto result = value.compare_exchange_strong(raw, desired.count(), order);
+			expected    = value_type{raw};
+			return result;
+		}
+
+		// The argument is converted to this ratio with unit_cast, so the scaling factor is a compile time constant
+		template <typename Rep2, typename Ratio2>
+		value_type fetch_add(unit<Rep2, Ratio2, UnitType> arg, std::memory_order order = std::memory_order_seq_cst)
+		{
+			auto const delta = unit_cast<value_type>(arg).count();
+			return value_type{detail::atomic_fetch_add(value, delta, order, std::is_integral<Rep>{})};
+		}
+
+		template <typename Rep2, typename Ratio2>
+		value_type fetch_sub(unit<Rep2, Ratio2, UnitType> arg, std::memory_order order = std::memory_order_seq_cst)
+		{
+			auto const delta = unit_cast<value_type>(arg).count();
+			return value_type{
+			    detail::atomic_fetch_add(value, static_cast<Rep>(0 - delta), order, std::is_integral<Rep>{})};
+		}
+
+		template <typename Rep2, typename Ratio2>
+		value_type operator+=(unit<Rep2, Ratio2, UnitType> arg)
+		{
+			auto const delta = unit_cast<value_type>(arg);
+			return value_type{static_cast<Rep>(fetch_add(delta).count() + delta.count())};
+		}
+
+		template <typename Rep2, typename Ratio2>
+		value_type operator-=(unit<Rep2, Ratio2, UnitType> arg)
+		{
+			auto const delta = unit_cast<value_type>(arg);
+			return value_type{static_cast<Rep>(fetch_sub(delta).count() - delta.count())};
+		}
+
+	private:
+		std::atomic<Rep> value;
+	};
+}
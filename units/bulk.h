@@ -0,0 +1,713 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Kernels that work on contiguous ranges of units. Floating point ranges are handed to the best kernel for the
+// processor, see units/cpu_dispatch.h. Each tier compiles the same generic kernel for a different instruction set,
+// so every tier gives the same results. Any other representation falls back to a plain loop over the unit
+// operators.
+
+#include <algorithm>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+#include "units.h"
+#include "units/cpu_dispatch.h"
+
+namespace units
+{
+	namespace detail
+	{
+		constexpr double exact_powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+		                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+		inline bool is_digit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		inline bool is_separator(char c)
+		{
+			return c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+		}
+
+		inline bool is_padding(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		// Correctly rounds the numbers the fast path cannot, including inf and nan. A number out of the range of
+		// double becomes infinity if large is set and zero otherwise, as with strtod. Nothing is allocated, and
+		// without from_chars the decimal point is translated for strtod in the current locale.
+		inline bool parse_slow(char const* first, char const* last, double& out, bool large)
+		{
+			auto p = first != last && *first == '+' ? first + 1 : first;
+			if (p != first && p != last && *p == '-')
+			{
+				return false;
+			}
+
+#if defined(__cpp_lib_to_chars)
+			auto const result = std::from_chars(p, last, out);
+			if (result.ptr != last || p == last)
+			{
+				return false;
+			}
+			if (result.ec == std::errc::result_out_of_range)
+			{
+				auto const value = large ? std::numeric_limits<double>::infinity() : 0.0;
+				out              = *p == '-' ? -value : value;
+			}
+			return true;
+#else
+			// strtod needs a terminated copy that spells the decimal point the way the locale does, and it saturates
+			// out of range values by itself
+			static_cast<void>(large);
+			char buffer[128];
+			if (p == last || last - p >= static_cast<std::ptrdiff_t>(sizeof buffer))
+			{
+				return false;
+			}
+			auto const point = *std::localeconv()->decimal_point;
+			std::transform(p, last, buffer, [point](char c) { return c == '.' ? point : c; });
+			buffer[last - p] = '\0';
+
+			char* end = nullptr;
+			out       = std::strtod(buffer, &end);
+			return end == buffer + (last - p) && !is_padding(buffer[0]);
+#endif
+		}
+
+		// Parses a whole token as a decimal number without consulting the locale. Spaces and tabs either side of the
+		// number are ignored. Numbers with at most 15 significant digits and a decimal exponent within +-22 are exact
+		// in double, so they are computed with a single multiply or divide. Anything else goes to parse_slow.
+		inline bool parse_number(char const* first, char const* last, double& out)
+		{
+			while (first != last && is_padding(*first))
+			{
+				++first;
+			}
+			while (last != first && is_padding(last[-1]))
+			{
+				--last;
+			}
+
+			auto p        = first;
+			auto negative = false;
+			if (p != last && (*p == '-' || *p == '+'))
+			{
+				negative = *p == '-';
+				++p;
+			}
+
+			std::uint64_t mantissa = 0;
+			int           digits   = 0;
+			int           exponent = 0;
+			auto          any      = false;
+
+			for (; p != last && is_digit(*p); ++p)
+			{
+				any = true;
+				if (digits < 19)
+				{
+					mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+					digits += mantissa != 0;
+				}
+				else
+				{
+					++exponent;
+				}
+			}
+
+			if (p != last && *p == '.')
+			{
+				for (++p; p != last && is_digit(*p); ++p)
+				{
+					any = true;
+					if (digits < 19)
+					{
+						mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+						digits += mantissa != 0;
+						--exponent;
+					}
+				}
+			}
+
+			if (!any)
+			{
+				return parse_slow(first, last, out, false);
+			}
+
+			if (p != last && (*p == 'e' || *p == 'E'))
+			{
+				++p;
+				auto exponent_negative = false;
+				if (p != last && (*p == '-' || *p == '+'))
+				{
+					exponent_negative = *p == '-';
+					++p;
+				}
+
+				if (p == last || !is_digit(*p))
+				{
+					return false;
+				}
+
+				int explicit_exponent = 0;
+				for (; p != last && is_digit(*p); ++p)
+				{
+					explicit_exponent = std::min(explicit_exponent * 10 + (*p - '0'), 100000);
+				}
+				exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+			}
+
+			if (p != last)
+			{
+				return false;
+			}
+
+			if (mantissa == 0)
+			{
+				out = negative ? -0.0 : 0.0;
+				return true;
+			}
+
+			if (digits > 15 || exponent < -22 || exponent > 22)
+			{
+				return parse_slow(first, last, out, digits + exponent > 0);
+			}
+
+			auto value = static_cast<double>(mantissa);
+			value      = exponent < 0 ? value / exact_powers_of_ten[-exponent] : value * exact_powers_of_ten[exponent];
+			out        = negative ? -value : value;
+			return true;
+		}
+
+		template <typename T>
+		using is_maskable =
+		    std::integral_constant<bool, std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>;
+
+		// value when keep is true and zero otherwise. A conditional add of a floating point value stays a branch
+		// because the add may trap, so float and double are masked through their bits instead.
+		template <typename T>
+		UNITS_ALWAYS_INLINE T zero_unless(bool keep, T value, std::true_type)
+		{
+			using bits_type = typename std::conditional<sizeof(T) == 8, std::uint64_t, std::uint32_t>::type;
+
+			bits_type bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			bits &= static_cast<bits_type>(0) - static_cast<bits_type>(keep);
+			std::memcpy(&value, &bits, sizeof(bits));
+			return value;
+		}
+
+		template <typename T>
+		UNITS_ALWAYS_INLINE T zero_unless(bool keep, T value, std::false_type)
+		{
+			return keep ? value : T{};
+		}
+
+		template <typename T>
+		UNITS_ALWAYS_INLINE T zero_unless(bool keep, T value)
+		{
+			return zero_unless(keep, value, is_maskable<T>{});
+		}
+
+		namespace kernels
+		{
+			constexpr std::size_t lanes = 8;
+
+			template <typename T>
+			UNITS_ALWAYS_INLINE void scale(T const* in, std::size_t n, T factor, T* out)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					out[i] = in[i] * factor;
+				}
+			}
+
+			// Reductions keep one partial result per lane so the loop vectorises without reassociating the sum
+			template <typename T>
+			UNITS_ALWAYS_INLINE double sum(T const* in, std::size_t n)
+			{
+				double      partial[lanes] = {};
+				std::size_t i              = 0;
+				for (; i + lanes <= n; i += lanes)
+				{
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						partial[j] += in[i + j];
+					}
+				}
+
+				double total = 0;
+				for (std::size_t j = 0; j < lanes; ++j)
+				{
+					total += partial[j];
+				}
+				for (; i < n; ++i)
+				{
+					total += in[i];
+				}
+				return total;
+			}
+
+			// NaN is skipped by both min and max. Each lane starts as NaN and takes the first value it meets, so a
+			// range that is empty or all NaN gives NaN rather than an infinity that looks like a real extreme.
+			template <typename T>
+			UNITS_ALWAYS_INLINE T lesser(T candidate, T current)
+			{
+				return (candidate < current) | (current != current) ? candidate : current;
+			}
+
+			template <typename T>
+			UNITS_ALWAYS_INLINE T greater(T candidate, T current)
+			{
+				return (candidate > current) | (current != current) ? candidate : current;
+			}
+
+			template <typename T>
+			UNITS_ALWAYS_INLINE T min(T const* in, std::size_t n)
+			{
+				T partial[lanes];
+				std::fill(partial, partial + lanes, std::numeric_limits<T>::quiet_NaN());
+
+				std::size_t i = 0;
+				for (; i + lanes <= n; i += lanes)
+				{
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						partial[j] = lesser(in[i + j], partial[j]);
+					}
+				}
+				for (; i < n; ++i)
+				{
+					partial[0] = lesser(in[i], partial[0]);
+				}
+				for (std::size_t j = 1; j < lanes; ++j)
+				{
+					partial[0] = lesser(partial[j], partial[0]);
+				}
+				return partial[0];
+			}
+
+			template <typename T>
+			UNITS_ALWAYS_INLINE T max(T const* in, std::size_t n)
+			{
+				T partial[lanes];
+				std::fill(partial, partial + lanes, std::numeric_limits<T>::quiet_NaN());
+
+				std::size_t i = 0;
+				for (; i + lanes <= n; i += lanes)
+				{
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						partial[j] = greater(in[i + j], partial[j]);
+					}
+				}
+				for (; i < n; ++i)
+				{
+					partial[0] = greater(in[i], partial[0]);
+				}
+				for (std::size_t j = 1; j < lanes; ++j)
+				{
+					partial[0] = greater(partial[j], partial[0]);
+				}
+				return partial[0];
+			}
+
+			// Counts the values in [lo, hi)
+			template <typename T>
+			UNITS_ALWAYS_INLINE std::size_t count_between(T const* in, std::size_t n, T lo, T hi)
+			{
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					count += static_cast<std::size_t>((in[i] >= lo) & (in[i] < hi));
+				}
+				return count;
+			}
+
+			UNITS_ALWAYS_INLINE std::size_t parse(char const* first, char const* last, double* out, std::size_t capacity)
+			{
+				std::size_t count = 0;
+				while (count < capacity)
+				{
+					while (first != last && is_separator(*first))
+					{
+						++first;
+					}
+					if (first == last)
+					{
+						break;
+					}
+
+					auto token_end = first;
+					while (token_end != last && !is_separator(*token_end))
+					{
+						++token_end;
+					}
+
+					if (!parse_number(first, token_end, out[count]))
+					{
+						throw std::invalid_argument{"Malformed number: " + std::string{first, token_end}};
+					}
+
+					++count;
+					first = token_end;
+				}
+				return count;
+			}
+		}
+	}
+
+	namespace bulk
+	{
+		template <typename T>
+		struct kernel_set
+		{
+			void (*scale)(T const*, std::size_t, T, T*);
+			double (*sum)(T const*, std::size_t);
+			T (*min)(T const*, std::size_t);
+			T (*max)(T const*, std::size_t);
+			std::size_t (*count_between)(T const*, std::size_t, T, T);
+		};
+
+		struct kernel_table
+		{
+			cpu::tier          tier;
+			kernel_set<float>  f32;
+			kernel_set<double> f64;
+			std::size_t (*parse)(char const*, char const*, double*, std::size_t);
+		};
+	}
+
+	namespace detail
+	{
+// Instantiates every kernel for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_BULK_TIER(Name, Tier, Target)                                                                            \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		template <typename T>                                                                                          \
+		Target void scale(T const* in, std::size_t n, T factor, T* out)                                               \
+		{                                                                                                              \
+			kernels::scale(in, n, factor, out);                                                                        \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target double sum(T const* in, std::size_t n)                                                                  \
+		{                                                                                                              \
+			return kernels::sum(in, n);                                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target T min(T const* in, std::size_t n)                                                                       \
+		{                                                                                                              \
+			return kernels::min(in, n);                                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target T max(T const* in, std::size_t n)                                                                       \
+		{                                                                                                              \
+			return kernels::max(in, n);                                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target std::size_t count_between(T const* in, std::size_t n, T lo, T hi)                                       \
+		{                                                                                                              \
+			return kernels::count_between(in, n, lo, hi);                                                              \
+		}                                                                                                              \
+                                                                                                                       \
+		Target inline std::size_t parse(char const* first, char const* last, double* out, std::size_t capacity)        \
+		{                                                                                                              \
+			return kernels::parse(first, last, out, capacity);                                                         \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		bulk::kernel_set<T> set()                                                                                      \
+		{                                                                                                              \
+			return bulk::kernel_set<T>{&scale<T>, &sum<T>, &min<T>, &max<T>, &count_between<T>};                      \
+		}                                                                                                              \
+                                                                                                                       \
+		inline bulk::kernel_table const& table()                                                                       \
+		{                                                                                                              \
+			static bulk::kernel_table const t{Tier, set<float>(), set<double>(), &parse};                              \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+		UNITS_FOR_EACH_TIER(UNITS_BULK_TIER)
+
+#undef UNITS_BULK_TIER
+
+		// The kernels for values of type T in a table that holds one set per type
+		template <typename Table>
+		auto kernels_of(Table const& table, float const*) -> decltype((table.f32))
+		{
+			return table.f32;
+		}
+
+		template <typename Table>
+		auto kernels_of(Table const& table, double const*) -> decltype((table.f64))
+		{
+			return table.f64;
+		}
+
+		template <typename Table>
+		auto kernels_of(Table const& table, std::int16_t const*) -> decltype((table.i16))
+		{
+			return table.i16;
+		}
+
+		template <typename Table>
+		auto kernels_of(Table const& table, std::int32_t const*) -> decltype((table.i32))
+		{
+			return table.i32;
+		}
+
+		template <typename T, typename Table>
+		auto select(Table const& table) -> decltype(kernels_of(table, static_cast<T const*>(nullptr)))
+		{
+			return kernels_of(table, static_cast<T const*>(nullptr));
+		}
+
+		template <typename Rep>
+		using is_dispatched = std::integral_constant<bool, std::is_same<Rep, float>::value || std::is_same<Rep, double>::value>;
+
+		// The factor unit_cast applies to a value of ratio From to express it in ratio To
+		template <typename T, typename From, typename To>
+		constexpr T conversion_factor()
+		{
+			using ratio = std::ratio_divide<To, From>;
+			return static_cast<T>(static_cast<long double>(ratio::den) / static_cast<long double>(ratio::num));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		Rep const* raw(unit<Rep, Ratio, UnitType> const* u)
+		{
+			static_assert(sizeof(unit<Rep, Ratio, UnitType>) == sizeof(Rep), "Units must have the size of their rep");
+			return reinterpret_cast<Rep const*>(u);
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		Rep* raw(unit<Rep, Ratio, UnitType>* u)
+		{
+			static_assert(sizeof(unit<Rep, Ratio, UnitType>) == sizeof(Rep), "Units must have the size of their rep");
+			return reinterpret_cast<Rep*>(u);
+		}
+	}
+
+	namespace bulk
+	{
+		// The kernels for a given tier, or the best supported one if the machine cannot run it
+		inline kernel_table const& kernels(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(detail));
+		}
+
+		// The kernels bound to the active tier, chosen once on first use
+		inline kernel_table const& kernels()
+		{
+			return cpu::active_kernels<kernel_table, &kernels>();
+		}
+
+		namespace detail
+		{
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			ToUnit* cast(unit<Rep, Ratio, UnitType> const* first,
+			             unit<Rep, Ratio, UnitType> const* last,
+			             ToUnit*                           out,
+			             std::true_type)
+			{
+				using rep        = typename ToUnit::rep;
+				auto const count = static_cast<std::size_t>(last - first);
+				units::detail::select<rep>(kernels()).scale(
+				    units::detail::raw(first),
+				    count,
+				    units::detail::conversion_factor<rep, Ratio, typename ToUnit::ratio>(),
+				    units::detail::raw(out));
+				return out + count;
+			}
+
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			ToUnit* cast(unit<Rep, Ratio, UnitType> const* first,
+			             unit<Rep, Ratio, UnitType> const* last,
+			             ToUnit*                           out,
+			             std::false_type)
+			{
+				return std::transform(first, last, out, [](unit<Rep, Ratio, UnitType> u) { return unit_cast<ToUnit>(u); });
+			}
+		}
+
+		// Converts a range with one multiply per element. The factor is computed at compile time, so results can
+		// differ in the last bit from unit_cast, which divides exactly when the factor is the reciprocal of an integer.
+		template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+		ToUnit* cast(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last, ToUnit* out)
+		{
+			static_assert(std::is_same<typename ToUnit::unit_type, UnitType>::value, "Incompatible types");
+
+			using dispatched = std::integral_constant<bool,
+			                                          units::detail::is_dispatched<Rep>::value
+			                                              && std::is_same<Rep, typename ToUnit::rep>::value>;
+			return detail::cast(first, last, out, dispatched{});
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto sum(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last) ->
+		    typename std::enable_if<units::detail::is_dispatched<Rep>::value, unit<Rep, Ratio, UnitType>>::type
+		{
+			auto const& k = units::detail::select<Rep>(kernels());
+			return unit<Rep, Ratio, UnitType>{
+			    static_cast<Rep>(k.sum(units::detail::raw(first), static_cast<std::size_t>(last - first)))};
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto sum(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last) ->
+		    typename std::enable_if<!units::detail::is_dispatched<Rep>::value, unit<Rep, Ratio, UnitType>>::type
+		{
+			auto total = unit<Rep, Ratio, UnitType>{0};
+			for (; first != last; ++first)
+			{
+				total += *first;
+			}
+			return total;
+		}
+
+		// Throws std::domain_error if the range is empty, as does max. NaN is skipped, and a range of only NaN gives
+		// NaN.
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto min(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last) ->
+		    typename std::enable_if<units::detail::is_dispatched<Rep>::value, unit<Rep, Ratio, UnitType>>::type
+		{
+			if (first == last)
+			{
+				throw std::domain_error{"Minimum of an empty range"};
+			}
+
+			auto const& k = units::detail::select<Rep>(kernels());
+			return unit<Rep, Ratio, UnitType>{k.min(units::detail::raw(first), static_cast<std::size_t>(last - first))};
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto min(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last) ->
+		    typename std::enable_if<!units::detail::is_dispatched<Rep>::value, unit<Rep, Ratio, UnitType>>::type
+		{
+			if (first == last)
+			{
+				throw std::domain_error{"Minimum of an empty range"};
+			}
+
+			return *std::min_element(first, last, [](unit<Rep, Ratio, UnitType> lhs, unit<Rep, Ratio, UnitType> rhs) {
+				return lhs.count() < rhs.count();
+			});
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto max(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last) ->
+		    typename std::enable_if<units::detail::is_dispatched<Rep>::value, unit<Rep, Ratio, UnitType>>::type
+		{
+			if (first == last)
+			{
+				throw std::domain_error{"Maximum of an empty range"};
+			}
+
+			auto const& k = units::detail::select<Rep>(kernels());
+			return unit<Rep, Ratio, UnitType>{k.max(units::detail::raw(first), static_cast<std::size_t>(last - first))};
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto max(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last) ->
+		    typename std::enable_if<!units::detail::is_dispatched<Rep>::value, unit<Rep, Ratio, UnitType>>::type
+		{
+			if (first == last)
+			{
+				throw std::domain_error{"Maximum of an empty range"};
+			}
+
+			return *std::max_element(first, last, [](unit<Rep, Ratio, UnitType> lhs, unit<Rep, Ratio, UnitType> rhs) {
+				return lhs.count() < rhs.count();
+			});
+		}
+
+		// Counts the values in [lo, hi). The bounds may be in any compatible ratio and are converted to the ratio of
+		// the range once.
+		template <typename Rep, typename Ratio, typename UnitType, typename Lo, typename Hi>
+		auto count_between(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last, Lo lo, Hi hi)
+		    -> typename std::enable_if<units::detail::is_dispatched<Rep>::value, std::size_t>::type
+		{
+			using bound      = unit<Rep, Ratio, UnitType>;
+			auto const& k    = units::detail::select<Rep>(kernels());
+			return k.count_between(units::detail::raw(first),
+			                       static_cast<std::size_t>(last - first),
+			                       unit_cast<bound>(lo).count(),
+			                       unit_cast<bound>(hi).count());
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType, typename Lo, typename Hi>
+		auto count_between(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last, Lo lo, Hi hi)
+		    -> typename std::enable_if<!units::detail::is_dispatched<Rep>::value, std::size_t>::type
+		{
+			using bound        = unit<typename std::common_type<Rep, double>::type, Ratio, UnitType>;
+			auto const lo_rep  = unit_cast<bound>(lo).count();
+			auto const hi_rep  = unit_cast<bound>(hi).count();
+			return static_cast<std::size_t>(std::count_if(first, last, [=](unit<Rep, Ratio, UnitType> u) {
+				return u.count() >= lo_rep && u.count() < hi_rep;
+			}));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType, typename Bound>
+		std::size_t count_less(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last, Bound bound)
+		{
+			using lowest = unit<long double, Ratio, UnitType>;
+			return count_between(first, last, lowest{-std::numeric_limits<long double>::infinity()}, bound);
+		}
+
+		// Parses decimal numbers separated by commas or whitespace, each expressed in Unit, into out. Returns the
+		// number of values written, at most capacity, and throws std::invalid_argument on a malformed number.
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto parse(char const* first, char const* last, unit<Rep, Ratio, UnitType>* out, std::size_t capacity) ->
+		    typename std::enable_if<std::is_same<Rep, double>::value, std::size_t>::type
+		{
+			return kernels().parse(first, last, units::detail::raw(out), capacity);
+		}
+	}
+}
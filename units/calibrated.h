@@ -0,0 +1,213 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Units whose scale is only known at runtime, such as the readings of a sensor with a per device calibration factor.
+// A calibrated_column stores the raw readings and one scale, the size of a raw count in Unit. Elements are read as
+// calibrated values, which pair a raw reading with the scale of its column and convert to static units through
+// unit_cast and std::common_type. Converting a whole column folds the scale into the conversion factor, so it runs
+// through the same bulk kernels as statically scaled data.
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+
+namespace units
+{
+	template <typename Unit, typename Raw = typename Unit::rep>
+	class calibrated
+	{
+		static_assert(is_unit<Unit>::value, "Calibrated values must be expressed in a unit");
+
+	public:
+		using raw_type  = Raw;
+		using unit_type = typename Unit::unit_type;
+
+		constexpr calibrated(Raw raw, double scale)
+		    : reading{raw}
+		    , factor{scale}
+		{
+		}
+
+		constexpr Raw    raw() const { return reading; }
+		constexpr double scale() const { return factor; }
+
+		constexpr Unit value() const { return Unit{static_cast<typename Unit::rep>(reading * factor)}; }
+
+		constexpr operator Unit() const { return value(); }
+
+	private:
+		Raw    reading;
+		double factor;
+	};
+
+	template <typename ToUnit, typename Unit, typename Raw>
+	constexpr auto unit_cast(calibrated<Unit, Raw> from) ->
+	    typename std::enable_if<is_unit<ToUnit>::value, ToUnit>::type
+	{
+		return unit_cast<ToUnit>(from.value());
+	}
+
+	template <typename Unit, typename Raw = typename Unit::rep>
+	class calibrated_column
+	{
+		static_assert(is_unit<Unit>::value, "Calibrated columns must be expressed in a unit");
+
+	public:
+		using value_type = calibrated<Unit, Raw>;
+
+		// scale is the size of one raw count in Unit
+		explicit calibrated_column(double scale)
+		    : factor{checked(scale)}
+		{
+		}
+
+		calibrated_column(double scale, std::vector<Raw> raw)
+		    : factor{checked(scale)}
+		    , readings(std::move(raw))
+		{
+		}
+
+		double scale() const { return factor; }
+
+		// Changes the scale of every reading in the column
+		void recalibrate(double scale) { factor = checked(scale); }
+
+		std::size_t size() const { return readings.size(); }
+		bool        empty() const { return readings.empty(); }
+
+		void reserve(std::size_t capacity) { readings.reserve(capacity); }
+		void clear() { readings.clear(); }
+
+		void push_back(Raw raw) { readings.push_back(raw); }
+
+		value_type operator[](std::size_t index) const { return value_type{readings[index], factor}; }
+
+		Raw const*              raw() const { return readings.data(); }
+		std::vector<Raw> const& raw_values() const { return readings; }
+
+		// Converts every reading to ToUnit with a single multiply each
+		template <typename ToUnit>
+		ToUnit* cast(ToUnit* out) const
+		{
+			static_assert(std::is_same<typename ToUnit::unit_type, typename Unit::unit_type>::value,
+			              "Incompatible types");
+
+			using rep        = typename ToUnit::rep;
+			using dispatched = std::integral_constant<bool, detail::is_dispatched<rep>::value
+			                                                    && std::is_same<Raw, rep>::value>;
+
+			auto const multiplier = detail::conversion_factor<double, typename Unit::ratio, typename ToUnit::ratio>();
+			return cast(out, factor * multiplier, dispatched{});
+		}
+
+		template <typename ToUnit = Unit>
+		std::vector<ToUnit> to_vector() const
+		{
+			auto result = std::vector<ToUnit>(readings.size(), ToUnit{0});
+			cast(result.data());
+			return result;
+		}
+
+		Unit sum() const
+		{
+			auto const total = sum(std::integral_constant<bool, detail::is_dispatched<Raw>::value>{});
+			return Unit{static_cast<typename Unit::rep>(total * factor)};
+		}
+
+	private:
+		static double checked(double scale)
+		{
+			if (!std::isfinite(scale) || scale == 0)
+			{
+				throw std::invalid_argument{"A calibration scale must be finite and non zero"};
+			}
+			return scale;
+		}
+
+		template <typename ToUnit>
+		ToUnit* cast(ToUnit* out, double multiplier, std::true_type) const
+		{
+			using rep = typename ToUnit::rep;
+			detail::select<rep>(bulk::kernels())
+			    .scale(readings.data(), readings.size(), static_cast<rep>(multiplier), detail::raw(out));
+			return out + readings.size();
+		}
+
+		template <typename ToUnit>
+		ToUnit* cast(ToUnit* out, double multiplier, std::false_type) const
+		{
+			for (auto reading : readings)
+			{
+				*out++ = ToUnit{static_cast<typename ToUnit::rep>(reading * multiplier)};
+			}
+			return out;
+		}
+
+		double sum(std::true_type) const
+		{
+			return detail::select<Raw>(bulk::kernels()).sum(readings.data(), readings.size());
+		}
+
+		double sum(std::false_type) const
+		{
+			auto total = 0.0;
+			for (auto reading : readings)
+			{
+				total += static_cast<double>(reading);
+			}
+			return total;
+		}
+
+		double           factor;
+		std::vector<Raw> readings;
+	};
+}
+
+namespace std
+{
+	template <typename Unit, typename Raw, typename Rep, typename Ratio, typename UnitType>
+	struct common_type<units::calibrated<Unit, Raw>, units::unit<Rep, Ratio, UnitType>>
+	    : common_type<Unit, units::unit<Rep, Ratio, UnitType>>
+	{
+	};
+
+	template <typename Rep, typename Ratio, typename UnitType, typename Unit, typename Raw>
+	struct common_type<units::unit<Rep, Ratio, UnitType>, units::calibrated<Unit, Raw>>
+	    : common_type<units::unit<Rep, Ratio, UnitType>, Unit>
+	{
+	};
+
+	template <typename Unit1, typename Raw1, typename Unit2, typename Raw2>
+	struct common_type<units::calibrated<Unit1, Raw1>, units::calibrated<Unit2, Raw2>> : common_type<Unit1, Unit2>
+	{
+	};
+}
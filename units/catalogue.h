@@ -0,0 +1,157 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Compile time lists of the aliases declared in units.h, and a runtime table that maps the stream suffix of each
+// alias back to its unit type and scale. Aliases without a stream suffix are not listed.
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+
+#include "units.h"
+
+namespace units
+{
+	template <typename... Types>
+	struct type_list
+	{
+		static constexpr std::size_t size = sizeof...(Types);
+	};
+
+	template <typename... Types>
+	constexpr std::size_t type_list<Types...>::size;
+
+	namespace detail
+	{
+		template <typename... Lists>
+		struct concat;
+
+		template <typename... Types>
+		struct concat<type_list<Types...>>
+		{
+			using type = type_list<Types...>;
+		};
+
+		template <typename... First, typename... Second, typename... Rest>
+		struct concat<type_list<First...>, type_list<Second...>, Rest...>
+		    : concat<type_list<First..., Second...>, Rest...>
+		{
+		};
+
+		template <typename T, typename List>
+		struct index_of;
+
+		template <typename T, typename... Rest>
+		struct index_of<T, type_list<T, Rest...>> : std::integral_constant<std::size_t, 0>
+		{
+		};
+
+		template <typename T, typename First, typename... Rest>
+		struct index_of<T, type_list<First, Rest...>>
+		    : std::integral_constant<std::size_t, 1 + index_of<T, type_list<Rest...>>::value>
+		{
+		};
+	}
+
+	namespace catalogue
+	{
+		using unit_types = type_list<unit_type::distance, unit_type::mass, unit_type::area>;
+
+		// Families are ordered from the smallest to the largest unit
+		using metric_distances       = type_list<nanometres, micrometres, millimetres, centimetres, decimetres, metres, kilometres>;
+		using imperial_distances     = type_list<thous, inches, links, feet, yards, rods, chains, furlongs, miles, leagues>;
+		using maritime_distances     = type_list<fathoms, cables, nautical_miles>;
+		using astronomical_distances = type_list<earth_radii, lunar_distances, astronimical_units, light_years, parsecs>;
+
+		using metric_masses   = type_list<picograms, nanograms, micrograms, milligrams, grams, kilograms>;
+		using imperial_masses = type_list<grains, drams, ounces, pounds, us_hundredweight>;
+
+		using areas = type_list<square_centimetres, square_metres, square_feet>;
+
+		using all = typename detail::concat<metric_distances,
+		                                    imperial_distances,
+		                                    maritime_distances,
+		                                    astronomical_distances,
+		                                    metric_masses,
+		                                    imperial_masses,
+		                                    areas>::type;
+
+		template <typename UnitType>
+		using unit_type_id = detail::index_of<UnitType, unit_types>;
+
+		template <typename Unit>
+		using unit_id = detail::index_of<Unit, all>;
+
+		// The scale of a ratio relative to std::ratio<1>
+		template <typename Ratio>
+		constexpr long double scale()
+		{
+			return static_cast<long double>(Ratio::num) / static_cast<long double>(Ratio::den);
+		}
+
+#ifndef UNITS_DISABLE_IOSTREAM
+		struct entry
+		{
+			std::string suffix;
+			std::size_t unit_type;
+			long double scale;
+		};
+
+		namespace detail
+		{
+			template <typename... Units>
+			std::vector<entry> make_entries(type_list<Units...>)
+			{
+				return std::vector<entry>{entry{units::detail::get_unit<typename Units::ratio, typename Units::unit_type>(),
+				                                unit_type_id<typename Units::unit_type>::value,
+				                                scale<typename Units::ratio>()}...};
+			}
+		}
+
+		// Every listed alias, in the order of catalogue::all
+		inline std::vector<entry> const& entries()
+		{
+			static std::vector<entry> const e = detail::make_entries(all{});
+			return e;
+		}
+
+		// The alias with the given stream suffix, or nullptr
+		inline entry const* find(std::string const& suffix)
+		{
+			for (auto const& e : entries())
+			{
+				if (e.suffix == suffix)
+				{
+					return &e;
+				}
+			}
+			return nullptr;
+		}
+#endif
+	}
+}
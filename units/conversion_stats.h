@@ -0,0 +1,286 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Counts of the conversions made by unit_cast and the mixed ratio operators, collected when units.h is compiled
+// with UNITS_ENABLE_CONVERSION_STATS defined. This header is included by units.h and should not be included
+// directly.
+//
+// Every thread counts into its own table without any read-modify-write operations. Tables are summed when a
+// report is requested and are folded into a global total when their thread exits. Define
+// UNITS_CONVERSION_STATS_REPORT_AT_EXIT to have the report written to std::cerr at program exit.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ratio>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace units
+{
+	namespace conversion_stats
+	{
+		// clang-format off
+		struct cast { static constexpr char const* name() { return "unit_cast"; } };
+		struct add { static constexpr char const* name() { return "operator+"; } };
+		struct subtract { static constexpr char const* name() { return "operator-"; } };
+		struct compare { static constexpr char const* name() { return "comparison"; } };
+		// clang-format on
+
+		struct entry
+		{
+			char const*   operation;
+			std::intmax_t from_num;
+			std::intmax_t from_den;
+			std::intmax_t to_num;
+			std::intmax_t to_den;
+			std::string   unit_type;
+			std::uint64_t count;
+		};
+
+		namespace detail
+		{
+			constexpr std::size_t block_size = 64;
+
+			using counter_block = std::array<std::atomic<std::uint64_t>, block_size>;
+
+			class thread_table;
+
+			class registry
+			{
+			public:
+				static registry& instance()
+				{
+					static registry r;
+					return r;
+				}
+
+				std::size_t add(entry key)
+				{
+					std::lock_guard<std::mutex> lock{mutex};
+					keys.push_back(std::move(key));
+					retired.push_back(0);
+					return keys.size() - 1;
+				}
+
+				void attach(thread_table* table)
+				{
+					std::lock_guard<std::mutex> lock{mutex};
+					tables.push_back(table);
+				}
+
+				void detach(thread_table* table);
+
+				std::vector<entry> snapshot();
+
+#ifdef UNITS_CONVERSION_STATS_REPORT_AT_EXIT
+				~registry();
+#endif
+
+			private:
+				registry() = default;
+
+				std::mutex                  mutex;
+				std::vector<entry>          keys;
+				std::vector<std::uint64_t>  retired;
+				std::vector<thread_table*>  tables;
+			};
+
+			class thread_table
+			{
+			public:
+				thread_table() { registry::instance().attach(this); }
+				~thread_table() { registry::instance().detach(this); }
+
+				void increment(std::size_t index)
+				{
+					auto const block = index / block_size;
+					if (block >= blocks.size())
+					{
+						grow(block);
+					}
+
+					// Only this thread writes the counter, so a relaxed load and store is enough
+					auto& counter = (*blocks[block])[index % block_size];
+					counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+
+				// Callers must hold the registry mutex, which keeps the owning thread from growing the table
+				std::uint64_t read(std::size_t index) const
+				{
+					std::lock_guard<std::mutex> lock{growth};
+					auto const                  block = index / block_size;
+					return block < blocks.size() ? (*blocks[block])[index % block_size].load(std::memory_order_relaxed)
+					                             : 0;
+				}
+
+			private:
+				void grow(std::size_t block)
+				{
+					std::lock_guard<std::mutex> lock{growth};
+					while (blocks.size() <= block)
+					{
+						auto fresh = std::unique_ptr<counter_block>{new counter_block};
+						for (auto& counter : *fresh)
+						{
+							counter.store(0, std::memory_order_relaxed);
+						}
+						blocks.push_back(std::move(fresh));
+					}
+				}
+
+				mutable std::mutex                          growth;
+				std::vector<std::unique_ptr<counter_block>> blocks;
+			};
+
+			inline void registry::detach(thread_table* table)
+			{
+				std::lock_guard<std::mutex> lock{mutex};
+				for (std::size_t i = 0; i < keys.size(); ++i)
+				{
+					retired[i] += table->read(i);
+				}
+				tables.erase(std::remove(tables.begin(), tables.end(), table), tables.end());
+			}
+
+			inline std::vector<entry> registry::snapshot()
+			{
+				std::lock_guard<std::mutex> lock{mutex};
+				auto                        result = keys;
+				for (std::size_t i = 0; i < keys.size(); ++i)
+				{
+					result[i].count = retired[i];
+					for (auto table : tables)
+					{
+						result[i].count += table->read(i);
+					}
+				}
+				return result;
+			}
+
+			inline thread_table& local_table()
+			{
+				thread_local thread_table table;
+				return table;
+			}
+
+			inline std::string type_name(std::type_info const& type)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				int  status    = 0;
+				auto demangled = std::unique_ptr<char, void (*)(void*)>{
+				    abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free};
+				return status == 0 ? std::string{demangled.get()} : std::string{type.name()};
+#else
+				return type.name();
+#endif
+			}
+
+			template <typename Operation, typename FromRatio, typename ToRatio, typename UnitType>
+			void record(std::false_type)
+			{
+				static std::size_t const index = registry::instance().add(entry{Operation::name(),
+				                                                                FromRatio::num,
+				                                                                FromRatio::den,
+				                                                                ToRatio::num,
+				                                                                ToRatio::den,
+				                                                                type_name(typeid(UnitType)),
+				                                                                0});
+				local_table().increment(index);
+			}
+
+			// Same ratio on both sides means no conversion took place
+			template <typename Operation, typename FromRatio, typename ToRatio, typename UnitType>
+			void record(std::true_type)
+			{
+			}
+
+			template <typename Operation, typename FromRatio, typename ToRatio, typename UnitType>
+			constexpr void trace()
+			{
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+				if (__builtin_is_constant_evaluated())
+				{
+					return;
+				}
+#endif
+#endif
+				record<Operation, FromRatio, ToRatio, UnitType>(std::ratio_equal<FromRatio, ToRatio>{});
+			}
+		}
+
+		namespace detail
+		{
+			inline void print(std::ostream& os, std::vector<entry> entries)
+			{
+				entries.erase(std::remove_if(entries.begin(),
+				                             entries.end(),
+				                             [](entry const& e) { return e.count == 0; }),
+				              entries.end());
+				std::sort(entries.begin(), entries.end(), [](entry const& lhs, entry const& rhs) {
+					return lhs.count > rhs.count;
+				});
+
+				os << "units conversion statistics\n";
+				for (auto const& e : entries)
+				{
+					os << e.count << '\t' << e.operation << '\t' << e.from_num << '/' << e.from_den << " -> "
+					   << e.to_num << '/' << e.to_den << '\t' << e.unit_type << '\n';
+				}
+			}
+		}
+
+		// Totals for every conversion seen so far, across all threads
+		inline std::vector<entry> snapshot()
+		{
+			return detail::registry::instance().snapshot();
+		}
+
+		inline void report(std::ostream& os)
+		{
+			detail::print(os, snapshot());
+		}
+
+#ifdef UNITS_CONVERSION_STATS_REPORT_AT_EXIT
+		inline detail::registry::~registry()
+		{
+			print(std::cerr, snapshot());
+		}
+#endif
+	}
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Runtime detection of the instruction sets the bulk kernels can use. The features are queried with cpuid once, the
+// first time they are needed, and the best tier the processor and operating system support is chosen. Setting the
+// environment variable UNITS_CPU_TIER to one of scalar, sse4.2, avx2 or avx512 forces a lower tier, which is useful
+// for testing. Asking for a tier the machine cannot run falls back to the best supported one.
+
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define UNITS_X86_DISPATCH
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UNITS_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define UNITS_ALWAYS_INLINE inline
+#endif
+
+// Kernels are compiled once per tier by a macro taking the namespace to put them in, the tier and the attribute that
+// selects its instruction set, with a table() returning them. UNITS_FOR_EACH_TIER(Macro) instantiates Macro for every
+// tier the build can dispatch to and UNITS_TIER_TABLES(Namespace) lists their table() in the order
+// units::cpu::kernels_for takes them.
+#ifdef UNITS_X86_DISPATCH
+#define UNITS_FOR_EACH_TIER(Macro)                                                                                     \
+	Macro(scalar_kernels, ::units::cpu::tier::scalar, )                                                                \
+	Macro(sse42_kernels, ::units::cpu::tier::sse42, __attribute__((target("sse4.2"))))                                 \
+	Macro(avx2_kernels, ::units::cpu::tier::avx2, __attribute__((target("avx2"))))                                     \
+	Macro(avx512_kernels, ::units::cpu::tier::avx512, __attribute__((target("avx512f"))))
+#define UNITS_TIER_TABLES(Namespace)                                                                                   \
+	&Namespace::scalar_kernels::table, &Namespace::sse42_kernels::table, &Namespace::avx2_kernels::table,            \
+	    &Namespace::avx512_kernels::table
+#else
+#define UNITS_FOR_EACH_TIER(Macro) Macro(scalar_kernels, ::units::cpu::tier::scalar, )
+#define UNITS_TIER_TABLES(Namespace) &Namespace::scalar_kernels::table
+#endif
+
+namespace units
+{
+	namespace cpu
+	{
+		enum class tier
+		{
+			scalar,
+			sse42,
+			avx2,
+			avx512
+		};
+
+		struct features
+		{
+			bool sse42;
+			bool avx;
+			bool avx2;
+			bool fma;
+			bool f16c;
+			bool avx512f;
+		};
+
+		namespace detail
+		{
+#ifdef UNITS_X86_DISPATCH
+			inline unsigned long long xgetbv()
+			{
+				unsigned int eax = 0;
+				unsigned int edx = 0;
+				__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+				return (static_cast<unsigned long long>(edx) << 32) | eax;
+			}
+
+			inline features query()
+			{
+				auto result = features{};
+
+				unsigned int eax = 0;
+				unsigned int ebx = 0;
+				unsigned int ecx = 0;
+				unsigned int edx = 0;
+				if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+				{
+					return result;
+				}
+
+				result.sse42 = (ecx & (1u << 20)) != 0;
+
+				// AVX state has to be enabled by the operating system as well as supported by the processor
+				auto const osxsave   = (ecx & (1u << 27)) != 0;
+				auto const xcr0      = osxsave ? xgetbv() : 0;
+				auto const ymm_state = (xcr0 & 0x6) == 0x6;
+				auto const zmm_state = (xcr0 & 0xe6) == 0xe6;
+
+				result.avx  = ymm_state && (ecx & (1u << 28)) != 0;
+				result.fma  = result.avx && (ecx & (1u << 12)) != 0;
+				result.f16c = result.avx && (ecx & (1u << 29)) != 0;
+
+				if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+				{
+					result.avx2    = result.avx && (ebx & (1u << 5)) != 0;
+					result.avx512f = zmm_state && (ebx & (1u << 16)) != 0;
+				}
+
+				return result;
+			}
+#else
+			inline features query()
+			{
+				return features{};
+			}
+#endif
+
+			inline tier best(features const& f)
+			{
+				return f.avx512f ? tier::avx512 : f.avx2 ? tier::avx2 : f.sse42 ? tier::sse42 : tier::scalar;
+			}
+
+			inline tier select(features const& f, char const* forced)
+			{
+				auto const supported = best(f);
+				if (forced == nullptr)
+				{
+					return supported;
+				}
+
+				auto requested = supported;
+				if (std::strcmp(forced, "scalar") == 0)
+				{
+					requested = tier::scalar;
+				}
+				else if (std::strcmp(forced, "sse4.2") == 0)
+				{
+					requested = tier::sse42;
+				}
+				else if (std::strcmp(forced, "avx2") == 0)
+				{
+					requested = tier::avx2;
+				}
+				else if (std::strcmp(forced, "avx512") == 0)
+				{
+					requested = tier::avx512;
+				}
+
+				return requested < supported ? requested : supported;
+			}
+		}
+
+		inline features const& detected_features()
+		{
+			static features const f = detail::query();
+			return f;
+		}
+
+		inline bool supported(tier t)
+		{
+			return t <= detail::best(detected_features());
+		}
+
+		// The tier used by the bulk kernels, honouring UNITS_CPU_TIER
+		inline tier active_tier()
+		{
+			static tier const t = detail::select(detected_features(), std::getenv("UNITS_CPU_TIER"));
+			return t;
+		}
+
+		// The table of kernels for tier t, given the table() of the kernels for each tier. Asking for a tier the
+		// machine does not support returns the best supported one. Only the scalar table is needed when the build
+		// cannot dispatch.
+		template <typename Table>
+		Table const& kernels_for(tier t,
+		                         Table const& (*scalar)(),
+		                         Table const& (*sse42)()  = nullptr,
+		                         Table const& (*avx2)()   = nullptr,
+		                         Table const& (*avx512)() = nullptr)
+		{
+			if (!supported(t))
+			{
+				t = detail::best(detected_features());
+			}
+
+#ifdef UNITS_X86_DISPATCH
+			switch (t)
+			{
+			case tier::avx512: return avx512();
+			case tier::avx2: return avx2();
+			case tier::sse42: return sse42();
+			default: return scalar();
+			}
+#else
+			static_cast<void>(sse42);
+			static_cast<void>(avx2);
+			static_cast<void>(avx512);
+			return scalar();
+#endif
+		}
+
+		// The table Lookup gives for the active tier, looked up once on first use
+		template <typename Table, Table const& (*Lookup)(tier)>
+		Table const& active_kernels()
+		{
+			static Table const& table = Lookup(active_tier());
+			return table;
+		}
+
+		inline char const* name(tier t)
+		{
+			switch (t)
+			{
+			case tier::scalar: return "scalar";
+			case tier::sse42: return "sse4.2";
+			case tier::avx2: return "avx2";
+			case tier::avx512: return "avx512";
+			}
+			return "unknown";
+		}
+	}
+}
@@ -0,0 +1,482 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// A multithreaded reader for numeric CSV files whose headers carry units, such as distance_ft, mass[kg] or
+// area(sqm). The input is read in large blocks and every block is split between threads at line boundaries. Each
+// thread counts its rows, then parses them straight into the final position of typed, contiguous columns, scaling
+// every value from the unit in the header to the requested unit as it is parsed.
+//
+// Fields are not quoted. Empty fields become NaN in floating point columns. Integer columns round each scaled value to
+// the nearest integer, and a value that does not fit the column is an error.
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/catalogue.h"
+
+namespace units
+{
+	namespace csv
+	{
+		struct options
+		{
+			char        delimiter  = ',';
+			std::size_t threads    = std::max(1u, std::thread::hardware_concurrency());
+			std::size_t block_size = std::size_t{64} << 20;
+		};
+
+		template <typename Unit>
+		struct field
+		{
+			std::string name;
+		};
+
+		// Requests the column called name, or whose name without its unit is name, as Unit
+		template <typename Unit>
+		field<Unit> column(std::string name)
+		{
+			static_assert(is_unit<Unit>::value, "Columns must be read as units");
+			return field<Unit>{std::move(name)};
+		}
+
+		struct header_field
+		{
+			std::string name;
+			std::string unit;
+		};
+
+		namespace detail
+		{
+			inline std::string trim(std::string const& s)
+			{
+				auto const first = s.find_first_not_of(" \t\r\"");
+				auto const last  = s.find_last_not_of(" \t\r\"");
+				return first == std::string::npos ? std::string{} : s.substr(first, last - first + 1);
+			}
+
+			// Splits a header into its name and unit. name[unit] and name(unit) are always taken as units,
+			// name_unit only when unit is a known suffix.
+			inline header_field split_header(std::string const& text)
+			{
+				auto const header = trim(text);
+				if (!header.empty() && (header.back() == ']' || header.back() == ')'))
+				{
+					auto const open = header.find_last_of(header.back() == ']' ? '[' : '(');
+					if (open != std::string::npos)
+					{
+						return header_field{trim(header.substr(0, open)),
+						                    trim(header.substr(open + 1, header.size() - open - 2))};
+					}
+				}
+
+				auto const underscore = header.rfind('_');
+				if (underscore != std::string::npos && catalogue::find(header.substr(underscore + 1)) != nullptr)
+				{
+					return header_field{header.substr(0, underscore), header.substr(underscore + 1)};
+				}
+
+				return header_field{header, std::string{}};
+			}
+
+			inline std::vector<header_field> parse_header(std::string const& line, char delimiter)
+			{
+				auto fields = std::vector<header_field>{};
+				auto start  = std::size_t{0};
+				while (true)
+				{
+					auto const end = line.find(delimiter, start);
+					fields.push_back(split_header(line.substr(start, end == std::string::npos ? end : end - start)));
+					if (end == std::string::npos)
+					{
+						return fields;
+					}
+					start = end + 1;
+				}
+			}
+
+			// Where parsed values of one header field go
+			struct sink
+			{
+				double factor;
+				bool   nullable;
+				void*  data;
+				bool (*store)(void*, std::size_t, double);
+			};
+
+			template <typename Rep>
+			bool fits(double value, std::true_type)
+			{
+				return !std::isfinite(value) || std::abs(value) <= static_cast<double>(std::numeric_limits<Rep>::max());
+			}
+
+			template <typename Rep>
+			bool fits(double, std::false_type)
+			{
+				return true;
+			}
+
+			template <typename Rep>
+			bool to_rep(double value, Rep& out, std::true_type)
+			{
+				value = std::round(value);
+				if (!(value >= static_cast<double>(std::numeric_limits<Rep>::lowest())
+				      && value < static_cast<double>(std::numeric_limits<Rep>::max()) + 1.0))
+				{
+					return false;
+				}
+				out = static_cast<Rep>(value);
+				return true;
+			}
+
+			template <typename Rep>
+			bool to_rep(double value, Rep& out, std::false_type)
+			{
+				if (!fits<Rep>(value, std::is_floating_point<Rep>{}))
+				{
+					return false;
+				}
+				out = static_cast<Rep>(value);
+				return true;
+			}
+
+			// Returns false if the value does not fit the rep of Unit
+			template <typename Unit>
+			bool store(void* data, std::size_t row, double value)
+			{
+				auto rep = typename Unit::rep{};
+				if (!to_rep(value, rep, std::is_integral<typename Unit::rep>{}))
+				{
+					return false;
+				}
+				static_cast<Unit*>(data)[row] = Unit{rep};
+				return true;
+			}
+
+			template <typename Unit>
+			sink make_sink(std::vector<header_field> const& header, field<Unit> const& request, std::size_t& index)
+			{
+				auto const found = std::find_if(header.begin(), header.end(), [&](header_field const& h) {
+					return h.name == request.name || (h.name + "_" + h.unit) == request.name
+					       || (h.name + "[" + h.unit + "]") == request.name;
+				});
+				if (found == header.end())
+				{
+					throw std::invalid_argument{"No column named " + request.name};
+				}
+				index = static_cast<std::size_t>(found - header.begin());
+
+				auto const target = catalogue::scale<typename Unit::ratio>();
+				auto       source = target;
+				if (!found->unit.empty())
+				{
+					auto const unit = catalogue::find(found->unit);
+					if (unit == nullptr)
+					{
+						throw std::invalid_argument{"Unknown unit " + found->unit + " in column " + request.name};
+					}
+					if (unit->unit_type != catalogue::unit_type_id<typename Unit::unit_type>::value)
+					{
+						throw std::invalid_argument{"Column " + request.name + " has an incompatible unit type"};
+					}
+					source = unit->scale;
+				}
+
+				return sink{static_cast<double>(source / target),
+				            std::is_floating_point<typename Unit::rep>::value,
+				            nullptr,
+				            &store<Unit>};
+			}
+
+			struct layout
+			{
+				std::vector<int>  field_sink;
+				std::vector<sink> sinks;
+				std::size_t       last_field;
+			};
+
+			inline char const* next_line(char const* first, char const* last)
+			{
+				auto const newline = static_cast<char const*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+				return newline == nullptr ? last : newline + 1;
+			}
+
+			inline bool is_blank(char const* first, char const* last)
+			{
+				return first == last || (last - first == 1 && (*first == '\n' || *first == '\r'))
+				       || (last - first == 2 && first[0] == '\r' && first[1] == '\n');
+			}
+
+			inline std::size_t count_rows(char const* first, char const* last)
+			{
+				std::size_t rows = 0;
+				while (first != last)
+				{
+					auto const end = next_line(first, last);
+					rows += !is_blank(first, end);
+					first = end;
+				}
+				return rows;
+			}
+
+			inline void parse_rows(char const* first, char const* last, layout const& l, char delimiter, std::size_t row)
+			{
+				while (first != last)
+				{
+					auto line_end = next_line(first, last);
+					if (is_blank(first, line_end))
+					{
+						first = line_end;
+						continue;
+					}
+
+					auto const next_first = line_end;
+					while (line_end != first && (line_end[-1] == '\n' || line_end[-1] == '\r'))
+					{
+						--line_end;
+					}
+
+					auto field = first;
+					for (std::size_t index = 0; index <= l.last_field; ++index)
+					{
+						if (field > line_end)
+						{
+							throw std::invalid_argument{"Row " + std::to_string(row) + " has too few fields"};
+						}
+
+						auto field_end = static_cast<char const*>(
+						    std::memchr(field, delimiter, static_cast<std::size_t>(line_end - field)));
+						field_end = field_end == nullptr ? line_end : field_end;
+
+						auto const sink_index = l.field_sink[index];
+						if (sink_index >= 0)
+						{
+							auto const& s     = l.sinks[static_cast<std::size_t>(sink_index)];
+							auto        value = 0.0;
+							if (field == field_end && s.nullable)
+							{
+								value = std::numeric_limits<double>::quiet_NaN();
+							}
+							else if (!units::detail::parse_number(field, field_end, value))
+							{
+								throw std::invalid_argument{"Malformed number in row " + std::to_string(row) + ": "
+								                            + std::string{field, field_end}};
+							}
+							if (!s.store(s.data, row, value * s.factor))
+							{
+								throw std::invalid_argument{"Number out of range in row " + std::to_string(row) + ": "
+								                            + std::string{field, field_end}};
+							}
+						}
+
+						field = field_end + 1;
+					}
+
+					++row;
+					first = next_first;
+				}
+			}
+
+			// Splits [first, last) into at most pieces ranges that end on line boundaries
+			inline std::vector<std::pair<char const*, char const*>> split(char const* first,
+			                                                               char const* last,
+			                                                               std::size_t pieces)
+			{
+				auto       result = std::vector<std::pair<char const*, char const*>>{};
+				auto const size   = static_cast<std::size_t>(last - first);
+				auto       start  = first;
+				for (std::size_t i = 1; i <= pieces && start != last; ++i)
+				{
+					auto end = i == pieces ? last : first + size * i / pieces;
+					end      = end <= start ? start : end;
+					end      = end == last ? last : next_line(end, last);
+					if (end != start)
+					{
+						result.emplace_back(start, end);
+					}
+					start = end;
+				}
+				return result;
+			}
+
+			template <typename Work>
+			void run_parallel(std::size_t count, Work const& work)
+			{
+				auto tasks = std::vector<std::future<void>>{};
+				for (std::size_t i = 1; i < count; ++i)
+				{
+					tasks.push_back(std::async(std::launch::async, work, i));
+				}
+				work(0);
+				for (auto& task : tasks)
+				{
+					task.get();
+				}
+			}
+
+			template <typename Columns, std::size_t... Indices>
+			void bind(layout& l, Columns& columns, std::index_sequence<Indices...>)
+			{
+				auto const data = std::vector<void*>{static_cast<void*>(std::get<Indices>(columns).data())...};
+				for (std::size_t i = 0; i < l.sinks.size(); ++i)
+				{
+					l.sinks[i].data = data[i];
+				}
+			}
+
+			template <typename Columns, std::size_t... Indices>
+			void resize(Columns& columns, std::size_t size, std::index_sequence<Indices...>)
+			{
+				using expand = int[];
+				static_cast<void>(expand{
+				    0, (std::get<Indices>(columns).resize(size, typename std::tuple_element<Indices, Columns>::type::value_type{0}), 0)...});
+			}
+
+			template <typename Columns, typename Indices>
+			void parse_block(char const* first,
+			                 char const* last,
+			                 layout&     l,
+			                 Columns&    columns,
+			                 std::size_t& rows,
+			                 options const& opts)
+			{
+				auto const pieces = split(first, last, opts.threads);
+				auto       counts = std::vector<std::size_t>(pieces.size());
+				run_parallel(pieces.size(), [&](std::size_t i) { counts[i] = count_rows(pieces[i].first, pieces[i].second); });
+
+				auto offsets = std::vector<std::size_t>(pieces.size());
+				for (std::size_t i = 0; i < pieces.size(); ++i)
+				{
+					offsets[i] = rows;
+					rows += counts[i];
+				}
+
+				resize(columns, rows, Indices{});
+				bind(l, columns, Indices{});
+				run_parallel(pieces.size(), [&](std::size_t i) {
+					parse_rows(pieces[i].first, pieces[i].second, l, opts.delimiter, offsets[i]);
+				});
+			}
+		}
+
+		// Reads the header of a CSV stream
+		inline std::vector<header_field> read_header(std::istream& in, char delimiter = ',')
+		{
+			auto line = std::string{};
+			if (!std::getline(in, line))
+			{
+				throw std::runtime_error{"CSV input has no header"};
+			}
+			return detail::parse_header(line, delimiter);
+		}
+
+		template <typename... Units>
+		std::tuple<std::vector<Units>...> read(std::istream& in, options const& opts, field<Units> const&... fields)
+		{
+			static_assert(sizeof...(Units) > 0, "Request at least one column");
+
+			auto const header  = read_header(in, opts.delimiter);
+			auto       l       = detail::layout{std::vector<int>(header.size(), -1), {}, 0};
+			auto       indices = std::vector<std::size_t>(sizeof...(Units));
+			auto       next    = std::size_t{0};
+			l.sinks            = std::vector<detail::sink>{detail::make_sink(header, fields, indices[next++])...};
+			for (std::size_t i = 0; i < indices.size(); ++i)
+			{
+				l.field_sink[indices[i]] = static_cast<int>(i);
+				l.last_field             = std::max(l.last_field, indices[i]);
+			}
+
+			using index_sequence = std::index_sequence_for<Units...>;
+
+			auto columns = std::tuple<std::vector<Units>...>{};
+			auto rows    = std::size_t{0};
+			auto buffer  = std::vector<char>{};
+			auto carry   = std::size_t{0};
+			while (in)
+			{
+				buffer.resize(carry + opts.block_size);
+				in.read(buffer.data() + carry, static_cast<std::streamsize>(opts.block_size));
+				auto const size = carry + static_cast<std::size_t>(in.gcount());
+
+				// Everything up to the last newline is complete, the rest waits for the next block
+				auto cut = size;
+				if (in)
+				{
+					while (cut != 0 && buffer[cut - 1] != '\n')
+					{
+						--cut;
+					}
+				}
+
+				detail::parse_block<decltype(columns), index_sequence>(
+				    buffer.data(), buffer.data() + cut, l, columns, rows, opts);
+
+				carry = size - cut;
+				std::memmove(buffer.data(), buffer.data() + cut, carry);
+			}
+
+			return columns;
+		}
+
+		template <typename... Units>
+		std::tuple<std::vector<Units>...> read(std::istream& in, field<Units> const&... fields)
+		{
+			return read(in, options{}, fields...);
+		}
+
+		template <typename... Units>
+		std::tuple<std::vector<Units>...> read(std::string const& path, options const& opts, field<Units> const&... fields)
+		{
+			auto file = std::ifstream{path, std::ios::binary};
+			if (!file)
+			{
+				throw std::runtime_error{"Cannot open " + path};
+			}
+			return read(file, opts, fields...);
+		}
+
+		template <typename... Units>
+		std::tuple<std::vector<Units>...> read(std::string const& path, field<Units> const&... fields)
+		{
+			return read(path, options{}, fields...);
+		}
+	}
+}
@@ -0,0 +1,727 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// A double-double representation for units of large magnitude. The astronomical aliases in units.h use long double,
+// which on x86-64 is x87 arithmetic that cannot be vectorised. double_double keeps a value as the unevaluated sum of
+// two doubles, giving about 106 bits of significand from SSE or AVX arithmetic, and units::dd has the astronomical
+// aliases with it as their rep. units::dd::cast and units::dd::sum are the batch forms, vectorised for each tier in
+// units/cpu_dispatch.h.
+//
+// The algorithms assume IEEE double arithmetic rounding to nearest. Do not build them with -ffast-math or
+// -fassociative-math, which simplify the error terms away.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#ifndef UNITS_DISABLE_IOSTREAM
+#include <ostream>
+#endif
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/cpu_dispatch.h"
+
+namespace units
+{
+	struct double_double;
+
+	namespace detail
+	{
+		template <typename T>
+		constexpr double integral_low(T value, double hi)
+		{
+			// hi can round up to 2^63, which does not fit back into a 64 bit integer
+			return std::numeric_limits<T>::digits > std::numeric_limits<double>::digits
+			               && hi >= static_cast<double>(std::numeric_limits<T>::max())
+			           ? -static_cast<double>(std::numeric_limits<T>::max() - value) - 1.0
+			           : static_cast<T>(hi) > value ? -static_cast<double>(static_cast<T>(hi) - value)
+			                                        : static_cast<double>(value - static_cast<T>(hi));
+		}
+
+		template <typename T>
+		constexpr double floating_low(T value, double hi)
+		{
+			return hi - hi == 0 ? static_cast<double>(value - static_cast<T>(hi)) : 0.0;
+		}
+	}
+
+	// The value hi + lo, where hi is the value rounded to double and |lo| is at most half an ulp of hi
+	struct double_double
+	{
+		double hi;
+		double lo;
+
+		constexpr double_double()
+		    : hi{0}
+		    , lo{0}
+		{
+		}
+
+		// hi must be hi + lo rounded to double
+		constexpr double_double(double hi, double lo)
+		    : hi{hi}
+		    , lo{lo}
+		{
+		}
+
+		template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+		constexpr double_double(T value)
+		    : hi{static_cast<double>(value)}
+		    , lo{detail::floating_low(value, static_cast<double>(value))}
+		{
+		}
+
+		template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+		constexpr double_double(T value)
+		    : hi{static_cast<double>(value)}
+		    , lo{detail::integral_low(value, static_cast<double>(value))}
+		{
+		}
+
+		// Rounds to double, which is what unit_compare and the std::isless family compare in
+		constexpr operator double() const { return hi; }
+
+		template <typename T,
+		          typename std::enable_if<std::is_floating_point<T>::value && !std::is_same<T, double>::value, int>::
+		              type = 0>
+		constexpr explicit operator T() const
+		{
+			return static_cast<T>(hi) + static_cast<T>(lo);
+		}
+
+		// Truncates towards zero like the built in conversions
+		template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+		explicit operator T() const
+		{
+			auto const whole = std::trunc(hi);
+			auto const rest  = (hi - whole) + lo;
+			return static_cast<T>(static_cast<T>(whole) - static_cast<T>(whole > 0 && rest < 0)
+			                      + static_cast<T>(whole < 0 && rest > 0));
+		}
+
+		double_double& operator+=(double_double const& other);
+		double_double& operator-=(double_double const& other);
+		double_double& operator*=(double_double const& other);
+		double_double& operator/=(double_double const& other);
+
+		double_double& operator++();
+		double_double  operator++(int);
+		double_double& operator--();
+		double_double  operator--(int);
+	};
+
+	namespace detail
+	{
+		// a + b exactly, for |a| >= |b|
+		UNITS_ALWAYS_INLINE double_double quick_two_sum(double a, double b)
+		{
+			auto const sum = a + b;
+			return double_double{sum, b - (sum - a)};
+		}
+
+		// a + b exactly
+		UNITS_ALWAYS_INLINE double_double two_sum(double a, double b)
+		{
+			auto const sum = a + b;
+			auto const b_virtual = sum - a;
+			auto const a_virtual = sum - b_virtual;
+			return double_double{sum, (a - a_virtual) + (b - b_virtual)};
+		}
+
+		// a * b exactly. Without a fused multiply add, which std::fma only is when the target has one, Dekker's
+		// product splits each factor into halves whose products are exact.
+		UNITS_ALWAYS_INLINE double_double two_product(double a, double b)
+		{
+			auto const product = a * b;
+#if defined(__FMA__) || defined(__FP_FAST_FMA)
+			return double_double{product, std::fma(a, b, -product)};
+#else
+			constexpr double splitter = 134217729.0; // 2^27 + 1
+
+			auto const a_scaled = splitter * a;
+			auto const a_hi     = a_scaled - (a_scaled - a);
+			auto const a_lo     = a - a_hi;
+			auto const b_scaled = splitter * b;
+			auto const b_hi     = b_scaled - (b_scaled - b);
+			auto const b_lo     = b - b_hi;
+			return double_double{product, ((a_hi * b_hi - product) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo};
+#endif
+		}
+
+		template <typename T, typename Result = double_double>
+		using if_arithmetic = typename std::enable_if<std::is_arithmetic<T>::value, Result>::type;
+	}
+
+	inline double_double operator-(double_double const& value)
+	{
+		return double_double{-value.hi, -value.lo};
+	}
+
+	inline double_double operator+(double_double const& lhs, double_double const& rhs)
+	{
+		auto       sum   = detail::two_sum(lhs.hi, rhs.hi);
+		auto const error = detail::two_sum(lhs.lo, rhs.lo);
+		sum              = detail::quick_two_sum(sum.hi, sum.lo + error.hi);
+		return detail::quick_two_sum(sum.hi, sum.lo + error.lo);
+	}
+
+	inline double_double operator-(double_double const& lhs, double_double const& rhs)
+	{
+		return lhs + -rhs;
+	}
+
+	inline double_double operator*(double_double const& lhs, double_double const& rhs)
+	{
+		auto const product = detail::two_product(lhs.hi, rhs.hi);
+		return detail::quick_two_sum(product.hi, product.lo + (lhs.hi * rhs.lo + lhs.lo * rhs.hi));
+	}
+
+	// Divides by the leading double and corrects the quotient with the exact remainder
+	inline double_double operator/(double_double const& lhs, double_double const& rhs)
+	{
+		auto const quotient  = lhs.hi / rhs.hi;
+		auto const product   = rhs * double_double{quotient, 0};
+		auto const remainder = detail::two_sum(lhs.hi, -product.hi);
+		auto const error     = (remainder.hi + ((remainder.lo - product.lo) + lhs.lo)) / rhs.hi;
+		return detail::quick_two_sum(quotient, error);
+	}
+
+	inline bool operator==(double_double const& lhs, double_double const& rhs)
+	{
+		return lhs.hi == rhs.hi && lhs.lo == rhs.lo;
+	}
+
+	inline bool operator!=(double_double const& lhs, double_double const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	inline bool operator<(double_double const& lhs, double_double const& rhs)
+	{
+		return lhs.hi < rhs.hi || (lhs.hi == rhs.hi && lhs.lo < rhs.lo);
+	}
+
+	inline bool operator>(double_double const& lhs, double_double const& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	inline bool operator<=(double_double const& lhs, double_double const& rhs)
+	{
+		return lhs.hi < rhs.hi || (lhs.hi == rhs.hi && lhs.lo <= rhs.lo);
+	}
+
+	inline bool operator>=(double_double const& lhs, double_double const& rhs)
+	{
+		return rhs <= lhs;
+	}
+
+	// Mixed with built in arithmetic types, which are converted exactly first
+	template <typename T>
+	detail::if_arithmetic<T> operator+(double_double const& lhs, T rhs)
+	{
+		return lhs + double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator+(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} + rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator-(double_double const& lhs, T rhs)
+	{
+		return lhs - double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator-(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} - rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator*(double_double const& lhs, T rhs)
+	{
+		return lhs * double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator*(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} * rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator/(double_double const& lhs, T rhs)
+	{
+		return lhs / double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T> operator/(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} / rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator==(double_double const& lhs, T rhs)
+	{
+		return lhs == double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator==(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} == rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator!=(double_double const& lhs, T rhs)
+	{
+		return lhs != double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator!=(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} != rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator<(double_double const& lhs, T rhs)
+	{
+		return lhs < double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator<(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} < rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator>(double_double const& lhs, T rhs)
+	{
+		return lhs > double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator>(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} > rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator<=(double_double const& lhs, T rhs)
+	{
+		return lhs <= double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator<=(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} <= rhs;
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator>=(double_double const& lhs, T rhs)
+	{
+		return lhs >= double_double{rhs};
+	}
+
+	template <typename T>
+	detail::if_arithmetic<T, bool> operator>=(T lhs, double_double const& rhs)
+	{
+		return double_double{lhs} >= rhs;
+	}
+
+	inline double_double& double_double::operator+=(double_double const& other)
+	{
+		return *this = *this + other;
+	}
+
+	inline double_double& double_double::operator-=(double_double const& other)
+	{
+		return *this = *this - other;
+	}
+
+	inline double_double& double_double::operator*=(double_double const& other)
+	{
+		return *this = *this * other;
+	}
+
+	inline double_double& double_double::operator/=(double_double const& other)
+	{
+		return *this = *this / other;
+	}
+
+	inline double_double& double_double::operator++()
+	{
+		return *this += double_double{1.0};
+	}
+
+	inline double_double double_double::operator++(int)
+	{
+		auto const temp = *this;
+		++*this;
+		return temp;
+	}
+
+	inline double_double& double_double::operator--()
+	{
+		return *this -= double_double{1.0};
+	}
+
+	inline double_double double_double::operator--(int)
+	{
+		auto const temp = *this;
+		--*this;
+		return temp;
+	}
+
+	inline double_double abs(double_double const& value)
+	{
+		return value.hi < 0 ? -value : value;
+	}
+
+	// One Newton step from the double square root doubles its precision
+	inline double_double sqrt(double_double const& value)
+	{
+		if (!(value.hi > 0) || value.hi - value.hi != 0)
+		{
+			return double_double{std::sqrt(value.hi), 0};
+		}
+
+		auto const root     = std::sqrt(value.hi);
+		auto const residual = value - detail::two_product(root, root);
+		return detail::quick_two_sum(root, residual.hi / (2 * root));
+	}
+
+#ifndef UNITS_DISABLE_IOSTREAM
+	template <typename CharT, typename Traits>
+	std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, double_double const& value)
+	{
+		return os << static_cast<long double>(value);
+	}
+#endif
+
+	namespace dd
+	{
+		// The astronomical aliases of units.h with double_double counts
+		using earth_radii        = distance<double_double, units::earth_radii::ratio>;
+		using lunar_distances    = distance<double_double, units::lunar_distances::ratio>;
+		using astronimical_units = distance<double_double, units::astronimical_units::ratio>;
+		using light_years        = distance<double_double, units::light_years::ratio>;
+		using parsecs            = distance<double_double, units::parsecs::ratio>;
+
+		// Each kernel takes double_double values as pairs of doubles, high part first
+		struct kernel_table
+		{
+			cpu::tier tier;
+			void (*scale)(double const*, std::size_t, double_double, double*);
+			void (*narrow)(double const*, std::size_t, double_double, double*);
+			void (*widen)(double const*, std::size_t, double_double, double*);
+			double_double (*sum)(double const*, std::size_t);
+		};
+
+		namespace detail
+		{
+			namespace kernels
+			{
+				constexpr std::size_t lanes = 8;
+
+				UNITS_ALWAYS_INLINE void scale(double const* in, std::size_t n, double_double factor, double* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto const product = double_double{in[2 * i], in[2 * i + 1]} * factor;
+						out[2 * i]         = product.hi;
+						out[2 * i + 1]     = product.lo;
+					}
+				}
+
+				UNITS_ALWAYS_INLINE void narrow(double const* in, std::size_t n, double_double factor, double* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = (double_double{in[2 * i], in[2 * i + 1]} * factor).hi;
+					}
+				}
+
+				UNITS_ALWAYS_INLINE void widen(double const* in, std::size_t n, double_double factor, double* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto const product = units::detail::two_product(in[i], factor.hi);
+						auto const result  = units::detail::quick_two_sum(product.hi, product.lo + in[i] * factor.lo);
+						out[2 * i]         = result.hi;
+						out[2 * i + 1]     = result.lo;
+					}
+				}
+
+				// Keeps one running sum per lane, so the additions are independent and vectorise
+				UNITS_ALWAYS_INLINE double_double sum(double const* in, std::size_t n)
+				{
+					double hi[lanes] = {};
+					double lo[lanes] = {};
+
+					std::size_t i = 0;
+					for (; i + lanes <= n; i += lanes)
+					{
+						for (std::size_t j = 0; j < lanes; ++j)
+						{
+							auto const total = double_double{hi[j], lo[j]}
+							                   + double_double{in[2 * (i + j)], in[2 * (i + j) + 1]};
+							hi[j] = total.hi;
+							lo[j] = total.lo;
+						}
+					}
+
+					auto total = double_double{};
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						total += double_double{hi[j], lo[j]};
+					}
+					for (; i < n; ++i)
+					{
+						total += double_double{in[2 * i], in[2 * i + 1]};
+					}
+					return total;
+				}
+			}
+
+// Instantiates the batch kernels for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_DOUBLE_DOUBLE_TIER(Name, Tier, Target)                                                                   \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		Target inline void scale(double const* in, std::size_t n, double_double factor, double* out)                  \
+		{                                                                                                              \
+			kernels::scale(in, n, factor, out);                                                                        \
+		}                                                                                                              \
+                                                                                                                       \
+		Target inline void narrow(double const* in, std::size_t n, double_double factor, double* out)                 \
+		{                                                                                                              \
+			kernels::narrow(in, n, factor, out);                                                                       \
+		}                                                                                                              \
+                                                                                                                       \
+		Target inline void widen(double const* in, std::size_t n, double_double factor, double* out)                  \
+		{                                                                                                              \
+			kernels::widen(in, n, factor, out);                                                                        \
+		}                                                                                                              \
+                                                                                                                       \
+		Target inline double_double sum(double const* in, std::size_t n)                                               \
+		{                                                                                                              \
+			return kernels::sum(in, n);                                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		inline dd::kernel_table const& table()                                                                         \
+		{                                                                                                              \
+			static dd::kernel_table const t{Tier, &scale, &narrow, &widen, &sum};                                      \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+			UNITS_FOR_EACH_TIER(UNITS_DOUBLE_DOUBLE_TIER)
+
+#undef UNITS_DOUBLE_DOUBLE_TIER
+
+			// The factor unit_cast applies, to double_double precision
+			template <typename From, typename To>
+			double_double conversion_factor()
+			{
+				using ratio = std::ratio_divide<To, From>;
+				return double_double{ratio::den} / double_double{ratio::num};
+			}
+
+			template <typename Rep>
+			double const* pairs(Rep const* values)
+			{
+				return reinterpret_cast<double const*>(values);
+			}
+
+			template <typename Rep>
+			double* pairs(Rep* values)
+			{
+				return reinterpret_cast<double*>(values);
+			}
+
+			struct scale_tag
+			{
+			};
+
+			struct narrow_tag
+			{
+			};
+
+			struct widen_tag
+			{
+			};
+
+			struct transform_tag
+			{
+			};
+
+			template <typename From, typename To>
+			struct cast_tag
+			{
+				using type = transform_tag;
+			};
+
+			template <>
+			struct cast_tag<double_double, double_double>
+			{
+				using type = scale_tag;
+			};
+
+			template <>
+			struct cast_tag<double_double, double>
+			{
+				using type = narrow_tag;
+			};
+
+			template <>
+			struct cast_tag<double, double_double>
+			{
+				using type = widen_tag;
+			};
+		}
+
+		// The kernels for a given tier, or the best supported one if the machine cannot run it
+		inline kernel_table const& kernels(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(detail));
+		}
+
+		// The kernels bound to the active tier, chosen once on first use
+		inline kernel_table const& kernels()
+		{
+			return cpu::active_kernels<kernel_table, &kernels>();
+		}
+
+		namespace detail
+		{
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			ToUnit* cast(unit<Rep, Ratio, UnitType> const* first,
+			             unit<Rep, Ratio, UnitType> const* last,
+			             ToUnit*                           out,
+			             scale_tag)
+			{
+				auto const count = static_cast<std::size_t>(last - first);
+				dd::kernels().scale(pairs(units::detail::raw(first)),
+				                    count,
+				                    conversion_factor<Ratio, typename ToUnit::ratio>(),
+				                    pairs(units::detail::raw(out)));
+				return out + count;
+			}
+
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			ToUnit* cast(unit<Rep, Ratio, UnitType> const* first,
+			             unit<Rep, Ratio, UnitType> const* last,
+			             ToUnit*                           out,
+			             narrow_tag)
+			{
+				auto const count = static_cast<std::size_t>(last - first);
+				dd::kernels().narrow(pairs(units::detail::raw(first)),
+				                     count,
+				                     conversion_factor<Ratio, typename ToUnit::ratio>(),
+				                     units::detail::raw(out));
+				return out + count;
+			}
+
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			ToUnit* cast(unit<Rep, Ratio, UnitType> const* first,
+			             unit<Rep, Ratio, UnitType> const* last,
+			             ToUnit*                           out,
+			             widen_tag)
+			{
+				auto const count = static_cast<std::size_t>(last - first);
+				dd::kernels().widen(units::detail::raw(first),
+				                    count,
+				                    conversion_factor<Ratio, typename ToUnit::ratio>(),
+				                    pairs(units::detail::raw(out)));
+				return out + count;
+			}
+
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			ToUnit* cast(unit<Rep, Ratio, UnitType> const* first,
+			             unit<Rep, Ratio, UnitType> const* last,
+			             ToUnit*                           out,
+			             transform_tag)
+			{
+				return std::transform(
+				    first, last, out, [](unit<Rep, Ratio, UnitType> u) { return unit_cast<ToUnit>(u); });
+			}
+		}
+
+		// Converts a range to or from double_double counts with one multiply by a double_double factor per element.
+		// Other reps are converted one at a time with unit_cast.
+		template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+		ToUnit* cast(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last, ToUnit* out)
+		{
+			static_assert(std::is_same<typename ToUnit::unit_type, UnitType>::value, "Incompatible types");
+
+			return detail::cast(first, last, out, typename detail::cast_tag<Rep, typename ToUnit::rep>::type{});
+		}
+
+		template <typename Ratio, typename UnitType>
+		unit<double_double, Ratio, UnitType> sum(unit<double_double, Ratio, UnitType> const* first,
+		                                         unit<double_double, Ratio, UnitType> const* last)
+		{
+			return unit<double_double, Ratio, UnitType>{
+			    kernels().sum(detail::pairs(units::detail::raw(first)), static_cast<std::size_t>(last - first))};
+		}
+	}
+}
+
+namespace std
+{
+	template <typename T>
+	struct common_type<units::double_double, T>
+	    : std::enable_if<std::is_arithmetic<T>::value || std::is_same<T, units::double_double>::value,
+	                     units::double_double>
+	{
+	};
+
+	template <typename T>
+	struct common_type<T, units::double_double>
+	    : std::enable_if<std::is_arithmetic<T>::value || std::is_same<T, units::double_double>::value,
+	                     units::double_double>
+	{
+	};
+
+	template <>
+	struct common_type<units::double_double, units::double_double>
+	{
+		using type = units::double_double;
+	};
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// The aliases of units.h for any rep. units::family<Rep> holds every alias with Rep counts, and the namespaces f32,
+// f64, i32 and i64 hold them for float, double, std::int32_t and std::int64_t together with literals:
+//
+//     using namespace units::f32::distance_literals;
+//     auto const track = std::vector<units::f32::metres>(n, 0_m);
+//
+// The ratios are taken from the aliases in units.h, so the stream suffixes and the catalogue entries of a family
+// alias are those of the alias it mirrors.
+
+#include <cstdint>
+
+#include "units.h"
+
+// The alias catalogue with counts of type Rep
+#define UNITS_FAMILY_ALIASES(Rep)                                                                                      \
+	using nanometres  = distance<Rep, units::nanometres::ratio>;                                                       \
+	using micrometres = distance<Rep, units::micrometres::ratio>;                                                      \
+	using millimetres = distance<Rep, units::millimetres::ratio>;                                                      \
+	using centimetres = distance<Rep, units::centimetres::ratio>;                                                      \
+	using decimetres  = distance<Rep, units::decimetres::ratio>;                                                       \
+	using metres      = distance<Rep, units::metres::ratio>;                                                           \
+	using kilometres  = distance<Rep, units::kilometres::ratio>;                                                       \
+                                                                                                                       \
+	using nanometers  = nanometres;                                                                                    \
+	using micrometers = micrometres;                                                                                   \
+	using millimeters = millimetres;                                                                                   \
+	using centimeters = centimetres;                                                                                   \
+	using decimeters  = decimetres;                                                                                    \
+	using meters      = metres;                                                                                        \
+	using kilometers  = kilometres;                                                                                    \
+                                                                                                                       \
+	using feet     = distance<Rep, units::feet::ratio>;                                                                \
+	using thous    = distance<Rep, units::thous::ratio>;                                                               \
+	using inches   = distance<Rep, units::inches::ratio>;                                                              \
+	using links    = distance<Rep, units::links::ratio>;                                                               \
+	using yards    = distance<Rep, units::yards::ratio>;                                                               \
+	using rods     = distance<Rep, units::rods::ratio>;                                                                \
+	using chains   = distance<Rep, units::chains::ratio>;                                                              \
+	using furlongs = distance<Rep, units::furlongs::ratio>;                                                            \
+	using miles    = distance<Rep, units::miles::ratio>;                                                               \
+	using leagues  = distance<Rep, units::leagues::ratio>;                                                             \
+                                                                                                                       \
+	using fathoms        = distance<Rep, units::fathoms::ratio>;                                                       \
+	using cables         = distance<Rep, units::cables::ratio>;                                                        \
+	using nautical_miles = distance<Rep, units::nautical_miles::ratio>;                                                \
+                                                                                                                       \
+	using earth_radii        = distance<Rep, units::earth_radii::ratio>;                                               \
+	using lunar_distances    = distance<Rep, units::lunar_distances::ratio>;                                           \
+	using astronimical_units = distance<Rep, units::astronimical_units::ratio>;                                        \
+	using light_years        = distance<Rep, units::light_years::ratio>;                                               \
+	using parsecs            = distance<Rep, units::parsecs::ratio>;                                                   \
+                                                                                                                       \
+	using picograms  = mass<Rep, units::picograms::ratio>;                                                             \
+	using nanograms  = mass<Rep, units::nanograms::ratio>;                                                             \
+	using micrograms = mass<Rep, units::micrograms::ratio>;                                                            \
+	using milligrams = mass<Rep, units::milligrams::ratio>;                                                            \
+	using grams      = mass<Rep, units::grams::ratio>;                                                                 \
+	using kilograms  = mass<Rep, units::kilograms::ratio>;                                                             \
+	using tons       = mass<Rep, units::tons::ratio>;                                                                  \
+                                                                                                                       \
+	using pounds             = mass<Rep, units::pounds::ratio>;                                                        \
+	using grains             = mass<Rep, units::grains::ratio>;                                                        \
+	using drams              = mass<Rep, units::drams::ratio>;                                                         \
+	using ounces             = mass<Rep, units::ounces::ratio>;                                                        \
+	using us_hundredweight   = mass<Rep, units::us_hundredweight::ratio>;                                              \
+	using long_hundredweight = mass<Rep, units::long_hundredweight::ratio>;                                            \
+	using short_ton          = mass<Rep, units::short_ton::ratio>;                                                     \
+	using long_ton           = mass<Rep, units::long_ton::ratio>;                                                      \
+                                                                                                                       \
+	using square_metres      = area<Rep, units::metres::ratio>;                                                        \
+	using square_centimetres = area<Rep, units::centimetres::ratio>;                                                   \
+	using square_feet        = area<Rep, units::feet::ratio>;
+
+#define UNITS_FAMILY_LITERAL(Alias, Suffix)                                                                            \
+	constexpr Alias operator"" Suffix(unsigned long long int value)                                                    \
+	{                                                                                                                  \
+		return Alias{static_cast<Alias::rep>(value)};                                                                  \
+	}
+
+// The literals of units.h, returning the aliases of the enclosing family
+#define UNITS_FAMILY_LITERALS                                                                                          \
+	namespace distance_literals                                                                                        \
+	{                                                                                                                  \
+		UNITS_FAMILY_LITERAL(nanometres, _nm)                                                                          \
+		UNITS_FAMILY_LITERAL(micrometres, _um)                                                                         \
+		UNITS_FAMILY_LITERAL(millimetres, _mm)                                                                         \
+		UNITS_FAMILY_LITERAL(centimetres, _cm)                                                                         \
+		UNITS_FAMILY_LITERAL(decimetres, _dm)                                                                          \
+		UNITS_FAMILY_LITERAL(metres, _m)                                                                               \
+		UNITS_FAMILY_LITERAL(kilometres, _km)                                                                          \
+                                                                                                                       \
+		UNITS_FAMILY_LITERAL(thous, _th)                                                                               \
+		UNITS_FAMILY_LITERAL(inches, _in)                                                                              \
+		UNITS_FAMILY_LITERAL(links, _li)                                                                               \
+		UNITS_FAMILY_LITERAL(feet, _ft)                                                                                \
+		UNITS_FAMILY_LITERAL(yards, _yd)                                                                               \
+		UNITS_FAMILY_LITERAL(rods, _rd)                                                                                \
+		UNITS_FAMILY_LITERAL(chains, _ch)                                                                              \
+		UNITS_FAMILY_LITERAL(furlongs, _fur)                                                                           \
+		UNITS_FAMILY_LITERAL(miles, _mi)                                                                               \
+		UNITS_FAMILY_LITERAL(leagues, _lea)                                                                            \
+                                                                                                                       \
+		UNITS_FAMILY_LITERAL(fathoms, _ftm)                                                                            \
+		UNITS_FAMILY_LITERAL(cables, _cb)                                                                              \
+		UNITS_FAMILY_LITERAL(nautical_miles, _NM)                                                                      \
+		UNITS_FAMILY_LITERAL(nautical_miles, _nmi)                                                                     \
+                                                                                                                       \
+		UNITS_FAMILY_LITERAL(earth_radii, _R)                                                                          \
+		UNITS_FAMILY_LITERAL(lunar_distances, _LD)                                                                     \
+		UNITS_FAMILY_LITERAL(astronimical_units, _AU)                                                                  \
+		UNITS_FAMILY_LITERAL(light_years, _ly)                                                                         \
+		UNITS_FAMILY_LITERAL(parsecs, _pc)                                                                             \
+	}                                                                                                                  \
+                                                                                                                       \
+	namespace mass_literals                                                                                            \
+	{                                                                                                                  \
+		UNITS_FAMILY_LITERAL(picograms, _pg)                                                                           \
+		UNITS_FAMILY_LITERAL(nanograms, _ng)                                                                           \
+		UNITS_FAMILY_LITERAL(micrograms, _ug)                                                                          \
+		UNITS_FAMILY_LITERAL(milligrams, _mg)                                                                          \
+		UNITS_FAMILY_LITERAL(grams, _g)                                                                                \
+		UNITS_FAMILY_LITERAL(kilograms, _kg)                                                                           \
+                                                                                                                       \
+		UNITS_FAMILY_LITERAL(grains, _gr)                                                                              \
+		UNITS_FAMILY_LITERAL(drams, _dr)                                                                               \
+		UNITS_FAMILY_LITERAL(ounces, _oz)                                                                              \
+		UNITS_FAMILY_LITERAL(pounds, _lb)                                                                              \
+		UNITS_FAMILY_LITERAL(us_hundredweight, _cwt)                                                                   \
+	}
+
+namespace units
+{
+	template <typename Rep>
+	struct family
+	{
+		UNITS_FAMILY_ALIASES(Rep)
+	};
+
+	namespace f32
+	{
+		UNITS_FAMILY_ALIASES(float)
+		UNITS_FAMILY_LITERALS
+	}
+
+	namespace f64
+	{
+		UNITS_FAMILY_ALIASES(double)
+		UNITS_FAMILY_LITERALS
+	}
+
+	namespace i32
+	{
+		UNITS_FAMILY_ALIASES(std::int32_t)
+		UNITS_FAMILY_LITERALS
+	}
+
+	namespace i64
+	{
+		UNITS_FAMILY_ALIASES(std::int64_t)
+		UNITS_FAMILY_LITERALS
+	}
+}
+
+#undef UNITS_FAMILY_LITERALS
+#undef UNITS_FAMILY_LITERAL
+#undef UNITS_FAMILY_ALIASES
@@ -0,0 +1,300 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Prints a value in whichever alias of a family of units reads best, so that 1532000 m is printed as 1.532 km and
+// 0.00042 kg as 420 mg. The alias is the largest one that is no larger than the value. It is looked up in a table
+// indexed by the binary exponent of the value, which leaves at most a comparison or two to settle binades that hold
+// the scale of an alias.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+#include "units.h"
+#include "units/catalogue.h"
+
+namespace units
+{
+	namespace format
+	{
+		// The family used when none is given
+		template <typename UnitType>
+		struct default_family;
+
+		template <>
+		struct default_family<unit_type::distance>
+		{
+			using type = catalogue::metric_distances;
+		};
+
+		template <>
+		struct default_family<unit_type::mass>
+		{
+			using type = catalogue::metric_masses;
+		};
+
+		template <>
+		struct default_family<unit_type::area>
+		{
+			using type = type_list<square_centimetres, square_metres>;
+		};
+
+		// Large enough for any value formatted by format_to
+		constexpr std::size_t buffer_size = 64;
+
+		struct scaled
+		{
+			double      value;
+			char const* suffix;
+		};
+
+		namespace detail
+		{
+			constexpr int min_exponent = std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits;
+			constexpr int max_exponent = std::numeric_limits<double>::max_exponent;
+
+			struct table
+			{
+				std::vector<double>        scales;
+				std::vector<double>        inverse_scales;
+				std::vector<std::string>   suffixes;
+				std::vector<unsigned char> by_exponent;
+
+				// The largest alias no larger than magnitude, or the smallest alias
+				std::size_t find(double magnitude) const
+				{
+					if (!(magnitude > 0 && magnitude <= std::numeric_limits<double>::max()))
+					{
+						magnitude = 1;
+					}
+
+					auto index = std::size_t{by_exponent[static_cast<std::size_t>(std::ilogb(magnitude) - min_exponent)]};
+					while (index + 1 < scales.size() && magnitude >= scales[index + 1])
+					{
+						++index;
+					}
+					return index;
+				}
+			};
+
+			template <typename... Units>
+			table make_table(type_list<Units...>)
+			{
+				static_assert(sizeof...(Units) > 0 && sizeof...(Units) <= std::numeric_limits<unsigned char>::max(),
+				              "A family must have between 1 and 255 units");
+
+				auto const scales   = std::vector<long double>{catalogue::scale<typename Units::ratio>()...};
+				auto const suffixes = std::vector<std::string>{
+				    units::detail::get_unit<typename Units::ratio, typename Units::unit_type>()...};
+
+				auto order = std::vector<std::size_t>(scales.size());
+				std::iota(order.begin(), order.end(), std::size_t{0});
+				std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return scales[a] < scales[b]; });
+
+				auto result = table{};
+				for (auto i : order)
+				{
+					result.scales.push_back(static_cast<double>(scales[i]));
+					result.inverse_scales.push_back(static_cast<double>(1 / scales[i]));
+					result.suffixes.push_back(suffixes[i]);
+				}
+
+				// Every binade starts with the largest alias no larger than its lower bound
+				auto index = std::size_t{0};
+				for (auto exponent = min_exponent; exponent <= max_exponent; ++exponent)
+				{
+					auto const lower = std::ldexp(1.0, exponent);
+					while (index + 1 < result.scales.size() && lower >= result.scales[index + 1])
+					{
+						++index;
+					}
+					result.by_exponent.push_back(static_cast<unsigned char>(index));
+				}
+				return result;
+			}
+
+			template <typename Family>
+			table const& get_table()
+			{
+				static table const t = make_table(Family{});
+				return t;
+			}
+
+			template <typename Family, typename UnitType>
+			struct is_family_of;
+
+			template <typename... Units, typename UnitType>
+			struct is_family_of<type_list<Units...>, UnitType>
+			    : std::is_same<type_list<UnitType, typename Units::unit_type...>, type_list<typename Units::unit_type..., UnitType>>
+			{
+			};
+
+			constexpr double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12};
+
+			// At most max_digits10 significant digits, which always fit in half of the buffer
+			inline char* format_general(char* out, double value, int precision)
+			{
+				auto const last = out + buffer_size / 2;
+#if defined(__cpp_lib_to_chars)
+				auto const result = std::to_chars(out, last, value, std::chars_format::general, precision);
+				return result.ec == std::errc{} ? result.ptr : out;
+#else
+				auto const n = std::snprintf(out, buffer_size / 2, "%.*g", precision, value);
+				return n < 0 ? out : std::min(out + n, last - 1);
+#endif
+			}
+
+			// Formats as %g would. Values that %g prints without an exponent, which is nearly all of them once they
+			// have been scaled, are rounded to an integer of up to 9 digits and printed directly. Precision is
+			// clamped to [1, max_digits10], as more digits than that say nothing more about a double.
+			inline char* format_number(char* out, double value, int precision)
+			{
+				precision = std::min(std::max(precision, 1), std::numeric_limits<double>::max_digits10);
+				auto const magnitude = std::fabs(value);
+				if (precision > 9 || !(magnitude >= 1e-4 && magnitude < powers_of_ten[precision]))
+				{
+					return value == 0 ? (*out = '0', out + 1) : format_general(out, value, precision);
+				}
+
+				auto exponent = -4;
+				while (exponent < 0 ? magnitude * powers_of_ten[-exponent - 1] >= 1 : magnitude >= powers_of_ten[exponent + 1])
+				{
+					++exponent;
+				}
+
+				auto digits = static_cast<long long>(std::llround(magnitude * powers_of_ten[precision - 1 - exponent]));
+				if (digits >= static_cast<long long>(powers_of_ten[precision]))
+				{
+					digits /= 10;
+					if (++exponent >= precision)
+					{
+						return format_general(out, value, precision);
+					}
+				}
+
+				char text[16];
+				for (auto i = precision; i-- > 0; digits /= 10)
+				{
+					text[i] = static_cast<char>('0' + digits % 10);
+				}
+
+				auto const whole = exponent < 0 ? 0 : exponent + 1;
+				auto       last  = precision;
+				while (last > whole && text[last - 1] == '0')
+				{
+					--last;
+				}
+
+				if (std::signbit(value))
+				{
+					*out++ = '-';
+				}
+				if (whole == 0)
+				{
+					*out++ = '0';
+				}
+				std::memcpy(out, text, static_cast<std::size_t>(whole));
+				out += whole;
+				if (last > whole)
+				{
+					*out++ = '.';
+					for (auto i = exponent + 1; i < 0; ++i)
+					{
+						*out++ = '0';
+					}
+					std::memcpy(out, text + whole, static_cast<std::size_t>(last - whole));
+					out += last - whole;
+				}
+				return out;
+			}
+		}
+
+		// Converts value to the alias of Family that reads best
+		template <typename Family, typename Rep, typename Ratio, typename UnitType>
+		scaled scale(unit<Rep, Ratio, UnitType> value)
+		{
+			static_assert(detail::is_family_of<Family, UnitType>::value, "The family must hold units of the same type");
+
+			auto const& t    = detail::get_table<Family>();
+			auto const  base = static_cast<double>(value.count()) * static_cast<double>(catalogue::scale<Ratio>());
+			auto const  i    = t.find(std::fabs(base));
+			return scaled{base * t.inverse_scales[i], t.suffixes[i].c_str()};
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		scaled scale(unit<Rep, Ratio, UnitType> value)
+		{
+			return scale<typename default_family<UnitType>::type>(value);
+		}
+
+		// Writes value with precision significant digits and the suffix of the chosen alias to out, which must hold
+		// buffer_size characters. Returns the end of the text, which is not null terminated.
+		template <typename Family, typename Rep, typename Ratio, typename UnitType>
+		char* format_to(char* out, unit<Rep, Ratio, UnitType> value, int precision = 4)
+		{
+			auto const s      = scale<Family>(value);
+			auto const length = std::strlen(s.suffix);
+
+			out    = detail::format_number(out, s.value, precision);
+			*out++ = ' ';
+			std::memcpy(out, s.suffix, length);
+			return out + length;
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		char* format_to(char* out, unit<Rep, Ratio, UnitType> value, int precision = 4)
+		{
+			return format_to<typename default_family<UnitType>::type>(out, value, precision);
+		}
+
+		template <typename Family, typename Rep, typename Ratio, typename UnitType>
+		std::string to_string(unit<Rep, Ratio, UnitType> value, int precision = 4)
+		{
+			char buffer[buffer_size];
+			return std::string{buffer, format_to<Family>(buffer, value, precision)};
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		std::string to_string(unit<Rep, Ratio, UnitType> value, int precision = 4)
+		{
+			return to_string<typename default_family<UnitType>::type>(value, precision);
+		}
+	}
+}
@@ -0,0 +1,734 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Distances between points given by latitude and longitude in degrees, returned as distances in any ratio.
+//
+// haversine is the great circle distance on a sphere of one earth radius (6371 km). It is within 0.6% of the
+// distance along the WGS84 ellipsoid.
+//
+// vincenty is the distance along the WGS84 ellipsoid, accurate to well under a millimetre. It iterates, and returns
+// NaN for the nearly antipodal points where the iteration does not converge.
+//
+// equirectangular is the fast approximation of the haversine distance that treats the earth as flat around the
+// midpoint of the two points. Between 70S and 70N, its relative error is below 1e-4 for points less than 100 km
+// apart and below 1e-6 for points less than 10 km apart. The error grows with the square of the separation and
+// towards the poles.
+//
+// The batch forms take structure of arrays input and are evaluated with polynomials in blocks of plain loops that
+// vectorise, compiled for each tier in units/cpu_dispatch.h. The vincenty batch iterates every pair of a block
+// together, freezing each pair once it has converged, so a block costs as many iterations as its slowest pair.
+// Latitudes must lie in [-90, 90] and longitudes in [-180, 180].
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/cpu_dispatch.h"
+
+namespace units
+{
+	namespace geodesic
+	{
+		struct point
+		{
+			double latitude;
+			double longitude;
+		};
+
+		// Computes n distances from structure of arrays input, multiplied by factor
+		using batch_kernel =
+		    void (*)(double const*, double const*, double const*, double const*, std::size_t, double, double*);
+
+		struct kernel_table
+		{
+			cpu::tier    tier;
+			batch_kernel haversine;
+			batch_kernel equirectangular;
+			batch_kernel vincenty;
+		};
+
+		namespace detail
+		{
+			constexpr double pi                 = 3.14159265358979323846;
+			constexpr double half_pi            = pi / 2;
+			constexpr double quarter_pi         = pi / 4;
+			constexpr double two_pi             = pi * 2;
+			constexpr double radians_per_degree = pi / 180;
+
+			constexpr double wgs84_a = 6378137.0;
+			constexpr double wgs84_f = 1 / 298.257223563;
+			constexpr double wgs84_b = wgs84_a * (1 - wgs84_f);
+
+			constexpr std::size_t block_size = 256;
+
+			UNITS_ALWAYS_INLINE std::uint64_t to_bits(double x)
+			{
+				std::uint64_t bits;
+				std::memcpy(&bits, &x, sizeof(bits));
+				return bits;
+			}
+
+			UNITS_ALWAYS_INLINE double from_bits(std::uint64_t bits)
+			{
+				double x;
+				std::memcpy(&x, &bits, sizeof(x));
+				return x;
+			}
+
+			// Selects with a mask rather than a comparison, which would stop the loops from vectorising
+			UNITS_ALWAYS_INLINE std::uint64_t above_half(double x)
+			{
+				return static_cast<std::uint64_t>(static_cast<std::int64_t>(to_bits(0.5 - x)) >> 63);
+			}
+
+			UNITS_ALWAYS_INLINE std::uint64_t less(double x, double y)
+			{
+				return static_cast<std::uint64_t>(static_cast<std::int64_t>(to_bits(x - y)) >> 63);
+			}
+
+			UNITS_ALWAYS_INLINE std::uint64_t negative(double x)
+			{
+				return static_cast<std::uint64_t>(static_cast<std::int64_t>(to_bits(x)) >> 63);
+			}
+
+			UNITS_ALWAYS_INLINE std::uint64_t zero(double x)
+			{
+				return std::uint64_t{0} - static_cast<std::uint64_t>((to_bits(x) << 1) == 0);
+			}
+
+			UNITS_ALWAYS_INLINE double select(std::uint64_t mask, double if_set, double if_clear)
+			{
+				return from_bits((to_bits(if_set) & mask) | (to_bits(if_clear) & ~mask));
+			}
+
+			// Evaluates the polynomial with the given coefficients, lowest order first, at x
+			template <std::size_t N>
+			UNITS_ALWAYS_INLINE double horner(double const (&coefficients)[N], double x)
+			{
+				auto result = coefficients[N - 1];
+				for (auto i = N - 1; i-- > 0;)
+				{
+					result = result * x + coefficients[i];
+				}
+				return result;
+			}
+
+			// The Taylor series of (sin(x) - x) / x^3 in x^2 to x^18, which makes sine exact to double precision for
+			// |x| <= pi / 2
+			constexpr double sine_series[] = {-1.0 / 6,
+			                                  1.0 / 120,
+			                                  -1.0 / 5040,
+			                                  1.0 / 362880,
+			                                  -1.0 / 39916800,
+			                                  1.0 / 6227020800,
+			                                  -1.0 / 1307674368000,
+			                                  1.0 / 355687428096000,
+			                                  -1.0 / 121645100408832000,
+			                                  1.0 / 5.109094217170944e19};
+
+			UNITS_ALWAYS_INLINE double sine(double x)
+			{
+				auto const x2 = x * x;
+				return x + x * x2 * horner(sine_series, x2);
+			}
+
+			// The rational approximation of (asin(x) - x) / x^3 in x^2 for |x| <= 0.5 from fdlibm
+			constexpr double asin_numerator[]   = {1.66666666666666657415e-01,
+			                                       -3.25565818622400915405e-01,
+			                                       2.01212532134862925881e-01,
+			                                       -4.00555345006794114027e-02,
+			                                       7.91534994289814532176e-04,
+			                                       3.47933107596021167570e-05};
+			constexpr double asin_denominator[] = {1.0,
+			                                       -2.40339491173441421878e+00,
+			                                       2.02094576023350569471e+00,
+			                                       -6.88283971605453293030e-01,
+			                                       7.70381505559019352791e-02};
+
+			UNITS_ALWAYS_INLINE double asin_ratio(double t)
+			{
+				return horner(asin_numerator, t) / horner(asin_denominator, t);
+			}
+
+			// The haversine of the central angle
+			UNITS_ALWAYS_INLINE double haversine_term(double lat1, double lon1, double lat2, double lon2)
+			{
+				auto const phi1 = lat1 * radians_per_degree;
+				auto const phi2 = lat2 * radians_per_degree;
+
+				// sin^2 has a period of pi, so half the longitude difference is folded into [0, pi / 2]
+				auto const half_lambda = std::fabs((lon2 - lon1) * radians_per_degree * 0.5);
+				auto const s_phi       = sine((phi2 - phi1) * 0.5);
+				auto const s_lambda    = sine(half_pi - std::fabs(half_pi - half_lambda));
+				auto const cos_phi1    = sine(half_pi - std::fabs(phi1));
+				auto const cos_phi2    = sine(half_pi - std::fabs(phi2));
+				return std::fabs(s_phi * s_phi + cos_phi1 * cos_phi2 * s_lambda * s_lambda);
+			}
+
+			// 2 asin(root) given root and sqrt((1 - root) / 2), which are taken outside so the loops can vectorise
+			UNITS_ALWAYS_INLINE double central_angle(double root, double half_complement)
+			{
+				auto const large  = above_half(root);
+				auto const t      = select(large, half_complement * half_complement, root * root);
+				auto const s      = select(large, half_complement, root);
+				auto const asin_s = s + s * t * asin_ratio(t);
+				return 2 * select(large, half_pi - 2 * asin_s, asin_s);
+			}
+
+			// The square of the angle between the points on the plane through their midpoint
+			UNITS_ALWAYS_INLINE double equirectangular_term(double lat1, double lon1, double lat2, double lon2)
+			{
+				auto const phi1   = lat1 * radians_per_degree;
+				auto const phi2   = lat2 * radians_per_degree;
+				auto const lambda = pi - std::fabs(pi - std::fabs((lon2 - lon1) * radians_per_degree));
+				auto const x      = lambda * sine(half_pi - std::fabs((phi1 + phi2) * 0.5));
+				auto const y      = phi2 - phi1;
+				return x * x + y * y;
+			}
+
+			// The sine and cosine of any angle within a few turns of zero
+			struct sine_cosine
+			{
+				double sin;
+				double cos;
+			};
+
+			UNITS_ALWAYS_INLINE sine_cosine sincos(double x)
+			{
+				// Adding and subtracting 1.5 * 2^52 rounds to the nearest whole turn
+				constexpr double round = 6755399441055744.0;
+
+				auto const turns   = (x * (1 / two_pi) + round) - round;
+				auto const reduced = x - turns * two_pi;
+				auto const r       = std::fabs(reduced);
+				auto const s       = sine(select(less(half_pi, r), pi - r, r));
+				return sine_cosine{std::copysign(s, reduced), sine(half_pi - r)};
+			}
+
+			// The rational approximation of (atan(x) - x) / x^3 in x^2 for |x| <= 0.66 from Cephes
+			constexpr double atan_numerator[]   = {-6.485021904942025371773e1,
+			                                       -1.228866684490136173410e2,
+			                                       -7.500855792314704667340e1,
+			                                       -1.615753718733365076637e1,
+			                                       -8.750608600031904122785e-1};
+			constexpr double atan_denominator[] = {1.945506571482613964425e2,
+			                                       4.853903996359136964868e2,
+			                                       4.328810604912902668951e2,
+			                                       1.650270098316988542046e2,
+			                                       2.485846490142306297962e1,
+			                                       1.0};
+
+			// atan(x) for |x| <= 1. Above 0.66 it is pi / 4 plus the atan of (|x| - 1) / (|x| + 1).
+			UNITS_ALWAYS_INLINE double arctangent(double x)
+			{
+				// The part of pi / 4 that quarter_pi leaves out
+				constexpr double quarter_pi_low = 3.061616997868382943065e-17;
+
+				auto const ax      = std::fabs(x);
+				auto const reduce  = less(0.66, ax);
+				auto const t       = select(reduce, (ax - 1) / (ax + 1), ax);
+				auto const t2      = t * t;
+				auto const atan_t  = t + t * t2 * horner(atan_numerator, t2) / horner(atan_denominator, t2);
+				auto const reduced = select(reduce, quarter_pi + (atan_t + quarter_pi_low), atan_t);
+				return std::copysign(reduced, x);
+			}
+
+			// atan2(y, x) for y >= 0, dividing the smaller of |x| and y by the larger
+			UNITS_ALWAYS_INLINE double angle(double y, double x)
+			{
+				auto const steep = less(std::fabs(x), y);
+				auto const t     = arctangent(select(steep, x, y) / select(steep, y, std::fabs(x)));
+				return select(steep, half_pi - t, select(negative(x), pi - t, t));
+			}
+
+			// One step of the iteration for lambda, from the reduced latitudes and the sines and cosines it needs
+			struct vincenty_step
+			{
+				double sigma;
+				double cos2_alpha;
+				double cos_2sigma_m;
+				double lambda;
+			};
+
+			UNITS_ALWAYS_INLINE vincenty_step step(double sin_u1,
+			                                       double cos_u1,
+			                                       double sin_u2,
+			                                       double cos_u2,
+			                                       double lambda0,
+			                                       double sin_lambda,
+			                                       double sin_sigma,
+			                                       double cos_sigma)
+			{
+				auto const sigma      = angle(sin_sigma, cos_sigma);
+				auto const sin_alpha  = cos_u1 * cos_u2 * sin_lambda / sin_sigma;
+				auto const cos2_alpha = 1 - sin_alpha * sin_alpha;
+
+				// Both points on the equator leave cos2_alpha at zero
+				auto const equator      = zero(cos2_alpha);
+				auto const divisor      = select(equator, 1.0, cos2_alpha);
+				auto const cos_2sigma_m = select(equator, 0.0, cos_sigma - 2 * sin_u1 * sin_u2 / divisor);
+				auto const c            = wgs84_f / 16 * cos2_alpha * (4 + wgs84_f * (4 - 3 * cos2_alpha));
+				auto const inner        = cos_2sigma_m + c * cos_sigma * (2 * cos_2sigma_m * cos_2sigma_m - 1);
+				auto const lambda       = lambda0 + (1 - c) * wgs84_f * sin_alpha * (sigma + c * sin_sigma * inner);
+				return vincenty_step{sigma, cos2_alpha, cos_2sigma_m, lambda};
+			}
+
+			// The distance in metres once lambda has converged
+			UNITS_ALWAYS_INLINE double vincenty_distance(vincenty_step const& s, double sin_sigma, double cos_sigma)
+			{
+				auto const cos2_2sigma_m = s.cos_2sigma_m * s.cos_2sigma_m;
+				auto const u_sq          = s.cos2_alpha * (wgs84_a * wgs84_a - wgs84_b * wgs84_b) / (wgs84_b * wgs84_b);
+				auto const big_a         = 1 + u_sq / 16384 * (4096 + u_sq * (-768 + u_sq * (320 - 175 * u_sq)));
+				auto const big_b         = u_sq / 1024 * (256 + u_sq * (-128 + u_sq * (74 - 47 * u_sq)));
+				auto const term1         = cos_sigma * (2 * cos2_2sigma_m - 1);
+				auto const term2         = s.cos_2sigma_m * (4 * sin_sigma * sin_sigma - 3) * (4 * cos2_2sigma_m - 3);
+				auto const bracket       = s.cos_2sigma_m + big_b / 4 * (term1 - big_b / 6 * term2);
+				return wgs84_b * big_a * (s.sigma - big_b * sin_sigma * bracket);
+			}
+
+			namespace kernels
+			{
+				UNITS_ALWAYS_INLINE void haversine(double const* lat1,
+				                                   double const* lon1,
+				                                   double const* lat2,
+				                                   double const* lon2,
+				                                   std::size_t   n,
+				                                   double        factor,
+				                                   double*       out)
+				{
+					double root[block_size];
+					double half_complement[block_size];
+					for (std::size_t first = 0; first < n; first += block_size)
+					{
+						auto const count = std::min(block_size, n - first);
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							auto const j = first + i;
+							root[i]      = haversine_term(lat1[j], lon1[j], lat2[j], lon2[j]);
+						}
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							root[i]            = std::sqrt(root[i]);
+							half_complement[i] = std::sqrt(std::fabs((1 - root[i]) * 0.5));
+						}
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							out[first + i] = central_angle(root[i], half_complement[i]) * factor;
+						}
+					}
+				}
+
+				UNITS_ALWAYS_INLINE void equirectangular(double const* lat1,
+				                                         double const* lon1,
+				                                         double const* lat2,
+				                                         double const* lon2,
+				                                         std::size_t   n,
+				                                         double        factor,
+				                                         double*       out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = equirectangular_term(lat1[i], lon1[i], lat2[i], lon2[i]);
+					}
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = std::sqrt(out[i]) * factor;
+					}
+				}
+
+				// The sines and cosines of lambda for every pair of a block, leaving the square of sin_sigma
+				UNITS_ALWAYS_INLINE void vincenty_trig(double const* sin_u1,
+				                                       double const* cos_u1,
+				                                       double const* sin_u2,
+				                                       double const* cos_u2,
+				                                       double const* lambda,
+				                                       std::size_t   count,
+				                                       double*       sin_lambda,
+				                                       double*       sin_sigma,
+				                                       double*       cos_sigma)
+				{
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						auto const sc = sincos(lambda[i]);
+						auto const a  = cos_u2[i] * sc.sin;
+						auto const b  = cos_u1[i] * sin_u2[i] - sin_u1[i] * cos_u2[i] * sc.cos;
+						sin_lambda[i] = sc.sin;
+						sin_sigma[i]  = a * a + b * b;
+						cos_sigma[i]  = sin_u1[i] * sin_u2[i] + cos_u1[i] * cos_u2[i] * sc.cos;
+					}
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						sin_sigma[i] = std::sqrt(sin_sigma[i]);
+					}
+				}
+
+				UNITS_ALWAYS_INLINE void vincenty(double const* lat1,
+				                                  double const* lon1,
+				                                  double const* lat2,
+				                                  double const* lon2,
+				                                  std::size_t   n,
+				                                  double        factor,
+				                                  double*       out)
+				{
+					double        sin_u1[block_size], cos_u1[block_size], sin_u2[block_size], cos_u2[block_size];
+					double        lambda0[block_size], lambda[block_size];
+					double        sin_lambda[block_size], sin_sigma[block_size], cos_sigma[block_size];
+					std::uint64_t converged[block_size];
+					for (std::size_t first = 0; first < n; first += block_size)
+					{
+						auto const count = std::min(block_size, n - first);
+
+						// tan(u) = (1 - f) tan(phi), kept as a sine and cosine that are normalised below
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							auto const j    = first + i;
+							auto const phi1 = lat1[j] * radians_per_degree;
+							auto const phi2 = lat2[j] * radians_per_degree;
+							sin_u1[i]       = (1 - wgs84_f) * sine(phi1);
+							cos_u1[i]       = sine(half_pi - std::fabs(phi1));
+							sin_u2[i]       = (1 - wgs84_f) * sine(phi2);
+							cos_u2[i]       = sine(half_pi - std::fabs(phi2));
+							sin_sigma[i]    = sin_u1[i] * sin_u1[i] + cos_u1[i] * cos_u1[i];
+							cos_sigma[i]    = sin_u2[i] * sin_u2[i] + cos_u2[i] * cos_u2[i];
+							lambda0[i]      = (lon2[j] - lon1[j]) * radians_per_degree;
+							lambda[i]       = lambda0[i];
+						}
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							sin_sigma[i] = std::sqrt(sin_sigma[i]);
+							cos_sigma[i] = std::sqrt(cos_sigma[i]);
+						}
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							sin_u1[i] /= sin_sigma[i];
+							cos_u1[i] /= sin_sigma[i];
+							sin_u2[i] /= cos_sigma[i];
+							cos_u2[i] /= cos_sigma[i];
+						}
+
+						// A pair stops moving once it has converged, or once its points coincide. Contracting the
+						// products into fused multiply adds leaves sin_sigma a rounding error above zero for coincident
+						// points, so anything below 1e-15, some nanometres, counts as zero.
+						auto remaining = ~std::uint64_t{0};
+						for (int iteration = 0; iteration < 200 && remaining != 0; ++iteration)
+						{
+							vincenty_trig(
+							    sin_u1, cos_u1, sin_u2, cos_u2, lambda, count, sin_lambda, sin_sigma, cos_sigma);
+
+							remaining = 0;
+							for (std::size_t i = 0; i < count; ++i)
+							{
+								auto const s = step(sin_u1[i],
+								                    cos_u1[i],
+								                    sin_u2[i],
+								                    cos_u2[i],
+								                    lambda0[i],
+								                    sin_lambda[i],
+								                    sin_sigma[i],
+								                    cos_sigma[i]);
+
+								auto const moved = std::fabs(s.lambda - lambda[i]);
+								auto const done  = less(moved, 1e-12) | less(sin_sigma[i], 1e-15);
+								converged[i]     = done;
+								lambda[i]        = select(done, lambda[i], s.lambda);
+								remaining |= ~done;
+							}
+						}
+
+						// Every pair that converged did so at the lambda it kept, so the last step is taken again
+						vincenty_trig(sin_u1, cos_u1, sin_u2, cos_u2, lambda, count, sin_lambda, sin_sigma, cos_sigma);
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							auto const s = step(sin_u1[i],
+							                    cos_u1[i],
+							                    sin_u2[i],
+							                    cos_u2[i],
+							                    lambda0[i],
+							                    sin_lambda[i],
+							                    sin_sigma[i],
+							                    cos_sigma[i]);
+
+							auto const nan      = std::numeric_limits<double>::quiet_NaN();
+							auto const distance = vincenty_distance(s, sin_sigma[i], cos_sigma[i]);
+							auto const metres   = select(less(sin_sigma[i], 1e-15), 0.0, distance);
+							out[first + i]      = select(converged[i], metres, nan) * factor;
+						}
+					}
+				}
+			}
+
+// Instantiates the batch kernels for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_GEODESIC_TIER(Name, Tier, Target)                                                                        \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		Target inline void haversine(double const* lat1,                                                               \
+		                             double const* lon1,                                                               \
+		                             double const* lat2,                                                               \
+		                             double const* lon2,                                                               \
+		                             std::size_t   n,                                                                  \
+		                             double        factor,                                                             \
+		                             double*       out)                                                                \
+		{                                                                                                              \
+			kernels::haversine(lat1, lon1, lat2, lon2, n, factor, out);                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		Target inline void equirectangular(double const* lat1,                                                         \
+		                                   double const* lon1,                                                         \
+		                                   double const* lat2,                                                         \
+		                                   double const* lon2,                                                         \
+		                                   std::size_t   n,                                                            \
+		                                   double        factor,                                                       \
+		                                   double*       out)                                                          \
+		{                                                                                                              \
+			kernels::equirectangular(lat1, lon1, lat2, lon2, n, factor, out);                                          \
+		}                                                                                                              \
+                                                                                                                       \
+		Target inline void vincenty(double const* lat1,                                                                \
+		                            double const* lon1,                                                                \
+		                            double const* lat2,                                                                \
+		                            double const* lon2,                                                                \
+		                            std::size_t   n,                                                                   \
+		                            double        factor,                                                              \
+		                            double*       out)                                                                 \
+		{                                                                                                              \
+			kernels::vincenty(lat1, lon1, lat2, lon2, n, factor, out);                                                 \
+		}                                                                                                              \
+                                                                                                                       \
+		inline geodesic::kernel_table const& table()                                                                   \
+		{                                                                                                              \
+			static geodesic::kernel_table const t{Tier, &haversine, &equirectangular, &vincenty};                      \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+			UNITS_FOR_EACH_TIER(UNITS_GEODESIC_TIER)
+
+#undef UNITS_GEODESIC_TIER
+
+			// The inverse formula of Vincenty (1975) on the WGS84 ellipsoid, in metres
+			inline double vincenty_metres(point from, point to)
+			{
+				auto const lambda0 = (to.longitude - from.longitude) * radians_per_degree;
+				auto const u1      = std::atan((1 - wgs84_f) * std::tan(from.latitude * radians_per_degree));
+				auto const u2      = std::atan((1 - wgs84_f) * std::tan(to.latitude * radians_per_degree));
+				auto const sin_u1  = std::sin(u1);
+				auto const cos_u1  = std::cos(u1);
+				auto const sin_u2  = std::sin(u2);
+				auto const cos_u2  = std::cos(u2);
+
+				auto lambda = lambda0;
+				for (int iteration = 0; iteration < 200; ++iteration)
+				{
+					auto const sin_lambda = std::sin(lambda);
+					auto const cos_lambda = std::cos(lambda);
+					auto const a          = cos_u2 * sin_lambda;
+					auto const b          = cos_u1 * sin_u2 - sin_u1 * cos_u2 * cos_lambda;
+					auto const sin_sigma  = std::sqrt(a * a + b * b);
+					if (sin_sigma == 0)
+					{
+						return 0;
+					}
+
+					auto const cos_sigma  = sin_u1 * sin_u2 + cos_u1 * cos_u2 * cos_lambda;
+					auto const sigma      = std::atan2(sin_sigma, cos_sigma);
+					auto const sin_alpha  = cos_u1 * cos_u2 * sin_lambda / sin_sigma;
+					auto const cos2_alpha = 1 - sin_alpha * sin_alpha;
+
+					// Both points on the equator leave cos2_alpha at zero
+					auto const cos_2sigma_m  = cos2_alpha != 0 ? cos_sigma - 2 * sin_u1 * sin_u2 / cos2_alpha : 0.0;
+					auto const cos2_2sigma_m = cos_2sigma_m * cos_2sigma_m;
+
+					auto const c        = wgs84_f / 16 * cos2_alpha * (4 + wgs84_f * (4 - 3 * cos2_alpha));
+					auto const previous = lambda;
+					auto const inner    = cos_2sigma_m + c * cos_sigma * (2 * cos2_2sigma_m - 1);
+					lambda              = lambda0 + (1 - c) * wgs84_f * sin_alpha * (sigma + c * sin_sigma * inner);
+					if (std::fabs(lambda - previous) >= 1e-12)
+					{
+						continue;
+					}
+
+					auto const u_sq        = cos2_alpha * (wgs84_a * wgs84_a - wgs84_b * wgs84_b) / (wgs84_b * wgs84_b);
+					auto const big_a       = 1 + u_sq / 16384 * (4096 + u_sq * (-768 + u_sq * (320 - 175 * u_sq)));
+					auto const big_b       = u_sq / 1024 * (256 + u_sq * (-128 + u_sq * (74 - 47 * u_sq)));
+					auto const term1       = cos_sigma * (2 * cos2_2sigma_m - 1);
+					auto const term2       = cos_2sigma_m * (4 * sin_sigma * sin_sigma - 3) * (4 * cos2_2sigma_m - 3);
+					auto const bracket     = cos_2sigma_m + big_b / 4 * (term1 - big_b / 6 * term2);
+					auto const delta_sigma = big_b * sin_sigma * bracket;
+					return wgs84_b * big_a * (sigma - delta_sigma);
+				}
+				return std::numeric_limits<double>::quiet_NaN();
+			}
+
+			template <typename ToUnit>
+			using is_distance = std::is_same<typename ToUnit::unit_type, unit_type::distance>;
+
+			// Writes the batch straight into out when it holds doubles, and through a block of doubles otherwise
+			template <typename ToUnit, typename Kernel>
+			ToUnit* run(Kernel kernel,
+			            double const* lat1,
+			            double const* lon1,
+			            double const* lat2,
+			            double const* lon2,
+			            std::size_t   n,
+			            double        factor,
+			            ToUnit*       out,
+			            std::true_type)
+			{
+				kernel(lat1, lon1, lat2, lon2, n, factor, units::detail::raw(out));
+				return out + n;
+			}
+
+			template <typename ToUnit, typename Kernel>
+			ToUnit* run(Kernel kernel,
+			            double const* lat1,
+			            double const* lon1,
+			            double const* lat2,
+			            double const* lon2,
+			            std::size_t   n,
+			            double        factor,
+			            ToUnit*       out,
+			            std::false_type)
+			{
+				double block[block_size];
+				for (std::size_t first = 0; first < n; first += block_size)
+				{
+					auto const count = std::min(block_size, n - first);
+					kernel(lat1 + first, lon1 + first, lat2 + first, lon2 + first, count, factor, block);
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						*out++ = ToUnit{static_cast<typename ToUnit::rep>(block[i])};
+					}
+				}
+				return out;
+			}
+
+			template <typename ToUnit, typename Kernel>
+			ToUnit* run(Kernel kernel,
+			            double const* lat1,
+			            double const* lon1,
+			            double const* lat2,
+			            double const* lon2,
+			            std::size_t   n,
+			            double        factor,
+			            ToUnit*       out)
+			{
+				static_assert(is_distance<ToUnit>::value, "Geodesic distances are distances");
+				using holds_doubles = std::is_same<typename ToUnit::rep, double>;
+				return run(kernel, lat1, lon1, lat2, lon2, n, factor, out, holds_doubles{});
+			}
+
+			template <typename ToUnit>
+			constexpr double from_earth_radii()
+			{
+				return units::detail::conversion_factor<double, earth_radii::ratio, typename ToUnit::ratio>();
+			}
+
+			template <typename ToUnit>
+			constexpr double from_metres()
+			{
+				return units::detail::conversion_factor<double, std::ratio<1>, typename ToUnit::ratio>();
+			}
+		}
+
+		// The kernels for a given tier, or the best supported one if the machine cannot run it
+		inline kernel_table const& kernels(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(detail));
+		}
+
+		// The kernels bound to the active tier, chosen once on first use
+		inline kernel_table const& kernels()
+		{
+			return cpu::active_kernels<kernel_table, &kernels>();
+		}
+
+		template <typename ToUnit = metres>
+		ToUnit haversine(point from, point to)
+		{
+			auto const term  = detail::haversine_term(from.latitude, from.longitude, to.latitude, to.longitude);
+			auto const root  = std::sqrt(term);
+			auto const angle = detail::central_angle(root, std::sqrt(std::fabs((1 - root) * 0.5)));
+			return ToUnit{static_cast<typename ToUnit::rep>(angle * detail::from_earth_radii<ToUnit>())};
+		}
+
+		template <typename ToUnit = metres>
+		ToUnit equirectangular(point from, point to)
+		{
+			auto const angle =
+			    std::sqrt(detail::equirectangular_term(from.latitude, from.longitude, to.latitude, to.longitude));
+			return ToUnit{static_cast<typename ToUnit::rep>(angle * detail::from_earth_radii<ToUnit>())};
+		}
+
+		template <typename ToUnit = metres>
+		ToUnit vincenty(point from, point to)
+		{
+			auto const distance = detail::vincenty_metres(from, to);
+			return ToUnit{static_cast<typename ToUnit::rep>(distance * detail::from_metres<ToUnit>())};
+		}
+
+		// The distance from (lat1[i], lon1[i]) to (lat2[i], lon2[i]) for each i below n
+		template <typename ToUnit>
+		ToUnit* haversine(double const* lat1,
+		                  double const* lon1,
+		                  double const* lat2,
+		                  double const* lon2,
+		                  std::size_t   n,
+		                  ToUnit*       out)
+		{
+			return detail::run(kernels().haversine, lat1, lon1, lat2, lon2, n, detail::from_earth_radii<ToUnit>(), out);
+		}
+
+		template <typename ToUnit>
+		ToUnit* equirectangular(double const* lat1,
+		                        double const* lon1,
+		                        double const* lat2,
+		                        double const* lon2,
+		                        std::size_t   n,
+		                        ToUnit*       out)
+		{
+			return detail::run(
+			    kernels().equirectangular, lat1, lon1, lat2, lon2, n, detail::from_earth_radii<ToUnit>(), out);
+		}
+
+		template <typename ToUnit>
+		ToUnit* vincenty(double const* lat1,
+		                 double const* lon1,
+		                 double const* lat2,
+		                 double const* lon2,
+		                 std::size_t   n,
+		                 ToUnit*       out)
+		{
+			return detail::run(kernels().vincenty, lat1, lon1, lat2, lon2, n, detail::from_metres<ToUnit>(), out);
+		}
+	}
+}
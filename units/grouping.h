@@ -0,0 +1,470 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Hashing and grouping of units that agrees with the tolerance of ==. No useful hash can be consistent with a
+// tolerance, since equality within a tolerance is not transitive, so std::hash is only specialised for integer units
+// and two tools are provided instead:
+//
+//     std::unordered_map<units::metres, int, units::grid_hash<units::metres>, units::grid_equal<units::metres>>
+//         counts{16, units::grid_hash<units::metres>{grid}, units::grid_equal<units::metres>{grid}};
+//
+// uses the cells of a units::grid as keys, so every pair of values under one key is within the width of the grid.
+// Values either side of a cell edge are different keys however close they are. units::group_by closes that gap:
+// values within the tolerance of each other are linked and a group is everything reachable through links, which is
+// the same partition as sorting the range and splitting it at every gap wider than the tolerance, found in one
+// hashed pass instead of a sort.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+
+namespace units
+{
+	namespace detail
+	{
+		namespace grouping
+		{
+			// The finaliser of splitmix64, which spreads neighbouring cells over the whole table
+			inline std::uint64_t mix(std::uint64_t x)
+			{
+				x ^= x >> 30;
+				x *= 0xbf58476d1ce4e5b9ull;
+				x ^= x >> 27;
+				x *= 0x94d049bb133111ebull;
+				x ^= x >> 31;
+				return x;
+			}
+
+			// Integer units compare their counts exactly, so the count is the hash. == on floating point units accepts
+			// a tolerance, and every value is linked to every other through a chain of equal neighbours, so the only
+			// hash it agrees with is a constant. std::hash is left disabled for them.
+			template <typename Unit, bool = std::is_integral<typename Unit::rep>::value>
+			struct hash
+			{
+				std::size_t operator()(Unit value) const
+				{
+					return static_cast<std::size_t>(mix(static_cast<std::uint64_t>(value.count())));
+				}
+			};
+
+			template <typename Unit>
+			struct hash<Unit, false>
+			{
+				hash()            = delete;
+				hash(hash const&) = delete;
+				hash& operator=(hash const&) = delete;
+			};
+
+			// Cells are numbered in 64 bits with room to spare for the neighbours of the outermost cells
+			constexpr double cell_limit = 4611686018427387904.0;
+		}
+	}
+
+	// Cells of a fixed width laid along the axis of a unit. Cell k holds the values in [k, k + 1) widths.
+	template <typename Unit>
+	class grid
+	{
+		static_assert(is_unit<Unit>::value, "A grid must be laid over a unit");
+
+	public:
+		using unit_type  = typename Unit::unit_type;
+		using value_type = typename std::common_type<typename Unit::rep, double>::type;
+
+		template <typename Rep, typename Ratio>
+		explicit grid(unit<Rep, Ratio, unit_type> width)
+		    : size{to_value(width)}
+		    , inverse{}
+		{
+			if (!(size > 0) || std::isinf(size))
+			{
+				throw std::invalid_argument{"Grid width must be positive and finite"};
+			}
+
+			inverse = 1 / size;
+		}
+
+		Unit width() const { return Unit{static_cast<typename Unit::rep>(size)}; }
+
+		// Throws std::domain_error for NaN and for values too far from zero to number their cell
+		template <typename Rep, typename Ratio>
+		std::int64_t cell(unit<Rep, Ratio, unit_type> value) const
+		{
+			return cell_of(to_value(value));
+		}
+
+		std::int64_t cell_of(value_type x) const
+		{
+			auto const t = std::floor(x * inverse);
+			if (!(std::abs(t) < detail::grouping::cell_limit))
+			{
+				throw std::domain_error{"Value cannot be placed on the grid"};
+			}
+			return static_cast<std::int64_t>(t);
+		}
+
+		template <typename Rep, typename Ratio>
+		static value_type to_value(unit<Rep, Ratio, unit_type> u)
+		{
+			return unit_cast<unit<value_type, typename Unit::ratio, unit_type>>(u).count();
+		}
+
+	private:
+		value_type size;
+		value_type inverse;
+	};
+
+	template <typename Unit>
+	struct grid_hash
+	{
+		explicit grid_hash(grid<Unit> cells)
+		    : cells{cells}
+		{
+		}
+
+		std::size_t operator()(Unit value) const
+		{
+			return static_cast<std::size_t>(detail::grouping::mix(static_cast<std::uint64_t>(cells.cell(value))));
+		}
+
+		grid<Unit> cells;
+	};
+
+	// Two values are equal when they fall in the same cell, which is an equivalence unlike a tolerance
+	template <typename Unit>
+	struct grid_equal
+	{
+		explicit grid_equal(grid<Unit> cells)
+		    : cells{cells}
+		{
+		}
+
+		bool operator()(Unit lhs, Unit rhs) const { return cells.cell(lhs) == cells.cell(rhs); }
+
+		grid<Unit> cells;
+	};
+
+	// The groups of a range of units. Each element gets the number of its group and groups are numbered in the order
+	// their first element appears in the range.
+	template <typename Unit>
+	class grouping
+	{
+		static_assert(is_unit<Unit>::value, "Only units can be grouped");
+
+	public:
+		using unit_type  = typename Unit::unit_type;
+		using value_type = typename grid<Unit>::value_type;
+
+		template <typename InputIt, typename Rep, typename Ratio>
+		grouping(InputIt first, InputIt last, unit<Rep, Ratio, unit_type> tolerance)
+		    : cells{tolerance}
+		    , membership{}
+		    , groups{}
+		{
+			// The grid is as wide as the tolerance, so the values in one cell are all linked and a cell can only link
+			// to its immediate neighbours.
+			auto const reach = grid<Unit>::to_value(tolerance);
+
+			table index;
+			auto const hint = reserve_hint(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+			index.reserve(hint);
+			membership.reserve(hint);
+			for (std::size_t i = 0; first != last; ++first, ++i)
+			{
+				Unit const u = *first;
+				auto const x = grid<Unit>::to_value(u);
+				auto&      e = index.find_or_add(cells.cell_of(x), u);
+				e.bounds.lo  = std::min(e.bounds.lo, x);
+				e.bounds.hi  = std::max(e.bounds.hi, x);
+				++e.bounds.count;
+				membership.push_back(e.cell);
+			}
+
+			auto const bounds = index.extents();
+			for (std::size_t c = 0; c != bounds.size(); ++c)
+			{
+				auto const next = index.find(index.links[c].key + 1);
+				if (next != table::npos && bounds[next].lo - bounds[c].hi <= reach)
+				{
+					index.unite(c, next);
+				}
+			}
+
+			// Cells are numbered in the order their first element appears, so numbering the roots in cell order
+			// numbers the groups in order of first appearance too
+			std::vector<std::size_t> number(bounds.size(), table::npos);
+			for (std::size_t c = 0; c != bounds.size(); ++c)
+			{
+				auto const root = index.root(c);
+				if (number[root] == table::npos)
+				{
+					number[root] = groups.size();
+					groups.push_back(summary{index.links[root].first, extent{bounds[c].lo, bounds[c].hi, 0}});
+				}
+				number[c] = number[root];
+
+				auto& g = groups[number[c]].bounds;
+				g.lo    = std::min(g.lo, bounds[c].lo);
+				g.hi    = std::max(g.hi, bounds[c].hi);
+				g.count += bounds[c].count;
+			}
+
+			for (auto& label : membership)
+			{
+				label = number[label];
+			}
+		}
+
+		// The number of groups
+		std::size_t size() const { return groups.size(); }
+
+		// The group of the element at index in the range
+		std::size_t group(std::size_t index) const { return membership[index]; }
+
+		std::vector<std::size_t> const& labels() const { return membership; }
+
+		// The first element of a group to appear in the range
+		Unit representative(std::size_t group) const { return groups[group].first; }
+
+		Unit lower(std::size_t group) const { return Unit{static_cast<typename Unit::rep>(groups[group].bounds.lo)}; }
+		Unit upper(std::size_t group) const { return Unit{static_cast<typename Unit::rep>(groups[group].bounds.hi)}; }
+
+		std::size_t count(std::size_t group) const { return groups[group].bounds.count; }
+
+	private:
+		struct extent
+		{
+			value_type  lo;
+			value_type  hi;
+			std::size_t count;
+		};
+
+		struct link
+		{
+			std::int64_t key;
+			std::size_t  parent;
+			Unit         first;
+		};
+
+		struct summary
+		{
+			Unit   first;
+			extent bounds;
+		};
+
+		// An open addressed table from cell keys to cells, with a union-find over the cells for the links. The slot
+		// of a cell holds its key and extent, so each element touches a single slot.
+		struct table
+		{
+			static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+			struct entry
+			{
+				std::int64_t key;
+				std::size_t  cell;
+				extent       bounds;
+			};
+
+			void reserve(std::size_t n)
+			{
+				rehash(capacity_for(n / 4));
+			}
+
+			std::size_t find(std::int64_t key) const
+			{
+				for (auto i = start(key);; i = (i + 1) & mask)
+				{
+					if (slots[i].cell == npos || slots[i].key == key)
+					{
+						return slots[i].cell;
+					}
+				}
+			}
+
+			entry& find_or_add(std::int64_t key, Unit value)
+			{
+				for (auto i = start(key);; i = (i + 1) & mask)
+				{
+					if (slots[i].cell != npos && slots[i].key == key)
+					{
+						return slots[i];
+					}
+
+					if (slots[i].cell == npos)
+					{
+						auto const added = links.size();
+						auto const x     = grid<Unit>::to_value(value);
+						links.push_back(link{key, added, value});
+						if (2 * links.size() > slots.size())
+						{
+							rehash(2 * slots.size());
+							i = start(key);
+							while (slots[i].cell != npos)
+							{
+								i = (i + 1) & mask;
+							}
+						}
+						slots[i] = entry{key, added, extent{x, x, 0}};
+						return slots[i];
+					}
+				}
+			}
+
+			// The extent of every cell, indexed by cell
+			std::vector<extent> extents() const
+			{
+				std::vector<extent> bounds(links.size());
+				for (auto const& e : slots)
+				{
+					if (e.cell != npos)
+					{
+						bounds[e.cell] = e.bounds;
+					}
+				}
+				return bounds;
+			}
+
+			std::size_t root(std::size_t c)
+			{
+				while (links[c].parent != c)
+				{
+					links[c].parent = links[links[c].parent].parent;
+					c               = links[c].parent;
+				}
+				return c;
+			}
+
+			// The root that appeared first is kept so that it carries the first element of the group
+			void unite(std::size_t a, std::size_t b)
+			{
+				a = root(a);
+				b = root(b);
+				if (a != b)
+				{
+					links[std::max(a, b)].parent = std::min(a, b);
+				}
+			}
+
+			std::size_t start(std::int64_t key) const
+			{
+				return static_cast<std::size_t>(detail::grouping::mix(static_cast<std::uint64_t>(key))) & mask;
+			}
+
+			static std::size_t capacity_for(std::size_t n)
+			{
+				std::size_t capacity = 16;
+				while (capacity < 2 * n)
+				{
+					capacity *= 2;
+				}
+				return capacity;
+			}
+
+			void rehash(std::size_t capacity)
+			{
+				if (capacity <= slots.size())
+				{
+					return;
+				}
+
+				std::vector<entry> old(capacity, entry{0, npos, extent{}});
+				old.swap(slots);
+				mask = capacity - 1;
+				for (auto const& e : old)
+				{
+					if (e.cell != npos)
+					{
+						auto i = start(e.key);
+						while (slots[i].cell != npos)
+						{
+							i = (i + 1) & mask;
+						}
+						slots[i] = e;
+					}
+				}
+			}
+
+			std::vector<entry> slots;
+			std::vector<link>  links;
+			std::size_t        mask = 0;
+		};
+
+		template <typename InputIt>
+		static std::size_t reserve_hint(InputIt first, InputIt last, std::forward_iterator_tag)
+		{
+			return static_cast<std::size_t>(std::distance(first, last));
+		}
+
+		template <typename InputIt>
+		static std::size_t reserve_hint(InputIt, InputIt, std::input_iterator_tag)
+		{
+			return 0;
+		}
+
+		grid<Unit>               cells;
+		std::vector<std::size_t> membership;
+		std::vector<summary>     groups;
+	};
+
+	// Groups the values in [first, last) that are within tolerance of each other, directly or through a chain of
+	// other values. Throws std::invalid_argument unless the tolerance is positive and std::domain_error for NaN.
+	template <typename InputIt, typename Rep, typename Ratio, typename UnitType>
+	grouping<typename std::iterator_traits<InputIt>::value_type>
+	group_by(InputIt first, InputIt last, unit<Rep, Ratio, UnitType> tolerance)
+	{
+		return grouping<typename std::iterator_traits<InputIt>::value_type>{first, last, tolerance};
+	}
+
+	// Copies the first element of every group to out, in the order they appear, and returns the end of the output
+	template <typename InputIt, typename OutputIt, typename Rep, typename Ratio, typename UnitType>
+	OutputIt dedup(InputIt first, InputIt last, OutputIt out, unit<Rep, Ratio, UnitType> tolerance)
+	{
+		auto const groups = group_by(first, last, tolerance);
+		for (std::size_t g = 0; g != groups.size(); ++g)
+		{
+			*out++ = groups.representative(g);
+		}
+		return out;
+	}
+}
+
+namespace std
+{
+	// Integer units hash their count. Floating point units have no std::hash, key them with units::grid_hash and
+	// units::grid_equal instead.
+	template <typename Rep, typename Ratio, typename UnitType>
+	struct hash<units::unit<Rep, Ratio, UnitType>> : units::detail::grouping::hash<units::unit<Rep, Ratio, UnitType>>
+	{
+	};
+}
@@ -0,0 +1,727 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Sixteen bit floating point reps for compact storage. units::half is IEEE binary16, with 11 bits of precision and a
+// range of about 6e-8 to 65504, and units::bfloat16 keeps the range of float with 8 bits of precision. Both convert
+// implicitly to float, so arithmetic on them is done in float, and from any arithmetic type rounding to nearest.
+// half::round and bfloat16::round take an explicit rounding mode.
+//
+// units::bulk::widen converts whole ranges of compact units to double units and units::bulk::narrow converts back,
+// each fused with the unit_cast factor. Conversions of binary16 use the F16C or AVX-512 instructions when the
+// processor has them, see units/cpu_dispatch.h, and every path rounds identically. Doubles are first rounded to float
+// with round to odd, so rounding twice never changes the result.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/cpu_dispatch.h"
+
+#ifdef UNITS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace units
+{
+	enum class rounding
+	{
+		to_nearest,
+		toward_zero,
+		upward,
+		downward
+	};
+
+	namespace detail
+	{
+		namespace half_precision
+		{
+			UNITS_ALWAYS_INLINE std::uint32_t bits_of(float value)
+			{
+				std::uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			}
+
+			UNITS_ALWAYS_INLINE float float_of(std::uint32_t bits)
+			{
+				float value;
+				std::memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+
+			// Rounds towards zero and sets the lowest bit if anything was discarded
+			UNITS_ALWAYS_INLINE float round_to_odd(double value)
+			{
+				auto const nearest = static_cast<float>(value);
+				auto const back    = static_cast<double>(nearest);
+				auto       bits    = bits_of(nearest);
+				bits -= static_cast<std::uint32_t>(std::fabs(back) > std::fabs(value));
+				bits |= static_cast<std::uint32_t>(back != value);
+				return float_of(bits);
+			}
+
+			UNITS_ALWAYS_INLINE double round_to_odd(long double value)
+			{
+				auto nearest = static_cast<double>(value);
+				if (std::fabs(static_cast<long double>(nearest)) > std::fabs(value))
+				{
+					nearest = std::nextafter(nearest, 0.0);
+				}
+
+				std::uint64_t bits;
+				std::memcpy(&bits, &nearest, sizeof(bits));
+				bits |= static_cast<std::uint64_t>(static_cast<long double>(nearest) != value);
+				std::memcpy(&nearest, &bits, sizeof(nearest));
+				return nearest;
+			}
+
+			// Whether a magnitude truncated to quotient, with the given remainder, rounds up
+			template <rounding Mode>
+			UNITS_ALWAYS_INLINE std::uint32_t increment(std::uint32_t quotient,
+			                                            std::uint32_t remainder,
+			                                            std::uint32_t half_way,
+			                                            bool          negative)
+			{
+				auto const nearest  = remainder > half_way || (remainder == half_way && (quotient & 1u) != 0);
+				auto const directed = remainder != 0 && negative == (Mode == rounding::downward);
+				return static_cast<std::uint32_t>(Mode == rounding::to_nearest    ? nearest
+				                                  : Mode == rounding::toward_zero ? false
+				                                                                  : directed);
+			}
+
+			// The magnitude a finite value too large for the format rounds to
+			template <rounding Mode>
+			UNITS_ALWAYS_INLINE std::uint32_t overflow(std::uint32_t infinity, bool negative)
+			{
+				return Mode == rounding::to_nearest
+				               || (Mode == rounding::upward && !negative)
+				               || (Mode == rounding::downward && negative)
+				           ? infinity
+				           : infinity - 1;
+			}
+
+			struct binary16_format
+			{
+				static UNITS_ALWAYS_INLINE float to_float(std::uint16_t value)
+				{
+					auto const sign      = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+					auto const magnitude = static_cast<std::uint32_t>(value & 0x7fffu);
+					auto const exponent  = magnitude >> 10;
+					auto const shifted   = magnitude << 13;
+
+					auto const normal    = sign | (shifted + (112u << 23));
+					auto const special   = sign | shifted | 0x7f800000u;
+					auto const subnormal = sign | bits_of(float_of(shifted + (113u << 23)) - float_of(113u << 23));
+					return float_of(exponent == 31 ? special : exponent == 0 ? subnormal : normal);
+				}
+
+				template <rounding Mode>
+				static UNITS_ALWAYS_INLINE std::uint16_t from_float(float value)
+				{
+					auto const bits      = bits_of(value);
+					auto const sign      = (bits >> 16) & 0x8000u;
+					auto const magnitude = bits & 0x7fffffffu;
+					auto const exponent  = std::max(magnitude >> 23, 1u);
+
+					// Normal halves rebias the exponent and keep 10 of the 23 fraction bits. Subnormal halves count in
+					// units of 2^-24, so the significand with its implicit bit is shifted right further.
+					auto const normal      = magnitude >= 0x38800000u;
+					auto const significand = (magnitude & 0x7fffffu) | (magnitude >= 0x00800000u ? 0x800000u : 0u);
+					auto const value_bits  = normal ? magnitude - (112u << 23) : significand;
+					auto const shift       = normal ? 13u : std::min(126u - exponent, 31u);
+
+					auto quotient        = value_bits >> shift;
+					auto const remainder = value_bits & ((1u << shift) - 1);
+					quotient += increment<Mode>(quotient, remainder, 1u << (shift - 1), sign != 0);
+					quotient = quotient >= 0x7c00u ? overflow<Mode>(0x7c00u, sign != 0) : quotient;
+
+					// Infinities stay infinite and NaNs are quieted, keeping the top of their payload
+					auto const special = magnitude == 0x7f800000u ? 0x7c00u : 0x7e00u | ((magnitude >> 13) & 0x3ffu);
+					return static_cast<std::uint16_t>(sign | (magnitude >= 0x7f800000u ? special : quotient));
+				}
+			};
+
+			struct bfloat16_format
+			{
+				static UNITS_ALWAYS_INLINE float to_float(std::uint16_t value)
+				{
+					return float_of(static_cast<std::uint32_t>(value) << 16);
+				}
+
+				template <rounding Mode>
+				static UNITS_ALWAYS_INLINE std::uint16_t from_float(float value)
+				{
+					auto const bits      = bits_of(value);
+					auto const sign      = (bits >> 16) & 0x8000u;
+					auto const magnitude = bits & 0x7fffffffu;
+
+					auto quotient        = magnitude >> 16;
+					auto const remainder = magnitude & 0xffffu;
+					quotient += increment<Mode>(quotient, remainder, 0x8000u, sign != 0);
+					quotient = quotient >= 0x7f80u ? overflow<Mode>(0x7f80u, sign != 0) : quotient;
+
+					auto const special = magnitude == 0x7f800000u ? 0x7f80u : 0x7fc0u | (magnitude >> 16);
+					return static_cast<std::uint16_t>(sign | (magnitude >= 0x7f800000u ? special : quotient));
+				}
+			};
+
+			// Calls Kernel::run<Mode> with the rounding mode chosen at runtime, so loops are compiled for each mode
+			template <typename Kernel, typename... Args>
+			auto with_rounding(rounding mode, Args... args)
+			    -> decltype(Kernel::template run<rounding::to_nearest>(args...))
+			{
+				switch (mode)
+				{
+				case rounding::toward_zero: return Kernel::template run<rounding::toward_zero>(args...);
+				case rounding::upward: return Kernel::template run<rounding::upward>(args...);
+				case rounding::downward: return Kernel::template run<rounding::downward>(args...);
+				default: return Kernel::template run<rounding::to_nearest>(args...);
+				}
+			}
+
+			template <typename Format>
+			struct from_float
+			{
+				template <rounding Mode>
+				static std::uint16_t run(float value)
+				{
+					return Format::template from_float<Mode>(value);
+				}
+			};
+
+			template <typename Format>
+			std::uint16_t from_value(float value, rounding mode)
+			{
+				return with_rounding<from_float<Format>>(mode, value);
+			}
+
+			template <typename Format>
+			std::uint16_t from_value(double value, rounding mode)
+			{
+				return with_rounding<from_float<Format>>(mode, round_to_odd(value));
+			}
+
+			template <typename Format>
+			std::uint16_t from_value(long double value, rounding mode)
+			{
+				return with_rounding<from_float<Format>>(mode, round_to_odd(round_to_odd(value)));
+			}
+		}
+	}
+
+	// A 16 bit floating point value stored as its bit pattern
+	template <typename Format>
+	struct basic_float16
+	{
+		std::uint16_t bits;
+
+		constexpr basic_float16()
+		    : bits{0}
+		{
+		}
+
+		// Integers are converted through double, which holds every integer that does not overflow a half exactly
+		template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+		basic_float16(T value)
+		    : bits{detail::half_precision::from_value<Format>(
+		          static_cast<typename std::conditional<std::is_floating_point<T>::value, T, double>::type>(value),
+		          rounding::to_nearest)}
+		{
+		}
+
+		static constexpr basic_float16 from_bits(std::uint16_t bits)
+		{
+			return basic_float16{bits, 0};
+		}
+
+		template <typename T>
+		static basic_float16 round(T value, rounding mode)
+		{
+			static_assert(std::is_floating_point<T>::value, "Only floating point values are rounded");
+			return from_bits(detail::half_precision::from_value<Format>(value, mode));
+		}
+
+		operator float() const { return Format::to_float(bits); }
+
+		basic_float16& operator+=(float other) { return *this = static_cast<float>(*this) + other; }
+		basic_float16& operator-=(float other) { return *this = static_cast<float>(*this) - other; }
+		basic_float16& operator*=(float other) { return *this = static_cast<float>(*this) * other; }
+		basic_float16& operator/=(float other) { return *this = static_cast<float>(*this) / other; }
+
+		basic_float16& operator++() { return *this += 1.0f; }
+		basic_float16& operator--() { return *this -= 1.0f; }
+
+		basic_float16 operator++(int)
+		{
+			auto const temp = *this;
+			++*this;
+			return temp;
+		}
+
+		basic_float16 operator--(int)
+		{
+			auto const temp = *this;
+			--*this;
+			return temp;
+		}
+
+	private:
+		constexpr basic_float16(std::uint16_t bits, int)
+		    : bits{bits}
+		{
+		}
+	};
+
+	using half     = basic_float16<detail::half_precision::binary16_format>;
+	using bfloat16 = basic_float16<detail::half_precision::bfloat16_format>;
+
+	namespace bulk
+	{
+		struct float16_kernels
+		{
+			void (*widen)(std::uint16_t const*, std::size_t, double, double*);
+			void (*narrow)(double const*, std::size_t, double, rounding, std::uint16_t*);
+		};
+
+		// hardware is set when binary16 is converted with F16C or AVX-512 instructions
+		struct float16_kernel_table
+		{
+			cpu::tier       tier;
+			bool            hardware;
+			float16_kernels binary16;
+			float16_kernels bfloat16;
+		};
+	}
+
+	namespace detail
+	{
+		namespace half_precision
+		{
+			constexpr std::size_t block_size = 256;
+
+			namespace kernels
+			{
+				template <typename Format>
+				UNITS_ALWAYS_INLINE void widen(std::uint16_t const* in, std::size_t n, double factor, double* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = static_cast<double>(Format::to_float(in[i])) * factor;
+					}
+				}
+
+				template <typename Format, rounding Mode>
+				UNITS_ALWAYS_INLINE void narrow(double const* in, std::size_t n, double factor, std::uint16_t* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = Format::template from_float<Mode>(round_to_odd(in[i] * factor));
+					}
+				}
+
+				UNITS_ALWAYS_INLINE void round_to_odd(double const* in, std::size_t n, double factor, float* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = half_precision::round_to_odd(in[i] * factor);
+					}
+				}
+			}
+
+// Instantiates the software kernels for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_FLOAT16_TIER(Name, Tier, Target)                                                                         \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		template <typename Format>                                                                                     \
+		Target void widen(std::uint16_t const* in, std::size_t n, double factor, double* out)                         \
+		{                                                                                                              \
+			kernels::widen<Format>(in, n, factor, out);                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename Format>                                                                                     \
+		struct narrow_kernel                                                                                           \
+		{                                                                                                              \
+			template <rounding Mode>                                                                                   \
+			Target static void run(double const* in, std::size_t n, double factor, std::uint16_t* out)                \
+			{                                                                                                          \
+				kernels::narrow<Format, Mode>(in, n, factor, out);                                                     \
+			}                                                                                                          \
+		};                                                                                                             \
+                                                                                                                       \
+		template <typename Format>                                                                                     \
+		void narrow(double const* in, std::size_t n, double factor, rounding mode, std::uint16_t* out)                \
+		{                                                                                                              \
+			with_rounding<narrow_kernel<Format>>(mode, in, n, factor, out);                                            \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename Format>                                                                                     \
+		bulk::float16_kernels set()                                                                                    \
+		{                                                                                                              \
+			return bulk::float16_kernels{&widen<Format>, &narrow<Format>};                                             \
+		}                                                                                                              \
+                                                                                                                       \
+		inline bulk::float16_kernel_table const& table()                                                               \
+		{                                                                                                              \
+			static bulk::float16_kernel_table const t{Tier, false, set<binary16_format>(), set<bfloat16_format>()};    \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+			UNITS_FOR_EACH_TIER(UNITS_FLOAT16_TIER)
+
+#undef UNITS_FLOAT16_TIER
+
+#ifdef UNITS_X86_DISPATCH
+			// The rounding control immediate of vcvtps2ph
+			constexpr int immediate(rounding mode)
+			{
+				return mode == rounding::toward_zero ? _MM_FROUND_TO_ZERO
+				       : mode == rounding::upward    ? _MM_FROUND_TO_POS_INF
+				       : mode == rounding::downward  ? _MM_FROUND_TO_NEG_INF
+				                                     : _MM_FROUND_TO_NEAREST_INT;
+			}
+
+			// binary16 conversions with the F16C instructions that come with AVX2 on every processor that has it
+			namespace f16c_kernels
+			{
+				__attribute__((target("avx2,f16c"))) inline void widen(std::uint16_t const* in,
+				                                                       std::size_t          n,
+				                                                       double               factor,
+				                                                       double*              out)
+				{
+					auto const  scale = _mm256_set1_pd(factor);
+					std::size_t i     = 0;
+					for (; i + 8 <= n; i += 8)
+					{
+						auto const values = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)));
+						auto const low    = _mm256_cvtps_pd(_mm256_castps256_ps128(values));
+						auto const high   = _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1));
+						_mm256_storeu_pd(out + i, _mm256_mul_pd(low, scale));
+						_mm256_storeu_pd(out + i + 4, _mm256_mul_pd(high, scale));
+					}
+					avx2_kernels::widen<binary16_format>(in + i, n - i, factor, out + i);
+				}
+
+				struct narrow_kernel
+				{
+					template <rounding Mode>
+					__attribute__((target("avx2,f16c"))) static void run(double const*  in,
+					                                                     std::size_t    n,
+					                                                     double         factor,
+					                                                     std::uint16_t* out)
+					{
+						constexpr int control = std::integral_constant<int, immediate(Mode)>::value;
+
+						float block[block_size];
+						for (std::size_t first = 0; first < n; first += block_size)
+						{
+							auto const count = std::min(block_size, n - first);
+							kernels::round_to_odd(in + first, count, factor, block);
+
+							std::size_t i = 0;
+							for (; i + 8 <= count; i += 8)
+							{
+								auto const halves = _mm256_cvtps_ph(_mm256_loadu_ps(block + i), control);
+								_mm_storeu_si128(reinterpret_cast<__m128i*>(out + first + i), halves);
+							}
+							for (; i < count; ++i)
+							{
+								out[first + i] = binary16_format::from_float<Mode>(block[i]);
+							}
+						}
+					}
+				};
+
+				inline void narrow(double const* in, std::size_t n, double factor, rounding mode, std::uint16_t* out)
+				{
+					with_rounding<narrow_kernel>(mode, in, n, factor, out);
+				}
+
+				inline bulk::float16_kernel_table const& table()
+				{
+					static bulk::float16_kernel_table const t{cpu::tier::avx2,
+					                                          true,
+					                                          bulk::float16_kernels{&widen, &narrow},
+					                                          avx2_kernels::set<bfloat16_format>()};
+					return t;
+				}
+			}
+
+			// binary16 conversions with the 512 bit forms of the same instructions, which are part of AVX-512F. The
+			// zero masking forms avoid the undefined source operands of the plain intrinsics.
+			namespace avx512_hardware_kernels
+			{
+				constexpr __mmask16 all = 0xffff;
+
+				__attribute__((target("avx512f"))) inline void widen(std::uint16_t const* in,
+				                                                     std::size_t          n,
+				                                                     double               factor,
+				                                                     double*              out)
+				{
+					auto const  scale = _mm512_set1_pd(factor);
+					std::size_t i     = 0;
+					for (; i + 16 <= n; i += 16)
+					{
+						auto const halves = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+						auto const values = _mm512_maskz_cvtph_ps(all, halves);
+						auto const lower  = _mm512_maskz_extractf64x4_pd(0xf, _mm512_castps_pd(values), 0);
+						auto const upper  = _mm512_maskz_extractf64x4_pd(0xf, _mm512_castps_pd(values), 1);
+						auto const low    = _mm512_maskz_cvtps_pd(0xff, _mm256_castpd_ps(lower));
+						auto const high   = _mm512_maskz_cvtps_pd(0xff, _mm256_castpd_ps(upper));
+						_mm512_storeu_pd(out + i, _mm512_mul_pd(low, scale));
+						_mm512_storeu_pd(out + i + 8, _mm512_mul_pd(high, scale));
+					}
+					avx512_kernels::widen<binary16_format>(in + i, n - i, factor, out + i);
+				}
+
+				struct narrow_kernel
+				{
+					template <rounding Mode>
+					__attribute__((target("avx512f"))) static void run(double const*  in,
+					                                                   std::size_t    n,
+					                                                   double         factor,
+					                                                   std::uint16_t* out)
+					{
+						constexpr int control = std::integral_constant<int, immediate(Mode)>::value;
+
+						float block[block_size];
+						for (std::size_t first = 0; first < n; first += block_size)
+						{
+							auto const count = std::min(block_size, n - first);
+							kernels::round_to_odd(in + first, count, factor, block);
+
+							std::size_t i = 0;
+							for (; i + 16 <= count; i += 16)
+							{
+								auto const halves = _mm512_maskz_cvtps_ph(all, _mm512_loadu_ps(block + i), control);
+								_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + first + i), halves);
+							}
+							for (; i < count; ++i)
+							{
+								out[first + i] = binary16_format::from_float<Mode>(block[i]);
+							}
+						}
+					}
+				};
+
+				inline void narrow(double const* in, std::size_t n, double factor, rounding mode, std::uint16_t* out)
+				{
+					with_rounding<narrow_kernel>(mode, in, n, factor, out);
+				}
+
+				inline bulk::float16_kernel_table const& table()
+				{
+					static bulk::float16_kernel_table const t{cpu::tier::avx512,
+					                                          true,
+					                                          bulk::float16_kernels{&widen, &narrow},
+					                                          avx512_kernels::set<bfloat16_format>()};
+					return t;
+				}
+			}
+#endif
+
+			// The kernels for each tier when the hardware conversions are used for binary16 where the processor has
+			// them
+			namespace hardware
+			{
+				namespace scalar_kernels = half_precision::scalar_kernels;
+#ifdef UNITS_X86_DISPATCH
+				namespace sse42_kernels  = half_precision::sse42_kernels;
+				namespace avx512_kernels = half_precision::avx512_hardware_kernels;
+
+				namespace avx2_kernels
+				{
+					inline bulk::float16_kernel_table const& table()
+					{
+						return cpu::detected_features().f16c ? f16c_kernels::table()
+						                                     : half_precision::avx2_kernels::table();
+					}
+				}
+#endif
+			}
+
+			// The kernels for each format, found by units::detail::select
+			inline bulk::float16_kernels const& kernels_of(bulk::float16_kernel_table const& table,
+			                                               binary16_format const*)
+			{
+				return table.binary16;
+			}
+
+			inline bulk::float16_kernels const& kernels_of(bulk::float16_kernel_table const& table,
+			                                               bfloat16_format const*)
+			{
+				return table.bfloat16;
+			}
+
+			template <typename Format>
+			std::uint16_t const* bits(basic_float16<Format> const* values)
+			{
+				static_assert(sizeof(basic_float16<Format>) == sizeof(std::uint16_t), "Values must be 16 bits");
+				return reinterpret_cast<std::uint16_t const*>(values);
+			}
+
+			template <typename Format>
+			std::uint16_t* bits(basic_float16<Format>* values)
+			{
+				static_assert(sizeof(basic_float16<Format>) == sizeof(std::uint16_t), "Values must be 16 bits");
+				return reinterpret_cast<std::uint16_t*>(values);
+			}
+		}
+	}
+
+	namespace bulk
+	{
+		// The 16 bit conversion kernels for a given tier, or the best supported one if the machine cannot run it. The
+		// hardware conversions are used for binary16 when the processor has them.
+		inline float16_kernel_table const& float16_kernels_for(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(units::detail::half_precision::hardware));
+		}
+
+		// The software kernels for a given tier, which give the same results as the hardware ones
+		inline float16_kernel_table const& float16_software_kernels_for(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(units::detail::half_precision));
+		}
+
+		// The 16 bit conversion kernels bound to the active tier, chosen once on first use
+		inline float16_kernel_table const& float16_kernels_for()
+		{
+			return cpu::active_kernels<float16_kernel_table, &float16_kernels_for>();
+		}
+
+		namespace detail
+		{
+			template <typename ToUnit, typename Format, typename Ratio, typename UnitType>
+			ToUnit* widen(unit<basic_float16<Format>, Ratio, UnitType> const* first,
+			              unit<basic_float16<Format>, Ratio, UnitType> const* last,
+			              ToUnit*                                             out,
+			              std::true_type)
+			{
+				namespace half_precision = units::detail::half_precision;
+
+				auto const count = static_cast<std::size_t>(last - first);
+				units::detail::select<Format>(float16_kernels_for())
+				    .widen(half_precision::bits(units::detail::raw(first)),
+				           count,
+				           units::detail::conversion_factor<double, Ratio, typename ToUnit::ratio>(),
+				           units::detail::raw(out));
+				return out + count;
+			}
+
+			template <typename ToUnit, typename Format, typename Ratio, typename UnitType>
+			ToUnit* widen(unit<basic_float16<Format>, Ratio, UnitType> const* first,
+			              unit<basic_float16<Format>, Ratio, UnitType> const* last,
+			              ToUnit*                                             out,
+			              std::false_type)
+			{
+				return std::transform(first, last, out, [](unit<basic_float16<Format>, Ratio, UnitType> u) {
+					return unit_cast<ToUnit>(u);
+				});
+			}
+
+			template <typename Format, typename ToRatio, typename Ratio, typename UnitType>
+			auto narrow(unit<double, Ratio, UnitType> const*            first,
+			            unit<double, Ratio, UnitType> const*            last,
+			            unit<basic_float16<Format>, ToRatio, UnitType>* out,
+			            rounding                                        mode) -> decltype(out)
+			{
+				namespace half_precision = units::detail::half_precision;
+
+				auto const count = static_cast<std::size_t>(last - first);
+				units::detail::select<Format>(float16_kernels_for())
+				    .narrow(units::detail::raw(first),
+				            count,
+				            units::detail::conversion_factor<double, Ratio, ToRatio>(),
+				            mode,
+				            half_precision::bits(units::detail::raw(out)));
+				return out + count;
+			}
+
+			template <typename Format, typename ToRatio, typename Rep, typename Ratio, typename UnitType>
+			auto narrow(unit<Rep, Ratio, UnitType> const*               first,
+			            unit<Rep, Ratio, UnitType> const*               last,
+			            unit<basic_float16<Format>, ToRatio, UnitType>* out,
+			            rounding                                        mode) -> decltype(out)
+			{
+				using wide = unit<double, ToRatio, UnitType>;
+				return std::transform(first, last, out, [mode](unit<Rep, Ratio, UnitType> u) {
+					return unit<basic_float16<Format>, ToRatio, UnitType>{
+					    basic_float16<Format>::round(unit_cast<wide>(u).count(), mode)};
+				});
+			}
+		}
+
+		// Converts a range of 16 bit units to ToUnit. Double units are converted in one pass with the unit_cast
+		// factor folded in, which can differ from unit_cast in the last bit like cast.
+		template <typename ToUnit, typename Format, typename Ratio, typename UnitType>
+		ToUnit* widen(unit<basic_float16<Format>, Ratio, UnitType> const* first,
+		              unit<basic_float16<Format>, Ratio, UnitType> const* last,
+		              ToUnit*                                             out)
+		{
+			static_assert(std::is_same<typename ToUnit::unit_type, UnitType>::value, "Incompatible types");
+
+			return detail::widen(first, last, out, std::is_same<typename ToUnit::rep, double>{});
+		}
+
+		// Converts a range of units to 16 bit units, rounding each value once with the given mode
+		template <typename Rep, typename Ratio, typename UnitType, typename Format, typename ToRatio>
+		auto narrow(unit<Rep, Ratio, UnitType> const*               first,
+		            unit<Rep, Ratio, UnitType> const*               last,
+		            unit<basic_float16<Format>, ToRatio, UnitType>* out,
+		            rounding                                        mode = rounding::to_nearest) -> decltype(out)
+		{
+			return detail::narrow<Format, ToRatio>(first, last, out, mode);
+		}
+	}
+}
+
+namespace std
+{
+	// Arithmetic on 16 bit values is done in float
+	template <typename Format, typename T>
+	struct common_type<units::basic_float16<Format>, T>
+	    : std::enable_if<std::is_arithmetic<T>::value, typename std::common_type<float, T>::type>
+	{
+	};
+
+	template <typename T, typename Format>
+	struct common_type<T, units::basic_float16<Format>>
+	    : std::enable_if<std::is_arithmetic<T>::value, typename std::common_type<T, float>::type>
+	{
+	};
+
+	template <typename Format>
+	struct common_type<units::basic_float16<Format>, units::basic_float16<Format>>
+	{
+		using type = units::basic_float16<Format>;
+	};
+}
@@ -0,0 +1,377 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "units.h"
+
+namespace units
+{
+	namespace detail
+	{
+		template <typename It, typename Unit>
+		struct is_contiguous_iterator
+		    : std::integral_constant<bool,
+		                             std::is_convertible<It, Unit const*>::value
+		                                 || std::is_same<It, typename std::vector<Unit>::iterator>::value
+		                                 || std::is_same<It, typename std::vector<Unit>::const_iterator>::value>
+		{
+		};
+
+		// Bin edges are held as plain values in the ratio of Unit so that filling never has to convert the edges.
+		// Slot 0 is the underflow bin, slots [1, bins] are the real bins and slot bins + 1 is the overflow bin.
+		// Bins are half-open, [lower, upper), so a value equal to the last edge lands in the overflow bin, as
+		// does NaN.
+		template <typename Unit>
+		class bin_edges
+		{
+		public:
+			using unit_type  = typename Unit::unit_type;
+			using value_type = typename std::common_type<typename Unit::rep, double>::type;
+
+			static constexpr std::size_t block_size = 256;
+
+			template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+			bin_edges(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi, std::size_t bins)
+			    : lo{to_value(lo)}
+			    , hi{to_value(hi)}
+			    , last{static_cast<value_type>(bins) - 1}
+			    , inv_width{}
+			    , edges{}
+			{
+				if (bins == 0)
+				{
+					throw std::invalid_argument{"A histogram needs at least one bin"};
+				}
+
+				if (!(this->lo < this->hi))
+				{
+					throw std::invalid_argument{"Histogram range is empty"};
+				}
+
+				inv_width = static_cast<value_type>(bins) / (this->hi - this->lo);
+			}
+
+			template <typename InputIt>
+			bin_edges(InputIt first, InputIt last_edge)
+			    : lo{}
+			    , hi{}
+			    , last{}
+			    , inv_width{}
+			    , edges{}
+			{
+				for (; first != last_edge; ++first)
+				{
+					edges.push_back(to_value(*first));
+				}
+
+				if (edges.size() < 2)
+				{
+					throw std::invalid_argument{"A histogram needs at least two edges"};
+				}
+
+				if (std::adjacent_find(edges.begin(), edges.end(), std::greater_equal<value_type>{}) != edges.end())
+				{
+					throw std::invalid_argument{"Histogram edges must be strictly increasing"};
+				}
+
+				lo   = edges.front();
+				hi   = edges.back();
+				last = static_cast<value_type>(edges.size() - 2);
+			}
+
+			std::size_t bins() const { return static_cast<std::size_t>(last) + 1; }
+
+			Unit lower_edge(std::size_t bin) const
+			{
+				return Unit{static_cast<typename Unit::rep>(edges.empty() ? lo + bin / inv_width : edges[bin])};
+			}
+
+			Unit upper_edge(std::size_t bin) const
+			{
+				return bin + 1 == bins() ? Unit{static_cast<typename Unit::rep>(hi)} : lower_edge(bin + 1);
+			}
+
+			std::size_t slot(value_type x) const
+			{
+				return edges.empty() ? uniform_slot(x) : variable_slot(x);
+			}
+
+			// Computes the slots of a block of at most block_size values. The uniform case is branch free so the
+			// compiler is able to vectorise it.
+			void slots(Unit const* first, std::size_t n, std::uint32_t* out) const
+			{
+				if (edges.empty())
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = static_cast<std::uint32_t>(uniform_slot(static_cast<value_type>(first[i].count())));
+					}
+				}
+				else
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = static_cast<std::uint32_t>(variable_slot(static_cast<value_type>(first[i].count())));
+					}
+				}
+			}
+
+			bool operator==(bin_edges const& other) const
+			{
+				return lo == other.lo && hi == other.hi && last == other.last && edges == other.edges;
+			}
+
+			template <typename Rep2, typename Ratio2>
+			static value_type to_value(unit<Rep2, Ratio2, unit_type> u)
+			{
+				using edge_unit = unit<value_type, typename Unit::ratio, unit_type>;
+				return units::unit_cast<edge_unit>(u).count();
+			}
+
+		private:
+			std::size_t uniform_slot(value_type x) const
+			{
+				auto const t       = (x - lo) * inv_width;
+				auto const clamped = t > 0 ? (t < last ? t : last) : value_type{0};
+				auto const bin     = static_cast<std::size_t>(clamped) + 1;
+				return x < lo ? 0 : (x < hi ? bin : bins() + 1);
+			}
+
+			std::size_t variable_slot(value_type x) const
+			{
+				return static_cast<std::size_t>(std::upper_bound(edges.begin(), edges.end(), x) - edges.begin());
+			}
+
+			value_type              lo;
+			value_type              hi;
+			value_type              last;
+			value_type              inv_width;
+			std::vector<value_type> edges;
+		};
+
+		template <typename Unit>
+		constexpr std::size_t bin_edges<Unit>::block_size;
+	}
+
+	template <typename Unit>
+	class concurrent_histogram;
+
+	template <typename Unit>
+	class histogram
+	{
+		static_assert(is_unit<Unit>::value, "A histogram must be binned on a unit");
+
+	public:
+		using unit_type = typename Unit::unit_type;
+
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		histogram(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi, std::size_t bins)
+		    : edges{lo, hi, bins}
+		    , counts(bins + 2)
+		{
+		}
+
+		template <typename Rep, typename Ratio>
+		histogram(std::initializer_list<unit<Rep, Ratio, unit_type>> bin_edges)
+		    : edges{bin_edges.begin(), bin_edges.end()}
+		    , counts(edges.bins() + 2)
+		{
+		}
+
+		template <typename InputIt>
+		histogram(InputIt first, InputIt last)
+		    : edges{first, last}
+		    , counts(edges.bins() + 2)
+		{
+		}
+
+		std::size_t bins() const { return edges.bins(); }
+
+		Unit lower_edge(std::size_t bin) const { return edges.lower_edge(bin); }
+		Unit upper_edge(std::size_t bin) const { return edges.upper_edge(bin); }
+
+		std::uint64_t count(std::size_t bin) const { return counts[bin + 1]; }
+		std::uint64_t underflow() const { return counts.front(); }
+		std::uint64_t overflow() const { return counts.back(); }
+
+		std::uint64_t total() const { return std::accumulate(counts.begin(), counts.end(), std::uint64_t{0}); }
+
+		template <typename Rep, typename Ratio>
+		void fill(unit<Rep, Ratio, unit_type> value)
+		{
+			++counts[edges.slot(edges.to_value(value))];
+		}
+
+		template <typename InputIt>
+		void fill(InputIt first, InputIt last)
+		{
+			fill_range(first, last, detail::is_contiguous_iterator<InputIt, Unit>{});
+		}
+
+		void clear() { std::fill(counts.begin(), counts.end(), 0); }
+
+		histogram& operator+=(histogram const& other)
+		{
+			if (!(edges == other.edges))
+			{
+				throw std::invalid_argument{"Histograms have different bin edges"};
+			}
+
+			std::transform(counts.begin(), counts.end(), other.counts.begin(), counts.begin(), std::plus<std::uint64_t>{});
+			return *this;
+		}
+
+	private:
+		friend class concurrent_histogram<Unit>;
+
+		explicit histogram(detail::bin_edges<Unit> const& layout)
+		    : edges{layout}
+		    , counts(layout.bins() + 2)
+		{
+		}
+
+		// Values already in the ratio of the histogram are binned a block at a time without any conversion
+		template <typename InputIt>
+		void fill_range(InputIt first, InputIt last, std::true_type)
+		{
+			Unit const*   begin = first == last ? nullptr : std::addressof(*first);
+			Unit const*   end   = begin + (last - first);
+			std::uint32_t slots[detail::bin_edges<Unit>::block_size];
+
+			for (; begin != end;)
+			{
+				auto const n = std::min<std::size_t>(end - begin, detail::bin_edges<Unit>::block_size);
+				edges.slots(begin, n, slots);
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					++counts[slots[i]];
+				}
+				begin += n;
+			}
+		}
+
+		template <typename InputIt>
+		void fill_range(InputIt first, InputIt last, std::false_type)
+		{
+			for (; first != last; ++first)
+			{
+				fill(*first);
+			}
+		}
+
+		detail::bin_edges<Unit>    edges;
+		std::vector<std::uint64_t> counts;
+	};
+
+	// A histogram that many threads may fill at once. Single values are counted with a relaxed atomic increment and
+	// ranges are binned into a local table first so that each bin is only touched once per call.
+	template <typename Unit>
+	class concurrent_histogram
+	{
+		static_assert(is_unit<Unit>::value, "A histogram must be binned on a unit");
+
+	public:
+		using unit_type = typename Unit::unit_type;
+
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		concurrent_histogram(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi, std::size_t bins)
+		    : edges{lo, hi, bins}
+		    , counts{new std::atomic<std::uint64_t>[bins + 2]}
+		{
+			clear();
+		}
+
+		template <typename Rep, typename Ratio>
+		concurrent_histogram(std::initializer_list<unit<Rep, Ratio, unit_type>> bin_edges)
+		    : edges{bin_edges.begin(), bin_edges.end()}
+		    , counts{new std::atomic<std::uint64_t>[edges.bins() + 2]}
+		{
+			clear();
+		}
+
+		template <typename InputIt>
+		concurrent_histogram(InputIt first, InputIt last)
+		    : edges{first, last}
+		    , counts{new std::atomic<std::uint64_t>[edges.bins() + 2]}
+		{
+			clear();
+		}
+
+		std::size_t bins() const { return edges.bins(); }
+
+		Unit lower_edge(std::size_t bin) const { return edges.lower_edge(bin); }
+		Unit upper_edge(std::size_t bin) const { return edges.upper_edge(bin); }
+
+		std::uint64_t count(std::size_t bin) const { return counts[bin + 1].load(std::memory_order_relaxed); }
+		std::uint64_t underflow() const { return counts[0].load(std::memory_order_relaxed); }
+		std::uint64_t overflow() const { return counts[bins() + 1].load(std::memory_order_relaxed); }
+
+		template <typename Rep, typename Ratio>
+		void fill(unit<Rep, Ratio, unit_type> value)
+		{
+			counts[edges.slot(edges.to_value(value))].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		template <typename InputIt>
+		void fill(InputIt first, InputIt last)
+		{
+			histogram<Unit> local{edges};
+			local.fill(first, last);
+
+			for (std::size_t i = 0; i < local.counts.size(); ++i)
+			{
+				if (local.counts[i] != 0)
+				{
+					counts[i].fetch_add(local.counts[i], std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void clear()
+		{
+			for (std::size_t i = 0; i < bins() + 2; ++i)
+			{
+				counts[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		detail::bin_edges<Unit>                      edges;
+		std::unique_ptr<std::atomic<std::uint64_t>[]> counts;
+	};
+}
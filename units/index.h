@@ -0,0 +1,503 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Static indexes over columns of units. units::range_index answers how many values, and which rows, fall in
+// [lo, hi), and units::interval_index answers which intervals contain a point or overlap a range. Bounds may be in
+// any ratio of the unit type; they are converted to the ratio of the index once per query, never per element.
+//
+// Both keep their keys sorted under a static B+ tree with nodes of 16 keys, so a search over hundreds of millions of
+// values reads about seven nodes and scans each one without branching. Building sorts a piece of the column on each
+// thread and merges the pieces in parallel.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+
+#include "units.h"
+
+namespace units
+{
+	struct index_options
+	{
+		std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+	};
+
+	// The rows of the original column that answer a query
+	class index_rows
+	{
+	public:
+		index_rows(std::size_t const* first, std::size_t const* last)
+		    : first{first}
+		    , last{last}
+		{
+		}
+
+		std::size_t const* begin() const { return first; }
+		std::size_t const* end() const { return last; }
+		std::size_t        size() const { return static_cast<std::size_t>(last - first); }
+		bool               empty() const { return first == last; }
+
+	private:
+		std::size_t const* first;
+		std::size_t const* last;
+	};
+
+	namespace detail
+	{
+		namespace index
+		{
+			template <typename Work>
+			void run_parallel(std::size_t count, Work const& work)
+			{
+				auto tasks = std::vector<std::future<void>>{};
+				for (std::size_t i = 1; i < count; ++i)
+				{
+					tasks.push_back(std::async(std::launch::async, work, i));
+				}
+				work(0);
+				for (auto& task : tasks)
+				{
+					task.get();
+				}
+			}
+
+			// Below this many items a single thread sorts faster than starting more
+			constexpr std::size_t parallel_threshold = std::size_t{1} << 16;
+
+			// Sorts a piece of items on each thread, then merges neighbouring runs in parallel until one is left
+			template <typename T, typename Less>
+			void sort(std::vector<T>& items, std::size_t threads, Less less)
+			{
+				auto const n = items.size();
+				if (threads <= 1 || n < parallel_threshold)
+				{
+					std::sort(items.begin(), items.end(), less);
+					return;
+				}
+
+				auto runs = std::vector<std::size_t>{};
+				for (std::size_t i = 0; i <= threads; ++i)
+				{
+					runs.push_back(n * i / threads);
+				}
+
+				run_parallel(threads, [&](std::size_t i) {
+					std::sort(items.begin() + runs[i], items.begin() + runs[i + 1], less);
+				});
+
+				auto buffer = std::vector<T>(n);
+				while (runs.size() > 2)
+				{
+					// A run left without a partner is merged with nothing, which copies it across
+					auto const pairs = (runs.size() - 1) / 2;
+					run_parallel(runs.size() / 2, [&](std::size_t p) {
+						auto const first  = runs[2 * p];
+						auto const middle = runs[2 * p + 1];
+						auto const last   = p < pairs ? runs[2 * p + 2] : middle;
+						std::merge(items.begin() + first,
+						           items.begin() + middle,
+						           items.begin() + middle,
+						           items.begin() + last,
+						           buffer.begin() + first,
+						           less);
+					});
+					items.swap(buffer);
+
+					auto merged = std::vector<std::size_t>{};
+					for (std::size_t i = 0; i < runs.size(); i += 2)
+					{
+						merged.push_back(runs[i]);
+					}
+					if (merged.back() != n)
+					{
+						merged.push_back(n);
+					}
+					runs.swap(merged);
+				}
+			}
+
+			// Finds ranks in a sorted array of keys with a static B+ tree over it. Each level above the keys holds
+			// the first key of every node of 16 keys in the level below, so a search reads one node per level, two
+			// cache lines scanned without branching, and the small top levels stay in cache between queries.
+			template <typename T>
+			class search_tree
+			{
+			public:
+				static constexpr std::size_t fanout = 16;
+
+				search_tree() = default;
+
+				explicit search_tree(std::vector<T> const& keys)
+				    : levels{}
+				{
+					auto const* below = &keys;
+					while (below->size() > fanout)
+					{
+						auto level = std::vector<T>{};
+						level.reserve((below->size() + fanout - 1) / fanout);
+						for (std::size_t i = 0; i < below->size(); i += fanout)
+						{
+							level.push_back((*below)[i]);
+						}
+						levels.push_back(std::move(level));
+						below = &levels.back();
+					}
+				}
+
+				// The number of keys for which below(key, x) is true. keys must be the array the tree was built over
+				// and below must be true for a prefix of it.
+				template <typename Below>
+				std::size_t rank(std::vector<T> const& keys, T x, Below below) const
+				{
+					if (levels.empty())
+					{
+						return count(keys, 0, x, below);
+					}
+
+					// A rank r in a level means the keys below x in the level beneath are every key of its first
+					// r - 1 nodes and a prefix of node r - 1
+					auto r = count(levels.back(), 0, x, below);
+					for (auto level = levels.size(); level-- > 0;)
+					{
+						if (r == 0)
+						{
+							return 0;
+						}
+						r = count(level == 0 ? keys : levels[level - 1], (r - 1) * fanout, x, below);
+					}
+					return r;
+				}
+
+			private:
+				template <typename Below>
+				static std::size_t count(std::vector<T> const& level, std::size_t first, T x, Below below)
+				{
+					auto const  last   = std::min(first + fanout, level.size());
+					std::size_t result = first;
+					for (auto i = first; i < last; ++i)
+					{
+						result += static_cast<std::size_t>(below(level[i], x));
+					}
+					return result;
+				}
+
+				std::vector<std::vector<T>> levels;
+			};
+
+			template <typename T>
+			constexpr std::size_t search_tree<T>::fanout;
+
+			template <typename T>
+			void check(T value)
+			{
+				if (std::isnan(static_cast<double>(value)))
+				{
+					throw std::domain_error{"Cannot index NaN"};
+				}
+			}
+		}
+	}
+
+	// A sorted index over a column of units, answering range queries over [lo, hi)
+	template <typename Unit>
+	class range_index
+	{
+		static_assert(is_unit<Unit>::value, "Only units can be indexed");
+
+	public:
+		using unit_type  = typename Unit::unit_type;
+		using value_type = typename std::common_type<typename Unit::rep, double>::type;
+
+		// Indexes [first, last); rows are positions in that range. Throws std::domain_error if a value is NaN.
+		template <typename InputIt>
+		range_index(InputIt first, InputIt last, index_options options = {})
+		    : keys{}
+		    , rows{}
+		    , search{}
+		{
+			struct entry
+			{
+				value_type  key;
+				std::size_t row;
+			};
+
+			auto entries = std::vector<entry>{};
+			for (std::size_t row = 0; first != last; ++first, ++row)
+			{
+				auto const key = to_value(*first);
+				detail::index::check(key);
+				entries.push_back(entry{key, row});
+			}
+
+			// Equal keys keep the order of their rows, so the answer does not depend on the number of threads
+			detail::index::sort(entries, options.threads, [](entry const& lhs, entry const& rhs) {
+				return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.row < rhs.row);
+			});
+
+			keys.reserve(entries.size());
+			rows.reserve(entries.size());
+			for (auto const& e : entries)
+			{
+				keys.push_back(e.key);
+				rows.push_back(e.row);
+			}
+			search = detail::index::search_tree<value_type>{keys};
+		}
+
+		std::size_t size() const { return keys.size(); }
+
+		// The number of values below bound
+		template <typename Rep, typename Ratio>
+		std::size_t rank(unit<Rep, Ratio, unit_type> bound) const
+		{
+			return search.rank(keys, to_value(bound), std::less<value_type>{});
+		}
+
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		std::size_t count_between(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi) const
+		{
+			auto const range = bounds(lo, hi);
+			return range.second - range.first;
+		}
+
+		// The rows with values in [lo, hi), in order of value
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		index_rows between(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi) const
+		{
+			auto const range = bounds(lo, hi);
+			return index_rows{rows.data() + range.first, rows.data() + range.second};
+		}
+
+		// The value at a rank, smallest first
+		Unit operator[](std::size_t rank) const { return Unit{static_cast<typename Unit::rep>(keys[rank])}; }
+
+		template <typename Rep, typename Ratio>
+		static value_type to_value(unit<Rep, Ratio, unit_type> u)
+		{
+			return unit_cast<unit<value_type, typename Unit::ratio, unit_type>>(u).count();
+		}
+
+	private:
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		std::pair<std::size_t, std::size_t> bounds(unit<Rep1, Ratio1, unit_type> lo,
+		                                           unit<Rep2, Ratio2, unit_type> hi) const
+		{
+			auto const first = rank(lo);
+			auto const last  = rank(hi);
+			return {first, std::max(first, last)};
+		}
+
+		std::vector<value_type>                 keys;
+		std::vector<std::size_t>                rows;
+		detail::index::search_tree<value_type> search;
+	};
+
+	// An index over a column of closed intervals [start, end], answering which intervals contain a point or overlap
+	// a range. Intervals are sorted by start, and a tree over blocks of them records the furthest end in each subtree,
+	// so a query only descends into blocks that can still reach it.
+	template <typename Unit>
+	class interval_index
+	{
+		static_assert(is_unit<Unit>::value, "Only units can be indexed");
+
+	public:
+		using unit_type  = typename Unit::unit_type;
+		using value_type = typename std::common_type<typename Unit::rep, double>::type;
+
+		static constexpr std::size_t block = 32;
+
+		// Indexes the intervals [*starts, *ends] for each position of [first_start, last_start). Throws
+		// std::invalid_argument if an interval ends before it starts and std::domain_error if a bound is NaN.
+		template <typename InputIt1, typename InputIt2>
+		interval_index(InputIt1 first_start, InputIt1 last_start, InputIt2 first_end, index_options options = {})
+		    : starts{}
+		    , ends{}
+		    , rows{}
+		    , reach{}
+		    , leaves{}
+		    , search{}
+		{
+			struct entry
+			{
+				value_type  start;
+				value_type  end;
+				std::size_t row;
+			};
+
+			auto entries = std::vector<entry>{};
+			for (std::size_t row = 0; first_start != last_start; ++first_start, ++first_end, ++row)
+			{
+				auto const start = to_value(*first_start);
+				auto const end   = to_value(*first_end);
+				detail::index::check(start);
+				detail::index::check(end);
+				if (end < start)
+				{
+					throw std::invalid_argument{"Interval ends before it starts"};
+				}
+				entries.push_back(entry{start, end, row});
+			}
+
+			detail::index::sort(entries, options.threads, [](entry const& lhs, entry const& rhs) {
+				return lhs.start < rhs.start || (lhs.start == rhs.start && lhs.row < rhs.row);
+			});
+
+			starts.reserve(entries.size());
+			ends.reserve(entries.size());
+			rows.reserve(entries.size());
+			for (auto const& e : entries)
+			{
+				starts.push_back(e.start);
+				ends.push_back(e.end);
+				rows.push_back(e.row);
+			}
+			search = detail::index::search_tree<value_type>{starts};
+
+			leaves = 1;
+			while (leaves * block < entries.size())
+			{
+				leaves *= 2;
+			}
+
+			reach.assign(2 * leaves, std::numeric_limits<value_type>::lowest());
+			for (std::size_t i = 0; i < ends.size(); ++i)
+			{
+				auto& r = reach[leaves + i / block];
+				r       = std::max(r, ends[i]);
+			}
+			for (auto node = leaves - 1; node > 0; --node)
+			{
+				reach[node] = std::max(reach[2 * node], reach[2 * node + 1]);
+			}
+		}
+
+		std::size_t size() const { return starts.size(); }
+
+		// Calls f with the row of every interval overlapping [lo, hi], in order of start
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2, typename F>
+		void for_each_overlapping(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi, F f) const
+		{
+			auto const from = to_value(lo);
+			auto const to   = to_value(hi);
+			if (!(from <= to) || starts.empty())
+			{
+				return;
+			}
+
+			auto const candidates = search.rank(starts, to, std::less_equal<value_type>{});
+			visit(1, 0, leaves, candidates, from, f);
+		}
+
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		std::vector<std::size_t> overlapping(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi) const
+		{
+			auto result = std::vector<std::size_t>{};
+			for_each_overlapping(lo, hi, [&](std::size_t row) { result.push_back(row); });
+			return result;
+		}
+
+		template <typename Rep1, typename Ratio1, typename Rep2, typename Ratio2>
+		std::size_t count_overlapping(unit<Rep1, Ratio1, unit_type> lo, unit<Rep2, Ratio2, unit_type> hi) const
+		{
+			std::size_t count = 0;
+			for_each_overlapping(lo, hi, [&](std::size_t) { ++count; });
+			return count;
+		}
+
+		// The rows of the intervals that contain point
+		template <typename Rep, typename Ratio>
+		std::vector<std::size_t> stabbing(unit<Rep, Ratio, unit_type> point) const
+		{
+			return overlapping(point, point);
+		}
+
+		template <typename Rep, typename Ratio>
+		std::size_t count_containing(unit<Rep, Ratio, unit_type> point) const
+		{
+			return count_overlapping(point, point);
+		}
+
+		template <typename Rep, typename Ratio>
+		static value_type to_value(unit<Rep, Ratio, unit_type> u)
+		{
+			return unit_cast<unit<value_type, typename Unit::ratio, unit_type>>(u).count();
+		}
+
+	private:
+		// Node covers the leaf blocks [first, last). Only the first candidates intervals start early enough.
+		template <typename F>
+		void visit(std::size_t node,
+		           std::size_t first,
+		           std::size_t last,
+		           std::size_t candidates,
+		           value_type  from,
+		           F&          f) const
+		{
+			if (first * block >= candidates || reach[node] < from)
+			{
+				return;
+			}
+
+			if (node >= leaves)
+			{
+				auto const end = std::min(candidates, (first + 1) * block);
+				for (auto i = first * block; i < end; ++i)
+				{
+					if (ends[i] >= from)
+					{
+						f(rows[i]);
+					}
+				}
+				return;
+			}
+
+			auto const middle = first + (last - first) / 2;
+			visit(2 * node, first, middle, candidates, from, f);
+			visit(2 * node + 1, middle, last, candidates, from, f);
+		}
+
+		std::vector<value_type>                 starts;
+		std::vector<value_type>                 ends;
+		std::vector<std::size_t>                rows;
+		std::vector<value_type>                 reach;
+		std::size_t                             leaves;
+		detail::index::search_tree<value_type> search;
+	};
+
+	template <typename Unit>
+	constexpr std::size_t interval_index<Unit>::block;
+}
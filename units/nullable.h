@@ -0,0 +1,1037 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Missing values stored in band, so a column of units with gaps keeps the size of its rep. units::nullable<Unit> holds
+// either a unit or null, where null is a quiet NaN with a fixed payload for floating point reps and the lowest value
+// (the highest for unsigned reps) for integer reps. Only that payload is null; NaN produced by arithmetic is a value.
+// An integer unit holding the sentinel reads as null.
+//
+// The bulk reductions skip nulls by masking rather than branching, either over a range of nullable units or over a
+// range of plain units with a validity bitmap, one bit per element, least significant bit first, set when the element
+// is present. units::bitmap_column keeps a column in the second form. Ranges of float and double are reduced with
+// vectorised kernels for each tier in units/cpu_dispatch.h.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+
+namespace units
+{
+	// The in band encoding of null for a rep
+	template <typename Rep, typename = void>
+	struct null_traits;
+
+	template <typename Rep>
+	struct null_traits<Rep, typename std::enable_if<std::is_floating_point<Rep>::value>::type>
+	{
+		static_assert(sizeof(Rep) == 4 || sizeof(Rep) == 8, "Null payloads are defined for float and double");
+
+		using bits_type = typename std::conditional<sizeof(Rep) == 8, std::uint64_t, std::uint32_t>::type;
+
+		static constexpr bits_type bits = sizeof(Rep) == 8 ? static_cast<bits_type>(0x7ff800004e554c4cull)
+		                                                   : static_cast<bits_type>(0x7fc04e55u);
+
+		static Rep null()
+		{
+			Rep value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		static bool is_null(Rep value)
+		{
+			bits_type raw;
+			std::memcpy(&raw, &value, sizeof(raw));
+			return raw == bits;
+		}
+	};
+
+	template <typename Rep>
+	struct null_traits<Rep, typename std::enable_if<std::is_integral<Rep>::value>::type>
+	{
+		static constexpr Rep null()
+		{
+			return std::is_signed<Rep>::value ? std::numeric_limits<Rep>::lowest() : std::numeric_limits<Rep>::max();
+		}
+
+		static constexpr bool is_null(Rep value)
+		{
+			return value == null();
+		}
+	};
+
+	struct null_t
+	{
+		constexpr explicit null_t(int)
+		{
+		}
+	};
+
+	constexpr null_t null{0};
+
+	template <typename Unit>
+	class nullable
+	{
+	public:
+		using unit_type = Unit;
+		using rep       = typename Unit::rep;
+
+		constexpr nullable()
+		    : stored{null_traits<rep>::null()}
+		{
+		}
+
+		constexpr nullable(null_t)
+		    : stored{null_traits<rep>::null()}
+		{
+		}
+
+		constexpr nullable(Unit value)
+		    : stored{value}
+		{
+		}
+
+		bool has_value() const
+		{
+			return !null_traits<rep>::is_null(stored.count());
+		}
+
+		explicit operator bool() const
+		{
+			return has_value();
+		}
+
+		// Throws std::domain_error when null
+		Unit value() const
+		{
+			if (!has_value())
+			{
+				throw std::domain_error{"Value is null"};
+			}
+			return stored;
+		}
+
+		Unit value_or(Unit fallback) const
+		{
+			return has_value() ? stored : fallback;
+		}
+
+	private:
+		Unit stored;
+	};
+
+	// Null compares equal to null and less than any value, as std::optional does
+	template <typename Unit1, typename Unit2>
+	bool operator==(nullable<Unit1> lhs, nullable<Unit2> rhs)
+	{
+		return lhs.has_value() == rhs.has_value() && (!lhs.has_value() || lhs.value() == rhs.value());
+	}
+
+	template <typename Unit1, typename Unit2>
+	bool operator!=(nullable<Unit1> lhs, nullable<Unit2> rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <typename Unit1, typename Unit2>
+	bool operator<(nullable<Unit1> lhs, nullable<Unit2> rhs)
+	{
+		return rhs.has_value() && (!lhs.has_value() || lhs.value() < rhs.value());
+	}
+
+	template <typename Unit1, typename Unit2>
+	bool operator<=(nullable<Unit1> lhs, nullable<Unit2> rhs)
+	{
+		return !lhs.has_value() || (rhs.has_value() && lhs.value() <= rhs.value());
+	}
+
+	template <typename Unit1, typename Unit2>
+	bool operator>(nullable<Unit1> lhs, nullable<Unit2> rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <typename Unit1, typename Unit2>
+	bool operator>=(nullable<Unit1> lhs, nullable<Unit2> rhs)
+	{
+		return rhs <= lhs;
+	}
+
+	template <typename Unit, typename Rep, typename Ratio, typename UnitType>
+	bool operator==(nullable<Unit> lhs, unit<Rep, Ratio, UnitType> rhs)
+	{
+		return lhs.has_value() && lhs.value() == rhs;
+	}
+
+	template <typename Unit, typename Rep, typename Ratio, typename UnitType>
+	bool operator==(unit<Rep, Ratio, UnitType> lhs, nullable<Unit> rhs)
+	{
+		return rhs == lhs;
+	}
+
+	template <typename Unit, typename Rep, typename Ratio, typename UnitType>
+	bool operator!=(nullable<Unit> lhs, unit<Rep, Ratio, UnitType> rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <typename Unit, typename Rep, typename Ratio, typename UnitType>
+	bool operator!=(unit<Rep, Ratio, UnitType> lhs, nullable<Unit> rhs)
+	{
+		return !(rhs == lhs);
+	}
+
+	// A column of units with a validity bitmap
+	template <typename Unit>
+	class bitmap_column
+	{
+	public:
+		using value_type = Unit;
+
+		void reserve(std::size_t count)
+		{
+			values.reserve(count);
+			bits.reserve(words(count));
+		}
+
+		void push_back(Unit value)
+		{
+			append(value, true);
+		}
+
+		void push_back(null_t)
+		{
+			append(Unit{typename Unit::rep{}}, false);
+		}
+
+		void push_back(nullable<Unit> value)
+		{
+			append(value.value_or(Unit{typename Unit::rep{}}), value.has_value());
+		}
+
+		std::size_t size() const
+		{
+			return values.size();
+		}
+
+		bool is_null(std::size_t index) const
+		{
+			return ((bits[index / 64] >> (index % 64)) & 1u) == 0;
+		}
+
+		nullable<Unit> operator[](std::size_t index) const
+		{
+			return is_null(index) ? nullable<Unit>{} : nullable<Unit>{values[index]};
+		}
+
+		// The values, with an unspecified value where an element is null
+		Unit const* data() const
+		{
+			return values.data();
+		}
+
+		std::uint64_t const* validity() const
+		{
+			return bits.data();
+		}
+
+		static constexpr std::size_t words(std::size_t count)
+		{
+			return (count + 63) / 64;
+		}
+
+	private:
+		void append(Unit value, bool valid)
+		{
+			auto const index = values.size();
+			values.push_back(value);
+			if (index % 64 == 0)
+			{
+				bits.push_back(0);
+			}
+			bits.back() |= static_cast<std::uint64_t>(valid) << (index % 64);
+		}
+
+		std::vector<Unit>          values;
+		std::vector<std::uint64_t> bits;
+	};
+
+	namespace bulk
+	{
+		template <typename T>
+		struct nullable_kernels
+		{
+			double (*sum)(T const*, std::size_t, std::size_t*);
+			T (*min)(T const*, std::size_t);
+			T (*max)(T const*, std::size_t);
+			std::size_t (*count_between)(T const*, std::size_t, T, T);
+			double (*masked_sum)(T const*, std::uint64_t const*, std::size_t, std::size_t*);
+			T (*masked_min)(T const*, std::uint64_t const*, std::size_t);
+			T (*masked_max)(T const*, std::uint64_t const*, std::size_t);
+			std::size_t (*masked_count_between)(T const*, std::uint64_t const*, std::size_t, T, T);
+		};
+
+		struct nullable_kernel_table
+		{
+			cpu::tier                tier;
+			nullable_kernels<float>  f32;
+			nullable_kernels<double> f64;
+		};
+	}
+
+	namespace detail
+	{
+		namespace nullable
+		{
+			// Sums of floating point reps are kept in double and sums of integer reps in 64 bits
+			template <typename T>
+			using accumulator = typename std::conditional<
+			    std::is_floating_point<T>::value,
+			    double,
+			    typename std::conditional<std::is_signed<T>::value, std::int64_t, std::uint64_t>::type>::type;
+
+			namespace kernels
+			{
+				constexpr std::size_t lanes = 8;
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool is_null(T value)
+				{
+					return null_traits<T>::is_null(value);
+				}
+
+				// Where a range keeps its nulls: in band in the values, or in a validity bitmap
+				template <typename T>
+				struct sentinel
+				{
+					T const* in;
+				};
+
+				struct bitmap
+				{
+					std::uint64_t const* validity;
+				};
+
+				// Calls step(lane, index, present) for every element. Whole blocks of lanes pass the lane they belong
+				// to, so each lane can keep its own partial result.
+				template <typename T, typename Step>
+				UNITS_ALWAYS_INLINE void visit(sentinel<T> nulls, std::size_t n, Step step)
+				{
+					std::size_t i = 0;
+					for (; i + lanes <= n; i += lanes)
+					{
+						for (std::size_t j = 0; j < lanes; ++j)
+						{
+							step(j, i + j, !is_null(nulls.in[i + j]));
+						}
+					}
+					for (; i < n; ++i)
+					{
+						step(0, i, !is_null(nulls.in[i]));
+					}
+				}
+
+				// The bitmap is read a word at a time
+				template <typename Step>
+				UNITS_ALWAYS_INLINE void visit(bitmap nulls, std::size_t n, Step step)
+				{
+					std::size_t i = 0;
+					for (; i + 64 <= n; i += 64)
+					{
+						auto const word = nulls.validity[i / 64];
+						for (std::size_t k = 0; k < 64; k += lanes)
+						{
+							for (std::size_t j = 0; j < lanes; ++j)
+							{
+								step(j, i + k + j, ((word >> (k + j)) & 1u) != 0);
+							}
+						}
+					}
+					for (; i < n; ++i)
+					{
+						step(0, i, ((nulls.validity[i / 64] >> (i % 64)) & 1u) != 0);
+					}
+				}
+
+				template <typename Nulls>
+				UNITS_ALWAYS_INLINE std::size_t count_valid(Nulls nulls, std::size_t n)
+				{
+					std::size_t counts[lanes] = {};
+					visit(nulls, n, [&](std::size_t lane, std::size_t, bool present) {
+						counts[lane] += static_cast<std::size_t>(present);
+					});
+
+					std::size_t count = 0;
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						count += counts[j];
+					}
+					return count;
+				}
+
+				template <typename T, typename Nulls>
+				UNITS_ALWAYS_INLINE accumulator<T> sum(T const* in, Nulls nulls, std::size_t n, std::size_t* count)
+				{
+					using total_type = accumulator<T>;
+
+					total_type  partial[lanes] = {};
+					std::size_t counts[lanes]  = {};
+					visit(nulls, n, [&](std::size_t lane, std::size_t index, bool present) {
+						partial[lane] += zero_unless(present, static_cast<total_type>(in[index]));
+						counts[lane] += static_cast<std::size_t>(present);
+					});
+
+					total_type  total = 0;
+					std::size_t kept  = 0;
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						total += partial[j];
+						kept += counts[j];
+					}
+					*count = kept;
+					return total;
+				}
+
+				// A floating point null is a NaN, which no comparison prefers, so a sentinel range needs no masking
+				template <typename T, typename Nulls>
+				struct compares_false : std::false_type
+				{
+				};
+
+				template <typename T>
+				struct compares_false<T, sentinel<T>> : std::is_floating_point<T>
+				{
+				};
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE T either(bool, T value, T, std::true_type)
+				{
+					return value;
+				}
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE T either(bool keep, T value, T otherwise, std::false_type)
+				{
+					return zero_unless(keep, value) + zero_unless(!keep, otherwise);
+				}
+
+				// Nulls are replaced by the identity of the reduction, so identity is also the result when every
+				// element is null
+				template <typename T, typename Nulls, typename Better>
+				UNITS_ALWAYS_INLINE T extreme(T const* in, Nulls nulls, std::size_t n, T identity, Better better)
+				{
+					T partial[lanes];
+					std::fill(partial, partial + lanes, identity);
+					visit(nulls, n, [&](std::size_t lane, std::size_t index, bool present) {
+						auto const value = either(present, in[index], identity, compares_false<T, Nulls>{});
+						partial[lane]    = better(value, partial[lane]) ? value : partial[lane];
+					});
+
+					T best = identity;
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						best = better(partial[j], best) ? partial[j] : best;
+					}
+					return best;
+				}
+
+				template <typename T>
+				constexpr T highest()
+				{
+					return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+					                                            : std::numeric_limits<T>::max();
+				}
+
+				template <typename T>
+				constexpr T lowest()
+				{
+					return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+					                                            : std::numeric_limits<T>::lowest();
+				}
+
+				struct less
+				{
+					template <typename T>
+					bool operator()(T lhs, T rhs) const
+					{
+						return lhs < rhs;
+					}
+				};
+
+				struct greater
+				{
+					template <typename T>
+					bool operator()(T lhs, T rhs) const
+					{
+						return lhs > rhs;
+					}
+				};
+
+				template <typename T, typename Nulls>
+				UNITS_ALWAYS_INLINE T min(T const* in, Nulls nulls, std::size_t n)
+				{
+					return extreme(in, nulls, n, highest<T>(), less{});
+				}
+
+				template <typename T, typename Nulls>
+				UNITS_ALWAYS_INLINE T max(T const* in, Nulls nulls, std::size_t n)
+				{
+					return extreme(in, nulls, n, lowest<T>(), greater{});
+				}
+
+				// Counts the present values in [lo, hi)
+				template <typename T, typename Nulls, typename Bound>
+				UNITS_ALWAYS_INLINE std::size_t
+				count_between(T const* in, Nulls nulls, std::size_t n, Bound lo, Bound hi)
+				{
+					std::size_t counts[lanes] = {};
+					visit(nulls, n, [&](std::size_t lane, std::size_t index, bool present) {
+						auto const value = static_cast<Bound>(in[index]);
+						counts[lane] += static_cast<std::size_t>(present & (value >= lo) & (value < hi));
+					});
+
+					std::size_t count = 0;
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						count += counts[j];
+					}
+					return count;
+				}
+			}
+
+// Instantiates the null skipping reductions for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_NULLABLE_TIER(Name, Tier, Target)                                                                        \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		template <typename T>                                                                                          \
+		Target double sum(T const* in, std::size_t n, std::size_t* count)                                             \
+		{                                                                                                              \
+			return kernels::sum(in, kernels::sentinel<T>{in}, n, count);                                               \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target T min(T const* in, std::size_t n)                                                                       \
+		{                                                                                                              \
+			return kernels::min(in, kernels::sentinel<T>{in}, n);                                                      \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target T max(T const* in, std::size_t n)                                                                       \
+		{                                                                                                              \
+			return kernels::max(in, kernels::sentinel<T>{in}, n);                                                      \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target std::size_t count_between(T const* in, std::size_t n, T lo, T hi)                                       \
+		{                                                                                                              \
+			return kernels::count_between(in, kernels::sentinel<T>{in}, n, lo, hi);                                    \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target double masked_sum(T const* in, std::uint64_t const* validity, std::size_t n, std::size_t* count)       \
+		{                                                                                                              \
+			return kernels::sum(in, kernels::bitmap{validity}, n, count);                                              \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target T masked_min(T const* in, std::uint64_t const* validity, std::size_t n)                                 \
+		{                                                                                                              \
+			return kernels::min(in, kernels::bitmap{validity}, n);                                                     \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target T masked_max(T const* in, std::uint64_t const* validity, std::size_t n)                                 \
+		{                                                                                                              \
+			return kernels::max(in, kernels::bitmap{validity}, n);                                                     \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target std::size_t masked_count_between(T const* in, std::uint64_t const* validity, std::size_t n, T lo, T hi) \
+		{                                                                                                              \
+			return kernels::count_between(in, kernels::bitmap{validity}, n, lo, hi);                                   \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		bulk::nullable_kernels<T> set()                                                                                \
+		{                                                                                                              \
+			return bulk::nullable_kernels<T>{&sum<T>,                                                                  \
+			                                 &min<T>,                                                                  \
+			                                 &max<T>,                                                                  \
+			                                 &count_between<T>,                                                        \
+			                                 &masked_sum<T>,                                                           \
+			                                 &masked_min<T>,                                                           \
+			                                 &masked_max<T>,                                                           \
+			                                 &masked_count_between<T>};                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		inline bulk::nullable_kernel_table const& table()                                                              \
+		{                                                                                                              \
+			static bulk::nullable_kernel_table const t{Tier, set<float>(), set<double>()};                            \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+			UNITS_FOR_EACH_TIER(UNITS_NULLABLE_TIER)
+
+#undef UNITS_NULLABLE_TIER
+
+			template <typename Rep, typename Ratio, typename UnitType>
+			Rep const* raw(units::nullable<unit<Rep, Ratio, UnitType>> const* u)
+			{
+				static_assert(sizeof(units::nullable<unit<Rep, Ratio, UnitType>>) == sizeof(Rep),
+				              "Nullable units must have the size of their rep");
+				return reinterpret_cast<Rep const*>(u);
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType>
+			Rep* raw(units::nullable<unit<Rep, Ratio, UnitType>>* u)
+			{
+				static_assert(sizeof(units::nullable<unit<Rep, Ratio, UnitType>>) == sizeof(Rep),
+				              "Nullable units must have the size of their rep");
+				return reinterpret_cast<Rep*>(u);
+			}
+
+			template <typename Rep>
+			using bound_rep = typename std::conditional<units::detail::is_dispatched<Rep>::value,
+			                                            Rep,
+			                                            typename std::common_type<Rep, double>::type>::type;
+
+			// Converts one present value as bulk::cast does, with one multiply when the reps are the same float or
+			// double and with unit_cast otherwise
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType, typename = void>
+			struct converter
+			{
+				typename ToUnit::rep operator()(Rep value) const
+				{
+					return units::unit_cast<ToUnit>(unit<Rep, Ratio, UnitType>{value}).count();
+				}
+			};
+
+			template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+			struct converter<ToUnit,
+			                 Rep,
+			                 Ratio,
+			                 UnitType,
+			                 typename std::enable_if<units::detail::is_dispatched<Rep>::value
+			                                         && std::is_same<Rep, typename ToUnit::rep>::value>::type>
+			{
+				Rep operator()(Rep value) const
+				{
+					return value * factor;
+				}
+
+				Rep factor = units::detail::conversion_factor<Rep, Ratio, typename ToUnit::ratio>();
+			};
+		}
+	}
+
+	namespace bulk
+	{
+		// The null skipping kernels for a given tier, or the best supported one if the machine cannot run it
+		inline nullable_kernel_table const& nullable_kernels_for(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(units::detail::nullable));
+		}
+
+		// The null skipping kernels bound to the active tier, chosen once on first use
+		inline nullable_kernel_table const& nullable_kernels_for()
+		{
+			return cpu::active_kernels<nullable_kernel_table, &nullable_kernels_for>();
+		}
+
+		namespace detail
+		{
+			template <typename Rep>
+			using null_sentinel = units::detail::nullable::kernels::sentinel<Rep>;
+			using null_bitmap   = units::detail::nullable::kernels::bitmap;
+
+			template <typename Rep>
+			nullable_kernels<Rep> const& null_kernels()
+			{
+				return units::detail::select<Rep>(nullable_kernels_for());
+			}
+
+			// Where each element is present comes from Nulls, either the sentinel or the bitmap
+			template <typename Rep, typename Nulls>
+			units::detail::nullable::accumulator<Rep>
+			sum(Rep const* in, Nulls nulls, std::size_t n, std::size_t* count, std::false_type)
+			{
+				return units::detail::nullable::kernels::sum(in, nulls, n, count);
+			}
+
+			template <typename Rep>
+			double sum(Rep const* in, null_sentinel<Rep>, std::size_t n, std::size_t* count, std::true_type)
+			{
+				return null_kernels<Rep>().sum(in, n, count);
+			}
+
+			template <typename Rep>
+			double sum(Rep const* in, null_bitmap nulls, std::size_t n, std::size_t* count, std::true_type)
+			{
+				return null_kernels<Rep>().masked_sum(in, nulls.validity, n, count);
+			}
+
+			template <typename Rep, typename Nulls>
+			Rep min(Rep const* in, Nulls nulls, std::size_t n, std::false_type)
+			{
+				return units::detail::nullable::kernels::min(in, nulls, n);
+			}
+
+			template <typename Rep>
+			Rep min(Rep const* in, null_sentinel<Rep>, std::size_t n, std::true_type)
+			{
+				return null_kernels<Rep>().min(in, n);
+			}
+
+			template <typename Rep>
+			Rep min(Rep const* in, null_bitmap nulls, std::size_t n, std::true_type)
+			{
+				return null_kernels<Rep>().masked_min(in, nulls.validity, n);
+			}
+
+			template <typename Rep, typename Nulls>
+			Rep max(Rep const* in, Nulls nulls, std::size_t n, std::false_type)
+			{
+				return units::detail::nullable::kernels::max(in, nulls, n);
+			}
+
+			template <typename Rep>
+			Rep max(Rep const* in, null_sentinel<Rep>, std::size_t n, std::true_type)
+			{
+				return null_kernels<Rep>().max(in, n);
+			}
+
+			template <typename Rep>
+			Rep max(Rep const* in, null_bitmap nulls, std::size_t n, std::true_type)
+			{
+				return null_kernels<Rep>().masked_max(in, nulls.validity, n);
+			}
+
+			template <typename Rep, typename Bound, typename Nulls>
+			std::size_t count_between(Rep const* in, Nulls nulls, std::size_t n, Bound lo, Bound hi, std::false_type)
+			{
+				return units::detail::nullable::kernels::count_between(in, nulls, n, lo, hi);
+			}
+
+			template <typename Rep>
+			std::size_t count_between(Rep const* in, null_sentinel<Rep>, std::size_t n, Rep lo, Rep hi, std::true_type)
+			{
+				return null_kernels<Rep>().count_between(in, n, lo, hi);
+			}
+
+			template <typename Rep>
+			std::size_t count_between(Rep const* in, null_bitmap nulls, std::size_t n, Rep lo, Rep hi, std::true_type)
+			{
+				return null_kernels<Rep>().masked_count_between(in, nulls.validity, n, lo, hi);
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType, typename Nulls>
+			unit<Rep, Ratio, UnitType> sum(Rep const* in, Nulls nulls, std::size_t n)
+			{
+				std::size_t count = 0;
+				return unit<Rep, Ratio, UnitType>{
+				    static_cast<Rep>(sum(in, nulls, n, &count, units::detail::is_dispatched<Rep>{}))};
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType, typename Nulls>
+			units::nullable<unit<typename std::common_type<Rep, double>::type, Ratio, UnitType>> mean(Rep const*  in,
+			                                                                                         Nulls       nulls,
+			                                                                                         std::size_t n)
+			{
+				using result_type = unit<typename std::common_type<Rep, double>::type, Ratio, UnitType>;
+				using rep         = typename result_type::rep;
+
+				std::size_t count = 0;
+				auto const  total = sum(in, nulls, n, &count, units::detail::is_dispatched<Rep>{});
+				if (count == 0)
+				{
+					return units::null;
+				}
+				return result_type{static_cast<rep>(total) / static_cast<rep>(count)};
+			}
+
+			// The reductions hand back their identity when every element is null. Only then is it worth counting
+			// whether anything was present.
+			template <typename Rep, typename Ratio, typename UnitType, typename Nulls>
+			units::nullable<unit<Rep, Ratio, UnitType>> extreme(Rep value, Rep identity, Nulls nulls, std::size_t n)
+			{
+				if (value == identity && units::detail::nullable::kernels::count_valid(nulls, n) == 0)
+				{
+					return units::null;
+				}
+				return unit<Rep, Ratio, UnitType>{value};
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType, typename Nulls>
+			units::nullable<unit<Rep, Ratio, UnitType>> min(Rep const* in, Nulls nulls, std::size_t n)
+			{
+				auto const value    = min(in, nulls, n, units::detail::is_dispatched<Rep>{});
+				auto const identity = units::detail::nullable::kernels::highest<Rep>();
+				return extreme<Rep, Ratio, UnitType>(value, identity, nulls, n);
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType, typename Nulls>
+			units::nullable<unit<Rep, Ratio, UnitType>> max(Rep const* in, Nulls nulls, std::size_t n)
+			{
+				auto const value    = max(in, nulls, n, units::detail::is_dispatched<Rep>{});
+				auto const identity = units::detail::nullable::kernels::lowest<Rep>();
+				return extreme<Rep, Ratio, UnitType>(value, identity, nulls, n);
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType, typename Nulls, typename Lo, typename Hi>
+			std::size_t count_between(Rep const* in, Nulls nulls, std::size_t n, Lo lo, Hi hi)
+			{
+				using bound = unit<units::detail::nullable::bound_rep<Rep>, Ratio, UnitType>;
+				return count_between(in,
+				                     nulls,
+				                     n,
+				                     unit_cast<bound>(lo).count(),
+				                     unit_cast<bound>(hi).count(),
+				                     units::detail::is_dispatched<Rep>{});
+			}
+		}
+
+		// The number of elements that are not null
+		template <typename Rep, typename Ratio, typename UnitType>
+		std::size_t count_valid(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                        nullable<unit<Rep, Ratio, UnitType>> const* last)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			return units::detail::nullable::kernels::count_valid(detail::null_sentinel<Rep>{in},
+			                                                     static_cast<std::size_t>(last - first));
+		}
+
+		// The sum of the elements that are not null, zero when all of them are
+		template <typename Rep, typename Ratio, typename UnitType>
+		unit<Rep, Ratio, UnitType> sum(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                               nullable<unit<Rep, Ratio, UnitType>> const* last)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			return detail::sum<Rep, Ratio, UnitType>(
+			    in, detail::null_sentinel<Rep>{in}, static_cast<std::size_t>(last - first));
+		}
+
+		// The mean of the elements that are not null, or null when all of them are
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto mean(nullable<unit<Rep, Ratio, UnitType>> const* first, nullable<unit<Rep, Ratio, UnitType>> const* last)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			return detail::mean<Rep, Ratio, UnitType>(
+			    in, detail::null_sentinel<Rep>{in}, static_cast<std::size_t>(last - first));
+		}
+
+		// The smallest element that is not null, or null when all of them are
+		template <typename Rep, typename Ratio, typename UnitType>
+		nullable<unit<Rep, Ratio, UnitType>> min(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                                         nullable<unit<Rep, Ratio, UnitType>> const* last)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			return detail::min<Rep, Ratio, UnitType>(
+			    in, detail::null_sentinel<Rep>{in}, static_cast<std::size_t>(last - first));
+		}
+
+		// The largest element that is not null, or null when all of them are
+		template <typename Rep, typename Ratio, typename UnitType>
+		nullable<unit<Rep, Ratio, UnitType>> max(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                                         nullable<unit<Rep, Ratio, UnitType>> const* last)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			return detail::max<Rep, Ratio, UnitType>(
+			    in, detail::null_sentinel<Rep>{in}, static_cast<std::size_t>(last - first));
+		}
+
+		// Counts the elements in [lo, hi) that are not null. The bounds may be in any compatible ratio and are
+		// converted to the ratio of the range once.
+		template <typename Rep, typename Ratio, typename UnitType, typename Lo, typename Hi>
+		std::size_t count_between(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                          nullable<unit<Rep, Ratio, UnitType>> const* last,
+		                          Lo                                          lo,
+		                          Hi                                          hi)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			return detail::count_between<Rep, Ratio, UnitType>(
+			    in, detail::null_sentinel<Rep>{in}, static_cast<std::size_t>(last - first), lo, hi);
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType, typename Bound>
+		std::size_t count_less(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                       nullable<unit<Rep, Ratio, UnitType>> const* last,
+		                       Bound                                       bound)
+		{
+			using lowest = unit<long double, Ratio, UnitType>;
+			return count_between(first, last, lowest{-std::numeric_limits<long double>::infinity()}, bound);
+		}
+
+		// The same reductions over plain units whose presence is given by a validity bitmap
+		template <typename Rep, typename Ratio, typename UnitType>
+		std::size_t count_valid(unit<Rep, Ratio, UnitType> const* first,
+		                        unit<Rep, Ratio, UnitType> const* last,
+		                        std::uint64_t const*              validity)
+		{
+			return units::detail::nullable::kernels::count_valid(detail::null_bitmap{validity},
+			                                                     static_cast<std::size_t>(last - first));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		unit<Rep, Ratio, UnitType> sum(unit<Rep, Ratio, UnitType> const* first,
+		                               unit<Rep, Ratio, UnitType> const* last,
+		                               std::uint64_t const*              validity)
+		{
+			return detail::sum<Rep, Ratio, UnitType>(units::detail::raw(first),
+			                                         detail::null_bitmap{validity},
+			                                         static_cast<std::size_t>(last - first));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		auto mean(unit<Rep, Ratio, UnitType> const* first,
+		          unit<Rep, Ratio, UnitType> const* last,
+		          std::uint64_t const*              validity)
+		{
+			return detail::mean<Rep, Ratio, UnitType>(units::detail::raw(first),
+			                                          detail::null_bitmap{validity},
+			                                          static_cast<std::size_t>(last - first));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		nullable<unit<Rep, Ratio, UnitType>> min(unit<Rep, Ratio, UnitType> const* first,
+		                                         unit<Rep, Ratio, UnitType> const* last,
+		                                         std::uint64_t const*              validity)
+		{
+			return detail::min<Rep, Ratio, UnitType>(units::detail::raw(first),
+			                                         detail::null_bitmap{validity},
+			                                         static_cast<std::size_t>(last - first));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType>
+		nullable<unit<Rep, Ratio, UnitType>> max(unit<Rep, Ratio, UnitType> const* first,
+		                                         unit<Rep, Ratio, UnitType> const* last,
+		                                         std::uint64_t const*              validity)
+		{
+			return detail::max<Rep, Ratio, UnitType>(units::detail::raw(first),
+			                                         detail::null_bitmap{validity},
+			                                         static_cast<std::size_t>(last - first));
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType, typename Lo, typename Hi>
+		std::size_t count_between(unit<Rep, Ratio, UnitType> const* first,
+		                          unit<Rep, Ratio, UnitType> const* last,
+		                          std::uint64_t const*              validity,
+		                          Lo                                lo,
+		                          Hi                                hi)
+		{
+			return detail::count_between<Rep, Ratio, UnitType>(units::detail::raw(first),
+			                                                   detail::null_bitmap{validity},
+			                                                   static_cast<std::size_t>(last - first),
+			                                                   lo,
+			                                                   hi);
+		}
+
+		template <typename Rep, typename Ratio, typename UnitType, typename Bound>
+		std::size_t count_less(unit<Rep, Ratio, UnitType> const* first,
+		                       unit<Rep, Ratio, UnitType> const* last,
+		                       std::uint64_t const*              validity,
+		                       Bound                             bound)
+		{
+			using lowest = unit<long double, Ratio, UnitType>;
+			return count_between(first, last, validity, lowest{-std::numeric_limits<long double>::infinity()}, bound);
+		}
+
+		// Converts a range of nullable units to another ratio, keeping nulls. Throws std::domain_error if a value
+		// converts to the null of the target rep.
+		template <typename ToUnit, typename Rep, typename Ratio, typename UnitType>
+		nullable<ToUnit>* cast(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		                       nullable<unit<Rep, Ratio, UnitType>> const* last,
+		                       nullable<ToUnit>*                           out)
+		{
+			static_assert(std::is_same<typename ToUnit::unit_type, UnitType>::value, "Incompatible types");
+			using to_rep = typename ToUnit::rep;
+
+			auto const in      = units::detail::nullable::raw(first);
+			auto const n       = static_cast<std::size_t>(last - first);
+			auto const null    = null_traits<to_rep>::null();
+			auto const convert = units::detail::nullable::converter<ToUnit, Rep, Ratio, UnitType>{};
+			auto const result  = units::detail::nullable::raw(out);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				if (null_traits<Rep>::is_null(in[i]))
+				{
+					result[i] = null;
+					continue;
+				}
+				auto const value = convert(in[i]);
+				if (null_traits<to_rep>::is_null(value))
+				{
+					throw std::domain_error{"Value converts to null"};
+				}
+				result[i] = value;
+			}
+			return out + n;
+		}
+
+		// Splits a range of nullable units into values and a validity bitmap of bitmap_column<Unit>::words(n) words
+		template <typename Rep, typename Ratio, typename UnitType>
+		void to_bitmap(nullable<unit<Rep, Ratio, UnitType>> const* first,
+		               nullable<unit<Rep, Ratio, UnitType>> const* last,
+		               unit<Rep, Ratio, UnitType>*                 values,
+		               std::uint64_t*                              validity)
+		{
+			auto const in = units::detail::nullable::raw(first);
+			auto const n  = static_cast<std::size_t>(last - first);
+			std::copy(in, in + n, units::detail::raw(values));
+			std::fill(validity, validity + bitmap_column<unit<Rep, Ratio, UnitType>>::words(n), std::uint64_t{0});
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				validity[i / 64] |= static_cast<std::uint64_t>(!null_traits<Rep>::is_null(in[i])) << (i % 64);
+			}
+		}
+
+		// Joins values and a validity bitmap into nullable units
+		template <typename Rep, typename Ratio, typename UnitType>
+		nullable<unit<Rep, Ratio, UnitType>>* from_bitmap(unit<Rep, Ratio, UnitType> const*     first,
+		                                                  unit<Rep, Ratio, UnitType> const*     last,
+		                                                  std::uint64_t const*                  validity,
+		                                                  nullable<unit<Rep, Ratio, UnitType>>* out)
+		{
+			auto const in     = units::detail::raw(first);
+			auto const n      = static_cast<std::size_t>(last - first);
+			auto const null   = null_traits<Rep>::null();
+			auto const result = units::detail::nullable::raw(out);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				result[i] = ((validity[i / 64] >> (i % 64)) & 1u) != 0 ? in[i] : null;
+			}
+			return out + n;
+		}
+	}
+}
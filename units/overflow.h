@@ -0,0 +1,995 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Integer reps that do not wrap around. units::saturating<T> clamps every result to the range of T, and
+// units::checked<T> throws std::overflow_error instead of producing a result T cannot hold. Both plug into unit, so
+// unit<saturating<std::int32_t>, std::milli, unit_type::distance> saturates in operator+=, operator* and unit_cast,
+// which computes in saturating<std::intmax_t> through std::common_type. Like the built in integers they convert
+// implicitly to double, which is what unit_compare and the std::isless family compare in.
+//
+// units::bulk::add, subtract, scale and sum work on whole ranges of either rep. Their kernels compute every element
+// without branches and keep one sticky overflow flag for the whole range instead of testing each result. Saturating
+// ranges return the flag, and checked ranges throw once the whole range has been processed. Ranges of int16_t and
+// int32_t use vectorised kernels for each tier in units/cpu_dispatch.h.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#ifndef UNITS_DISABLE_IOSTREAM
+#include <ostream>
+#endif
+
+#include "units.h"
+#include "units/bulk.h"
+#include "units/cpu_dispatch.h"
+
+namespace units
+{
+	namespace overflow
+	{
+		// Clamps a result that overflowed to the bound it passed
+		struct saturate
+		{
+			template <typename T>
+			static constexpr T on_overflow(T bound)
+			{
+				return bound;
+			}
+
+			static constexpr bool on_range_overflow(bool overflowed) { return overflowed; }
+		};
+
+		// Throws std::overflow_error
+		struct check
+		{
+			template <typename T>
+			static T on_overflow(T)
+			{
+				throw std::overflow_error{"Integer overflow"};
+			}
+
+			static bool on_range_overflow(bool overflowed)
+			{
+				if (overflowed)
+				{
+					throw std::overflow_error{"Integer overflow"};
+				}
+				return false;
+			}
+		};
+	}
+
+	namespace detail
+	{
+		namespace overflow
+		{
+			template <typename T>
+			using unsigned_t = typename std::make_unsigned<T>::type;
+
+			template <typename T>
+			using wide_t = typename std::conditional<(sizeof(T) < sizeof(std::int64_t)), std::int64_t, T>::type;
+
+			// Two's complement arithmetic, which is what every supported compiler does with the conversion back
+			template <typename T>
+			constexpr T wrapping_add(T a, T b)
+			{
+				return static_cast<T>(static_cast<unsigned_t<T>>(a) + static_cast<unsigned_t<T>>(b));
+			}
+
+			template <typename T>
+			constexpr T wrapping_subtract(T a, T b)
+			{
+				return static_cast<T>(static_cast<unsigned_t<T>>(a) - static_cast<unsigned_t<T>>(b));
+			}
+
+			// All ones when the sign bit of value is set, zero otherwise
+			template <typename T>
+			constexpr T sign_mask(T value)
+			{
+				return static_cast<T>(value >> std::numeric_limits<T>::digits);
+			}
+
+			// The bound a result overflowed past when its first operand was value: lowest for a negative value and
+			// max otherwise
+			template <typename T>
+			constexpr T bound(T value)
+			{
+				return static_cast<T>(sign_mask(value) ^ std::numeric_limits<T>::max());
+			}
+
+			// Each operation returns the saturated result and sets overflowed when it had to saturate
+			template <typename T>
+			constexpr T add(T a, T b, bool& overflowed)
+			{
+				auto const result = wrapping_add(a, b);
+				auto const over   = sign_mask(static_cast<T>((a ^ result) & (b ^ result)));
+				overflowed        = over != 0;
+				return static_cast<T>((result & ~over) | (bound(a) & over));
+			}
+
+			template <typename T>
+			constexpr T subtract(T a, T b, bool& overflowed)
+			{
+				auto const result = wrapping_subtract(a, b);
+				auto const over   = sign_mask(static_cast<T>((a ^ b) & (a ^ result)));
+				overflowed        = over != 0;
+				return static_cast<T>((result & ~over) | (bound(a) & over));
+			}
+
+			template <typename T>
+			constexpr T clamp(wide_t<T> value, bool& overflowed)
+			{
+				constexpr auto lo = static_cast<wide_t<T>>(std::numeric_limits<T>::lowest());
+				constexpr auto hi = static_cast<wide_t<T>>(std::numeric_limits<T>::max());
+
+				overflowed = value < lo || value > hi;
+				return static_cast<T>(value < lo ? lo : value > hi ? hi : value);
+			}
+
+			template <typename T>
+			T multiply(T a, T b, bool& overflowed, std::true_type)
+			{
+				return clamp<T>(static_cast<wide_t<T>>(a) * static_cast<wide_t<T>>(b), overflowed);
+			}
+
+			template <typename T>
+			T multiply(T a, T b, bool& overflowed, std::false_type)
+			{
+				auto const negative = (a < 0) != (b < 0);
+				auto const limit    = negative ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+#if defined(__GNUC__) || defined(__clang__)
+				T result{};
+				overflowed = __builtin_mul_overflow(a, b, &result);
+				return overflowed ? limit : result;
+#else
+				overflowed = a != 0 && b != 0
+				             && (negative ? (a < 0 ? b > limit / a : a > limit / b)
+				                          : (a < 0 ? a < limit / b : a > limit / b));
+				return overflowed ? limit : static_cast<T>(a * b);
+#endif
+			}
+
+			template <typename T>
+			T multiply(T a, T b, bool& overflowed)
+			{
+				return multiply(a, b, overflowed, std::integral_constant<bool, (sizeof(T) < sizeof(wide_t<T>))>{});
+			}
+
+			template <typename T>
+			T divide(T a, T b, bool& overflowed)
+			{
+				if (b == 0)
+				{
+					throw std::domain_error{"Dividing by zero!"};
+				}
+
+				overflowed = a == std::numeric_limits<T>::lowest() && b == -1;
+				return overflowed ? std::numeric_limits<T>::max() : static_cast<T>(a / b);
+			}
+
+			template <typename T>
+			T remainder(T a, T b)
+			{
+				if (b == 0)
+				{
+					throw std::domain_error{"Dividing by zero!"};
+				}
+
+				return b == -1 ? T{0} : static_cast<T>(a % b);
+			}
+
+			template <typename T, typename U>
+			constexpr auto below(U value) -> typename std::enable_if<std::is_signed<U>::value, bool>::type
+			{
+				return static_cast<std::intmax_t>(value) < static_cast<std::intmax_t>(std::numeric_limits<T>::lowest());
+			}
+
+			template <typename T, typename U>
+			constexpr auto below(U) -> typename std::enable_if<std::is_unsigned<U>::value, bool>::type
+			{
+				return false;
+			}
+
+			template <typename T, typename U>
+			constexpr auto above(U value) -> typename std::enable_if<std::is_signed<U>::value, bool>::type
+			{
+				return static_cast<std::intmax_t>(value) > static_cast<std::intmax_t>(std::numeric_limits<T>::max());
+			}
+
+			template <typename T, typename U>
+			constexpr auto above(U value) -> typename std::enable_if<std::is_unsigned<U>::value, bool>::type
+			{
+				return static_cast<std::uintmax_t>(value) > static_cast<std::uintmax_t>(std::numeric_limits<T>::max());
+			}
+
+			template <typename T, typename Policy, typename U>
+			constexpr auto convert(U value) -> typename std::enable_if<std::is_integral<U>::value, T>::type
+			{
+				return below<T>(value)   ? Policy::on_overflow(std::numeric_limits<T>::lowest())
+				       : above<T>(value) ? Policy::on_overflow(std::numeric_limits<T>::max())
+				                         : static_cast<T>(value);
+			}
+
+			// Truncates towards zero like the built in conversions. NaN saturates to zero.
+			template <typename T, typename Policy, typename U>
+			constexpr auto convert(U value) -> typename std::enable_if<std::is_floating_point<U>::value, T>::type
+			{
+				constexpr auto lo = static_cast<long double>(std::numeric_limits<T>::lowest());
+				constexpr auto hi = -lo;
+
+				return value != value                          ? Policy::on_overflow(T{0})
+				       : static_cast<long double>(value) < lo  ? Policy::on_overflow(std::numeric_limits<T>::lowest())
+				       : static_cast<long double>(value) >= hi ? Policy::on_overflow(std::numeric_limits<T>::max())
+				                                               : static_cast<T>(value);
+			}
+		}
+	}
+
+	// A signed integer that handles overflow with Policy, see units::saturating and units::checked
+	template <typename T, typename Policy>
+	struct bounded_integer
+	{
+		static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "Bounded integers must be signed");
+
+		using value_type  = T;
+		using policy_type = Policy;
+
+		T value;
+
+		constexpr bounded_integer()
+		    : value{0}
+		{
+		}
+
+		// Values outside the range of T are handled by Policy
+		template <typename U, typename std::enable_if<std::is_arithmetic<U>::value, int>::type = 0>
+		constexpr bounded_integer(U value)
+		    : value{detail::overflow::convert<T, Policy>(value)}
+		{
+		}
+
+		template <typename U>
+		constexpr bounded_integer(bounded_integer<U, Policy> other)
+		    : value{detail::overflow::convert<T, Policy>(other.value)}
+		{
+		}
+
+		constexpr operator double() const { return static_cast<double>(value); }
+
+		template <typename U,
+		          typename std::enable_if<std::is_arithmetic<U>::value && !std::is_same<U, double>::value, int>::type =
+		              0>
+		constexpr explicit operator U() const
+		{
+			return static_cast<U>(value);
+		}
+
+		bounded_integer& operator+=(bounded_integer other);
+		bounded_integer& operator-=(bounded_integer other);
+		bounded_integer& operator*=(bounded_integer other);
+		bounded_integer& operator/=(bounded_integer other);
+		bounded_integer& operator%=(bounded_integer other);
+
+		bounded_integer& operator++();
+		bounded_integer  operator++(int);
+		bounded_integer& operator--();
+		bounded_integer  operator--(int);
+	};
+
+	template <typename T>
+	using saturating = bounded_integer<T, overflow::saturate>;
+
+	template <typename T>
+	using checked = bounded_integer<T, overflow::check>;
+
+	namespace detail
+	{
+		namespace overflow
+		{
+			template <typename T, typename Policy>
+			bounded_integer<T, Policy> handle(T result, bool overflowed)
+			{
+				return bounded_integer<T, Policy>{overflowed ? Policy::on_overflow(result) : result};
+			}
+
+			template <typename T, typename Result>
+			using if_integral = typename std::enable_if<std::is_integral<T>::value, Result>::type;
+
+			template <typename T, typename Policy, typename U, typename = void>
+			struct common_with
+			{
+			};
+
+			template <typename T, typename Policy, typename U>
+			struct common_with<T, Policy, U, typename std::enable_if<std::is_integral<U>::value>::type>
+			{
+				using type = bounded_integer<typename std::make_signed<typename std::common_type<T, U>::type>::type,
+				                             Policy>;
+			};
+
+			template <typename T, typename Policy, typename U>
+			struct common_with<T, Policy, U, typename std::enable_if<std::is_floating_point<U>::value>::type>
+			{
+				using type = typename std::common_type<T, U>::type;
+			};
+		}
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator+(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		auto       overflowed = false;
+		auto const result     = detail::overflow::add(lhs.value, rhs.value, overflowed);
+		return detail::overflow::handle<T, Policy>(result, overflowed);
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator-(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		auto       overflowed = false;
+		auto const result     = detail::overflow::subtract(lhs.value, rhs.value, overflowed);
+		return detail::overflow::handle<T, Policy>(result, overflowed);
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator*(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		auto       overflowed = false;
+		auto const result     = detail::overflow::multiply(lhs.value, rhs.value, overflowed);
+		return detail::overflow::handle<T, Policy>(result, overflowed);
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator/(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		auto       overflowed = false;
+		auto const result     = detail::overflow::divide(lhs.value, rhs.value, overflowed);
+		return detail::overflow::handle<T, Policy>(result, overflowed);
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator%(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return bounded_integer<T, Policy>{detail::overflow::remainder(lhs.value, rhs.value)};
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator-(bounded_integer<T, Policy> value)
+	{
+		return bounded_integer<T, Policy>{} - value;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> operator+(bounded_integer<T, Policy> value)
+	{
+		return value;
+	}
+
+	template <typename T, typename Policy>
+	constexpr bool operator==(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return lhs.value == rhs.value;
+	}
+
+	template <typename T, typename Policy>
+	constexpr bool operator!=(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return lhs.value != rhs.value;
+	}
+
+	template <typename T, typename Policy>
+	constexpr bool operator<(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return lhs.value < rhs.value;
+	}
+
+	template <typename T, typename Policy>
+	constexpr bool operator>(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return lhs.value > rhs.value;
+	}
+
+	template <typename T, typename Policy>
+	constexpr bool operator<=(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return lhs.value <= rhs.value;
+	}
+
+	template <typename T, typename Policy>
+	constexpr bool operator>=(bounded_integer<T, Policy> lhs, bounded_integer<T, Policy> rhs)
+	{
+		return lhs.value >= rhs.value;
+	}
+
+	// Mixed with built in integers, which are converted to the bounded type first. Mixed with floating point types
+	// the bounded integer converts to double like a built in integer.
+	template <typename T, typename Policy, typename U>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator+(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return lhs + bounded_integer<T, Policy>{rhs};
+	}
+
+	template <typename U, typename T, typename Policy>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator+(U lhs, bounded_integer<T, Policy> rhs)
+	{
+		return bounded_integer<T, Policy>{lhs} + rhs;
+	}
+
+	template <typename T, typename Policy, typename U>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator-(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return lhs - bounded_integer<T, Policy>{rhs};
+	}
+
+	template <typename U, typename T, typename Policy>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator-(U lhs, bounded_integer<T, Policy> rhs)
+	{
+		return bounded_integer<T, Policy>{lhs} - rhs;
+	}
+
+	template <typename T, typename Policy, typename U>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator*(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return lhs * bounded_integer<T, Policy>{rhs};
+	}
+
+	template <typename U, typename T, typename Policy>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator*(U lhs, bounded_integer<T, Policy> rhs)
+	{
+		return bounded_integer<T, Policy>{lhs} * rhs;
+	}
+
+	template <typename T, typename Policy, typename U>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator/(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return lhs / bounded_integer<T, Policy>{rhs};
+	}
+
+	template <typename U, typename T, typename Policy>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator/(U lhs, bounded_integer<T, Policy> rhs)
+	{
+		return bounded_integer<T, Policy>{lhs} / rhs;
+	}
+
+	template <typename T, typename Policy, typename U>
+	detail::overflow::if_integral<U, bounded_integer<T, Policy>> operator%(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return lhs % bounded_integer<T, Policy>{rhs};
+	}
+
+	template <typename T, typename Policy, typename U>
+	constexpr detail::overflow::if_integral<U, bool> operator==(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return !detail::overflow::below<T>(rhs) && !detail::overflow::above<T>(rhs)
+		       && lhs.value == static_cast<T>(rhs);
+	}
+
+	template <typename U, typename T, typename Policy>
+	constexpr detail::overflow::if_integral<U, bool> operator==(U lhs, bounded_integer<T, Policy> rhs)
+	{
+		return rhs == lhs;
+	}
+
+	template <typename T, typename Policy, typename U>
+	constexpr detail::overflow::if_integral<U, bool> operator!=(bounded_integer<T, Policy> lhs, U rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <typename U, typename T, typename Policy>
+	constexpr detail::overflow::if_integral<U, bool> operator!=(U lhs, bounded_integer<T, Policy> rhs)
+	{
+		return !(rhs == lhs);
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator+=(bounded_integer other)
+	{
+		return *this = *this + other;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator-=(bounded_integer other)
+	{
+		return *this = *this - other;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator*=(bounded_integer other)
+	{
+		return *this = *this * other;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator/=(bounded_integer other)
+	{
+		return *this = *this / other;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator%=(bounded_integer other)
+	{
+		return *this = *this % other;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator++()
+	{
+		return *this += bounded_integer{1};
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> bounded_integer<T, Policy>::operator++(int)
+	{
+		auto const temp = *this;
+		++*this;
+		return temp;
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy>& bounded_integer<T, Policy>::operator--()
+	{
+		return *this -= bounded_integer{1};
+	}
+
+	template <typename T, typename Policy>
+	bounded_integer<T, Policy> bounded_integer<T, Policy>::operator--(int)
+	{
+		auto const temp = *this;
+		--*this;
+		return temp;
+	}
+
+#ifndef UNITS_DISABLE_IOSTREAM
+	template <typename CharT, typename Traits, typename T, typename Policy>
+	std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os,
+	                                              bounded_integer<T, Policy> const&  value)
+	{
+		return os << +value.value;
+	}
+#endif
+
+	namespace bulk
+	{
+		// Each kernel returns whether any result saturated
+		template <typename T>
+		struct overflow_kernels
+		{
+			bool (*add)(T const*, T const*, std::size_t, T*);
+			bool (*subtract)(T const*, T const*, std::size_t, T*);
+			bool (*scale)(T const*, std::size_t, T, T*);
+			bool (*sum)(T const*, std::size_t, T*);
+		};
+
+		struct overflow_kernel_table
+		{
+			cpu::tier                      tier;
+			overflow_kernels<std::int16_t> i16;
+			overflow_kernels<std::int32_t> i32;
+		};
+	}
+
+	namespace detail
+	{
+		namespace overflow
+		{
+			namespace kernels
+			{
+				constexpr std::size_t lanes = 8;
+
+				// The flags of every element are or-ed together, so the loops have no branches
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool add(T const* lhs, T const* rhs, std::size_t n, T* out)
+				{
+					T flags = 0;
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto const result = wrapping_add(lhs[i], rhs[i]);
+						auto const over   = sign_mask(static_cast<T>((lhs[i] ^ result) & (rhs[i] ^ result)));
+						out[i]            = static_cast<T>((result & ~over) | (bound(lhs[i]) & over));
+						flags             = static_cast<T>(flags | over);
+					}
+					return flags != 0;
+				}
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool subtract(T const* lhs, T const* rhs, std::size_t n, T* out)
+				{
+					T flags = 0;
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto const result = wrapping_subtract(lhs[i], rhs[i]);
+						auto const over   = sign_mask(static_cast<T>((lhs[i] ^ rhs[i]) & (lhs[i] ^ result)));
+						out[i]            = static_cast<T>((result & ~over) | (bound(lhs[i]) & over));
+						flags             = static_cast<T>(flags | over);
+					}
+					return flags != 0;
+				}
+
+				// A product overflows exactly when the value lies outside [low, high], which is worked out once per
+				// range, so the loop multiplies and compares at the width of T
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool scale(T const* in, std::size_t n, T factor, T* out, std::true_type)
+				{
+					constexpr auto lo = static_cast<std::int64_t>(std::numeric_limits<T>::lowest());
+					constexpr auto hi = static_cast<std::int64_t>(std::numeric_limits<T>::max());
+
+					// A negative factor swaps the bound each side saturates to. lo / -1 is one past hi, which no value
+					// reaches.
+					auto const f           = static_cast<std::int64_t>(factor);
+					auto const low         = static_cast<T>(f > 0 ? lo / f : f < 0 ? hi / f : lo);
+					auto const high        = static_cast<T>(f > 0 ? hi / f : f < 0 ? std::min(lo / f, hi) : hi);
+					auto const low_result  = static_cast<T>(f < 0 ? hi : lo);
+					auto const high_result = static_cast<T>(f < 0 ? lo : hi);
+
+					T flags = 0;
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto const product =
+						    static_cast<T>(static_cast<std::uint32_t>(in[i]) * static_cast<std::uint32_t>(factor));
+						auto const past_low  = static_cast<T>(-static_cast<T>(in[i] < low));
+						auto const past_high = static_cast<T>(-static_cast<T>(in[i] > high));
+						auto const over      = static_cast<T>(past_low | past_high);
+						auto const bound     = static_cast<T>((low_result & past_low) | (high_result & past_high));
+						out[i]               = static_cast<T>((product & ~over) | bound);
+						flags  = static_cast<T>(flags | over);
+					}
+					return flags != 0;
+				}
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool scale(T const* in, std::size_t n, T factor, T* out, std::false_type)
+				{
+					auto flags = false;
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto overflowed = false;
+						out[i]          = multiply(in[i], factor, overflowed);
+						flags |= overflowed;
+					}
+					return flags;
+				}
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool scale(T const* in, std::size_t n, T factor, T* out)
+				{
+					using widened = std::integral_constant<bool, (sizeof(T) < sizeof(std::int64_t))>;
+					return scale(in, n, factor, out, widened{});
+				}
+
+				// Adds value to a 64 bit total, counting the times the total wrapped around in wraps. The exact sum
+				// is total + wraps * 2^64.
+				UNITS_ALWAYS_INLINE void accumulate(std::int64_t& total, std::int64_t& wraps, std::int64_t value)
+				{
+					auto const result = wrapping_add(total, value);
+					auto const over   = sign_mask(static_cast<std::int64_t>((total ^ result) & (value ^ result)));
+					wraps += over & (sign_mask(value) | 1);
+					total = result;
+				}
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool saturate(std::int64_t total, std::int64_t wraps, T* out)
+				{
+					if (wraps != 0)
+					{
+						*out = wraps < 0 ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+						return true;
+					}
+
+					auto overflowed = false;
+					*out            = clamp<T>(static_cast<wide_t<T>>(total), overflowed);
+					return overflowed;
+				}
+
+				// Fewer than 2^32 values of at most 32 bits cannot overflow a 64 bit total, so each block of them is
+				// summed plainly with one partial sum per lane
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool sum(T const* in, std::size_t n, T* out, std::true_type)
+				{
+					constexpr auto block = static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max());
+
+					std::int64_t total = 0;
+					std::int64_t wraps = 0;
+					while (n > 0)
+					{
+						auto const count = n < block ? n : block;
+
+						std::int64_t partial[lanes] = {};
+						std::size_t  i              = 0;
+						for (; i + lanes <= count; i += lanes)
+						{
+							for (std::size_t j = 0; j < lanes; ++j)
+							{
+								partial[j] += in[i + j];
+							}
+						}
+						for (; i < count; ++i)
+						{
+							partial[0] += in[i];
+						}
+
+						for (std::size_t j = 0; j < lanes; ++j)
+						{
+							accumulate(total, wraps, partial[j]);
+						}
+						in += count;
+						n -= count;
+					}
+					return saturate(total, wraps, out);
+				}
+
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool sum(T const* in, std::size_t n, T* out, std::false_type)
+				{
+					std::int64_t total = 0;
+					std::int64_t wraps = 0;
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						accumulate(total, wraps, in[i]);
+					}
+					return saturate(total, wraps, out);
+				}
+
+				// The exact total is computed and saturated once, so overflow in partial sums that later cancels out
+				// is not reported
+				template <typename T>
+				UNITS_ALWAYS_INLINE bool sum(T const* in, std::size_t n, T* out)
+				{
+					using widened = std::integral_constant<bool, (sizeof(T) < sizeof(std::int64_t))>;
+					return sum(in, n, out, widened{});
+				}
+			}
+
+// Instantiates the kernels for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_OVERFLOW_TIER(Name, Tier, Target)                                                                        \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		template <typename T>                                                                                          \
+		Target bool add(T const* lhs, T const* rhs, std::size_t n, T* out)                                             \
+		{                                                                                                              \
+			return kernels::add(lhs, rhs, n, out);                                                                     \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target bool subtract(T const* lhs, T const* rhs, std::size_t n, T* out)                                        \
+		{                                                                                                              \
+			return kernels::subtract(lhs, rhs, n, out);                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target bool scale(T const* in, std::size_t n, T factor, T* out)                                                \
+		{                                                                                                              \
+			return kernels::scale(in, n, factor, out);                                                                 \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		Target bool sum(T const* in, std::size_t n, T* out)                                                            \
+		{                                                                                                              \
+			return kernels::sum(in, n, out);                                                                           \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename T>                                                                                          \
+		bulk::overflow_kernels<T> set()                                                                                \
+		{                                                                                                              \
+			return bulk::overflow_kernels<T>{&add<T>, &subtract<T>, &scale<T>, &sum<T>};                               \
+		}                                                                                                              \
+                                                                                                                       \
+		inline bulk::overflow_kernel_table const& table()                                                              \
+		{                                                                                                              \
+			static bulk::overflow_kernel_table const t{Tier, set<std::int16_t>(), set<std::int32_t>()};                \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+			UNITS_FOR_EACH_TIER(UNITS_OVERFLOW_TIER)
+
+#undef UNITS_OVERFLOW_TIER
+
+			template <typename T>
+			using is_dispatched = std::integral_constant<bool,
+			                                             std::is_same<T, std::int16_t>::value
+			                                                 || std::is_same<T, std::int32_t>::value>;
+
+			template <typename T, typename Policy, typename Ratio, typename UnitType>
+			T const* values(unit<bounded_integer<T, Policy>, Ratio, UnitType> const* units)
+			{
+				static_assert(sizeof(unit<bounded_integer<T, Policy>, Ratio, UnitType>) == sizeof(T),
+				              "Units must have the size of their value");
+				return reinterpret_cast<T const*>(units);
+			}
+
+			template <typename T, typename Policy, typename Ratio, typename UnitType>
+			T* values(unit<bounded_integer<T, Policy>, Ratio, UnitType>* units)
+			{
+				static_assert(sizeof(unit<bounded_integer<T, Policy>, Ratio, UnitType>) == sizeof(T),
+				              "Units must have the size of their value");
+				return reinterpret_cast<T*>(units);
+			}
+		}
+	}
+
+	namespace bulk
+	{
+		// The overflow kernels for a given tier, or the best supported one if the machine cannot run it
+		inline overflow_kernel_table const& overflow_kernels_for(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(units::detail::overflow));
+		}
+
+		// The overflow kernels bound to the active tier, chosen once on first use
+		inline overflow_kernel_table const& overflow_kernels_for()
+		{
+			return cpu::active_kernels<overflow_kernel_table, &overflow_kernels_for>();
+		}
+
+		namespace detail
+		{
+			template <typename T>
+			bool add(T const* lhs, T const* rhs, std::size_t n, T* out, std::true_type)
+			{
+				return units::detail::select<T>(overflow_kernels_for()).add(lhs, rhs, n, out);
+			}
+
+			template <typename T>
+			bool add(T const* lhs, T const* rhs, std::size_t n, T* out, std::false_type)
+			{
+				return units::detail::overflow::kernels::add(lhs, rhs, n, out);
+			}
+
+			template <typename T>
+			bool subtract(T const* lhs, T const* rhs, std::size_t n, T* out, std::true_type)
+			{
+				return units::detail::select<T>(overflow_kernels_for()).subtract(lhs, rhs, n, out);
+			}
+
+			template <typename T>
+			bool subtract(T const* lhs, T const* rhs, std::size_t n, T* out, std::false_type)
+			{
+				return units::detail::overflow::kernels::subtract(lhs, rhs, n, out);
+			}
+
+			template <typename T>
+			bool scale(T const* in, std::size_t n, T factor, T* out, std::true_type)
+			{
+				return units::detail::select<T>(overflow_kernels_for()).scale(in, n, factor, out);
+			}
+
+			template <typename T>
+			bool scale(T const* in, std::size_t n, T factor, T* out, std::false_type)
+			{
+				return units::detail::overflow::kernels::scale(in, n, factor, out);
+			}
+
+			template <typename T>
+			bool sum(T const* in, std::size_t n, T* out, std::true_type)
+			{
+				return units::detail::select<T>(overflow_kernels_for()).sum(in, n, out);
+			}
+
+			template <typename T>
+			bool sum(T const* in, std::size_t n, T* out, std::false_type)
+			{
+				return units::detail::overflow::kernels::sum(in, n, out);
+			}
+		}
+
+		// Adds two ranges element by element into out, which may be either of them. Returns whether any element
+		// overflowed; checked units throw std::overflow_error instead, once the whole range has been written.
+		template <typename T, typename Policy, typename Ratio, typename UnitType>
+		bool add(unit<bounded_integer<T, Policy>, Ratio, UnitType> const* first,
+		         unit<bounded_integer<T, Policy>, Ratio, UnitType> const* last,
+		         unit<bounded_integer<T, Policy>, Ratio, UnitType> const* other,
+		         unit<bounded_integer<T, Policy>, Ratio, UnitType>*       out)
+		{
+			namespace overflow = units::detail::overflow;
+			return Policy::on_range_overflow(detail::add(overflow::values(first),
+			                                             overflow::values(other),
+			                                             static_cast<std::size_t>(last - first),
+			                                             overflow::values(out),
+			                                             overflow::is_dispatched<T>{}));
+		}
+
+		// Subtracts other from the range element by element, like add
+		template <typename T, typename Policy, typename Ratio, typename UnitType>
+		bool subtract(unit<bounded_integer<T, Policy>, Ratio, UnitType> const* first,
+		              unit<bounded_integer<T, Policy>, Ratio, UnitType> const* last,
+		              unit<bounded_integer<T, Policy>, Ratio, UnitType> const* other,
+		              unit<bounded_integer<T, Policy>, Ratio, UnitType>*       out)
+		{
+			namespace overflow = units::detail::overflow;
+			return Policy::on_range_overflow(detail::subtract(overflow::values(first),
+			                                                  overflow::values(other),
+			                                                  static_cast<std::size_t>(last - first),
+			                                                  overflow::values(out),
+			                                                  overflow::is_dispatched<T>{}));
+		}
+
+		// Multiplies every element by factor, like add
+		template <typename T, typename Policy, typename Ratio, typename UnitType, typename Factor>
+		bool scale(unit<bounded_integer<T, Policy>, Ratio, UnitType> const* first,
+		           unit<bounded_integer<T, Policy>, Ratio, UnitType> const* last,
+		           Factor                                                   factor,
+		           unit<bounded_integer<T, Policy>, Ratio, UnitType>*       out)
+		{
+			namespace overflow = units::detail::overflow;
+			return Policy::on_range_overflow(detail::scale(overflow::values(first),
+			                                               static_cast<std::size_t>(last - first),
+			                                               bounded_integer<T, Policy>{factor}.value,
+			                                               overflow::values(out),
+			                                               overflow::is_dispatched<T>{}));
+		}
+
+		// The exact total of the range, saturated once. overflowed is set when it did not fit and is never cleared,
+		// so one flag can collect several ranges.
+		template <typename T, typename Policy, typename Ratio, typename UnitType>
+		unit<bounded_integer<T, Policy>, Ratio, UnitType> sum(
+		    unit<bounded_integer<T, Policy>, Ratio, UnitType> const* first,
+		    unit<bounded_integer<T, Policy>, Ratio, UnitType> const* last,
+		    bool&                                                    overflowed)
+		{
+			namespace overflow = units::detail::overflow;
+
+			T total{};
+			overflowed |= Policy::on_range_overflow(detail::sum(
+			    overflow::values(first), static_cast<std::size_t>(last - first), &total, overflow::is_dispatched<T>{}));
+			return unit<bounded_integer<T, Policy>, Ratio, UnitType>{bounded_integer<T, Policy>{total}};
+		}
+
+		template <typename T, typename Policy, typename Ratio, typename UnitType>
+		unit<bounded_integer<T, Policy>, Ratio, UnitType> sum(
+		    unit<bounded_integer<T, Policy>, Ratio, UnitType> const* first,
+		    unit<bounded_integer<T, Policy>, Ratio, UnitType> const* last)
+		{
+			auto overflowed = false;
+			return bulk::sum(first, last, overflowed);
+		}
+	}
+}
+
+namespace std
+{
+	// Bounded integers combine like their values and keep their policy. Floating point types win, as they do over
+	// built in integers.
+	template <typename T, typename Policy, typename U>
+	struct common_type<units::bounded_integer<T, Policy>, U> : units::detail::overflow::common_with<T, Policy, U>
+	{
+	};
+
+	template <typename U, typename T, typename Policy>
+	struct common_type<U, units::bounded_integer<T, Policy>> : units::detail::overflow::common_with<T, Policy, U>
+	{
+	};
+
+	template <typename T, typename U, typename Policy>
+	struct common_type<units::bounded_integer<T, Policy>, units::bounded_integer<U, Policy>>
+	{
+		using type = units::bounded_integer<typename std::common_type<T, U>::type, Policy>;
+	};
+}
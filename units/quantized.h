@@ -0,0 +1,342 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Integer storage for floating point columns. A unit with an integer rep stores a value as a count of its ratio, the
+// quantum, so unit<std::int16_t, std::centi, unit_type::distance> holds up to +-327.67 m in steps of 1 cm at a quarter
+// of the size of a double. units::bulk::encode converts a range of floating point units into such a column, rounding
+// to the nearest quantum and clamping the values the rep cannot hold, and returns a quantize_report that counts them.
+// units::bulk::decode converts a column back to floating point units of any ratio in one pass. Columns of int16_t and
+// int32_t are converted with vectorised kernels for each tier in units/cpu_dispatch.h.
+//
+// units::bulk::pick_quantum chooses the finest of a list of candidate quanta that holds a range without clamping.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#include "units.h"
+#include "units/bulk.h"
+
+namespace units
+{
+	namespace bulk
+	{
+		// Counts the values encode could not represent. Values below or above the range of the rep are stored as
+		// its lowest or highest value, and NaN is stored as zero.
+		struct quantize_report
+		{
+			std::size_t below   = 0;
+			std::size_t above   = 0;
+			std::size_t invalid = 0;
+
+			std::size_t clamped() const { return below + above; }
+			bool        exact_range() const { return below == 0 && above == 0 && invalid == 0; }
+
+			quantize_report& operator+=(quantize_report const& other)
+			{
+				below += other.below;
+				above += other.above;
+				invalid += other.invalid;
+				return *this;
+			}
+		};
+
+		template <typename Int>
+		struct quantized_kernels
+		{
+			quantize_report (*encode)(double const*, std::size_t, double, Int*);
+			void (*decode)(Int const*, std::size_t, double, double*);
+		};
+
+		struct quantized_kernel_table
+		{
+			cpu::tier                      tier;
+			quantized_kernels<std::int16_t> i16;
+			quantized_kernels<std::int32_t> i32;
+		};
+	}
+
+	namespace detail
+	{
+		namespace quantized
+		{
+			// Adding and subtracting 1.5 * 2^52 rounds any double of magnitude below 2^51 to the nearest integer, ties
+			// to even, with two instructions that vectorise on every tier. Larger magnitudes keep their sign and size.
+			constexpr double rounder = 6755399441055744.0;
+
+			template <typename Int>
+			using is_encodable = std::integral_constant<bool, std::is_integral<Int>::value && sizeof(Int) <= 4>;
+
+			namespace kernels
+			{
+				// The rounding trick is exact for every value that rounds into the range of Int, and anything larger
+				// stays out of it, so values are only clamped once rounded. NaN fails every comparison and is replaced
+				// last. Selects that only follow the comparisons keep the loop free of branches.
+				template <typename In, typename Int>
+				UNITS_ALWAYS_INLINE bulk::quantize_report encode(In const* in, std::size_t n, double factor, Int* out)
+				{
+					constexpr auto lo = static_cast<double>(std::numeric_limits<Int>::lowest());
+					constexpr auto hi = static_cast<double>(std::numeric_limits<Int>::max());
+
+					std::size_t below   = 0;
+					std::size_t above   = 0;
+					std::size_t invalid = 0;
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						auto const value   = static_cast<double>(in[i]) * factor;
+						auto       rounded = (value + rounder) - rounder;
+						below += static_cast<std::size_t>(rounded < lo);
+						above += static_cast<std::size_t>(rounded > hi);
+						invalid += static_cast<std::size_t>(rounded != rounded);
+						rounded = rounded < lo ? lo : rounded;
+						rounded = rounded > hi ? hi : rounded;
+						rounded = rounded == rounded ? rounded : 0.0;
+						out[i]  = static_cast<Int>(rounded);
+					}
+
+					auto report    = bulk::quantize_report{};
+					report.below   = below;
+					report.above   = above;
+					report.invalid = invalid;
+					return report;
+				}
+
+				template <typename Int, typename Out>
+				UNITS_ALWAYS_INLINE void decode(Int const* in, std::size_t n, double factor, Out* out)
+				{
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						out[i] = static_cast<Out>(static_cast<double>(in[i]) * factor);
+					}
+				}
+			}
+
+// Instantiates the codec for one tier. Target is the attribute that selects the instruction set.
+#define UNITS_QUANTIZED_TIER(Name, Tier, Target)                                                                       \
+	namespace Name                                                                                                     \
+	{                                                                                                                  \
+		template <typename Int>                                                                                        \
+		Target bulk::quantize_report encode(double const* in, std::size_t n, double factor, Int* out)                 \
+		{                                                                                                              \
+			return kernels::encode(in, n, factor, out);                                                                \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename Int>                                                                                        \
+		Target void decode(Int const* in, std::size_t n, double factor, double* out)                                  \
+		{                                                                                                              \
+			kernels::decode(in, n, factor, out);                                                                       \
+		}                                                                                                              \
+                                                                                                                       \
+		template <typename Int>                                                                                        \
+		bulk::quantized_kernels<Int> set()                                                                             \
+		{                                                                                                              \
+			return bulk::quantized_kernels<Int>{&encode<Int>, &decode<Int>};                                           \
+		}                                                                                                              \
+                                                                                                                       \
+		inline bulk::quantized_kernel_table const& table()                                                             \
+		{                                                                                                              \
+			static bulk::quantized_kernel_table const t{Tier, set<std::int16_t>(), set<std::int32_t>()};               \
+			return t;                                                                                                  \
+		}                                                                                                              \
+	}
+
+			UNITS_FOR_EACH_TIER(UNITS_QUANTIZED_TIER)
+
+#undef UNITS_QUANTIZED_TIER
+
+			template <typename Int>
+			using is_dispatched = std::integral_constant<bool,
+			                                             std::is_same<Int, std::int16_t>::value
+			                                                 || std::is_same<Int, std::int32_t>::value>;
+
+			// Whether the extremes of a range, in counts of Quantum, round into the range of Int
+			template <typename Int, typename Quantum, typename Ratio>
+			bool holds(double lo, double hi)
+			{
+				auto const factor = detail::conversion_factor<double, Ratio, Quantum>();
+				auto const first  = std::nearbyint(lo * factor);
+				auto const last   = std::nearbyint(hi * factor);
+				return first >= static_cast<double>(std::numeric_limits<Int>::lowest())
+				       && last <= static_cast<double>(std::numeric_limits<Int>::max());
+			}
+
+			template <typename Quantum>
+			constexpr long double size()
+			{
+				return static_cast<long double>(Quantum::num) / static_cast<long double>(Quantum::den);
+			}
+
+			template <typename Int, typename Ratio>
+			void pick(double, double, std::size_t, std::size_t&, long double&)
+			{
+			}
+
+			template <typename Int, typename Ratio, typename Quantum, typename... Quanta>
+			void pick(double lo, double hi, std::size_t index, std::size_t& best, long double& finest)
+			{
+				if (holds<Int, Quantum, Ratio>(lo, hi) && size<Quantum>() < finest)
+				{
+					best   = index;
+					finest = size<Quantum>();
+				}
+				pick<Int, Ratio, Quanta...>(lo, hi, index + 1, best, finest);
+			}
+		}
+	}
+
+	namespace bulk
+	{
+		// The codec kernels for a given tier, or the best supported one if the machine cannot run it
+		inline quantized_kernel_table const& quantized_kernels_for(cpu::tier tier)
+		{
+			return cpu::kernels_for(tier, UNITS_TIER_TABLES(units::detail::quantized));
+		}
+
+		// The codec kernels bound to the active tier, chosen once on first use
+		inline quantized_kernel_table const& quantized_kernels_for()
+		{
+			return cpu::active_kernels<quantized_kernel_table, &quantized_kernels_for>();
+		}
+
+		namespace detail
+		{
+			template <typename Int, typename ToRatio, typename Ratio, typename UnitType>
+			quantize_report encode(unit<double, Ratio, UnitType> const* first,
+			                       unit<double, Ratio, UnitType> const* last,
+			                       unit<Int, ToRatio, UnitType>*        out,
+			                       std::true_type)
+			{
+				return units::detail::select<Int>(quantized_kernels_for())
+				    .encode(units::detail::raw(first),
+				            static_cast<std::size_t>(last - first),
+				            units::detail::conversion_factor<double, Ratio, ToRatio>(),
+				            units::detail::raw(out));
+			}
+
+			template <typename Int, typename ToRatio, typename Rep, typename Ratio, typename UnitType>
+			quantize_report encode(unit<Rep, Ratio, UnitType> const* first,
+			                       unit<Rep, Ratio, UnitType> const* last,
+			                       unit<Int, ToRatio, UnitType>*     out,
+			                       std::false_type)
+			{
+				return units::detail::quantized::kernels::encode(
+				    units::detail::raw(first),
+				    static_cast<std::size_t>(last - first),
+				    units::detail::conversion_factor<double, Ratio, ToRatio>(),
+				    units::detail::raw(out));
+			}
+
+			template <typename ToUnit, typename Int, typename Ratio, typename UnitType>
+			ToUnit* decode(unit<Int, Ratio, UnitType> const* first,
+			               unit<Int, Ratio, UnitType> const* last,
+			               ToUnit*                           out,
+			               std::true_type)
+			{
+				auto const count = static_cast<std::size_t>(last - first);
+				units::detail::select<Int>(quantized_kernels_for())
+				    .decode(units::detail::raw(first),
+				            count,
+				            units::detail::conversion_factor<double, Ratio, typename ToUnit::ratio>(),
+				            units::detail::raw(out));
+				return out + count;
+			}
+
+			template <typename ToUnit, typename Int, typename Ratio, typename UnitType>
+			ToUnit* decode(unit<Int, Ratio, UnitType> const* first,
+			               unit<Int, Ratio, UnitType> const* last,
+			               ToUnit*                           out,
+			               std::false_type)
+			{
+				auto const count = static_cast<std::size_t>(last - first);
+				units::detail::quantized::kernels::decode(
+				    units::detail::raw(first),
+				    count,
+				    units::detail::conversion_factor<double, Ratio, typename ToUnit::ratio>(),
+				    units::detail::raw(out));
+				return out + count;
+			}
+		}
+
+		// Encodes a range of floating point units as counts of ToRatio, rounding each value to the nearest count,
+		// ties to even. Values the rep cannot hold are clamped and NaN is stored as zero; the report counts both.
+		template <typename Rep, typename Ratio, typename UnitType, typename Int, typename ToRatio>
+		quantize_report encode(unit<Rep, Ratio, UnitType> const* first,
+		                       unit<Rep, Ratio, UnitType> const* last,
+		                       unit<Int, ToRatio, UnitType>*     out)
+		{
+			static_assert(std::is_floating_point<Rep>::value, "Only floating point units can be encoded");
+			static_assert(units::detail::quantized::is_encodable<Int>::value,
+			              "Encoded units must have an integer rep of at most 32 bits");
+
+			using dispatched = std::integral_constant<bool,
+			                                          std::is_same<Rep, double>::value
+			                                              && units::detail::quantized::is_dispatched<Int>::value>;
+			return detail::encode(first, last, out, dispatched{});
+		}
+
+		// Decodes a range of integer units to floating point units with one multiply per element, which can differ
+		// from unit_cast in the last bit like cast.
+		template <typename ToUnit, typename Int, typename Ratio, typename UnitType>
+		ToUnit* decode(unit<Int, Ratio, UnitType> const* first, unit<Int, Ratio, UnitType> const* last, ToUnit* out)
+		{
+			static_assert(std::is_same<typename ToUnit::unit_type, UnitType>::value, "Incompatible types");
+			static_assert(std::is_integral<Int>::value, "Only integer units can be decoded");
+			static_assert(std::is_floating_point<typename ToUnit::rep>::value,
+			              "Units must be decoded to floating point");
+
+			using dispatched = std::integral_constant<bool,
+			                                          std::is_same<typename ToUnit::rep, double>::value
+			                                              && units::detail::quantized::is_dispatched<Int>::value>;
+			return detail::decode(first, last, out, dispatched{});
+		}
+
+		// The index of the finest of Quanta with which Int holds every value of the range, or sizeof...(Quanta) when
+		// none does. NaN is ignored, and an empty range picks the finest quantum.
+		template <typename Int, typename... Quanta, typename Rep, typename Ratio, typename UnitType>
+		std::size_t pick_quantum(unit<Rep, Ratio, UnitType> const* first, unit<Rep, Ratio, UnitType> const* last)
+		{
+			static_assert(sizeof...(Quanta) > 0, "At least one quantum is needed");
+			static_assert(std::is_floating_point<Rep>::value, "Only floating point units can be encoded");
+
+			auto lo = 0.0;
+			auto hi = 0.0;
+			if (first != last)
+			{
+				lo = static_cast<double>(bulk::min(first, last).count());
+				hi = static_cast<double>(bulk::max(first, last).count());
+			}
+
+			auto best   = sizeof...(Quanta);
+			auto finest = std::numeric_limits<long double>::infinity();
+			units::detail::quantized::pick<Int, Ratio, Quanta...>(lo, hi, 0, best, finest);
+			return best;
+		}
+	}
+}
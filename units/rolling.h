@@ -0,0 +1,284 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Aggregates over the samples of a stream that fall in a sliding time window. Each sample is converted to Unit once as
+// it arrives and then held in a ring that doubles when full, so once the ring has grown to the most samples a window
+// ever holds, adding and expiring samples stops allocating.
+//
+// The sum, min and max are kept as two stacks in the one ring. New samples are folded into a single running summary
+// as they arrive. The older samples each carry the summary of themselves and every older sample newer than them, so
+// expiring one just steps past it, and when the older samples run out the newer ones are folded into their place in
+// one pass. Nothing is ever subtracted, so a floating point sum does not drift however long the stream runs.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+
+namespace units
+{
+	namespace detail
+	{
+		namespace rolling
+		{
+			// A queue in a power of two sized buffer, doubling when it is full
+			template <typename T>
+			class ring
+			{
+			public:
+				explicit ring(std::size_t capacity)
+				    : slots(round_up(capacity))
+				    , first{0}
+				    , count{0}
+				{
+				}
+
+				std::size_t size() const { return count; }
+				bool        empty() const { return count == 0; }
+				std::size_t capacity() const { return slots.size(); }
+
+				T&       operator[](std::size_t i) { return slots[(first + i) & (slots.size() - 1)]; }
+				T const& operator[](std::size_t i) const { return slots[(first + i) & (slots.size() - 1)]; }
+				T const& front() const { return slots[first]; }
+				T const& back() const { return (*this)[count - 1]; }
+
+				void push_back(T const& value)
+				{
+					if (count == slots.size())
+					{
+						grow();
+					}
+					slots[(first + count) & (slots.size() - 1)] = value;
+					++count;
+				}
+
+				void pop_front()
+				{
+					first = (first + 1) & (slots.size() - 1);
+					--count;
+				}
+
+				void clear()
+				{
+					first = 0;
+					count = 0;
+				}
+
+			private:
+				static std::size_t round_up(std::size_t capacity)
+				{
+					std::size_t size = 1;
+					while (size < capacity)
+					{
+						size *= 2;
+					}
+					return size;
+				}
+
+				void grow()
+				{
+					auto bigger = std::vector<T>(slots.size() * 2);
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						bigger[i] = (*this)[i];
+					}
+					slots.swap(bigger);
+					first = 0;
+				}
+
+				std::vector<T> slots;
+				std::size_t    first;
+				std::size_t    count;
+			};
+		}
+	}
+
+	// The samples of the last width of a stream, with time points from Clock. A sample stays in the window while it
+	// is less than width older than the newest sample.
+	template <typename Unit, typename Clock = std::chrono::steady_clock>
+	class rolling_window
+	{
+		static_assert(is_unit<Unit>::value, "A rolling window must aggregate units");
+
+	public:
+		using value_type = Unit;
+		using unit_type  = typename Unit::unit_type;
+		using time_point = typename Clock::time_point;
+		using duration   = typename Clock::duration;
+
+		// Reserves room for capacity samples up front. Throws std::invalid_argument if width is not positive.
+		template <typename Rep, typename Period>
+		explicit rolling_window(std::chrono::duration<Rep, Period> width, std::size_t capacity = 64)
+		    : span{std::chrono::duration_cast<duration>(width)}
+		    , samples{capacity}
+		    , folded{0}
+		    , back{0, 0, 0}
+		{
+			if (span <= duration::zero())
+			{
+				throw std::invalid_argument{"A rolling window needs a positive width"};
+			}
+		}
+
+		// Adds value at time at, first expiring the samples it leaves behind. Throws std::invalid_argument if at is
+		// earlier than the newest sample and std::domain_error if value is NaN.
+		template <typename Rep2, typename Ratio2>
+		void push(time_point at, unit<Rep2, Ratio2, unit_type> value)
+		{
+			if (!samples.empty() && at < samples.back().at)
+			{
+				throw std::invalid_argument{"Samples must arrive in time order"};
+			}
+
+			auto const x = unit_cast<Unit>(value).count();
+			if (std::is_floating_point<rep>::value && std::isnan(static_cast<double>(x)))
+			{
+				throw std::domain_error{"Cannot aggregate NaN"};
+			}
+
+			expire(at);
+
+			back = samples.size() == folded ? summary{x, x, x} : combine(back, x);
+			samples.push_back(sample{at, {x, x, x}});
+		}
+
+		// Drops the samples that are no longer within width of now, for when time moves on without new samples
+		void expire(time_point now)
+		{
+			auto const oldest = now - span;
+			while (!samples.empty() && samples.front().at <= oldest)
+			{
+				if (folded == 0)
+				{
+					flip();
+				}
+				samples.pop_front();
+				--folded;
+			}
+		}
+
+		void clear()
+		{
+			samples.clear();
+			folded = 0;
+		}
+
+		std::size_t size() const { return samples.size(); }
+		bool        empty() const { return samples.empty(); }
+		duration    width() const { return span; }
+
+		// The number of samples the window holds before it has to allocate again
+		std::size_t capacity() const { return samples.capacity(); }
+
+		Unit sum() const { return Unit{samples.empty() ? rep{0} : totals().sum}; }
+
+		// Throws std::domain_error if the window is empty, as do min and max
+		Unit mean() const
+		{
+			check();
+			return Unit{static_cast<rep>(totals().sum / static_cast<rep>(samples.size()))};
+		}
+
+		Unit min() const
+		{
+			check();
+			return Unit{totals().lo};
+		}
+
+		Unit max() const
+		{
+			check();
+			return Unit{totals().hi};
+		}
+
+	private:
+		using rep = typename Unit::rep;
+
+		struct summary
+		{
+			rep lo;
+			rep hi;
+			rep sum;
+		};
+
+		// The oldest folded samples summarise themselves and every newer folded sample, the rest only themselves
+		struct sample
+		{
+			time_point at;
+			summary    from;
+		};
+
+		static summary combine(summary const& lhs, rep x)
+		{
+			return summary{std::min(lhs.lo, x), std::max(lhs.hi, x), lhs.sum + x};
+		}
+
+		void check() const
+		{
+			if (samples.empty())
+			{
+				throw std::domain_error{"The window is empty"};
+			}
+		}
+
+		// Called once every folded sample has expired. Each sample is folded once on its way through the window, so
+		// expiring stays constant time on average.
+		void flip()
+		{
+			auto total = samples.back().from;
+			for (auto i = samples.size() - 1; i-- > 0;)
+			{
+				total = combine(total, samples[i].from.sum);
+				samples[i].from = total;
+			}
+			folded = samples.size();
+		}
+
+		summary totals() const
+		{
+			if (folded == 0)
+			{
+				return back;
+			}
+			auto const older = samples.front().from;
+			if (folded == samples.size())
+			{
+				return older;
+			}
+			return summary{std::min(older.lo, back.lo), std::max(older.hi, back.hi), older.sum + back.sum};
+		}
+
+		duration                      span;
+		detail::rolling::ring<sample> samples;
+		std::size_t                   folded;
+		summary                       back;
+	};
+}
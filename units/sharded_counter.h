@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <cstddef>
+
+#include "units.h"
+#include "units/atomic.h"
+
+namespace units
+{
+	namespace detail
+	{
+		constexpr std::size_t cache_line_size = 64;
+
+		// Threads are handed out consecutive indices the first time they touch any sharded counter, which spreads
+		// them over the shards more evenly than hashing std::thread::id
+		inline std::size_t thread_shard_hint()
+		{
+			static std::atomic<std::size_t> next{0};
+			thread_local std::size_t const  hint = next.fetch_add(1, std::memory_order_relaxed);
+			return hint;
+		}
+
+		inline std::size_t default_shard_count()
+		{
+			auto const threads = std::max(1u, std::thread::hardware_concurrency());
+			auto       shards  = std::size_t{1};
+			while (shards < threads)
+			{
+				shards *= 2;
+			}
+			return shards;
+		}
+	}
+
+	// A counter for many writers and few readers. Each thread adds into its own cache line sized shard and reading
+	// sums the shards, so a read is only a snapshot while writers are active.
+	template <typename Unit>
+	class sharded_counter
+	{
+		static_assert(is_unit<Unit>::value, "A sharded counter must count a unit");
+
+	public:
+		using value_type = Unit;
+		using unit_type  = typename Unit::unit_type;
+
+		explicit sharded_counter(std::size_t shard_count = detail::default_shard_count())
+		    : shard_count{shard_count}
+		    , shards{new shard[shard_count]}
+		{
+			if (shard_count == 0 || (shard_count & (shard_count - 1)) != 0)
+			{
+				throw std::invalid_argument{"Shard count must be a power of two"};
+			}
+		}
+
+		sharded_counter(sharded_counter const&) = delete;
+		sharded_counter& operator=(sharded_counter const&) = delete;
+
+		template <typename Rep2, typename Ratio2>
+		void add(unit<Rep2, Ratio2, unit_type> value)
+		{
+			local().fetch_add(value, std::memory_order_relaxed);
+		}
+
+		template <typename Rep2, typename Ratio2>
+		void subtract(unit<Rep2, Ratio2, unit_type> value)
+		{
+			local().fetch_sub(value, std::memory_order_relaxed);
+		}
+
+		template <typename Rep2, typename Ratio2>
+		sharded_counter& operator+=(unit<Rep2, Ratio2, unit_type> value)
+		{
+			add(value);
+			return *this;
+		}
+
+		template <typename Rep2, typename Ratio2>
+		sharded_counter& operator-=(unit<Rep2, Ratio2, unit_type> value)
+		{
+			subtract(value);
+			return *this;
+		}
+
+		Unit load() const
+		{
+			auto total = Unit{0};
+			for (std::size_t i = 0; i < shard_count; ++i)
+			{
+				total += shards[i].value.load(std::memory_order_relaxed);
+			}
+			return total;
+		}
+
+		operator Unit() const { return load(); }
+
+		void reset()
+		{
+			for (std::size_t i = 0; i < shard_count; ++i)
+			{
+				shards[i].value.store(Unit{0}, std::memory_order_relaxed);
+			}
+		}
+
+		std::size_t size() const { return shard_count; }
+
+	private:
+		struct alignas(detail::cache_line_size) shard
+		{
+			atomic<Unit> value;
+		};
+
+		atomic<Unit>& local() { return shards[detail::thread_shard_hint() & (shard_count - 1)].value; }
+
+		std::size_t              shard_count;
+		std::unique_ptr<shard[]> shards;
+	};
+}
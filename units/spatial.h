@@ -0,0 +1,378 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// A static KD-tree over points given as vec3 of units. The points are reordered once so that every subtree is a
+// contiguous range of them: the median of a range along one axis sits in its middle with the nearer points before it
+// and the further ones after, the axes taking turns by depth, so the tree needs no nodes or pointers at all. The
+// coordinates are kept as three arrays so a leaf of 16 points is scanned with whole vector instructions.
+//
+// Queries take their centre and radius in any ratio of the unit type and convert them once. A radius search calls
+// back for every point found and a nearest search fills a buffer the caller owns, so neither allocates. Building and
+// the batch queries split the work over index_options::threads.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "units.h"
+#include "units/index.h"
+#include "units/vec3.h"
+
+namespace units
+{
+	template <typename Unit>
+	struct neighbour
+	{
+		std::size_t row;
+		Unit        distance;
+	};
+
+	template <typename Unit>
+	class kd_tree
+	{
+		static_assert(is_unit<Unit>::value, "Coordinates must be units");
+
+	public:
+		using unit_type  = typename Unit::unit_type;
+		using value_type = typename std::common_type<typename Unit::rep, double>::type;
+
+		static constexpr std::size_t leaf_size = 16;
+
+		// Indexes the points in [first, last); rows are positions in that range. Throws std::domain_error if a
+		// coordinate is NaN.
+		template <typename InputIt>
+		kd_tree(InputIt first, InputIt last, index_options options = {})
+		    : axes{}
+		    , rows{}
+		{
+			auto entries = std::vector<entry>{};
+			for (std::size_t row = 0; first != last; ++first, ++row)
+			{
+				vec3<Unit> const p = *first;
+
+				entry e{{to_value(p.x()), to_value(p.y()), to_value(p.z())}, row};
+				for (auto c : e.at)
+				{
+					detail::index::check(c);
+				}
+				entries.push_back(e);
+			}
+
+			std::size_t spawn = 0;
+			while ((std::size_t{1} << spawn) < options.threads)
+			{
+				++spawn;
+			}
+			build(entries, 0, entries.size(), 0, spawn);
+
+			for (auto& axis : axes)
+			{
+				axis.reserve(entries.size());
+			}
+			rows.reserve(entries.size());
+			for (auto const& e : entries)
+			{
+				for (std::size_t a = 0; a < 3; ++a)
+				{
+					axes[a].push_back(e.at[a]);
+				}
+				rows.push_back(e.row);
+			}
+		}
+
+		std::size_t size() const { return rows.size(); }
+
+		// Calls f with the row of every point at most radius from centre
+		template <typename Unit2, typename Rep, typename Ratio, typename F>
+		void for_each_within(vec3<Unit2> const& centre, unit<Rep, Ratio, unit_type> radius, F f) const
+		{
+			auto const r = to_value(radius);
+			if (r >= 0)
+			{
+				search_within(0, size(), 0, query(centre), r * r, f);
+			}
+		}
+
+		template <typename Unit2, typename Rep, typename Ratio>
+		std::size_t count_within(vec3<Unit2> const& centre, unit<Rep, Ratio, unit_type> radius) const
+		{
+			std::size_t count = 0;
+			for_each_within(centre, radius, [&](std::size_t) { ++count; });
+			return count;
+		}
+
+		// Appends the rows within radius of centre to out, which allocates only when out has to grow
+		template <typename Unit2, typename Rep, typename Ratio>
+		void within(vec3<Unit2> const& centre, unit<Rep, Ratio, unit_type> radius, std::vector<std::size_t>& out) const
+		{
+			for_each_within(centre, radius, [&](std::size_t row) { out.push_back(row); });
+		}
+
+		// The point closest to centre. Throws std::domain_error if the tree is empty.
+		template <typename Unit2>
+		neighbour<Unit> nearest(vec3<Unit2> const& centre) const
+		{
+			neighbour<Unit> result{0, Unit{0}};
+			if (nearest(centre, 1, &result) == 0)
+			{
+				throw std::domain_error{"The tree is empty"};
+			}
+			return result;
+		}
+
+		// Writes the k points closest to centre to out, nearest first, and returns how many were written
+		template <typename Unit2>
+		std::size_t nearest(vec3<Unit2> const& centre, std::size_t k, neighbour<Unit>* out) const
+		{
+			auto const q    = query(centre);
+			auto       best = closest{out, std::min(k, size()), 0, std::numeric_limits<value_type>::infinity()};
+			if (best.k != 0)
+			{
+				search_nearest(0, size(), 0, q, best);
+			}
+			for (std::size_t i = 0; i < best.found; ++i)
+			{
+				auto const position = out[i].row;
+				auto const distance = std::sqrt(squared_distance(position, q));
+				out[i]              = neighbour<Unit>{rows[position], Unit{static_cast<typename Unit::rep>(distance)}};
+			}
+			return best.found;
+		}
+
+		// The nearest point to each centre in [first, last), written to out
+		template <typename Unit2>
+		void nearest(vec3<Unit2> const* first,
+		             vec3<Unit2> const* last,
+		             neighbour<Unit>*   out,
+		             index_options      options = {}) const
+		{
+			batch(static_cast<std::size_t>(last - first), options, [&](std::size_t i) { out[i] = nearest(first[i]); });
+		}
+
+		// The number of points within radius of each centre in [first, last), written to out
+		template <typename Unit2, typename Rep, typename Ratio>
+		void count_within(vec3<Unit2> const*          first,
+		                  vec3<Unit2> const*          last,
+		                  unit<Rep, Ratio, unit_type> radius,
+		                  std::size_t*                out,
+		                  index_options               options = {}) const
+		{
+			batch(static_cast<std::size_t>(last - first), options, [&](std::size_t i) {
+				out[i] = count_within(first[i], radius);
+			});
+		}
+
+		template <typename Rep, typename Ratio>
+		static value_type to_value(unit<Rep, Ratio, unit_type> u)
+		{
+			return unit_cast<unit<value_type, typename Unit::ratio, unit_type>>(u).count();
+		}
+
+	private:
+		struct entry
+		{
+			value_type  at[3];
+			std::size_t row;
+		};
+
+		struct point
+		{
+			value_type at[3];
+		};
+
+		// The k best so far, kept sorted in the caller's buffer by their positions in the tree, whose exact squared
+		// distances order them until the search ends. Once there are k of them, worst is the squared distance a point
+		// has to beat.
+		struct closest
+		{
+			neighbour<Unit>* out;
+			std::size_t      k;
+			std::size_t      found;
+			value_type       worst;
+		};
+
+		template <typename Unit2>
+		static point query(vec3<Unit2> const& centre)
+		{
+			return point{{to_value(centre.x()), to_value(centre.y()), to_value(centre.z())}};
+		}
+
+		// Moves the median of [first, last) along the axis of depth to the middle and builds the ranges either side of
+		// it, on another thread while spawn allows
+		static void
+		build(std::vector<entry>& entries, std::size_t first, std::size_t last, std::size_t depth, std::size_t spawn)
+		{
+			if (last - first <= leaf_size)
+			{
+				return;
+			}
+
+			auto const axis   = depth % 3;
+			auto const middle = first + (last - first) / 2;
+			std::nth_element(entries.begin() + first,
+			                 entries.begin() + middle,
+			                 entries.begin() + last,
+			                 [axis](entry const& lhs, entry const& rhs) { return lhs.at[axis] < rhs.at[axis]; });
+
+			if (spawn > 0)
+			{
+				auto left = std::async(std::launch::async, [&] {
+					build(entries, first, middle, depth + 1, spawn - 1);
+				});
+				build(entries, middle + 1, last, depth + 1, spawn - 1);
+				left.get();
+			}
+			else
+			{
+				build(entries, first, middle, depth + 1, 0);
+				build(entries, middle + 1, last, depth + 1, 0);
+			}
+		}
+
+		value_type squared_distance(std::size_t i, point const& q) const
+		{
+			auto const dx = axes[0][i] - q.at[0];
+			auto const dy = axes[1][i] - q.at[1];
+			auto const dz = axes[2][i] - q.at[2];
+			return dx * dx + dy * dy + dz * dz;
+		}
+
+		// The point at middle splits the range: those before it are no further along the axis and those after it no
+		// nearer
+		template <typename F>
+		void
+		search_within(std::size_t first, std::size_t last, std::size_t depth, point const& q, value_type r2, F& f) const
+		{
+			if (last - first <= leaf_size)
+			{
+				for (auto i = first; i < last; ++i)
+				{
+					if (squared_distance(i, q) <= r2)
+					{
+						f(rows[i]);
+					}
+				}
+				return;
+			}
+
+			auto const axis   = depth % 3;
+			auto const middle = first + (last - first) / 2;
+			auto const offset = q.at[axis] - axes[axis][middle];
+			if (squared_distance(middle, q) <= r2)
+			{
+				f(rows[middle]);
+			}
+			if (offset <= 0 || offset * offset <= r2)
+			{
+				search_within(first, middle, depth + 1, q, r2, f);
+			}
+			if (offset >= 0 || offset * offset <= r2)
+			{
+				search_within(middle + 1, last, depth + 1, q, r2, f);
+			}
+		}
+
+		void search_nearest(std::size_t first, std::size_t last, std::size_t depth, point const& q, closest& best) const
+		{
+			if (last - first <= leaf_size)
+			{
+				for (auto i = first; i < last; ++i)
+				{
+					auto const d2 = squared_distance(i, q);
+					if (d2 < best.worst)
+					{
+						insert(best, i, d2, q);
+					}
+				}
+				return;
+			}
+
+			// The side holding the query is searched first, so the other side is usually ruled out by then
+			auto const axis   = depth % 3;
+			auto const middle = first + (last - first) / 2;
+			auto const offset = q.at[axis] - axes[axis][middle];
+			auto const d2     = squared_distance(middle, q);
+			if (d2 < best.worst)
+			{
+				insert(best, middle, d2, q);
+			}
+			if (offset <= 0)
+			{
+				search_nearest(first, middle, depth + 1, q, best);
+				if (offset * offset < best.worst)
+				{
+					search_nearest(middle + 1, last, depth + 1, q, best);
+				}
+			}
+			else
+			{
+				search_nearest(middle + 1, last, depth + 1, q, best);
+				if (offset * offset < best.worst)
+				{
+					search_nearest(first, middle, depth + 1, q, best);
+				}
+			}
+		}
+
+		void insert(closest& best, std::size_t position, value_type d2, point const& q) const
+		{
+			auto i = best.found < best.k ? best.found++ : best.k - 1;
+			for (; i > 0 && squared_distance(best.out[i - 1].row, q) > d2; --i)
+			{
+				best.out[i] = best.out[i - 1];
+			}
+			best.out[i].row = position;
+
+			if (best.found == best.k)
+			{
+				best.worst = squared_distance(best.out[best.k - 1].row, q);
+			}
+		}
+
+		template <typename Work>
+		static void batch(std::size_t n, index_options const& options, Work const& work)
+		{
+			auto const pieces = std::max<std::size_t>(1, std::min(options.threads, n));
+			detail::index::run_parallel(pieces, [&](std::size_t piece) {
+				for (auto i = n * piece / pieces; i < n * (piece + 1) / pieces; ++i)
+				{
+					work(i);
+				}
+			});
+		}
+
+		std::vector<value_type>  axes[3];
+		std::vector<std::size_t> rows;
+	};
+
+	template <typename Unit>
+	constexpr std::size_t kd_tree<Unit>::leaf_size;
+}
@@ -0,0 +1,407 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// A buffered writer for ranges of units. Values are formatted with the shortest text that reads back to the same
+// value, the unit suffix is written once per column (in the header of a CSV file, or as a constant per value for
+// line delimited text), and the text is handed to the file descriptor in large writes.
+//
+// CSV headers are written as name[suffix], which units/csv.h reads back. NaN is written as an empty field.
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+#include "units.h"
+
+namespace units
+{
+	namespace text
+	{
+		class writer
+		{
+		public:
+			static constexpr std::size_t default_buffer_size = std::size_t{1} << 20;
+
+			// Writes to fd, which is left open
+			explicit writer(int fd, std::size_t buffer_size = default_buffer_size)
+			    : buffer(std::max<std::size_t>(buffer_size, 256))
+			    , used{0}
+			    , fd{fd}
+			    , owns_fd{false}
+			    , stream{nullptr}
+			{
+			}
+
+			// Creates or truncates the file at path
+			explicit writer(std::string const& path, std::size_t buffer_size = default_buffer_size)
+			    : buffer(std::max<std::size_t>(buffer_size, 256))
+			    , used{0}
+			    , fd{open(path)}
+			    , owns_fd{true}
+			    , stream{nullptr}
+			{
+			}
+
+			explicit writer(std::ostream& os, std::size_t buffer_size = default_buffer_size)
+			    : buffer(std::max<std::size_t>(buffer_size, 256))
+			    , used{0}
+			    , fd{-1}
+			    , owns_fd{false}
+			    , stream{&os}
+			{
+			}
+
+			writer(writer const&) = delete;
+			writer& operator=(writer const&) = delete;
+
+			// Call flush() to see write errors, the destructor ignores them
+			~writer()
+			{
+				try
+				{
+					flush();
+				}
+				catch (...)
+				{
+				}
+
+				if (owns_fd)
+				{
+#if defined(_WIN32)
+					::_close(fd);
+#else
+					::close(fd);
+#endif
+				}
+			}
+
+			void write(char const* data, std::size_t size)
+			{
+				while (size != 0)
+				{
+					if (used == buffer.size())
+					{
+						drain();
+					}
+
+					auto const n = std::min(size, buffer.size() - used);
+					std::memcpy(buffer.data() + used, data, n);
+					used += n;
+					data += n;
+					size -= n;
+				}
+			}
+
+			void write(std::string const& text) { write(text.data(), text.size()); }
+
+			// Returns space for at least size characters, which is kept by passing its new end to commit
+			char* reserve(std::size_t size)
+			{
+				if (buffer.size() - used < size)
+				{
+					drain();
+					if (buffer.size() < size)
+					{
+						buffer.resize(size);
+					}
+				}
+				return buffer.data() + used;
+			}
+
+			void commit(char* end) { used = static_cast<std::size_t>(end - buffer.data()); }
+
+			void flush()
+			{
+				drain();
+				if (stream != nullptr)
+				{
+					stream->flush();
+				}
+			}
+
+		private:
+			static int open(std::string const& path)
+			{
+#if defined(_WIN32)
+				auto const result = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+				auto const result = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+				if (result < 0)
+				{
+					throw std::system_error{errno, std::generic_category(), "Unable to open " + path};
+				}
+				return result;
+			}
+
+			void drain()
+			{
+				auto data = buffer.data();
+				auto size = used;
+				used      = 0;
+
+				if (stream != nullptr)
+				{
+					if (!stream->write(data, static_cast<std::streamsize>(size)))
+					{
+						throw std::runtime_error{"Unable to write to stream"};
+					}
+					return;
+				}
+
+				while (size != 0)
+				{
+#if defined(_WIN32)
+					auto const n = ::_write(fd, data, static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30)));
+#else
+					auto const n = ::write(fd, data, size);
+#endif
+					if (n < 0)
+					{
+						if (errno == EINTR)
+						{
+							continue;
+						}
+						throw std::system_error{errno, std::generic_category(), "Unable to write"};
+					}
+					data += n;
+					size -= static_cast<std::size_t>(n);
+				}
+			}
+
+			std::vector<char> buffer;
+			std::size_t       used;
+			int               fd;
+			bool              owns_fd;
+			std::ostream*     stream;
+		};
+
+		template <typename Unit>
+		struct column_view
+		{
+			std::string name;
+			Unit const* data;
+			std::size_t size;
+		};
+
+		template <typename Unit>
+		column_view<Unit> column(std::string name, Unit const* data, std::size_t size)
+		{
+			static_assert(is_unit<Unit>::value, "Columns must hold units");
+			return column_view<Unit>{std::move(name), data, size};
+		}
+
+		template <typename Unit, typename Allocator>
+		column_view<Unit> column(std::string name, std::vector<Unit, Allocator> const& values)
+		{
+			return column(std::move(name), values.data(), values.size());
+		}
+
+		namespace detail
+		{
+			// Enough for the longest long double and a sign, exponent and decimal point
+			constexpr std::size_t max_number_chars = 48;
+
+			template <typename Rep>
+			char* format_number(char* out, Rep value, std::true_type)
+			{
+				using unsigned_rep = typename std::make_unsigned<Rep>::type;
+
+				auto magnitude = static_cast<unsigned_rep>(value);
+				if (value < 0)
+				{
+					*out++    = '-';
+					magnitude = static_cast<unsigned_rep>(unsigned_rep{0} - magnitude);
+				}
+
+				char  digits[std::numeric_limits<unsigned_rep>::digits10 + 1];
+				char* first = digits + sizeof(digits);
+				do
+				{
+					*--first = static_cast<char>('0' + magnitude % 10);
+					magnitude /= 10;
+				} while (magnitude != 0);
+
+				auto const n = static_cast<std::size_t>(digits + sizeof(digits) - first);
+				std::memcpy(out, first, n);
+				return out + n;
+			}
+
+#if defined(__cpp_lib_to_chars)
+			template <typename Rep>
+			char* format_number(char* out, Rep value, std::false_type)
+			{
+				return std::to_chars(out, out + max_number_chars, value).ptr;
+			}
+#else
+			// Without floating point to_chars, the shorter of the two precisions that reads back exactly is used
+			template <typename Rep>
+			char* format_number(char* out, Rep value, std::false_type)
+			{
+				using wide = typename std::conditional<std::is_same<Rep, long double>::value, long double, double>::type;
+
+				auto const format = std::is_same<wide, long double>::value ? "%.*Lg" : "%.*g";
+				auto       n      = std::snprintf(out, max_number_chars, format, std::numeric_limits<Rep>::digits10, static_cast<wide>(value));
+				if (std::isfinite(value) && static_cast<Rep>(std::strtold(out, nullptr)) != value)
+				{
+					n = std::snprintf(out, max_number_chars, format, std::numeric_limits<Rep>::max_digits10, static_cast<wide>(value));
+				}
+				return out + n;
+			}
+#endif
+
+			template <typename Rep>
+			char* format_number(char* out, Rep value)
+			{
+				return format_number(out, value, std::is_integral<Rep>{});
+			}
+
+			template <typename Rep>
+			bool is_nan(Rep, std::true_type)
+			{
+				return false;
+			}
+
+			template <typename Rep>
+			bool is_nan(Rep value, std::false_type)
+			{
+				return std::isnan(value);
+			}
+
+			template <typename Unit>
+			std::string suffix()
+			{
+				return units::detail::get_unit<typename Unit::ratio, typename Unit::unit_type>();
+			}
+
+			template <typename Unit>
+			char* format_field(char* out, Unit const& value, char delimiter)
+			{
+				using rep = typename Unit::rep;
+
+				if (!is_nan(value.count(), std::is_integral<rep>{}))
+				{
+					out = format_number(out, value.count());
+				}
+				*out++ = delimiter;
+				return out;
+			}
+
+			template <typename... Units, std::size_t... Indices>
+			char* format_row(char*                                     out,
+			                 std::tuple<column_view<Units> const&...> const& columns,
+			                 std::size_t                                row,
+			                 char                                        delimiter,
+			                 std::index_sequence<Indices...>)
+			{
+				int expand[] = {(out = format_field(out, std::get<Indices>(columns).data[row], delimiter), 0)...};
+				static_cast<void>(expand);
+				return out;
+			}
+		}
+
+		// Writes a header of name[suffix] fields followed by one row per element of the columns, which must all be the
+		// same length
+		template <typename... Units>
+		void write_csv(writer& out, char delimiter, column_view<Units> const&... columns)
+		{
+			static_assert(sizeof...(Units) > 0, "At least one column must be written");
+
+			auto const sizes = std::vector<std::size_t>{columns.size...};
+			auto const rows  = sizes.front();
+			if (std::any_of(sizes.begin(), sizes.end(), [rows](std::size_t size) { return size != rows; }))
+			{
+				throw std::invalid_argument{"Columns have different lengths"};
+			}
+
+			auto header = std::string{};
+			int  expand[] = {(header += columns.name + "[" + detail::suffix<Units>() + "]" + delimiter, 0)...};
+			static_cast<void>(expand);
+			header.back() = '\n';
+			out.write(header);
+
+			auto const row_chars = sizeof...(Units) * (detail::max_number_chars + 1);
+			auto const fields    = std::tuple<column_view<Units> const&...>{columns...};
+			for (std::size_t row = 0; row < rows; ++row)
+			{
+				auto end = detail::format_row(out.reserve(row_chars), fields, row, delimiter, std::index_sequence_for<Units...>{});
+				end[-1]  = '\n';
+				out.commit(end);
+			}
+		}
+
+		template <typename... Units>
+		void write_csv(writer& out, column_view<Units> const&... columns)
+		{
+			write_csv(out, ',', columns...);
+		}
+
+		// Writes one value per line, as operator<< would print it
+		template <typename InputIt>
+		void write_lines(writer& out, InputIt first, InputIt last)
+		{
+			using unit_type = typename std::iterator_traits<InputIt>::value_type;
+			static_assert(is_unit<unit_type>::value, "Only units can be written");
+
+			auto const suffix     = detail::suffix<unit_type>() + '\n';
+			auto const line_chars = detail::max_number_chars + suffix.size();
+			for (; first != last; ++first)
+			{
+				auto end = detail::format_number(out.reserve(line_chars), first->count());
+				std::memcpy(end, suffix.data(), suffix.size());
+				out.commit(end + suffix.size());
+			}
+		}
+	}
+}
@@ -0,0 +1,391 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Three dimensional vector quantities. A vec3 keeps its components contiguous in four aligned lanes, the last of which
+// is always zero, so that component-wise arithmetic compiles to whole vector instructions. A vec3_array keeps arrays
+// of vectors as three component arrays, which is the layout that vectorises across many vectors.
+
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "units.h"
+#include "units/bulk.h"
+
+namespace units
+{
+	template <typename Unit>
+	class alignas(4 * sizeof(typename Unit::rep)) vec3
+	{
+		static_assert(is_unit<Unit>::value, "Vector components must be units");
+
+	public:
+		using value_type = Unit;
+		using rep        = typename Unit::rep;
+
+		static constexpr std::size_t lanes = 4;
+
+		vec3()
+		    : lane{}
+		{
+		}
+
+		vec3(Unit x, Unit y, Unit z)
+		    : lane{x.count(), y.count(), z.count(), rep{0}}
+		{
+		}
+
+		// Converts component-wise from another ratio, as unit does
+		template <typename Rep2, typename Ratio2, typename UnitType2>
+		vec3(vec3<unit<Rep2, Ratio2, UnitType2>> const& other)
+		    : lane{}
+		{
+			static_assert(std::is_same<typename Unit::unit_type, UnitType2>::value, "Unit types are not compatible");
+			for (std::size_t i = 0; i < lanes; ++i)
+			{
+				lane[i] = unit_cast<Unit>(other[i]).count();
+			}
+		}
+
+		Unit x() const { return Unit{lane[0]}; }
+		Unit y() const { return Unit{lane[1]}; }
+		Unit z() const { return Unit{lane[2]}; }
+
+		Unit operator[](std::size_t index) const { return Unit{lane[index]}; }
+
+		// The four lanes, x, y, z and a zero
+		rep const* data() const { return lane; }
+
+		vec3& operator+=(vec3 const& other)
+		{
+			for (std::size_t i = 0; i < lanes; ++i)
+			{
+				lane[i] += other.lane[i];
+			}
+			return *this;
+		}
+
+		vec3& operator-=(vec3 const& other)
+		{
+			for (std::size_t i = 0; i < lanes; ++i)
+			{
+				lane[i] -= other.lane[i];
+			}
+			return *this;
+		}
+
+		vec3& operator*=(rep scalar)
+		{
+			for (std::size_t i = 0; i < lanes - 1; ++i)
+			{
+				lane[i] *= scalar;
+			}
+			return *this;
+		}
+
+		vec3& operator/=(rep scalar)
+		{
+			for (std::size_t i = 0; i < lanes - 1; ++i)
+			{
+				lane[i] /= scalar;
+			}
+			return *this;
+		}
+
+		vec3 operator-() const { return vec3{} -= *this; }
+
+	private:
+		rep lane[lanes];
+	};
+
+	template <typename Unit>
+	constexpr std::size_t vec3<Unit>::lanes;
+
+	template <typename Unit1, typename Unit2>
+	auto operator+(vec3<Unit1> const& lhs, vec3<Unit2> const& rhs)
+	    -> vec3<typename std::common_type<Unit1, Unit2>::type>
+	{
+		using common_type = vec3<typename std::common_type<Unit1, Unit2>::type>;
+		return common_type{lhs} += common_type{rhs};
+	}
+
+	template <typename Unit1, typename Unit2>
+	auto operator-(vec3<Unit1> const& lhs, vec3<Unit2> const& rhs)
+	    -> vec3<typename std::common_type<Unit1, Unit2>::type>
+	{
+		using common_type = vec3<typename std::common_type<Unit1, Unit2>::type>;
+		return common_type{lhs} -= common_type{rhs};
+	}
+
+	template <typename Unit>
+	vec3<Unit> operator*(vec3<Unit> lhs, typename Unit::rep scalar)
+	{
+		return lhs *= scalar;
+	}
+
+	template <typename Unit>
+	vec3<Unit> operator*(typename Unit::rep scalar, vec3<Unit> rhs)
+	{
+		return rhs *= scalar;
+	}
+
+	template <typename Unit>
+	vec3<Unit> operator/(vec3<Unit> lhs, typename Unit::rep scalar)
+	{
+		return lhs /= scalar;
+	}
+
+	// Component-wise, with the tolerance of the unit comparison
+	template <typename Unit1, typename Unit2>
+	bool operator==(vec3<Unit1> const& lhs, vec3<Unit2> const& rhs)
+	{
+		return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.z() == rhs.z();
+	}
+
+	template <typename Unit1, typename Unit2>
+	bool operator!=(vec3<Unit1> const& lhs, vec3<Unit2> const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	// The dot product of two vectors, dimensioned as the product of their components
+	template <typename Unit>
+	auto dot(vec3<Unit> const& lhs, vec3<Unit> const& rhs) -> decltype(Unit{0} * Unit{0})
+	{
+		using result_type = decltype(Unit{0} * Unit{0});
+
+		typename Unit::rep products[vec3<Unit>::lanes];
+		for (std::size_t i = 0; i < vec3<Unit>::lanes; ++i)
+		{
+			products[i] = lhs.data()[i] * rhs.data()[i];
+		}
+		return result_type{(products[0] + products[1]) + (products[2] + products[3])};
+	}
+
+	template <typename Unit>
+	Unit norm(vec3<Unit> const& v)
+	{
+		return Unit{static_cast<typename Unit::rep>(std::sqrt(dot(v, v).count()))};
+	}
+
+	template <typename ToUnit, typename Unit>
+	auto unit_cast(vec3<Unit> const& from) -> typename std::enable_if<is_unit<ToUnit>::value, vec3<ToUnit>>::type
+	{
+		return vec3<ToUnit>{from};
+	}
+
+	template <typename Unit>
+	class vec3_array
+	{
+		static_assert(is_unit<Unit>::value, "Vector components must be units");
+
+	public:
+		using value_type = vec3<Unit>;
+		using rep        = typename Unit::rep;
+
+		vec3_array() = default;
+
+		explicit vec3_array(std::size_t size)
+		    : xs(size, Unit{0})
+		    , ys(size, Unit{0})
+		    , zs(size, Unit{0})
+		{
+		}
+
+		// Transposes an array of vectors
+		template <typename InputIt>
+		vec3_array(InputIt first, InputIt last)
+		{
+			for (; first != last; ++first)
+			{
+				push_back(*first);
+			}
+		}
+
+		vec3_array(std::initializer_list<vec3<Unit>> values)
+		    : vec3_array(values.begin(), values.end())
+		{
+		}
+
+		std::size_t size() const { return xs.size(); }
+		bool        empty() const { return xs.empty(); }
+
+		void reserve(std::size_t capacity)
+		{
+			xs.reserve(capacity);
+			ys.reserve(capacity);
+			zs.reserve(capacity);
+		}
+
+		void push_back(vec3<Unit> const& v)
+		{
+			xs.push_back(v.x());
+			ys.push_back(v.y());
+			zs.push_back(v.z());
+		}
+
+		vec3<Unit> operator[](std::size_t index) const { return vec3<Unit>{xs[index], ys[index], zs[index]}; }
+
+		Unit* x() { return xs.data(); }
+		Unit* y() { return ys.data(); }
+		Unit* z() { return zs.data(); }
+
+		Unit const* x() const { return xs.data(); }
+		Unit const* y() const { return ys.data(); }
+		Unit const* z() const { return zs.data(); }
+
+		vec3_array& operator+=(vec3_array const& other)
+		{
+			check_size(other);
+			apply(other, [](rep& lhs, rep rhs) { lhs += rhs; });
+			return *this;
+		}
+
+		vec3_array& operator-=(vec3_array const& other)
+		{
+			check_size(other);
+			apply(other, [](rep& lhs, rep rhs) { lhs -= rhs; });
+			return *this;
+		}
+
+		// Adds the same vector to every element
+		vec3_array& operator+=(vec3<Unit> const& offset)
+		{
+			for (std::size_t axis = 0; axis < 3; ++axis)
+			{
+				auto const component = offset.data()[axis];
+				auto       values    = detail::raw(components(axis));
+				for (std::size_t i = 0; i < size(); ++i)
+				{
+					values[i] += component;
+				}
+			}
+			return *this;
+		}
+
+		vec3_array& operator*=(rep scalar)
+		{
+			for (std::size_t axis = 0; axis < 3; ++axis)
+			{
+				auto values = detail::raw(components(axis));
+				for (std::size_t i = 0; i < size(); ++i)
+				{
+					values[i] *= scalar;
+				}
+			}
+			return *this;
+		}
+
+	private:
+		template <typename U>
+		friend class vec3_array;
+
+		Unit* components(std::size_t axis) { return axis == 0 ? x() : axis == 1 ? y() : z(); }
+
+		Unit const* components(std::size_t axis) const { return axis == 0 ? x() : axis == 1 ? y() : z(); }
+
+		void check_size(vec3_array const& other) const
+		{
+			if (other.size() != size())
+			{
+				throw std::invalid_argument{"Vector arrays have different sizes"};
+			}
+		}
+
+		template <typename Operation>
+		void apply(vec3_array const& other, Operation operation)
+		{
+			for (std::size_t axis = 0; axis < 3; ++axis)
+			{
+				auto       lhs = detail::raw(components(axis));
+				auto const rhs = detail::raw(other.components(axis));
+				for (std::size_t i = 0; i < size(); ++i)
+				{
+					operation(lhs[i], rhs[i]);
+				}
+			}
+		}
+
+		std::vector<Unit> xs;
+		std::vector<Unit> ys;
+		std::vector<Unit> zs;
+	};
+
+	// The dot product of each pair of vectors. out must hold lhs.size() values.
+	template <typename Unit>
+	auto dot(vec3_array<Unit> const& lhs, vec3_array<Unit> const& rhs, decltype(Unit{0} * Unit{0})* out)
+	    -> decltype(out)
+	{
+		if (lhs.size() != rhs.size())
+		{
+			throw std::invalid_argument{"Vector arrays have different sizes"};
+		}
+
+		auto const x1 = detail::raw(lhs.x());
+		auto const y1 = detail::raw(lhs.y());
+		auto const z1 = detail::raw(lhs.z());
+		auto const x2 = detail::raw(rhs.x());
+		auto const y2 = detail::raw(rhs.y());
+		auto const z2 = detail::raw(rhs.z());
+		auto const o  = detail::raw(out);
+		for (std::size_t i = 0; i < lhs.size(); ++i)
+		{
+			o[i] = x1[i] * x2[i] + y1[i] * y2[i] + z1[i] * z2[i];
+		}
+		return out + lhs.size();
+	}
+
+	// The length of each vector. out must hold v.size() values.
+	template <typename Unit>
+	Unit* norm(vec3_array<Unit> const& v, Unit* out)
+	{
+		auto const x = detail::raw(v.x());
+		auto const y = detail::raw(v.y());
+		auto const z = detail::raw(v.z());
+		auto const o = detail::raw(out);
+		for (std::size_t i = 0; i < v.size(); ++i)
+		{
+			o[i] = static_cast<typename Unit::rep>(std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]));
+		}
+		return out + v.size();
+	}
+
+	// Converts each component array with the bulk kernels
+	template <typename ToUnit, typename Unit>
+	auto unit_cast(vec3_array<Unit> const& from) ->
+	    typename std::enable_if<is_unit<ToUnit>::value, vec3_array<ToUnit>>::type
+	{
+		auto result = vec3_array<ToUnit>(from.size());
+		bulk::cast(from.x(), from.x() + from.size(), result.x());
+		bulk::cast(from.y(), from.y() + from.size(), result.y());
+		bulk::cast(from.z(), from.z() + from.size(), result.z());
+		return result;
+	}
+}
@@ -0,0 +1,588 @@
+#pragma once
+
+/**
+ * MIT License
+ *
+ * Copyright (c) 2016-2017 David Brown
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Lazily evaluated views over ranges of units. A view keeps the iterators of the range it was made from, one
+// transform and one filter, and each adaptor applied with | folds into them, so
+//
+//     auto metres = readings | units::views::filter_between(0_m, 10_km) | units::views::cast<units::metres>();
+//     auto total  = units::views::sum(metres);
+//
+// makes a single pass over readings without materialising a converted copy. While the transform only converts the
+// ratio without losing precision, filter bounds are converted to the ratio of the source once and compared against
+// the stored values, and consecutive casts convert from the source directly. sum and size run the fused loop over
+// several independent lanes without branches, so it can be vectorised when the range is contiguous.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "units.h"
+#include "units/bulk.h"
+
+namespace units
+{
+	namespace views
+	{
+		namespace detail
+		{
+			struct identity
+			{
+				template <typename T>
+				constexpr T operator()(T value) const
+				{
+					return value;
+				}
+			};
+
+			struct keep_all
+			{
+				template <typename T>
+				constexpr bool operator()(T) const
+				{
+					return true;
+				}
+			};
+
+			template <typename To>
+			struct cast_to
+			{
+				template <typename Unit>
+				constexpr To operator()(Unit value) const
+				{
+					return unit_cast<To>(value);
+				}
+			};
+
+			template <typename Factor>
+			struct scale_by
+			{
+				Factor factor;
+
+				template <typename Unit>
+				constexpr auto operator()(Unit value) const -> decltype(value * factor)
+				{
+					return value * factor;
+				}
+			};
+
+			struct count_of
+			{
+				template <typename Unit>
+				constexpr typename Unit::rep operator()(Unit value) const
+				{
+					return value.count();
+				}
+			};
+
+			template <typename Outer, typename Inner>
+			struct compose
+			{
+				Outer outer;
+				Inner inner;
+
+				template <typename T>
+				constexpr auto operator()(T value) const
+				    -> decltype(std::declval<Outer const&>()(std::declval<Inner const&>()(value)))
+				{
+					return outer(inner(value));
+				}
+			};
+
+			// [lo, hi) on the count of a unit already in the ratio of the bounds
+			template <typename Rep>
+			struct between
+			{
+				Rep lo;
+				Rep hi;
+
+				template <typename Unit>
+				constexpr bool operator()(Unit value) const
+				{
+					return (value.count() >= lo) & (value.count() < hi);
+				}
+			};
+
+			template <typename First, typename Second>
+			struct both
+			{
+				First  first;
+				Second second;
+
+				template <typename T>
+				constexpr bool operator()(T value) const
+				{
+					return first(value) & second(value);
+				}
+			};
+
+			template <typename Keep, typename Between>
+			both<Keep, Between> and_then(Keep keep, Between between)
+			{
+				return both<Keep, Between>{keep, between};
+			}
+
+			template <typename Between>
+			Between and_then(keep_all, Between between)
+			{
+				return between;
+			}
+
+			// Integer counts are compared against bounds that keep their fraction
+			template <typename Rep>
+			using bound_rep =
+			    std::conditional_t<std::is_floating_point<Rep>::value, Rep, std::common_type_t<Rep, double>>;
+
+			template <typename Unit>
+			using bound_of = unit<bound_rep<typename Unit::rep>, typename Unit::ratio, typename Unit::unit_type>;
+
+			template <typename T>
+			struct rep_of
+			{
+				using type = T;
+			};
+
+			template <typename Rep, typename Ratio, typename UnitType>
+			struct rep_of<unit<Rep, Ratio, UnitType>>
+			{
+				using type = Rep;
+			};
+
+			template <typename T>
+			constexpr T to_count(T value)
+			{
+				return value;
+			}
+
+			template <typename Rep, typename Ratio, typename UnitType>
+			constexpr Rep to_count(unit<Rep, Ratio, UnitType> value)
+			{
+				return value.count();
+			}
+
+			template <typename T>
+			constexpr T from_count(typename rep_of<T>::type count, std::false_type)
+			{
+				return count;
+			}
+
+			template <typename T>
+			constexpr T from_count(typename rep_of<T>::type count, std::true_type)
+			{
+				return T{count};
+			}
+		}
+
+		// The elements of [first, last) for which keep is true, passed through transform. Converted is true while
+		// transform only converts the ratio of the source to a floating point rep that holds every source value.
+		template <typename Iterator, typename Transform, typename Keep, bool Converted>
+		struct view
+		{
+			using source_type = typename std::iterator_traits<Iterator>::value_type;
+			using value_type  = std::decay_t<decltype(std::declval<Transform const&>()(std::declval<source_type>()))>;
+
+			class iterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type        = view::value_type;
+				using difference_type   = typename std::iterator_traits<Iterator>::difference_type;
+				using pointer           = void;
+				using reference         = value_type;
+
+				iterator() = default;
+
+				iterator(view const* parent, Iterator current)
+				    : parent{parent}
+				    , current{current}
+				{
+					skip();
+				}
+
+				reference operator*() const
+				{
+					return parent->transform(*current);
+				}
+
+				iterator& operator++()
+				{
+					++current;
+					skip();
+					return *this;
+				}
+
+				iterator operator++(int)
+				{
+					auto const previous = *this;
+					++*this;
+					return previous;
+				}
+
+				friend bool operator==(iterator const& lhs, iterator const& rhs)
+				{
+					return lhs.current == rhs.current;
+				}
+
+				friend bool operator!=(iterator const& lhs, iterator const& rhs)
+				{
+					return lhs.current != rhs.current;
+				}
+
+			private:
+				void skip()
+				{
+					while (current != parent->last && !parent->keep(*current))
+					{
+						++current;
+					}
+				}
+
+				view const* parent = nullptr;
+				Iterator    current{};
+			};
+
+			view(Iterator first, Iterator last, Transform transform, Keep keep)
+			    : first{first}
+			    , last{last}
+			    , transform{transform}
+			    , keep{keep}
+			{
+			}
+
+			iterator begin() const
+			{
+				return iterator{this, first};
+			}
+
+			iterator end() const
+			{
+				return iterator{this, last};
+			}
+
+			Iterator  first;
+			Iterator  last;
+			Transform transform;
+			Keep      keep;
+		};
+
+		template <typename T>
+		struct is_view : std::false_type
+		{
+		};
+
+		template <typename Iterator, typename Transform, typename Keep, bool Converted>
+		struct is_view<view<Iterator, Transform, Keep, Converted>> : std::true_type
+		{
+		};
+
+		// A view of a whole range of units, which must outlive it
+		template <typename Range>
+		auto all(Range& range)
+		    -> view<decltype(std::begin(range)), detail::identity, detail::keep_all, true>
+		{
+			using iterator = decltype(std::begin(range));
+			static_assert(is_unit<typename std::iterator_traits<iterator>::value_type>::value,
+			              "Views are made from ranges of units");
+			return view<iterator, detail::identity, detail::keep_all, true>{
+			    std::begin(range), std::end(range), detail::identity{}, detail::keep_all{}};
+		}
+
+		template <typename To>
+		struct cast_adaptor
+		{
+		};
+
+		template <typename Factor>
+		struct scale_adaptor
+		{
+			Factor factor;
+		};
+
+		struct count_adaptor
+		{
+		};
+
+		template <typename Lo, typename Hi>
+		struct filter_between_adaptor
+		{
+			Lo lo;
+			Hi hi;
+		};
+
+		// Converts each element to To
+		template <typename To>
+		constexpr cast_adaptor<To> cast()
+		{
+			static_assert(is_unit<To>::value, "Views cast to units");
+			return {};
+		}
+
+		// Multiplies each element by factor
+		template <typename Factor>
+		constexpr scale_adaptor<Factor> scale(Factor factor)
+		{
+			return scale_adaptor<Factor>{factor};
+		}
+
+		// The count of each element
+		constexpr count_adaptor count{};
+
+		// Keeps the elements in [lo, hi). The bounds may be in any compatible ratio.
+		template <typename Lo, typename Hi>
+		constexpr filter_between_adaptor<Lo, Hi> filter_between(Lo lo, Hi hi)
+		{
+			static_assert(is_unit<Lo>::value && is_unit<Hi>::value, "Bounds must be units");
+			return filter_between_adaptor<Lo, Hi>{lo, hi};
+		}
+
+		namespace detail
+		{
+			// Whether every value of From survives a cast to To, so the source can stand in for the cast value
+			template <typename From, typename To>
+			using preserves_value = std::integral_constant<bool,
+			                                               std::is_floating_point<typename To::rep>::value &&
+			                                                   std::numeric_limits<typename To::rep>::digits >=
+			                                                       std::numeric_limits<typename From::rep>::digits>;
+
+			template <typename Iterator, typename Transform, typename Keep, typename To>
+			auto apply_cast(view<Iterator, Transform, Keep, true> const& v, cast_adaptor<To>, std::true_type)
+			{
+				return view<Iterator, cast_to<To>, Keep, true>{v.first, v.last, cast_to<To>{}, v.keep};
+			}
+
+			template <typename Iterator, typename Transform, typename Keep, bool Converted, typename To>
+			auto apply_cast(view<Iterator, Transform, Keep, Converted> const& v, cast_adaptor<To>, std::false_type)
+			{
+				using transform = compose<cast_to<To>, Transform>;
+				return view<Iterator, transform, Keep, false>{v.first, v.last, transform{{}, v.transform}, v.keep};
+			}
+
+			template <typename Iterator, typename Transform, typename Keep, typename To>
+			auto apply(view<Iterator, Transform, Keep, true> const& v, cast_adaptor<To> adaptor)
+			{
+				using source_type = typename view<Iterator, Transform, Keep, true>::source_type;
+				return apply_cast(v, adaptor, preserves_value<source_type, To>{});
+			}
+
+			template <typename Iterator, typename Transform, typename Keep, typename To>
+			auto apply(view<Iterator, Transform, Keep, false> const& v, cast_adaptor<To> adaptor)
+			{
+				return apply_cast(v, adaptor, std::false_type{});
+			}
+
+			template <typename Iterator, typename Transform, typename Keep, bool Converted, typename Factor>
+			auto apply(view<Iterator, Transform, Keep, Converted> const& v, scale_adaptor<Factor> adaptor)
+			{
+				using transform = compose<scale_by<Factor>, Transform>;
+				return view<Iterator, transform, Keep, false>{
+				    v.first, v.last, transform{{adaptor.factor}, v.transform}, v.keep};
+			}
+
+			template <typename Iterator, typename Transform, typename Keep, bool Converted>
+			auto apply(view<Iterator, Transform, Keep, Converted> const& v, count_adaptor)
+			{
+				using transform = compose<count_of, Transform>;
+				return view<Iterator, transform, Keep, false>{v.first, v.last, transform{{}, v.transform}, v.keep};
+			}
+
+			// The bounds are compared against the stored values in the ratio of the source
+			template <typename Iterator, typename Transform, typename Keep, typename Lo, typename Hi>
+			auto apply(view<Iterator, Transform, Keep, true> const& v, filter_between_adaptor<Lo, Hi> adaptor)
+			{
+				using bound = bound_of<typename view<Iterator, Transform, Keep, true>::source_type>;
+
+				auto const test = between<typename bound::rep>{unit_cast<bound>(adaptor.lo).count(),
+				                                               unit_cast<bound>(adaptor.hi).count()};
+				auto const keep = and_then(v.keep, test);
+				using filtered  = view<Iterator, Transform, std::decay_t<decltype(keep)>, true>;
+				return filtered{v.first, v.last, v.transform, keep};
+			}
+
+			// After a scale, a count or a cast that may lose precision the bounds are compared against the transformed
+			// values
+			template <typename Iterator, typename Transform, typename Keep, typename Lo, typename Hi>
+			auto apply(view<Iterator, Transform, Keep, false> const& v, filter_between_adaptor<Lo, Hi> adaptor)
+			{
+				using element = typename view<Iterator, Transform, Keep, false>::value_type;
+				static_assert(is_unit<element>::value, "filter_between needs units, apply it before count");
+				using bound = bound_of<element>;
+
+				auto const test = compose<between<typename bound::rep>, Transform>{
+				    {unit_cast<bound>(adaptor.lo).count(), unit_cast<bound>(adaptor.hi).count()}, v.transform};
+				auto const keep = and_then(v.keep, test);
+				using filtered  = view<Iterator, Transform, std::decay_t<decltype(keep)>, false>;
+				return filtered{v.first, v.last, v.transform, keep};
+			}
+
+			template <typename T>
+			struct is_adaptor : std::false_type
+			{
+			};
+
+			template <typename To>
+			struct is_adaptor<cast_adaptor<To>> : std::true_type
+			{
+			};
+
+			template <typename Factor>
+			struct is_adaptor<scale_adaptor<Factor>> : std::true_type
+			{
+			};
+
+			template <>
+			struct is_adaptor<count_adaptor> : std::true_type
+			{
+			};
+
+			template <typename Lo, typename Hi>
+			struct is_adaptor<filter_between_adaptor<Lo, Hi>> : std::true_type
+			{
+			};
+		}
+
+		template <typename Iterator, typename Transform, typename Keep, bool Converted, typename Adaptor>
+		auto operator|(view<Iterator, Transform, Keep, Converted> const& v, Adaptor adaptor)
+		    -> std::enable_if_t<detail::is_adaptor<Adaptor>::value, decltype(detail::apply(v, adaptor))>
+		{
+			return detail::apply(v, adaptor);
+		}
+
+		template <typename Range, typename Adaptor>
+		auto operator|(Range& range, Adaptor adaptor)
+		    -> std::enable_if_t<!is_view<std::remove_const_t<Range>>::value && detail::is_adaptor<Adaptor>::value,
+		                        decltype(detail::apply(all(range), adaptor))>
+		{
+			return detail::apply(all(range), adaptor);
+		}
+
+		namespace detail
+		{
+			constexpr std::size_t lanes = 8;
+
+			// A rejected element is still transformed, so its source is zeroed first. Otherwise an out of range or NaN
+			// value would be converted to an integer rep, which is undefined.
+			template <typename Rep, typename Ratio, typename UnitType>
+			unit<Rep, Ratio, UnitType> admitted(bool keep, unit<Rep, Ratio, UnitType> source)
+			{
+				return unit<Rep, Ratio, UnitType>{units::detail::zero_unless(keep, source.count())};
+			}
+
+			template <typename View>
+			auto sum(View const& v, std::random_access_iterator_tag)
+			{
+				using value_type = typename View::value_type;
+				using rep        = typename rep_of<value_type>::type;
+
+				auto const n = static_cast<std::size_t>(v.last - v.first);
+
+				rep         partial[lanes] = {};
+				std::size_t i              = 0;
+				for (; i + lanes <= n; i += lanes)
+				{
+					for (std::size_t j = 0; j < lanes; ++j)
+					{
+						auto const source = v.first[i + j];
+						auto const keep   = v.keep(source);
+						auto const value  = to_count(v.transform(admitted(keep, source)));
+						partial[j] += units::detail::zero_unless(keep, value);
+					}
+				}
+				for (; i < n; ++i)
+				{
+					auto const source = v.first[i];
+					auto const keep   = v.keep(source);
+					auto const value  = to_count(v.transform(admitted(keep, source)));
+					partial[0] += units::detail::zero_unless(keep, value);
+				}
+
+				rep total{};
+				for (std::size_t j = 0; j < lanes; ++j)
+				{
+					total += partial[j];
+				}
+				return from_count<value_type>(total, is_unit<value_type>{});
+			}
+
+			template <typename View>
+			auto sum(View const& v, std::input_iterator_tag)
+			{
+				using value_type = typename View::value_type;
+				using rep        = typename rep_of<value_type>::type;
+
+				rep total{};
+				for (auto it = v.first; it != v.last; ++it)
+				{
+					auto const source = *it;
+					if (v.keep(source))
+					{
+						total += to_count(v.transform(source));
+					}
+				}
+				return from_count<value_type>(total, is_unit<value_type>{});
+			}
+
+			template <typename View>
+			std::size_t size(View const& v, std::random_access_iterator_tag)
+			{
+				auto const n = static_cast<std::size_t>(v.last - v.first);
+
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					count += static_cast<std::size_t>(v.keep(v.first[i]));
+				}
+				return count;
+			}
+
+			template <typename View>
+			std::size_t size(View const& v, std::input_iterator_tag)
+			{
+				std::size_t count = 0;
+				for (auto it = v.first; it != v.last; ++it)
+				{
+					count += static_cast<std::size_t>(v.keep(*it));
+				}
+				return count;
+			}
+		}
+
+		// The sum of the elements of a view, in its element type
+		template <typename Iterator, typename Transform, typename Keep, bool Converted>
+		auto sum(view<Iterator, Transform, Keep, Converted> const& v)
+		{
+			return detail::sum(v, typename std::iterator_traits<Iterator>::iterator_category{});
+		}
+
+		// The number of elements a view keeps
+		template <typename Iterator, typename Transform, typename Keep, bool Converted>
+		std::size_t size(view<Iterator, Transform, Keep, Converted> const& v)
+		{
+			return detail::size(v, typename std::iterator_traits<Iterator>::iterator_category{});
+		}
+	}
+}